@@ -0,0 +1,445 @@
+// Copyright (C) 2021 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpIpoptApplication.hpp"
+#include "IpIpoptData.hpp"
+#include "IpSolveStatistics.hpp"
+#include "IpTimingStatistics.hpp"
+#include "RegisteredTNLP.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#define HAVE_GETRUSAGE
+#endif
+
+using namespace Ipopt;
+
+/** One problem instance of the sweep */
+struct Configuration
+{
+   std::string problem;
+   Index       size;
+};
+
+/** Measurements of one configuration, as medians over the repetitions */
+struct Result
+{
+   Configuration       config;
+   Index               repetitions;
+   int                 status;
+   Index               iterations;
+   Number              wall_median;
+   Number              wall_min;
+   long                peak_rss_kb;
+   std::vector<Number> task_medians;
+};
+
+static void print_usage(
+   const char* prog
+)
+{
+   printf("Usage: %s [options] PROBLEM:N[,N...] [PROBLEM:N[,N...] ...]\n", prog);
+   printf("       %s list\n", prog);
+   printf("          to list all registered problems.\n\n");
+   printf("Solves every problem for every size N several times and reports the median\n");
+   printf("wallclock time, the number of iterations, the median time of every timed task,\n");
+   printf("and the peak resident set size of the process after the last repetition.\n");
+   printf("Options are read from ipopt.opt as usual; print_level defaults to 0.\n\n");
+   printf("Options:\n");
+   printf("   -r REPS       number of repetitions of every configuration (default 3)\n");
+   printf("   -o FILE       write results to FILE, as JSON if it ends with .json, else as CSV\n");
+   printf("   -b FILE       compare with a baseline CSV file written by -o\n");
+   printf("   -t THRESHOLD  relative increase of the median time that is a regression (default 0.1)\n");
+   printf("   -m SECONDS    increases of the median time below this are ignored (default 0.01)\n\n");
+   printf("Exit code 1 indicates a regression with respect to the baseline.\n");
+}
+
+static Number median(
+   std::vector<Number> values
+)
+{
+   std::sort(values.begin(), values.end());
+   const size_t n = values.size();
+   if( n == 0 )
+   {
+      return 0.;
+   }
+   return n % 2 == 1 ? values[n / 2] : 0.5 * (values[n / 2 - 1] + values[n / 2]);
+}
+
+static long peak_rss_kb()
+{
+#ifdef HAVE_GETRUSAGE
+   struct rusage usage;
+   if( getrusage(RUSAGE_SELF, &usage) != 0 )
+   {
+      return -1;
+   }
+#ifdef __APPLE__
+   return (long) (usage.ru_maxrss / 1024);
+#else
+   return (long) usage.ru_maxrss;
+#endif
+#else
+   return -1;
+#endif
+}
+
+/** Parse PROBLEM:N[,N...]; returns false if the argument is malformed */
+static bool parse_configurations(
+   const char*                 arg,
+   std::vector<Configuration>& configs
+)
+{
+   const char* colon = strchr(arg, ':');
+   if( colon == NULL || colon == arg )
+   {
+      return false;
+   }
+   Configuration config;
+   config.problem = std::string(arg, colon - arg);
+   std::istringstream sizes(colon + 1);
+   std::string size;
+   while( std::getline(sizes, size, ',') )
+   {
+      config.size = (Index) atoi(size.c_str());
+      if( config.size <= 0 )
+      {
+         return false;
+      }
+      configs.push_back(config);
+   }
+   return true;
+}
+
+/** Solve one configuration repeatedly */
+static bool run_configuration(
+   const Configuration& config,
+   Index                repetitions,
+   Result&              result
+)
+{
+   SmartPtr<RegisteredTNLP> tnlp = RegisteredTNLPs::GetTNLP(config.problem);
+   if( !IsValid(tnlp) )
+   {
+      printf("Problem with name \"%s\" not known.\n", config.problem.c_str());
+      return false;
+   }
+
+   const Index ntasks = TimingStatistics::NumTimedTasks();
+   std::vector<Number> walltimes;
+   std::vector<std::vector<Number> > tasktimes(ntasks);
+
+   result.config = config;
+   result.repetitions = repetitions;
+   result.status = 0;
+   result.iterations = 0;
+
+   for( Index rep = 0; rep < repetitions; rep++ )
+   {
+      if( !tnlp->InitializeProblem(config.size) )
+      {
+         printf("Cannot initialize problem %s with N=%d.\n", config.problem.c_str(), (int) config.size);
+         return false;
+      }
+
+      // a new application for every run, so that no state is carried over
+      SmartPtr<IpoptApplication> app = IpoptApplicationFactory();
+      if( app->Initialize() != Solve_Succeeded )
+      {
+         printf("Error during initialization!\n");
+         return false;
+      }
+      app->Options()->SetIntegerValueIfUnset("print_level", 0);
+      app->Options()->SetStringValueIfUnset("sb", "yes");
+      app->Options()->SetStringValue("timing_statistics", "yes");
+
+      const ApplicationReturnStatus status = app->OptimizeTNLP(GetRawPtr(tnlp));
+
+      // iterations and status should not change between repetitions; keep the last
+      result.status = (int) status;
+      result.iterations = IsValid(app->Statistics()) ? app->Statistics()->IterationCount() : -1;
+
+      const TimingStatistics& timing = app->IpoptDataObject()->TimingStats();
+      walltimes.push_back(timing.OverallAlgorithm().TotalWallclockTime());
+      for( Index i = 0; i < ntasks; i++ )
+      {
+         const TimedTask& task = timing.GetTimedTask(i);
+         tasktimes[i].push_back(task.IsEnabled() ? task.TotalWallclockTime() : 0.);
+      }
+   }
+
+   result.wall_median = median(walltimes);
+   result.wall_min = *std::min_element(walltimes.begin(), walltimes.end());
+   result.peak_rss_kb = peak_rss_kb();
+   result.task_medians.resize(ntasks);
+   for( Index i = 0; i < ntasks; i++ )
+   {
+      result.task_medians[i] = median(tasktimes[i]);
+   }
+   return true;
+}
+
+static bool write_csv(
+   const std::string&         filename,
+   const std::vector<Result>& results
+)
+{
+   FILE* file = fopen(filename.c_str(), "w");
+   if( file == NULL )
+   {
+      return false;
+   }
+   fprintf(file, "problem,size,repetitions,status,iterations,wall_median,wall_min,peak_rss_kb");
+   for( Index i = 0; i < TimingStatistics::NumTimedTasks(); i++ )
+   {
+      fprintf(file, ",%s", TimingStatistics::TimedTaskName(i));
+   }
+   fprintf(file, "\n");
+   for( std::vector<Result>::const_iterator r = results.begin(); r != results.end(); ++r )
+   {
+      fprintf(file, "%s,%d,%d,%d,%d,%.6f,%.6f,%ld", r->config.problem.c_str(), (int) r->config.size,
+              (int) r->repetitions, r->status, (int) r->iterations, r->wall_median, r->wall_min, r->peak_rss_kb);
+      for( size_t i = 0; i < r->task_medians.size(); i++ )
+      {
+         fprintf(file, ",%.6f", r->task_medians[i]);
+      }
+      fprintf(file, "\n");
+   }
+   fclose(file);
+   return true;
+}
+
+static bool write_json(
+   const std::string&         filename,
+   const std::vector<Result>& results
+)
+{
+   FILE* file = fopen(filename.c_str(), "w");
+   if( file == NULL )
+   {
+      return false;
+   }
+   fprintf(file, "[\n");
+   for( std::vector<Result>::const_iterator r = results.begin(); r != results.end(); ++r )
+   {
+      fprintf(file, "  {\"problem\": \"%s\", \"size\": %d, \"repetitions\": %d, \"status\": %d, \"iterations\": %d, "
+              "\"wall_median\": %.6f, \"wall_min\": %.6f, \"peak_rss_kb\": %ld, \"tasks\": {",
+              r->config.problem.c_str(), (int) r->config.size, (int) r->repetitions, r->status, (int) r->iterations,
+              r->wall_median, r->wall_min, r->peak_rss_kb);
+      for( size_t i = 0; i < r->task_medians.size(); i++ )
+      {
+         fprintf(file, "%s\"%s\": %.6f", i > 0 ? ", " : "", TimingStatistics::TimedTaskName((Index) i),
+                 r->task_medians[i]);
+      }
+      fprintf(file, "}}%s\n", r + 1 != results.end() ? "," : "");
+   }
+   fprintf(file, "]\n");
+   fclose(file);
+   return true;
+}
+
+/** Compare with a baseline CSV file; returns the number of regressions, or -1 on error */
+static int compare_baseline(
+   const std::string&         filename,
+   const std::vector<Result>& results,
+   Number                     threshold,
+   Number                     min_increase
+)
+{
+   std::ifstream file(filename.c_str());
+   std::string line;
+   if( !file || !std::getline(file, line) )
+   {
+      printf("Cannot read baseline file \"%s\".\n", filename.c_str());
+      return -1;
+   }
+
+   // find the columns of interest in the header
+   std::vector<std::string> header;
+   std::istringstream hs(line);
+   std::string field;
+   while( std::getline(hs, field, ',') )
+   {
+      header.push_back(field);
+   }
+   const char* const columns[] = { "problem", "size", "status", "iterations", "wall_median" };
+   int col[5];
+   for( int c = 0; c < 5; c++ )
+   {
+      col[c] = (int) (std::find(header.begin(), header.end(), columns[c]) - header.begin());
+      if( col[c] == (int) header.size() )
+      {
+         printf("Baseline file \"%s\" has no column %s.\n", filename.c_str(), columns[c]);
+         return -1;
+      }
+   }
+
+   printf("\nComparison with baseline %s (threshold %.0f%%):\n\n", filename.c_str(), 100. * threshold);
+   printf("%-20s %8s %10s %10s %8s %6s %6s  %s\n", "problem", "size", "base [s]", "new [s]", "change", "b.it",
+          "n.it", "verdict");
+
+   int regressions = 0;
+   while( std::getline(file, line) )
+   {
+      std::vector<std::string> fields;
+      std::istringstream ls(line);
+      while( std::getline(ls, field, ',') )
+      {
+         fields.push_back(field);
+      }
+      if( fields.size() != header.size() )
+      {
+         continue;
+      }
+      const std::string& problem = fields[col[0]];
+      const Index size = (Index) atoi(fields[col[1]].c_str());
+      for( std::vector<Result>::const_iterator r = results.begin(); r != results.end(); ++r )
+      {
+         if( r->config.problem != problem || r->config.size != size )
+         {
+            continue;
+         }
+         const int base_status = atoi(fields[col[2]].c_str());
+         const Index base_iter = (Index) atoi(fields[col[3]].c_str());
+         const Number base_wall = atof(fields[col[4]].c_str());
+         const Number change = base_wall > 0. ? r->wall_median / base_wall - 1. : 0.;
+
+         const char* verdict = "ok";
+         if( r->status != base_status )
+         {
+            verdict = "REGRESSION (status changed)";
+         }
+         else if( r->iterations > base_iter )
+         {
+            verdict = "REGRESSION (more iterations)";
+         }
+         else if( change > threshold && r->wall_median - base_wall > min_increase )
+         {
+            verdict = "REGRESSION (slower)";
+         }
+         else if( r->iterations < base_iter )
+         {
+            verdict = "ok (fewer iterations)";
+         }
+         if( strncmp(verdict, "REGRESSION", 10) == 0 )
+         {
+            regressions++;
+         }
+         printf("%-20s %8d %10.3f %10.3f %7.1f%% %6d %6d  %s\n", problem.c_str(), (int) size, base_wall,
+                r->wall_median, 100. * change, (int) base_iter, (int) r->iterations, verdict);
+      }
+   }
+   return regressions;
+}
+
+int main(
+   int   argc,
+   char* argv[]
+)
+{
+   if( argc == 2 && !strcmp(argv[1], "list") )
+   {
+      printf("\nList of all registered problems:\n\n");
+      RegisteredTNLPs::PrintRegisteredProblems();
+      return 0;
+   }
+
+   Index repetitions = 3;
+   std::string outfile;
+   std::string baseline;
+   Number threshold = 0.1;
+   Number min_increase = 0.01;
+   std::vector<Configuration> configs;
+
+   for( int i = 1; i < argc; i++ )
+   {
+      if( argv[i][0] == '-' && argv[i][1] != '\0' && argv[i][2] == '\0' && i + 1 < argc )
+      {
+         switch( argv[i][1] )
+         {
+            case 'r':
+               repetitions = (Index) atoi(argv[++i]);
+               break;
+            case 'o':
+               outfile = argv[++i];
+               break;
+            case 'b':
+               baseline = argv[++i];
+               break;
+            case 't':
+               threshold = atof(argv[++i]);
+               break;
+            case 'm':
+               min_increase = atof(argv[++i]);
+               break;
+            default:
+               print_usage(argv[0]);
+               return -1;
+         }
+      }
+      else if( !parse_configurations(argv[i], configs) )
+      {
+         print_usage(argv[0]);
+         return -1;
+      }
+   }
+   if( configs.empty() || repetitions <= 0 )
+   {
+      print_usage(argv[0]);
+      return -1;
+   }
+
+   printf("%-20s %8s %6s %6s %10s %10s %12s\n", "problem", "size", "status", "iter", "median [s]", "min [s]",
+          "peak RSS [kB]");
+   std::vector<Result> results;
+   for( std::vector<Configuration>::const_iterator c = configs.begin(); c != configs.end(); ++c )
+   {
+      Result result;
+      if( !run_configuration(*c, repetitions, result) )
+      {
+         return -2;
+      }
+      printf("%-20s %8d %6d %6d %10.3f %10.3f %12ld\n", c->problem.c_str(), (int) c->size, result.status,
+             (int) result.iterations, result.wall_median, result.wall_min, result.peak_rss_kb);
+      fflush(stdout);
+      results.push_back(result);
+   }
+
+   if( !outfile.empty() )
+   {
+      const bool json = outfile.size() >= 5 && outfile.compare(outfile.size() - 5, 5, ".json") == 0;
+      if( !(json ? write_json(outfile, results) : write_csv(outfile, results)) )
+      {
+         printf("Cannot write results to \"%s\".\n", outfile.c_str());
+         return -3;
+      }
+   }
+
+   if( !baseline.empty() )
+   {
+      const int regressions = compare_baseline(baseline, results, threshold, min_increase);
+      if( regressions < 0 )
+      {
+         return -3;
+      }
+      if( regressions > 0 )
+      {
+         printf("\n%d regression(s) found.\n", regressions);
+         return 1;
+      }
+      printf("\nNo regressions found.\n");
+   }
+
+   return 0;
+}
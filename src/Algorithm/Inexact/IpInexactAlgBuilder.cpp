@@ -40,6 +40,7 @@
 #include "IpMc19TSymScalingMethod.hpp"
 #include "IpInexactTSymScalingMethod.hpp"
 #include "IpIterativePardisoSolverInterface.hpp"
+#include "IpKrylovSolverInterface.hpp"
 #include "IpInexactNormalTerminationTester.hpp"
 #include "IpInexactPDTerminationTester.hpp"
 
@@ -141,6 +142,13 @@ SmartPtr<IpoptAlgorithm> InexactAlgorithmBuilder::BuildBasicAlgorithm(
       SolverInterface = new IterativePardisoSolverInterface(*NormalTester, *pd_tester, GetPardisoLoader(options, prefix));
    }
 
+   else if( linear_solver == "krylov" )
+   {
+      NormalTester = new InexactNormalTerminationTester();
+      SmartPtr<IterativeSolverTerminationTester> pd_tester = new InexactPDTerminationTester();
+      SolverInterface = new KrylovSolverInterface(*NormalTester, *pd_tester);
+   }
+
 #ifdef IPOPT_HAS_WSMP
    else if( linear_solver == "wsmp" )
    {
@@ -238,7 +246,11 @@ void AddInexactDefaultOptions(
    // TODO: Find out about the following:
    //options_list.SetNumericValueIfUnset("bound_relax_factor", 0.);
    options_list.SetNumericValueIfUnset("kappa_d", 0.);
+#ifdef PARDISO_LIB
    options_list.SetStringValueIfUnset("linear_solver", "pardiso");
+#else
+   options_list.SetStringValueIfUnset("linear_solver", "krylov");
+#endif
    options_list.SetStringValue("linear_scaling_on_demand", "no");
    options_list.SetStringValue("replace_bounds", "yes");
 }
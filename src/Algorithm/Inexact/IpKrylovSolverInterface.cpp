@@ -0,0 +1,655 @@
+// Copyright (C) 2021 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpoptConfig.h"
+#include "IpKrylovSolverInterface.hpp"
+#include "IpBlas.hpp"
+#include "IpIncompleteLdl.hpp"
+#include "IpMultilevelPreconditioner.hpp"
+
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+namespace Ipopt
+{
+#if IPOPT_VERBOSITY > 0
+static const Index dbg_verbosity = 0;
+#endif
+
+KrylovSolverInterface::KrylovSolverInterface(
+   IterativeSolverTerminationTester& normal_tester,
+   IterativeSolverTerminationTester& pd_tester
+)
+   : dim_(0),
+     nonzeros_(0),
+     a_(NULL),
+     method_(MINRES),
+     precond_(PRECOND_DIAGONAL),
+     max_iter_(500),
+     normal_max_iter_(500),
+     ildl_droptol_(1e-3),
+     ildl_fill_factor_(5.),
+     ildl_pivtol_(1e-8),
+     ildl_scaling_(true),
+     ildl_pattern_reuse_(10),
+     multilevel_coarse_size_(200),
+     multilevel_max_levels_(10),
+     multilevel_strength_(0.08),
+     have_preconditioner_(false),
+     normal_tester_(&normal_tester),
+     pd_tester_(&pd_tester),
+     test_result_(IterativeSolverTerminationTester::CONTINUE)
+{
+   DBG_START_METH("KrylovSolverInterface::KrylovSolverInterface()", dbg_verbosity);
+}
+
+KrylovSolverInterface::~KrylovSolverInterface()
+{
+   DBG_START_METH("KrylovSolverInterface::~KrylovSolverInterface()", dbg_verbosity);
+   delete[] a_;
+}
+
+void KrylovSolverInterface::RegisterOptions(
+   SmartPtr<RegisteredOptions> roptions
+)
+{
+   roptions->AddStringOption2(
+      "krylov_method",
+      "Krylov method of the built-in iterative linear solver for the inexact algorithm.",
+      "minres",
+      "minres", "minimal residual method; requires a positive definite preconditioner",
+      "sqmr", "symmetric quasi-minimal residual method; allows for an indefinite preconditioner",
+      "This option is used if linear_solver is set to krylov.");
+   roptions->AddStringOption4(
+      "krylov_preconditioner",
+      "Preconditioner of the built-in iterative linear solver for the inexact algorithm.",
+      "ildl",
+      "none", "no preconditioning",
+      "diagonal", "use the diagonal of the matrix, in absolute value for MINRES; zero diagonal entries are replaced by one",
+      "ildl", "incomplete LDL^T factorization of the matrix with threshold dropping",
+      "multilevel", "block diagonal preconditioner with an algebraic multigrid cycle for the Hessian block and an incomplete factorization of an approximate Schur complement",
+      "For MINRES, the absolute values of the pivots of the incomplete factorization and a positive Schur complement block are used.");
+   roptions->AddLowerBoundedIntegerOption(
+      "krylov_max_iter",
+      "Maximal number of iterations of the built-in iterative linear solver for the inexact algorithm.",
+      1,
+      500,
+      "The value for the computation of the normal step can be set separately with prefix \"normal.\".");
+   roptions->AddLowerBoundedNumberOption(
+      "ildl_droptol",
+      "Drop tolerance of the incomplete LDL^T factorization for the built-in iterative linear solver.",
+      0., false,
+      1e-3,
+      "An entry of the factor is dropped if it is smaller than this value times the largest entry of its row of the (scaled) matrix. "
+      "This is also used for the Schur complement and for a large coarsest level of the multilevel preconditioner.");
+   roptions->AddLowerBoundedNumberOption(
+      "ildl_fill_factor",
+      "Fill factor of the incomplete LDL^T factorization for the built-in iterative linear solver.",
+      0., true,
+      5.,
+      "At most this value times the average number of nonzeros per row of the matrix are kept in every column of the factor.");
+   roptions->AddLowerBoundedNumberOption(
+      "ildl_pivtol",
+      "Pivot tolerance of the incomplete LDL^T factorization for the built-in iterative linear solver.",
+      0., true,
+      1e-8,
+      "Pivots smaller than this value times the largest entry of their row of the (scaled) matrix are perturbed.");
+   roptions->AddBoolOption(
+      "ildl_scaling",
+      "Whether to equilibrate the matrix before the incomplete LDL^T factorization for the built-in iterative linear solver.",
+      true);
+   roptions->AddLowerBoundedIntegerOption(
+      "ildl_pattern_reuse",
+      "Number of incomplete factorizations that reuse the sparsity pattern of a previous one.",
+      0,
+      10,
+      "If only the values of the matrix change, the factor is recomputed on the sparsity pattern of an earlier factorization "
+      "(and the multilevel preconditioner reuses its aggregates), which is considerably cheaper. "
+      "A new pattern is computed after this number of factorizations, or if more pivots have to be perturbed.");
+   roptions->AddLowerBoundedIntegerOption(
+      "multilevel_coarse_size",
+      "Size of the coarsest level of the multilevel preconditioner for the built-in iterative linear solver.",
+      1,
+      200,
+      "The coarsening stops when a level has at most this number of rows. "
+      "The coarsest level is factorized completely if it is not larger than this.");
+   roptions->AddLowerBoundedIntegerOption(
+      "multilevel_max_levels",
+      "Maximal number of levels of the multilevel preconditioner for the built-in iterative linear solver.",
+      1,
+      10);
+   roptions->AddBoundedNumberOption(
+      "multilevel_strength",
+      "Threshold for strong connections in the multilevel preconditioner for the built-in iterative linear solver.",
+      0., true,
+      1., false,
+      0.08,
+      "Two variables i and j are strongly connected if |H_ij| >= multilevel_strength * sqrt(|H_ii H_jj|).");
+}
+
+bool KrylovSolverInterface::InitializeImpl(
+   const OptionsList& options,
+   const std::string& prefix
+)
+{
+   Index enum_int;
+   options.GetEnumValue("krylov_method", enum_int, prefix);
+   method_ = KrylovMethod(enum_int);
+   options.GetEnumValue("krylov_preconditioner", enum_int, prefix);
+   precond_ = KrylovPreconditioner(enum_int);
+   options.GetIntegerValue("krylov_max_iter", max_iter_, prefix);
+   options.GetIntegerValue("krylov_max_iter", normal_max_iter_, prefix + "normal.");
+   options.GetNumericValue("ildl_droptol", ildl_droptol_, prefix);
+   options.GetNumericValue("ildl_fill_factor", ildl_fill_factor_, prefix);
+   options.GetNumericValue("ildl_pivtol", ildl_pivtol_, prefix);
+   options.GetBoolValue("ildl_scaling", ildl_scaling_, prefix);
+   options.GetIntegerValue("ildl_pattern_reuse", ildl_pattern_reuse_, prefix);
+   options.GetIntegerValue("multilevel_coarse_size", multilevel_coarse_size_, prefix);
+   options.GetIntegerValue("multilevel_max_levels", multilevel_max_levels_, prefix);
+   options.GetNumericValue("multilevel_strength", multilevel_strength_, prefix);
+
+   // Reset all private data
+   dim_ = 0;
+   nonzeros_ = 0;
+   delete[] a_;
+   a_ = NULL;
+   have_preconditioner_ = false;
+   precond_diag_.clear();
+   preconditioner_ = NULL;
+
+   bool retval = normal_tester_->Initialize(Jnlst(), IpNLP(), IpData(), IpCq(), options, prefix);
+   if( retval )
+   {
+      retval = pd_tester_->Initialize(Jnlst(), IpNLP(), IpData(), IpCq(), options, prefix);
+   }
+
+   return retval;
+}
+
+ESymSolverStatus KrylovSolverInterface::InitializeStructure(
+   Index        dim,
+   Index        nonzeros,
+   const Index* ia,
+   const Index* ja
+)
+{
+   DBG_START_METH("KrylovSolverInterface::InitializeStructure", dbg_verbosity);
+
+   dim_ = dim;
+   nonzeros_ = nonzeros;
+
+   delete[] a_;
+   a_ = NULL;
+   a_ = new Number[nonzeros_];
+
+   have_preconditioner_ = false;
+   preconditioner_ = NULL;
+   if( precond_ == PRECOND_ILDL )
+   {
+      preconditioner_ = new IncompleteLdlPreconditioner(ildl_droptol_, ildl_fill_factor_, ildl_pivtol_, ildl_scaling_,
+            ildl_pattern_reuse_);
+   }
+   else if( precond_ == PRECOND_MULTILEVEL )
+   {
+      SmartPtr<MultilevelBlockPreconditioner> ml = new MultilevelBlockPreconditioner(multilevel_coarse_size_,
+            multilevel_max_levels_, multilevel_strength_, ildl_droptol_, ildl_fill_factor_, ildl_pivtol_, ildl_pattern_reuse_);
+      // the (1,1) block of the augmented system belongs to x and s
+      if( HaveIpData() )
+      {
+         ml->SetBlockSize(IpData().curr()->x()->Dim() + IpData().curr()->s()->Dim());
+      }
+      preconditioner_ = GetRawPtr(ml);
+   }
+   if( IsValid(preconditioner_) )
+   {
+      preconditioner_->SetPositiveDefinite(method_ == MINRES);
+      preconditioner_->InitializeStructure(dim_, ia, ja);
+   }
+
+   return SYMSOLVER_SUCCESS;
+}
+
+Number* KrylovSolverInterface::GetValuesArrayPtr()
+{
+   DBG_START_METH("KrylovSolverInterface::GetValuesArrayPtr", dbg_verbosity);
+   DBG_ASSERT(a_ != NULL);
+   return a_;
+}
+
+ESymSolverStatus KrylovSolverInterface::MultiSolve(
+   bool         new_matrix,
+   const Index* ia,
+   const Index* ja,
+   Index        nrhs,
+   Number*      rhs_vals,
+   bool         /*check_NegEVals*/,
+   Index        /*numberOfNegEVals*/
+)
+{
+   DBG_START_METH("KrylovSolverInterface::MultiSolve", dbg_verbosity);
+
+   if( new_matrix || !have_preconditioner_ )
+   {
+      if( HaveIpData() )
+      {
+         IpData().TimingStats().LinearSystemFactorization().Start();
+      }
+      ESymSolverStatus precond_status = ComputePreconditioner(ia, ja);
+      if( HaveIpData() )
+      {
+         IpData().TimingStats().LinearSystemFactorization().End();
+      }
+      if( precond_status != SYMSOLVER_SUCCESS )
+      {
+         Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                        "Krylov solver: computation of the preconditioner failed.\n");
+         return precond_status;
+      }
+   }
+
+   IterativeSolverTerminationTester* tester;
+   Index max_iter;
+   bool is_normal = false;
+   if( IsNull(InexData().normal_x()) && InexData().compute_normal() )
+   {
+      tester = GetRawPtr(normal_tester_);
+      max_iter = normal_max_iter_;
+      is_normal = true;
+   }
+   else
+   {
+      tester = GetRawPtr(pd_tester_);
+      max_iter = max_iter_;
+   }
+
+   if( HaveIpData() )
+   {
+      IpData().TimingStats().LinearSystemBackSolve().Start();
+   }
+
+   ESymSolverStatus retval = SYMSOLVER_SUCCESS;
+   std::vector<Number> b(dim_);
+   for( Index irhs = 0; irhs < nrhs && retval == SYMSOLVER_SUCCESS; irhs++ )
+   {
+      Number* x = rhs_vals + irhs * dim_;
+      IpBlasCopy(dim_, x, 1, &b[0], 1);
+
+      bool initialized = tester->InitializeSolve();
+      ASSERT_EXCEPTION(initialized, INTERNAL_ABORT, "tester->InitializeSolve(); returned false");
+
+      if( method_ == MINRES )
+      {
+         retval = SolveMinres(*tester, ia, ja, &b[0], x, max_iter);
+      }
+      else
+      {
+         retval = SolveSqmr(*tester, ia, ja, &b[0], x, max_iter);
+      }
+
+      Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                     "Number of iterations in Krylov solver for %s step = %" IPOPT_INDEX_FORMAT ".\n",
+                     is_normal ? "normal" : "PD", tester->GetSolverIterations());
+      tester->Clear();
+
+      if( retval != SYMSOLVER_SUCCESS )
+      {
+         break;
+      }
+      if( test_result_ == IterativeSolverTerminationTester::MODIFY_HESSIAN )
+      {
+         Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                        "Termination tester requests modification of Hessian\n");
+         retval = SYMSOLVER_WRONG_INERTIA;
+      }
+      else if( test_result_ == IterativeSolverTerminationTester::TEST_2_SATISFIED )
+      {
+         // Termination Test 2 is satisfied, set the step for the primal
+         // iterates to zero
+         Index nvars = IpData().curr()->x()->Dim() + IpData().curr()->s()->Dim();
+         const Number zero = 0.;
+         IpBlasCopy(nvars, &zero, 0, x, 1);
+      }
+   }
+
+   if( HaveIpData() )
+   {
+      IpData().TimingStats().LinearSystemBackSolve().End();
+   }
+
+   return retval;
+}
+
+Index KrylovSolverInterface::NumberOfNegEVals() const
+{
+   DBG_START_METH("KrylovSolverInterface::NumberOfNegEVals", dbg_verbosity);
+   // no inertia is available without a factorization
+   return -1;
+}
+
+bool KrylovSolverInterface::IncreaseQuality()
+{
+   // The accuracy is controlled by the termination testers
+   return false;
+}
+
+ESymSolverStatus KrylovSolverInterface::ComputePreconditioner(
+   const Index* ia,
+   const Index* ja
+)
+{
+   DBG_START_METH("KrylovSolverInterface::ComputePreconditioner", dbg_verbosity);
+
+   have_preconditioner_ = false;
+   if( IsValid(preconditioner_) )
+   {
+      ESymSolverStatus retval = preconditioner_->Factorize(a_);
+      have_preconditioner_ = (retval == SYMSOLVER_SUCCESS);
+      return retval;
+   }
+
+   precond_diag_.assign(dim_, 0.);
+   have_preconditioner_ = true;
+   if( precond_ == PRECOND_NONE )
+   {
+      return SYMSOLVER_SUCCESS;
+   }
+
+   for( Index i = 0; i < dim_; i++ )
+   {
+      for( Index k = ia[i]; k < ia[i + 1]; k++ )
+      {
+         if( ja[k] == i )
+         {
+            precond_diag_[i] += a_[k];
+         }
+      }
+   }
+   for( Index i = 0; i < dim_; i++ )
+   {
+      Number d = precond_diag_[i];
+      if( method_ == MINRES )
+      {
+         d = std::abs(d);
+      }
+      precond_diag_[i] = (d == 0.) ? 1. : 1. / d;
+   }
+   return SYMSOLVER_SUCCESS;
+}
+
+void KrylovSolverInterface::ApplyPreconditioner(
+   const Number* r,
+   Number*       z
+) const
+{
+   if( IsValid(preconditioner_) )
+   {
+      preconditioner_->Apply(r, z);
+      return;
+   }
+   if( precond_ == PRECOND_NONE )
+   {
+      IpBlasCopy(dim_, r, 1, z, 1);
+      return;
+   }
+
+   for( Index i = 0; i < dim_; i++ )
+   {
+      z[i] = precond_diag_[i] * r[i];
+   }
+}
+
+void KrylovSolverInterface::MultMatrix(
+   const Index*  ia,
+   const Index*  ja,
+   const Number* x,
+   Number*       y
+) const
+{
+   const Number zero = 0.;
+   IpBlasCopy(dim_, &zero, 0, y, 1);
+   for( Index i = 0; i < dim_; i++ )
+   {
+      Number yi = 0.;
+      const Number xi = x[i];
+      for( Index k = ia[i]; k < ia[i + 1]; k++ )
+      {
+         const Index j = ja[k];
+         yi += a_[k] * x[j];
+         if( j != i )
+         {
+            y[j] += a_[k] * xi;
+         }
+      }
+      y[i] += yi;
+   }
+}
+
+bool KrylovSolverInterface::TestTermination(
+   IterativeSolverTerminationTester& tester,
+   const Index*                      ia,
+   const Index*                      ja,
+   const Number*                     b,
+   const Number*                     x,
+   Number*                           r,
+   Index                             iter,
+   Number                            norm2_rhs
+)
+{
+   MultMatrix(ia, ja, x, r);
+   IpBlasAxpy(dim_, -1., b, 1, r, 1);
+
+   test_result_ = tester.TestTermination(dim_, x, r, iter, norm2_rhs);
+   Jnlst().Printf(J_MOREDETAILED, J_LINEAR_ALGEBRA,
+                  "Termination Tester Result = %d.\n", test_result_);
+
+   return test_result_ != IterativeSolverTerminationTester::CONTINUE;
+}
+
+ESymSolverStatus KrylovSolverInterface::SolveMinres(
+   IterativeSolverTerminationTester& tester,
+   const Index*                      ia,
+   const Index*                      ja,
+   const Number*                     b,
+   Number*                           x,
+   Index                             max_iter
+)
+{
+   DBG_START_METH("KrylovSolverInterface::SolveMinres", dbg_verbosity);
+
+   // Preconditioned MINRES of Paige and Saunders, starting from x = 0
+   const Number zero = 0.;
+   IpBlasCopy(dim_, &zero, 0, x, 1);
+   test_result_ = IterativeSolverTerminationTester::CONTINUE;
+
+   const Number norm2_rhs = IpBlasNrm2(dim_, b, 1);
+   if( norm2_rhs == 0. )
+   {
+      test_result_ = IterativeSolverTerminationTester::OTHER_SATISFIED;
+      return SYMSOLVER_SUCCESS;
+   }
+
+   std::vector<Number> r1(b, b + dim_);
+   std::vector<Number> r2(r1);
+   std::vector<Number> y(dim_);
+   std::vector<Number> v(dim_);
+   std::vector<Number> w(dim_, 0.);
+   std::vector<Number> w1(dim_, 0.);
+   std::vector<Number> w2(dim_, 0.);
+   std::vector<Number> resid(dim_);
+
+   ApplyPreconditioner(&r1[0], &y[0]);
+   Number beta = IpBlasDot(dim_, &r1[0], 1, &y[0], 1);
+   if( beta <= 0. )
+   {
+      Jnlst().Printf(J_ERROR, J_LINEAR_ALGEBRA,
+                     "MINRES: preconditioner is not positive definite.\n");
+      return SYMSOLVER_FATAL_ERROR;
+   }
+   beta = std::sqrt(beta);
+
+   Number oldb = 0.;
+   Number dbar = 0.;
+   Number epsln = 0.;
+   Number phibar = beta;
+   Number cs = -1.;
+   Number sn = 0.;
+
+   for( Index iter = 1; iter <= max_iter; iter++ )
+   {
+      // Lanczos step
+      const Number s = 1. / beta;
+      for( Index i = 0; i < dim_; i++ )
+      {
+         v[i] = s * y[i];
+      }
+      MultMatrix(ia, ja, &v[0], &y[0]);
+      if( iter >= 2 )
+      {
+         IpBlasAxpy(dim_, -beta / oldb, &r1[0], 1, &y[0], 1);
+      }
+      const Number alfa = IpBlasDot(dim_, &v[0], 1, &y[0], 1);
+      IpBlasAxpy(dim_, -alfa / beta, &r2[0], 1, &y[0], 1);
+      r1.swap(r2);
+      r2.swap(y);
+      ApplyPreconditioner(&r2[0], &y[0]);
+      oldb = beta;
+      beta = IpBlasDot(dim_, &r2[0], 1, &y[0], 1);
+      if( beta < 0. )
+      {
+         Jnlst().Printf(J_ERROR, J_LINEAR_ALGEBRA,
+                        "MINRES: preconditioner is not positive definite.\n");
+         return SYMSOLVER_FATAL_ERROR;
+      }
+      beta = std::sqrt(beta);
+
+      // apply previous rotation and compute the new one
+      const Number oldeps = epsln;
+      const Number delta = cs * dbar + sn * alfa;
+      const Number gbar = sn * dbar - cs * alfa;
+      epsln = sn * beta;
+      dbar = -cs * beta;
+      Number gamma = std::sqrt(gbar * gbar + beta * beta);
+      gamma = Max(gamma, std::numeric_limits<Number>::epsilon());
+      cs = gbar / gamma;
+      sn = beta / gamma;
+      const Number phi = cs * phibar;
+      phibar = sn * phibar;
+
+      // update the search direction and the solution
+      for( Index i = 0; i < dim_; i++ )
+      {
+         w1[i] = (v[i] - oldeps * w2[i] - delta * w[i]) / gamma;
+      }
+      w1.swap(w2);
+      w2.swap(w);
+      IpBlasAxpy(dim_, phi, &w[0], 1, x, 1);
+
+      if( TestTermination(tester, ia, ja, b, x, &resid[0], iter, norm2_rhs) )
+      {
+         return SYMSOLVER_SUCCESS;
+      }
+      if( beta == 0. )
+      {
+         // the Krylov subspace is invariant, so x does not change anymore;
+         // after the first iteration, leave the decision to the caller as
+         // if the iteration limit had been reached
+         Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                        "MINRES: Krylov subspace exhausted after %" IPOPT_INDEX_FORMAT " iterations.\n", iter);
+         return iter == 1 ? SYMSOLVER_SINGULAR : SYMSOLVER_SUCCESS;
+      }
+   }
+
+   Jnlst().Printf(J_WARNING, J_LINEAR_ALGEBRA,
+                  "MINRES did not satisfy the termination test within %" IPOPT_INDEX_FORMAT " iterations.\n", max_iter);
+   return SYMSOLVER_SUCCESS;
+}
+
+ESymSolverStatus KrylovSolverInterface::SolveSqmr(
+   IterativeSolverTerminationTester& tester,
+   const Index*                      ia,
+   const Index*                      ja,
+   const Number*                     b,
+   Number*                           x,
+   Index                             max_iter
+)
+{
+   DBG_START_METH("KrylovSolverInterface::SolveSqmr", dbg_verbosity);
+
+   // Symmetric QMR of Freund and Nachtigal with a right preconditioner, starting from x = 0
+   const Number zero = 0.;
+   IpBlasCopy(dim_, &zero, 0, x, 1);
+   test_result_ = IterativeSolverTerminationTester::CONTINUE;
+
+   const Number norm2_rhs = IpBlasNrm2(dim_, b, 1);
+   if( norm2_rhs == 0. )
+   {
+      test_result_ = IterativeSolverTerminationTester::OTHER_SATISFIED;
+      return SYMSOLVER_SUCCESS;
+   }
+
+   std::vector<Number> r(b, b + dim_);
+   std::vector<Number> q(dim_);
+   std::vector<Number> t(dim_);
+   std::vector<Number> d(dim_, 0.);
+   std::vector<Number> resid(dim_);
+
+   ApplyPreconditioner(&r[0], &q[0]);
+   Number tau = norm2_rhs;
+   Number theta = 0.;
+   Number rho = IpBlasDot(dim_, &r[0], 1, &q[0], 1);
+
+   for( Index iter = 1; iter <= max_iter; iter++ )
+   {
+      MultMatrix(ia, ja, &q[0], &t[0]);
+      const Number sigma = IpBlasDot(dim_, &q[0], 1, &t[0], 1);
+      if( sigma == 0. || rho == 0. )
+      {
+         // after the first iteration, return the current iterate as if the
+         // iteration limit had been reached
+         Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                        "SQMR: breakdown in iteration %" IPOPT_INDEX_FORMAT ".\n", iter);
+         return iter == 1 ? SYMSOLVER_SINGULAR : SYMSOLVER_SUCCESS;
+      }
+      const Number alpha = rho / sigma;
+      IpBlasAxpy(dim_, -alpha, &t[0], 1, &r[0], 1);
+
+      const Number theta_old = theta;
+      theta = IpBlasNrm2(dim_, &r[0], 1) / tau;
+      const Number c2 = 1. / (1. + theta * theta);
+      tau = tau * theta * std::sqrt(c2);
+      for( Index i = 0; i < dim_; i++ )
+      {
+         d[i] = c2 * theta_old * theta_old * d[i] + c2 * alpha * q[i];
+      }
+      IpBlasAxpy(dim_, 1., &d[0], 1, x, 1);
+
+      if( TestTermination(tester, ia, ja, b, x, &resid[0], iter, norm2_rhs) )
+      {
+         return SYMSOLVER_SUCCESS;
+      }
+      if( tau == 0. )
+      {
+         Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                        "SQMR: residual vanished after %" IPOPT_INDEX_FORMAT " iterations.\n", iter);
+         return SYMSOLVER_SUCCESS;
+      }
+
+      // t is free now and holds the preconditioned residual
+      ApplyPreconditioner(&r[0], &t[0]);
+      const Number rho_old = rho;
+      rho = IpBlasDot(dim_, &r[0], 1, &t[0], 1);
+      const Number beta = rho / rho_old;
+      for( Index i = 0; i < dim_; i++ )
+      {
+         q[i] = t[i] + beta * q[i];
+      }
+   }
+
+   Jnlst().Printf(J_WARNING, J_LINEAR_ALGEBRA,
+                  "SQMR did not satisfy the termination test within %" IPOPT_INDEX_FORMAT " iterations.\n", max_iter);
+   return SYMSOLVER_SUCCESS;
+}
+
+} // namespace Ipopt
@@ -0,0 +1,272 @@
+// Copyright (C) 2021 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPKRYLOVSOLVERINTERFACE_HPP__
+#define __IPKRYLOVSOLVERINTERFACE_HPP__
+
+#include "IpSparseSymLinearSolverInterface.hpp"
+#include "IpInexactCq.hpp"
+#include "IpIterativeSolverTerminationTester.hpp"
+#include "IpSymPreconditioner.hpp"
+
+#include <vector>
+
+namespace Ipopt
+{
+
+/** Built-in preconditioned Krylov solver for the inexact version of
+ *  Ipopt, derived from SparseSymLinearSolverInterface.
+ *
+ *  The augmented system is solved by MINRES or by the symmetric QMR
+ *  method (SQMR).  The matrix is only used for matrix-vector products
+ *  and for the preconditioner, which is either diagonal, an incomplete
+ *  LDL^T factorization with bounded fill (IncompleteLdlPreconditioner),
+ *  or a block preconditioner with a multigrid cycle for the Hessian
+ *  block (MultilevelBlockPreconditioner), so that the memory
+ *  requirement is linear in the number of nonzeros of the matrix.  As for
+ *  IterativePardisoSolverInterface, the iteration is stopped as soon
+ *  as the termination tester for the normal or primal-dual step is
+ *  satisfied.
+ *
+ *  Since no complete factorization is computed, the solver does not
+ *  provide the inertia of the matrix.
+ *
+ *  @since 3.14.5
+ */
+class KrylovSolverInterface: public SparseSymLinearSolverInterface
+{
+public:
+   /** @name Constructor/Destructor */
+   ///@{
+   /** Constructor */
+   KrylovSolverInterface(
+      IterativeSolverTerminationTester& normal_tester,
+      IterativeSolverTerminationTester& pd_tester
+   );
+
+   /** Destructor */
+   virtual ~KrylovSolverInterface();
+   ///@}
+
+   bool InitializeImpl(
+      const OptionsList& options,
+      const std::string& prefix
+   );
+
+   /** @name Methods for requesting solution of the linear system. */
+   ///@{
+   virtual ESymSolverStatus InitializeStructure(
+      Index        dim,
+      Index        nonzeros,
+      const Index* ia,
+      const Index* ja
+   );
+
+   virtual Number* GetValuesArrayPtr();
+
+   virtual ESymSolverStatus MultiSolve(
+      bool         new_matrix,
+      const Index* ia,
+      const Index* ja,
+      Index        nrhs,
+      Number*      rhs_vals,
+      bool         check_NegEVals,
+      Index        numberOfNegEVals
+   );
+
+   virtual Index NumberOfNegEVals() const;
+   ///@}
+
+   //* @name Options of Linear solver */
+   ///@{
+   virtual bool IncreaseQuality();
+
+   virtual bool ProvidesInertia() const
+   {
+      return false;
+   }
+
+   EMatrixFormat MatrixFormat() const
+   {
+      return CSR_Format_0_Offset;
+   }
+   ///@}
+
+   static void RegisterOptions(
+      SmartPtr<RegisteredOptions> roptions
+   );
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called. */
+   ///@{
+   /** Default Constructor */
+   KrylovSolverInterface();
+
+   /** Copy Constructor */
+   KrylovSolverInterface(
+      const KrylovSolverInterface&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const KrylovSolverInterface&
+   );
+   ///@}
+
+   /** Krylov methods */
+   enum KrylovMethod
+   {
+      MINRES,
+      SQMR
+   };
+
+   /** Preconditioners */
+   enum KrylovPreconditioner
+   {
+      PRECOND_NONE,
+      PRECOND_DIAGONAL,
+      PRECOND_ILDL,
+      PRECOND_MULTILEVEL
+   };
+
+   /** @name Information about the matrix */
+   ///@{
+   /** Number of rows and columns of the matrix */
+   Index dim_;
+
+   /** Number of nonzeros of the upper triangular part of the matrix */
+   Index nonzeros_;
+
+   /** Values of the matrix */
+   Number* a_;
+   ///@}
+
+   /** @name Solver specific options */
+   ///@{
+   /** Krylov method */
+   KrylovMethod method_;
+   /** Preconditioner */
+   KrylovPreconditioner precond_;
+   /** Maximal number of iterations for the primal-dual step */
+   Index max_iter_;
+   /** Maximal number of iterations for the normal step */
+   Index normal_max_iter_;
+   /** Drop tolerance of the incomplete factorization */
+   Number ildl_droptol_;
+   /** Fill factor of the incomplete factorization */
+   Number ildl_fill_factor_;
+   /** Pivot tolerance of the incomplete factorization */
+   Number ildl_pivtol_;
+   /** Whether the matrix is scaled for the incomplete factorization */
+   bool ildl_scaling_;
+   /** Number of factorizations with the same pattern */
+   Index ildl_pattern_reuse_;
+   /** Size of the coarsest level of the multilevel preconditioner */
+   Index multilevel_coarse_size_;
+   /** Maximal number of levels of the multilevel preconditioner */
+   Index multilevel_max_levels_;
+   /** Strength threshold of the multilevel preconditioner */
+   Number multilevel_strength_;
+   ///@}
+
+   /** Whether the preconditioner has been computed for the current matrix */
+   bool have_preconditioner_;
+
+   /** Inverse of the diagonal preconditioner */
+   std::vector<Number> precond_diag_;
+
+   /** Incomplete factorization or multilevel preconditioner */
+   SmartPtr<SymPreconditioner> preconditioner_;
+
+   /** Termination tester for normal step computation */
+   SmartPtr<IterativeSolverTerminationTester> normal_tester_;
+
+   /** Termination tester for primal-dual step computation */
+   SmartPtr<IterativeSolverTerminationTester> pd_tester_;
+
+   /** Result of the most recent termination test */
+   IterativeSolverTerminationTester::ETerminationTest test_result_;
+
+   /** @name Internal functions */
+   ///@{
+   /** Compute the preconditioner for the matrix in a_. */
+   ESymSolverStatus ComputePreconditioner(
+      const Index* ia,
+      const Index* ja
+   );
+
+   /** Apply the inverse of the preconditioner: z = M^{-1} r. */
+   void ApplyPreconditioner(
+      const Number* r,
+      Number*       z
+   ) const;
+
+   /** Compute y = A x for the symmetric matrix given by its upper triangle. */
+   void MultMatrix(
+      const Index*  ia,
+      const Index*  ja,
+      const Number* x,
+      Number*       y
+   ) const;
+
+   /** Compute the residual r = A x - b and call the termination tester.
+    *
+    *  @return true, if the iteration can be stopped
+    */
+   bool TestTermination(
+      IterativeSolverTerminationTester& tester,
+      const Index*                      ia,
+      const Index*                      ja,
+      const Number*                     b,
+      const Number*                     x,
+      Number*                           r,
+      Index                             iter,
+      Number                            norm2_rhs
+   );
+
+   /** Solve for one right hand side with MINRES.
+    *
+    *  The preconditioner must be positive definite.
+    */
+   ESymSolverStatus SolveMinres(
+      IterativeSolverTerminationTester& tester,
+      const Index*                      ia,
+      const Index*                      ja,
+      const Number*                     b,
+      Number*                           x,
+      Index                             max_iter
+   );
+
+   /** Solve for one right hand side with SQMR.
+    *
+    *  The preconditioner can be indefinite.
+    */
+   ESymSolverStatus SolveSqmr(
+      IterativeSolverTerminationTester& tester,
+      const Index*                      ia,
+      const Index*                      ja,
+      const Number*                     b,
+      Number*                           x,
+      Index                             max_iter
+   );
+   ///@}
+
+   /** Method to easily access Inexact data */
+   InexactData& InexData()
+   {
+      InexactData& inexact_data = static_cast<InexactData&>(IpData().AdditionalData());
+      DBG_ASSERT(dynamic_cast<InexactData*>(&IpData().AdditionalData()));
+      return inexact_data;
+   }
+};
+
+} // namespace Ipopt
+
+#endif
@@ -39,6 +39,7 @@
 #include "IpOrigIpoptNLP.hpp"
 #include "IpLowRankAugSystemSolver.hpp"
 #include "IpLowRankSSAugSystemSolver.hpp"
+#include "IpSchurAugSystemSolver.hpp"
 #include "IpRestoIterationOutput.hpp"
 #include "IpRestoFilterConvCheck.hpp"
 #include "IpRestoIterateInitializer.hpp"
@@ -59,6 +60,7 @@
 #include "IpMa97SolverInterface.hpp"
 #include "IpMc19TSymScalingMethod.hpp"
 #include "IpPardisoSolverInterface.hpp"
+#include "IpLdlSolverInterface.hpp"
 #ifdef IPOPT_HAS_PARDISO_MKL
 # include "IpPardisoMKLSolverInterface.hpp"
 #endif
@@ -199,6 +201,17 @@ void AlgorithmBuilder::RegisterOptions(
       descrs.push_back("use the Mumps package");
    }
 
+   if( availablesolvers & IPOPTLINEARSOLVER_LDL )
+   {
+      options.push_back("ldl");
+      descrs.push_back("use the built-in multifrontal LDL^T solver");
+   }
+
+#ifdef BUILD_INEXACT
+   options.push_back("krylov");
+   descrs.push_back("use the built-in preconditioned Krylov solver (MINRES or SQMR); only for the inexact algorithm");
+#endif
+
    options.push_back("custom");
    descrs.push_back("use custom linear solver (expert use)");
 
@@ -247,6 +260,10 @@ void AlgorithmBuilder::RegisterOptions(
    {
       defaultsolver = "ma27";
    }
+   else if( availablesolvers & IPOPTLINEARSOLVER_LDL )
+   {
+      defaultsolver = "ldl";
+   }
    else
    {
       defaultsolver = "custom";
@@ -513,6 +530,18 @@ SmartPtr<SymLinearSolver> AlgorithmBuilder::SymLinearSolverFactory(
    }
 #endif
 
+   else if( linear_solver == "ldl" )
+   {
+      SolverInterface = new LdlSolverInterface();
+   }
+
+#ifdef BUILD_INEXACT
+   else if( linear_solver == "krylov" )
+   {
+      THROW_EXCEPTION(OPTION_INVALID, "Linear solver krylov is only available for the inexact algorithm (option inexact_algorithm).");
+   }
+#endif
+
    else if( linear_solver == "custom" )
    {
       SolverInterface = NULL;
@@ -620,6 +649,13 @@ SmartPtr<AugSystemSolver> AlgorithmBuilder::AugSystemSolverFactory(
          THROW_EXCEPTION(OPTION_INVALID, "Unknown value for option \"limited_memory_aug_solver\".");
       }
    }
+
+   bool schur_aug_solver;
+   options.GetBoolValue("schur_complement_aug_solver", schur_aug_solver, prefix);
+   if( schur_aug_solver )
+   {
+      AugSolver = new SchurAugSystemSolver(*AugSolver);
+   }
    return AugSolver;
 }
 
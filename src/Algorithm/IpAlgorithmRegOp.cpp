@@ -34,6 +34,7 @@
 #include "IpRestoIpoptNLP.hpp"
 #include "IpRestoMinC_1Nrm.hpp"
 #include "IpRestoPenaltyConvCheck.hpp"
+#include "IpSchurAugSystemSolver.hpp"
 #include "IpWarmStartIterateInitializer.hpp"
 
 namespace Ipopt
@@ -83,6 +84,8 @@ void RegisterOptions_Algorithm(
    PDFullSpaceSolver::RegisterOptions(roptions);
    roptions->SetRegisteringCategory("Step Calculation");
    PDPerturbationHandler::RegisterOptions(roptions);
+   roptions->SetRegisteringCategory("Step Calculation");
+   SchurAugSystemSolver::RegisterOptions(roptions);
    roptions->SetRegisteringCategory("Barrier Parameter Update");
    ProbingMuOracle::RegisterOptions(roptions);
    roptions->SetRegisteringCategory("Barrier Parameter Update");
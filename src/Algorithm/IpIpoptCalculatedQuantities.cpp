@@ -768,18 +768,10 @@ Number IpoptCalculatedQuantities::CalcBarrierTerm(
       SmartPtr<const Vector> dampind_s_U;
       ComputeDampingIndicators(dampind_x_L, dampind_x_U, dampind_s_L, dampind_s_U);
 
-      Tmp_x_L().Copy(slack_x_L);
-      Tmp_x_L().ElementWiseMultiply(*dampind_x_L);
-      retval += kappa_d_ * mu * Tmp_x_L().Asum();
-      Tmp_x_U().Copy(slack_x_U);
-      Tmp_x_U().ElementWiseMultiply(*dampind_x_U);
-      retval += kappa_d_ * mu * Tmp_x_U().Asum();
-      Tmp_s_L().Copy(slack_s_L);
-      Tmp_s_L().ElementWiseMultiply(*dampind_s_L);
-      retval += kappa_d_ * mu * Tmp_s_L().Asum();
-      Tmp_s_U().Copy(slack_s_U);
-      Tmp_s_U().ElementWiseMultiply(*dampind_s_U);
-      retval += kappa_d_ * mu * Tmp_s_U().Asum();
+      retval += kappa_d_ * mu * slack_x_L.WeightedAsum(*dampind_x_L);
+      retval += kappa_d_ * mu * slack_x_U.WeightedAsum(*dampind_x_U);
+      retval += kappa_d_ * mu * slack_s_L.WeightedAsum(*dampind_s_L);
+      retval += kappa_d_ * mu * slack_s_U.WeightedAsum(*dampind_s_U);
    }
 
    DBG_PRINT((1, "BarrierTerm with damping = %25.16e\n", retval));
@@ -2015,8 +2007,7 @@ SmartPtr<const Vector> IpoptCalculatedQuantities::curr_grad_lag_x()
       {
          SmartPtr<Vector> tmp = x->MakeNew();
          DBG_PRINT_VECTOR(2, "curr_grad_f", *curr_grad_f());
-         tmp->Copy(*curr_grad_f());
-         tmp->AddTwoVectors(1., *curr_jac_cT_times_curr_y_c(), 1., *curr_jac_dT_times_curr_y_d(), 1.);
+         tmp->AddThreeVectors(1., *curr_jac_cT_times_curr_y_c(), 1., *curr_jac_dT_times_curr_y_d(), 1., *curr_grad_f(), 0.);
          DBG_PRINT_VECTOR(2, "jac_cT*y_c", *curr_jac_cT_times_curr_y_c());
          DBG_PRINT_VECTOR(2, "jac_dT*y_d", *curr_jac_dT_times_curr_y_d());
          ip_nlp_->Px_L()->MultVector(-1., *z_L, 1., *tmp);
@@ -2054,8 +2045,7 @@ SmartPtr<const Vector> IpoptCalculatedQuantities::trial_grad_lag_x()
       {
          SmartPtr<Vector> tmp = x->MakeNew();
          DBG_PRINT_VECTOR(2, "trial_grad_f", *trial_grad_f());
-         tmp->Copy(*trial_grad_f());
-         tmp->AddTwoVectors(1., *trial_jac_cT_times_trial_y_c(), 1., *trial_jac_dT_times_trial_y_d(), 1.);
+         tmp->AddThreeVectors(1., *trial_jac_cT_times_trial_y_c(), 1., *trial_jac_dT_times_trial_y_d(), 1., *trial_grad_f(), 0.);
          ip_nlp_->Px_L()->MultVector(-1., *z_L, 1., *tmp);
          ip_nlp_->Px_U()->MultVector(1., *z_U, 1., *tmp);
          result = ConstPtr(tmp);
@@ -2234,8 +2224,7 @@ SmartPtr<const Vector> IpoptCalculatedQuantities::CalcCompl(
    DBG_START_METH("IpoptCalculatedQuantities::CalcCompl()",
                   dbg_verbosity);
    SmartPtr<Vector> result = slack.MakeNew();
-   result->Copy(slack);
-   result->ElementWiseMultiply(mult);
+   result->AddVectorAndProduct(0., slack, 1., slack, mult, 0., 0.);
    return ConstPtr(result);
 }
 
@@ -2422,8 +2411,7 @@ SmartPtr<const Vector> IpoptCalculatedQuantities::curr_relaxed_compl_x_L()
    if( !curr_relaxed_compl_x_L_cache_.GetCachedResult(result, tdeps, sdeps) )
    {
       SmartPtr<Vector> tmp = slack->MakeNew();
-      tmp->Copy(*curr_compl_x_L());
-      tmp->AddScalar(-mu);
+      tmp->AddVectorAndProduct(0., *slack, 1., *slack, *mult, 0., -mu);
       result = ConstPtr(tmp);
       curr_relaxed_compl_x_L_cache_.AddCachedResult(result, tdeps, sdeps);
    }
@@ -2449,8 +2437,7 @@ SmartPtr<const Vector> IpoptCalculatedQuantities::curr_relaxed_compl_x_U()
    if( !curr_relaxed_compl_x_U_cache_.GetCachedResult(result, tdeps, sdeps) )
    {
       SmartPtr<Vector> tmp = slack->MakeNew();
-      tmp->Copy(*curr_compl_x_U());
-      tmp->AddScalar(-mu);
+      tmp->AddVectorAndProduct(0., *slack, 1., *slack, *mult, 0., -mu);
       result = ConstPtr(tmp);
       curr_relaxed_compl_x_U_cache_.AddCachedResult(result, tdeps, sdeps);
    }
@@ -2476,8 +2463,7 @@ SmartPtr<const Vector> IpoptCalculatedQuantities::curr_relaxed_compl_s_L()
    if( !curr_relaxed_compl_s_L_cache_.GetCachedResult(result, tdeps, sdeps) )
    {
       SmartPtr<Vector> tmp = slack->MakeNew();
-      tmp->Copy(*curr_compl_s_L());
-      tmp->AddScalar(-mu);
+      tmp->AddVectorAndProduct(0., *slack, 1., *slack, *mult, 0., -mu);
       result = ConstPtr(tmp);
       curr_relaxed_compl_s_L_cache_.AddCachedResult(result, tdeps, sdeps);
    }
@@ -2503,8 +2489,7 @@ SmartPtr<const Vector> IpoptCalculatedQuantities::curr_relaxed_compl_s_U()
    if( !curr_relaxed_compl_s_U_cache_.GetCachedResult(result, tdeps, sdeps) )
    {
       SmartPtr<Vector> tmp = slack->MakeNew();
-      tmp->Copy(*curr_compl_s_U());
-      tmp->AddScalar(-mu);
+      tmp->AddVectorAndProduct(0., *slack, 1., *slack, *mult, 0., -mu);
       result = ConstPtr(tmp);
       curr_relaxed_compl_s_U_cache_.AddCachedResult(result, tdeps, sdeps);
    }
@@ -2844,20 +2829,16 @@ Number IpoptCalculatedQuantities::curr_complementarity(
          else
          {
             SmartPtr<Vector> tmp = compl_x_L->MakeNew();
-            tmp->Copy(*compl_x_L);
-            tmp->AddScalar(-mu);
+            tmp->AddVectorAndProduct(1., *compl_x_L, 0., *compl_x_L, *compl_x_L, 0., -mu);
             vecs[0] = GetRawPtr(tmp);
             tmp = compl_x_U->MakeNew();
-            tmp->Copy(*compl_x_U);
-            tmp->AddScalar(-mu);
+            tmp->AddVectorAndProduct(1., *compl_x_U, 0., *compl_x_U, *compl_x_U, 0., -mu);
             vecs[1] = GetRawPtr(tmp);
             tmp = compl_s_L->MakeNew();
-            tmp->Copy(*compl_s_L);
-            tmp->AddScalar(-mu);
+            tmp->AddVectorAndProduct(1., *compl_s_L, 0., *compl_s_L, *compl_s_L, 0., -mu);
             vecs[2] = GetRawPtr(tmp);
             tmp = compl_s_U->MakeNew();
-            tmp->Copy(*compl_s_U);
-            tmp->AddScalar(-mu);
+            tmp->AddVectorAndProduct(1., *compl_s_U, 0., *compl_s_U, *compl_s_U, 0., -mu);
             vecs[3] = GetRawPtr(tmp);
          }
 
@@ -2918,20 +2899,16 @@ Number IpoptCalculatedQuantities::trial_complementarity(
          else
          {
             SmartPtr<Vector> tmp = compl_x_L->MakeNew();
-            tmp->Copy(*compl_x_L);
-            tmp->AddScalar(-mu);
+            tmp->AddVectorAndProduct(1., *compl_x_L, 0., *compl_x_L, *compl_x_L, 0., -mu);
             vecs[0] = GetRawPtr(tmp);
             tmp = compl_x_U->MakeNew();
-            tmp->Copy(*compl_x_U);
-            tmp->AddScalar(-mu);
+            tmp->AddVectorAndProduct(1., *compl_x_U, 0., *compl_x_U, *compl_x_U, 0., -mu);
             vecs[1] = GetRawPtr(tmp);
             tmp = compl_s_L->MakeNew();
-            tmp->Copy(*compl_s_L);
-            tmp->AddScalar(-mu);
+            tmp->AddVectorAndProduct(1., *compl_s_L, 0., *compl_s_L, *compl_s_L, 0., -mu);
             vecs[2] = GetRawPtr(tmp);
             tmp = compl_s_U->MakeNew();
-            tmp->Copy(*compl_s_U);
-            tmp->AddScalar(-mu);
+            tmp->AddVectorAndProduct(1., *compl_s_U, 0., *compl_s_U, *compl_s_U, 0., -mu);
             vecs[3] = GetRawPtr(tmp);
          }
 
@@ -206,6 +206,44 @@ public:
    virtual Index h_evals() const = 0;
    ///@}
 
+   /** @name Counters for the number of times that a result was found in the cache of evaluation results.
+    *
+    *  The number of times that a result was not found is the number
+    *  of evaluations.  The default implementations return 0, for
+    *  IpoptNLPs that do not cache evaluation results.
+    *  @since 3.14.5
+    */
+   ///@{
+   virtual Index f_cache_hits() const
+   {
+      return 0;
+   }
+   virtual Index grad_f_cache_hits() const
+   {
+      return 0;
+   }
+   virtual Index c_cache_hits() const
+   {
+      return 0;
+   }
+   virtual Index jac_c_cache_hits() const
+   {
+      return 0;
+   }
+   virtual Index d_cache_hits() const
+   {
+      return 0;
+   }
+   virtual Index jac_d_cache_hits() const
+   {
+      return 0;
+   }
+   virtual Index h_cache_hits() const
+   {
+      return 0;
+   }
+   ///@}
+
    /** @name Special method for dealing with the fact that the
     *  restoration phase objective function depends on the barrier
     *  parameter */
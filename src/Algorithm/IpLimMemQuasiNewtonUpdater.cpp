@@ -17,6 +17,22 @@ namespace Ipopt
 static const Index dbg_verbosity = 0;
 #endif
 
+/** Compute the dot products of v with all columns of V.
+ *
+ *  This is done by one product with the transpose of V, which
+ *  passes over the columns of V in blocks if they are dense.
+ */
+static SmartPtr<DenseVector> ColumnDots(
+   const MultiVectorMatrix& V,
+   const Vector&            v
+)
+{
+   SmartPtr<DenseVectorSpace> space = new DenseVectorSpace(V.NCols());
+   SmartPtr<DenseVector> dots = space->MakeNewDenseVector();
+   V.TransMultVector(1., v, 0., *dots);
+   return dots;
+}
+
 LimMemQuasiNewtonUpdater::LimMemQuasiNewtonUpdater(
    bool update_for_resto
 )
@@ -92,6 +108,16 @@ void LimMemQuasiNewtonUpdater::RegisterOptions(
       "Until Nov 2010, Ipopt used a special update during the restoration phase, but it turned out that this does not work well. "
       "The new default uses the regular update procedure and it improves results. "
       "If for some reason you want to get back to the original update, set this option to \"yes\".");
+
+   roptions->AddLowerBoundedIntegerOption(
+      "limited_memory_num_threads",
+      "Number of threads for the products with the vectors of the limited-memory history.",
+      0,
+      1,
+      "If not 1, the blocks of rows in the products of the history vectors with small dense matrices "
+      "are processed concurrently. "
+      "If set to 0, the number of hardware threads is used.",
+      true);
 }
 
 bool LimMemQuasiNewtonUpdater::InitializeImpl(
@@ -110,6 +136,17 @@ bool LimMemQuasiNewtonUpdater::InitializeImpl(
    options.GetNumericValue("limited_memory_init_val_max", sigma_safe_max_, prefix);
    options.GetNumericValue("limited_memory_init_val_min", sigma_safe_min_, prefix);
    options.GetBoolValue("limited_memory_special_for_resto", limited_memory_special_for_resto_, prefix);
+   Index num_threads;
+   options.GetIntegerValue("limited_memory_num_threads", num_threads, prefix);
+   pool_ = NULL;
+   if( num_threads != 1 )
+   {
+      pool_ = new ThreadPool(num_threads);
+      if( pool_->NumThreads() == 1 )
+      {
+         pool_ = NULL;
+      }
+   }
 
    h_space_ = NULL;
    curr_lm_memory_ = 0;
@@ -504,12 +541,12 @@ void LimMemQuasiNewtonUpdater::UpdateHessian()
             if( !update_for_resto_ || !limited_memory_special_for_resto_ )
             {
                DBG_ASSERT(sigma_ > 0.);
-               U_->AddRightMultMatrix(sigma_, *S_, *C, 0.);
+               U_->AddRightMultMatrix(sigma_, *S_, *C, 0., GetRawPtr(pool_));
             }
             else
             {
                DBG_ASSERT(sigma_ < 0.);
-               U_->AddRightMultMatrix(curr_eta_, *DRS_, *C, 0.);
+               U_->AddRightMultMatrix(curr_eta_, *DRS_, *C, 0., GetRawPtr(pool_));
             }
 
             // Compute Lbar = Ltilde^T * C
@@ -517,7 +554,7 @@ void LimMemQuasiNewtonUpdater::UpdateHessian()
             Lbar->AddMatrixProduct(1., *Ltilde, true, *C, false, 0.);
 
             // Compute U += V * Lbar;
-            U_->AddRightMultMatrix(1., *V_, *Lbar, 1.);
+            U_->AddRightMultMatrix(1., *V_, *Lbar, 1., GetRawPtr(pool_));
             break;
          }
          case SR1:
@@ -646,7 +683,7 @@ void LimMemQuasiNewtonUpdater::UpdateHessian()
                SmartPtr<MultiVectorMatrixSpace> U_space = new MultiVectorMatrixSpace(Qminus->NCols(),
                      *s_new->OwnerSpace());
                U_ = U_space->MakeNewMultiVectorMatrix();
-               U_->AddRightMultMatrix(1., *Vtilde, *Qminus, 0.);
+               U_->AddRightMultMatrix(1., *Vtilde, *Qminus, 0., GetRawPtr(pool_));
                DBG_PRINT_MATRIX(3, "U", *U_);
             }
             else
@@ -660,7 +697,7 @@ void LimMemQuasiNewtonUpdater::UpdateHessian()
                SmartPtr<MultiVectorMatrixSpace> V_space = new MultiVectorMatrixSpace(Qplus->NCols(),
                      *s_new->OwnerSpace());
                V_ = V_space->MakeNewMultiVectorMatrix();
-               V_->AddRightMultMatrix(1., *Vtilde, *Qplus, 0.);
+               V_->AddRightMultMatrix(1., *Vtilde, *Qplus, 0., GetRawPtr(pool_));
                DBG_PRINT_MATRIX(3, "V", *V_);
             }
             else
@@ -1111,9 +1148,11 @@ void LimMemQuasiNewtonUpdater::AugmentLMatrix(
       }
    }
 
+   SmartPtr<DenseVector> dots = ColumnDots(Y, *S.GetVector(ndim));
+   const Number* dotvalues = dots->Values();
    for( Index j = 0; j < ndim; j++ )
    {
-      newVvalues[ndim + j * (ndim + 1)] = S.GetVector(ndim)->Dot(*Y.GetVector(j));
+      newVvalues[ndim + j * (ndim + 1)] = dotvalues[j];
    }
 
    for( Index i = 0; i < ndim + 1; i++ )
@@ -1155,9 +1194,11 @@ void LimMemQuasiNewtonUpdater::AugmentSdotSMatrix(
       }
    }
 
+   SmartPtr<DenseVector> dots = ColumnDots(S, *S.GetVector(ndim));
+   const Number* dotvalues = dots->Values();
    for( Index j = 0; j < ndim + 1; j++ )
    {
-      newVvalues[ndim + j * (ndim + 1)] = S.GetVector(ndim)->Dot(*S.GetVector(j));
+      newVvalues[ndim + j * (ndim + 1)] = dotvalues[j];
    }
 
    V = new_V;
@@ -1195,9 +1236,11 @@ void LimMemQuasiNewtonUpdater::AugmentSTDRSMatrix(
       }
    }
 
+   SmartPtr<DenseVector> dots = ColumnDots(DRS, *S.GetVector(ndim));
+   const Number* dotvalues = dots->Values();
    for( Index j = 0; j < ndim + 1; j++ )
    {
-      newVvalues[ndim + j * (ndim + 1)] = S.GetVector(ndim)->Dot(*DRS.GetVector(j));
+      newVvalues[ndim + j * (ndim + 1)] = dotvalues[j];
    }
 
    V = new_V;
@@ -1265,9 +1308,11 @@ void LimMemQuasiNewtonUpdater::ShiftLMatrix(
       }
    }
 
+   SmartPtr<DenseVector> dots = ColumnDots(Y, *S.GetVector(ndim - 1));
+   const Number* dotvalues = dots->Values();
    for( Index j = 0; j < ndim - 1; j++ )
    {
-      new_Vvalues[ndim - 1 + j * ndim] = S.GetVector(ndim - 1)->Dot(*Y.GetVector(j));
+      new_Vvalues[ndim - 1 + j * ndim] = dotvalues[j];
    }
 
    for( Index i = 0; i < ndim; i++ )
@@ -1298,9 +1343,11 @@ void LimMemQuasiNewtonUpdater::ShiftSdotSMatrix(
       }
    }
 
+   SmartPtr<DenseVector> dots = ColumnDots(S, *S.GetVector(ndim - 1));
+   const Number* dotvalues = dots->Values();
    for( Index j = 0; j < ndim; j++ )
    {
-      new_Vvalues[ndim - 1 + j * ndim] = S.GetVector(ndim - 1)->Dot(*S.GetVector(j));
+      new_Vvalues[ndim - 1 + j * ndim] = dotvalues[j];
    }
 
    V = new_V;
@@ -1327,9 +1374,11 @@ void LimMemQuasiNewtonUpdater::ShiftSTDRSMatrix(
       }
    }
 
+   SmartPtr<DenseVector> dots = ColumnDots(DRS, *S.GetVector(ndim - 1));
+   const Number* dotvalues = dots->Values();
    for( Index j = 0; j < ndim; j++ )
    {
-      new_Vvalues[ndim - 1 + j * ndim] = S.GetVector(ndim - 1)->Dot(*DRS.GetVector(j));
+      new_Vvalues[ndim - 1 + j * ndim] = dotvalues[j];
    }
 
    V = new_V;
@@ -1417,6 +1466,8 @@ void LimMemQuasiNewtonUpdater::RecalcL(
    Index dim = S.NCols();
    SmartPtr<DenseGenMatrixSpace> space = new DenseGenMatrixSpace(dim, dim);
    L = space->MakeNewDenseGenMatrix();
+   // compute all products s_i^T y_j at once and keep the strictly lower triangle
+   L->HighRankUpdateTranspose(1., S, Y, 0., GetRawPtr(pool_));
    Number* Lvalues = L->Values();
    for( Index j = 0; j < dim; j++ )
    {
@@ -1424,11 +1475,6 @@ void LimMemQuasiNewtonUpdater::RecalcL(
       {
          Lvalues[i + j * dim] = 0.;
       }
-      for( Index i = j + 1; i < dim; i++ )
-      {
-         Lvalues[i + j * dim] = S.GetVector(i)->Dot(*Y.GetVector(j));
-         ;
-      }
    }
 }
 
@@ -13,6 +13,7 @@
 #include "IpDenseVector.hpp"
 #include "IpDenseGenMatrix.hpp"
 #include "IpDenseSymMatrix.hpp"
+#include "IpThreadPool.hpp"
 
 namespace Ipopt
 {
@@ -121,6 +122,9 @@ private:
     *  special manner for the restoration phase.
     */
    bool limited_memory_special_for_resto_;
+
+   /** Threads for the products with the history vectors, or NULL */
+   SmartPtr<ThreadPool> pool_;
    ///@}
 
    /** Flag indicating if the update is to be done for the original
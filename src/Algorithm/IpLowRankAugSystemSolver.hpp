@@ -197,6 +197,28 @@ private:
    /** Vector space for Compound vectors that capture the entire
     *  right hand side and solution vectors .*/
    SmartPtr<const CompoundVectorSpace> compound_sol_vecspace_;
+
+   /** Tag of the diagonal of the low-rank update that is stored in Wdiag_ */
+   TaggedObject::Tag b0_tag_;
+   ///@}
+
+   /** @name Solutions of the augmented system without the low-rank
+    *  update for the columns of V and U.
+    *
+    *  They stay valid as long as the augmented system without the
+    *  low-rank update does not change, so that only the columns of
+    *  V and U that are new have to be solved for if just the
+    *  low-rank update changes.
+    */
+   ///@{
+   /** Tags of Wdiag_, D_x, D_s, J_c, D_c, J_d, D_d for the cached solutions */
+   std::vector<TaggedObject::Tag> cache_system_tags_;
+   /** delta_x, delta_s, delta_c, delta_d for the cached solutions */
+   std::vector<Number> cache_system_deltas_;
+   /** Tags of the columns of V and U for which the solutions are cached */
+   std::vector<TaggedObject::Tag> cache_rhs_tags_;
+   /** Cached solutions */
+   std::vector<SmartPtr<const CompoundVector> > cache_sols_;
    ///@}
 
    /** Stores the number of negative eigenvalues detected during most
@@ -242,29 +264,34 @@ private:
     *
     *  The result is returned as a MultiVectorMatrix in Vtilde1.
     *  V_x and Vtilde1_x are V and Vtilde1 in the x-space.
+    *  Only the columns of V without a cached solution are solved
+    *  for; the tags of all columns and their solutions are appended
+    *  to rhs_tags and sols.
     */
    ESymSolverStatus SolveMultiVector(
-      const Vector*                 D_x,
-      Number                        delta_x,
-      const Vector*                 D_s,
-      Number                        delta_s,
-      const Matrix&                 J_c,
-      const Vector*                 D_c,
-      Number                        delta_c,
-      const Matrix&                 J_d,
-      const Vector*                 D_d,
-      Number                        delta_d,
-      const Vector&                 proto_rhs_x,
-      const Vector&                 proto_rhs_s,
-      const Vector&                 proto_rhs_c,
-      const Vector&                 proto_rhs_d,
-      const MultiVectorMatrix&      V,
-      const SmartPtr<const Matrix>& P_LM,
-      SmartPtr<MultiVectorMatrix>&  V_x,
-      SmartPtr<MultiVectorMatrix>&  Vtilde1,
-      SmartPtr<MultiVectorMatrix>&  Vtilde1_x,
-      bool                          check_NegEVals,
-      Index                         numberOfNegEVals
+      const Vector*                                 D_x,
+      Number                                        delta_x,
+      const Vector*                                 D_s,
+      Number                                        delta_s,
+      const Matrix&                                 J_c,
+      const Vector*                                 D_c,
+      Number                                        delta_c,
+      const Matrix&                                 J_d,
+      const Vector*                                 D_d,
+      Number                                        delta_d,
+      const Vector&                                 proto_rhs_x,
+      const Vector&                                 proto_rhs_s,
+      const Vector&                                 proto_rhs_c,
+      const Vector&                                 proto_rhs_d,
+      const MultiVectorMatrix&                      V,
+      const SmartPtr<const Matrix>&                 P_LM,
+      SmartPtr<MultiVectorMatrix>&                  V_x,
+      SmartPtr<MultiVectorMatrix>&                  Vtilde1,
+      SmartPtr<MultiVectorMatrix>&                  Vtilde1_x,
+      bool                                          check_NegEVals,
+      Index                                         numberOfNegEVals,
+      std::vector<TaggedObject::Tag>&               rhs_tags,
+      std::vector<SmartPtr<const CompoundVector> >& sols
    );
 
    /** Method that compares the tags of the data for the matrix with
@@ -123,6 +123,47 @@ void OrigIpoptNLP::RegisterOptions(
       "all-variables", "in space of all variables (without slacks)",
       "",
       true);
+   roptions->SetRegisteringCategory("NLP");
+   roptions->AddLowerBoundedIntegerOption(
+      "obj_cache_depth",
+      "Number of objective function values that are kept for reuse.",
+      1,
+      1,
+      "Ipopt remembers the objective function values at the most recent points and does not evaluate the objective "
+      "again if it is requested at one of these points. "
+      "A larger number avoids reevaluations when the algorithm returns to earlier points, "
+      "e.g., in the watchdog procedure or when restoring an acceptable point. "
+      "This can be worthwhile if function evaluations are expensive. "
+      "Changes take no effect if warm_start_same_structure is enabled.",
+      true);
+   roptions->AddLowerBoundedIntegerOption(
+      "obj_grad_cache_depth",
+      "Number of objective gradients that are kept for reuse.",
+      1,
+      1,
+      "See obj_cache_depth.",
+      true);
+   roptions->AddLowerBoundedIntegerOption(
+      "constr_cache_depth",
+      "Number of constraint values that are kept for reuse.",
+      1,
+      1,
+      "This applies to equality and inequality constraints separately. See obj_cache_depth.",
+      true);
+   roptions->AddLowerBoundedIntegerOption(
+      "constr_jac_cache_depth",
+      "Number of constraint Jacobians that are kept for reuse.",
+      1,
+      1,
+      "This applies to the Jacobians of equality and inequality constraints separately. See obj_cache_depth.",
+      true);
+   roptions->AddLowerBoundedIntegerOption(
+      "hessian_cache_depth",
+      "Number of Lagrangian Hessians that are kept for reuse.",
+      1,
+      1,
+      "See obj_cache_depth. If hessian_constant is enabled, at least 2 Hessians are kept.",
+      true);
 }
 
 bool OrigIpoptNLP::Initialize(
@@ -146,6 +187,12 @@ bool OrigIpoptNLP::Initialize(
    options.GetBoolValue("jac_d_constant", jac_d_constant_, prefix);
    options.GetBoolValue("hessian_constant", hessian_constant_, prefix);
 
+   options.GetIntegerValue("obj_cache_depth", obj_cache_depth_, prefix);
+   options.GetIntegerValue("obj_grad_cache_depth", obj_grad_cache_depth_, prefix);
+   options.GetIntegerValue("constr_cache_depth", constr_cache_depth_, prefix);
+   options.GetIntegerValue("constr_jac_cache_depth", constr_jac_cache_depth_, prefix);
+   options.GetIntegerValue("hessian_cache_depth", hessian_cache_depth_, prefix);
+
    // Reset the function evaluation counters (for warm start)
    f_evals_ = 0;
    grad_f_evals_ = 0;
@@ -155,24 +202,33 @@ bool OrigIpoptNLP::Initialize(
    jac_d_evals_ = 0;
    h_evals_ = 0;
 
+   f_cache_hits_ = 0;
+   grad_f_cache_hits_ = 0;
+   c_cache_hits_ = 0;
+   jac_c_cache_hits_ = 0;
+   d_cache_hits_ = 0;
+   jac_d_cache_hits_ = 0;
+   h_cache_hits_ = 0;
+
    if( !warm_start_same_structure_ )
    {
-      // Reset all caches.
-      grad_f_cache_.Clear();
-      c_cache_.Clear();
-      jac_c_cache_.Clear();
-      d_cache_.Clear();
-      jac_d_cache_.Clear();
+      // Reset all caches and set their sizes.
+      f_cache_.Clear(obj_cache_depth_);
+      grad_f_cache_.Clear(obj_grad_cache_depth_);
+      c_cache_.Clear(constr_cache_depth_);
+      jac_c_cache_.Clear(constr_jac_cache_depth_);
+      d_cache_.Clear(constr_cache_depth_);
+      jac_d_cache_.Clear(constr_jac_cache_depth_);
       // If the hessian is constant, we want two hessians to be
       // cached, one for regular iterations and one for restoration
       // phase
       if( hessian_constant_ )
       {
-         h_cache_.Clear(2);
+         h_cache_.Clear(Max(hessian_cache_depth_, 2));
       }
       else
       {
-         h_cache_.Clear(1);
+         h_cache_.Clear(hessian_cache_depth_);
       }
    }
 
@@ -476,7 +532,11 @@ Number OrigIpoptNLP::f(
    DBG_START_METH("OrigIpoptNLP::f", dbg_verbosity);
    Number ret = 0.0;
    DBG_PRINT((2, "x.Tag = %u\n", x.GetTag()));
-   if( !f_cache_.GetCachedResult1Dep(ret, &x) )
+   if( f_cache_.GetCachedResult1Dep(ret, &x) )
+   {
+      f_cache_hits_++;
+   }
+   else
    {
       f_evals_++;
       SmartPtr<const Vector> unscaled_x = get_unscaled_x(x);
@@ -507,7 +567,11 @@ SmartPtr<const Vector> OrigIpoptNLP::grad_f(
 {
    SmartPtr<Vector> unscaled_grad_f;
    SmartPtr<const Vector> retValue;
-   if( !grad_f_cache_.GetCachedResult1Dep(retValue, &x) )
+   if( grad_f_cache_.GetCachedResult1Dep(retValue, &x) )
+   {
+      grad_f_cache_hits_++;
+   }
+   else
    {
       grad_f_evals_++;
       unscaled_grad_f = x_space_->MakeNew();
@@ -553,7 +617,11 @@ SmartPtr<const Vector> OrigIpoptNLP::c(
    }
    else
    {
-      if( !c_cache_.GetCachedResult1Dep(retValue, x) )
+      if( c_cache_.GetCachedResult1Dep(retValue, x) )
+      {
+         c_cache_hits_++;
+      }
+      else
       {
          SmartPtr<Vector> unscaled_c = c_space_->MakeNew();
          c_evals_++;
@@ -599,7 +667,11 @@ SmartPtr<const Vector> OrigIpoptNLP::d(
    }
    else
    {
-      if( !d_cache_.GetCachedResult1Dep(retValue, x) )
+      if( d_cache_.GetCachedResult1Dep(retValue, x) )
+      {
+         d_cache_hits_++;
+      }
+      else
       {
          d_evals_++;
          SmartPtr<Vector> unscaled_d = d_space_->MakeNew();
@@ -652,7 +724,11 @@ SmartPtr<const Matrix> OrigIpoptNLP::jac_c(
       {
          dep = &x;
       }
-      if( !jac_c_cache_.GetCachedResult1Dep(retValue, GetRawPtr(dep)) )
+      if( jac_c_cache_.GetCachedResult1Dep(retValue, GetRawPtr(dep)) )
+      {
+         jac_c_cache_hits_++;
+      }
+      else
       {
          jac_c_evals_++;
          SmartPtr<Matrix> unscaled_jac_c = jac_c_space_->MakeNew();
@@ -706,7 +782,11 @@ SmartPtr<const Matrix> OrigIpoptNLP::jac_d(
          dep = &x;
       }
 
-      if( !jac_d_cache_.GetCachedResult1Dep(retValue, GetRawPtr(dep)) )
+      if( jac_d_cache_.GetCachedResult1Dep(retValue, GetRawPtr(dep)) )
+      {
+         jac_d_cache_hits_++;
+      }
+      else
       {
          jac_d_evals_++;
          SmartPtr<Matrix> unscaled_jac_d = jac_d_space_->MakeNew();
@@ -767,7 +847,11 @@ SmartPtr<const SymMatrix> OrigIpoptNLP::h(
    std::vector<Number> scalar_deps(1);
    scalar_deps[0] = obj_factor;
 
-   if( !h_cache_.GetCachedResult(retValue, deps, scalar_deps) )
+   if( h_cache_.GetCachedResult(retValue, deps, scalar_deps) )
+   {
+      h_cache_hits_++;
+   }
+   else
    {
       h_evals_++;
       unscaled_h = h_space_->MakeNewSymMatrix();
@@ -323,6 +323,38 @@ public:
    }
    ///@}
 
+   /** @name Counters for the number of times that a result was found in the cache of evaluation results. */
+   ///@{
+   virtual Index f_cache_hits() const
+   {
+      return f_cache_hits_;
+   }
+   virtual Index grad_f_cache_hits() const
+   {
+      return grad_f_cache_hits_;
+   }
+   virtual Index c_cache_hits() const
+   {
+      return c_cache_hits_;
+   }
+   virtual Index jac_c_cache_hits() const
+   {
+      return jac_c_cache_hits_;
+   }
+   virtual Index d_cache_hits() const
+   {
+      return d_cache_hits_;
+   }
+   virtual Index jac_d_cache_hits() const
+   {
+      return jac_d_cache_hits_;
+   }
+   virtual Index h_cache_hits() const
+   {
+      return h_cache_hits_;
+   }
+   ///@}
+
    /** Solution Routines - overloaded from IpoptNLP */
    ///@{
    void FinalizeSolution(
@@ -545,6 +577,21 @@ private:
 
    /** Flag indicating if we need to ask for Hessian only once */
    bool hessian_constant_;
+
+   /** Number of results of the objective function that are cached */
+   Index obj_cache_depth_;
+
+   /** Number of objective gradients that are cached */
+   Index obj_grad_cache_depth_;
+
+   /** Number of constraint values that are cached, for equality and inequality constraints each */
+   Index constr_cache_depth_;
+
+   /** Number of constraint Jacobians that are cached, for equality and inequality constraints each */
+   Index constr_jac_cache_depth_;
+
+   /** Number of Lagrangian Hessians that are cached */
+   Index hessian_cache_depth_;
    ///@}
 
    /** @name Counters for the function evaluations */
@@ -558,6 +605,17 @@ private:
    Index h_evals_;
    ///@}
 
+   /** @name Counters for the results that were found in the caches */
+   ///@{
+   Index f_cache_hits_;
+   Index grad_f_cache_hits_;
+   Index c_cache_hits_;
+   Index jac_c_cache_hits_;
+   Index d_cache_hits_;
+   Index jac_d_cache_hits_;
+   Index h_cache_hits_;
+   ///@}
+
    /** Flag indicating if initialization method has been called */
    bool initialized_;
 
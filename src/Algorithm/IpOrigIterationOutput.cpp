@@ -5,6 +5,7 @@
 // Authors:  Carl Laird, Andreas Waechter              IBM    2004-09-23
 
 #include "IpOrigIterationOutput.hpp"
+#include "IpTimingStatistics.hpp"
 
 #include <cmath>
 #include <cstdio>
@@ -53,6 +54,17 @@ void OrigIterationOutput::RegisterOptions(
       0.,
       "Summarizing iteration output is printed if at least print_frequency_time seconds have "
       "passed since last output and the iteration number is a multiple of print_frequency_iter.");
+   roptions->AddStringOption1(
+      "telemetry_file",
+      "File name for machine-readable per-iteration records (leave unset for none).",
+      "",
+      "*", "Any acceptable standard file name",
+      "If set, a record for every iteration is written to this file as one line in JSON format. "
+      "A record holds the values of the iteration summary line "
+      "and the wallclock time that every timed task took since the previous record. "
+      "Times are only available for all tasks if \"timing_statistics\" is enabled. "
+      "Iterations of the restoration phase are not recorded.",
+      true);
    roptions->SetRegisteringCategory(prev_cat);
 }
 
@@ -68,6 +80,24 @@ bool OrigIterationOutput::InitializeImpl(
    options.GetIntegerValue("print_frequency_iter", print_frequency_iter_, prefix);
    options.GetNumericValue("print_frequency_time", print_frequency_time_, prefix);
 
+   telemetry_jrnls_.clear();
+   std::string telemetry_file;
+   options.GetStringValue("telemetry_file", telemetry_file, prefix);
+   if( telemetry_file != "" )
+   {
+      SmartPtr<FileJournal> file_jrnl = new FileJournal("Telemetry:" + telemetry_file, J_NONE);
+      if( !file_jrnl->Open(telemetry_file.c_str()) )
+      {
+         THROW_EXCEPTION(OPTION_INVALID, "Error opening telemetry file \"" + telemetry_file + "\"");
+      }
+      telemetry_jrnls_.push_back(GetRawPtr(file_jrnl));
+   }
+   SmartPtr<Journal> callback_jrnl = Jnlst().GetJournal("Telemetry");
+   if( IsValid(callback_jrnl) )
+   {
+      telemetry_jrnls_.push_back(callback_jrnl);
+   }
+
    return true;
 }
 
@@ -142,6 +172,12 @@ void OrigIterationOutput::WriteOutput()
    Index ls_count = IpData().info_ls_count();
    const std::string info_string = IpData().info_string();
 
+   if( !telemetry_jrnls_.empty() )
+   {
+      WriteTelemetry(iter, unscaled_f, inf_pr, inf_du, mu, dnrm, regu_x, alpha_dual, alpha_primal, alpha_primal_char,
+                     ls_count);
+   }
+
    Number current_time = 0.0;
    Number last_output = IpData().info_last_output();
    if( !IpData().info_skip_output() && (iter % print_frequency_iter_) == 0
@@ -296,4 +332,101 @@ void OrigIterationOutput::WriteOutput()
    Jnlst().FlushBuffer();
 }
 
+/** Append a number in JSON format; JSON has no representation of inf and nan */
+static void AppendJsonNumber(
+   std::string& record,
+   const char*  key,
+   Number       value
+)
+{
+   char buf[64];
+   if( IsFiniteNumber(value) )
+   {
+      Snprintf(buf, 63, "\"%s\":%.17g", key, value);
+   }
+   else
+   {
+      Snprintf(buf, 63, "\"%s\":null", key);
+   }
+   record += buf;
+}
+
+void OrigIterationOutput::WriteTelemetry(
+   Index       iter,
+   Number      unscaled_f,
+   Number      inf_pr,
+   Number      inf_du,
+   Number      mu,
+   Number      dnrm,
+   Number      regu_x,
+   Number      alpha_dual,
+   Number      alpha_primal,
+   char        alpha_primal_char,
+   Index       ls_count
+)
+{
+   char buf[128];
+   std::string record;
+   record.reserve(1024);
+
+   Snprintf(buf, 127, "{\"iter\":%" IPOPT_INDEX_FORMAT ",", iter);
+   record += buf;
+   AppendJsonNumber(record, "objective", unscaled_f);
+   record += ',';
+   AppendJsonNumber(record, "inf_pr", inf_pr);
+   record += ',';
+   AppendJsonNumber(record, "inf_du", inf_du);
+   record += ',';
+   AppendJsonNumber(record, "mu", mu);
+   record += ',';
+   AppendJsonNumber(record, "d_norm", dnrm);
+   record += ',';
+   AppendJsonNumber(record, "regularization", regu_x);
+   record += ',';
+   AppendJsonNumber(record, "alpha_du", alpha_dual);
+   record += ',';
+   AppendJsonNumber(record, "alpha_pr", alpha_primal);
+   Snprintf(buf, 127, ",\"alpha_pr_type\":\"%c\",\"ls_trials\":%" IPOPT_INDEX_FORMAT ",\"times\":{",
+            alpha_primal_char == '"' || alpha_primal_char == '\\' ? ' ' : alpha_primal_char, ls_count);
+   record += buf;
+
+   // wallclock time of the timed tasks since the last record; the times
+   // have been reset at the beginning of the optimization
+   const TimingStatistics& timing_stats = IpData().TimingStats();
+   const Index ntasks = TimingStatistics::NumTimedTasks();
+   if( iter == 0 || (Index) telemetry_last_times_.size() != ntasks )
+   {
+      telemetry_last_times_.assign(ntasks, 0.);
+   }
+   bool first = true;
+   for( Index i = 0; i < ntasks; i++ )
+   {
+      const TimedTask& task = timing_stats.GetTimedTask(i);
+      // tasks that are running (e.g., OverallAlgorithm) have no final time yet
+      if( !task.IsEnabled() || task.IsStarted() )
+      {
+         continue;
+      }
+      const Number total = task.TotalWallclockTime();
+      const Number delta = total - telemetry_last_times_[i];
+      telemetry_last_times_[i] = total;
+      if( delta <= 0. )
+      {
+         continue;
+      }
+      if( !first )
+      {
+         record += ',';
+      }
+      AppendJsonNumber(record, TimingStatistics::TimedTaskName(i), delta);
+      first = false;
+   }
+   record += "}}\n";
+
+   for( std::vector<SmartPtr<Journal> >::iterator it = telemetry_jrnls_.begin(); it != telemetry_jrnls_.end(); ++it )
+   {
+      (*it)->Print(J_MAIN, J_ITERSUMMARY, record.c_str());
+   }
+}
+
 } // namespace Ipopt
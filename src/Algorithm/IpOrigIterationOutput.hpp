@@ -9,10 +9,21 @@
 
 #include "IpIterationOutput.hpp"
 
+#include <string>
+#include <vector>
+
 namespace Ipopt
 {
 
 /** Class for the iteration summary output for the original NLP.
+ *
+ *  In addition to the text output, a machine-readable record of every
+ *  iteration can be written as one line in JSON format, either to the
+ *  file given by option telemetry_file or to a journal with name
+ *  "Telemetry" that has been added to the Journalist.  The latter
+ *  allows to receive the records in a callback by implementing the
+ *  PrintImpl method of a Journal; its print levels should be set to
+ *  J_NONE, so that it does not receive the regular output.
  */
 class OrigIterationOutput: public IterationOutput
 {
@@ -79,6 +90,27 @@ private:
 
    /** Option indicating at which time frequency the summary line should be printed */
    Number print_frequency_time_;
+
+   /** Journals that receive the per-iteration records, empty if none */
+   std::vector<SmartPtr<Journal> > telemetry_jrnls_;
+
+   /** Wallclock times of all timed tasks when the last record was written */
+   std::vector<Number> telemetry_last_times_;
+
+   /** Write the record for the current iteration to the telemetry journals */
+   void WriteTelemetry(
+      Index       iter,
+      Number      unscaled_f,
+      Number      inf_pr,
+      Number      inf_du,
+      Number      mu,
+      Number      dnrm,
+      Number      regu_x,
+      Number      alpha_dual,
+      Number      alpha_primal,
+      char        alpha_primal_char,
+      Index       ls_count
+   );
 };
 
 } // namespace Ipopt
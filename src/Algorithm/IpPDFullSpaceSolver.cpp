@@ -375,6 +375,84 @@ bool PDFullSpaceSolver::Solve(
    return true;
 }
 
+bool PDFullSpaceSolver::MultiSolve(
+   const std::vector<Number>&                    alphaV,
+   const std::vector<Number>&                    betaV,
+   std::vector<SmartPtr<const IteratesVector> >& rhsV,
+   std::vector<SmartPtr<IteratesVector> >&       resV,
+   bool                                          allow_inexact
+)
+{
+   DBG_START_METH("PDFullSpaceSolver::MultiSolve", dbg_verbosity);
+
+   const Index nrhs = (Index) rhsV.size();
+   DBG_ASSERT(nrhs > 0);
+   DBG_ASSERT(nrhs == (Index)resV.size());
+   DBG_ASSERT(nrhs == (Index)alphaV.size());
+   DBG_ASSERT(nrhs == (Index)betaV.size());
+
+   if( nrhs == 1 )
+   {
+      return Solve(alphaV[0], betaV[0], *rhsV[0], *resV[0], allow_inexact);
+   }
+
+   IpData().TimingStats().PDSystemSolverTotal().Start();
+
+   SmartPtr<const SymMatrix> W = IpData().W();
+   SmartPtr<const Matrix> J_c = IpCq().curr_jac_c();
+   SmartPtr<const Matrix> J_d = IpCq().curr_jac_d();
+   SmartPtr<const Matrix> Px_L = IpNLP().Px_L();
+   SmartPtr<const Matrix> Px_U = IpNLP().Px_U();
+   SmartPtr<const Matrix> Pd_L = IpNLP().Pd_L();
+   SmartPtr<const Matrix> Pd_U = IpNLP().Pd_U();
+   SmartPtr<const Vector> z_L = IpData().curr()->z_L();
+   SmartPtr<const Vector> z_U = IpData().curr()->z_U();
+   SmartPtr<const Vector> v_L = IpData().curr()->v_L();
+   SmartPtr<const Vector> v_U = IpData().curr()->v_U();
+   SmartPtr<const Vector> slack_x_L = IpCq().curr_slack_x_L();
+   SmartPtr<const Vector> slack_x_U = IpCq().curr_slack_x_U();
+   SmartPtr<const Vector> slack_s_L = IpCq().curr_slack_s_L();
+   SmartPtr<const Vector> slack_s_U = IpCq().curr_slack_s_U();
+   SmartPtr<const Vector> sigma_x = IpCq().curr_sigma_x();
+   SmartPtr<const Vector> sigma_s = IpCq().curr_sigma_s();
+
+   // Compute the unscaled solutions for all right hand sides with one
+   // factorization and one multi-RHS backsolve
+   std::vector<SmartPtr<IteratesVector> > solV(nrhs);
+   for( Index i = 0; i < nrhs; i++ )
+   {
+      solV[i] = resV[i]->MakeNewIteratesVector(true);
+   }
+   bool retval = SolveOnce(false, false, *W, *J_c, *J_d, *Px_L, *Px_U, *Pd_L, *Pd_U, *z_L, *z_U, *v_L, *v_U, *slack_x_L,
+                           *slack_x_U, *slack_s_L, *slack_s_U, *sigma_x, *sigma_s, 1., 0., rhsV, solV);
+   IpData().TimingStats().PDSystemSolverTotal().End();
+   if( !retval )
+   {
+      return false;
+   }
+
+   for( Index i = 0; i < nrhs; i++ )
+   {
+      if( !allow_inexact )
+      {
+         // iterative refinement (and, if necessary, modifications of
+         // the system) for every right hand side, which also applies alpha
+         retval = Solve(alphaV[i], 0., *rhsV[i], *solV[i], false, true);
+         if( !retval )
+         {
+            return false;
+         }
+         resV[i]->AddOneVector(1., *solV[i], betaV[i]);
+      }
+      else
+      {
+         resV[i]->AddOneVector(alphaV[i], *solV[i], betaV[i]);
+      }
+   }
+
+   return true;
+}
+
 bool PDFullSpaceSolver::SolveOnce(
    bool                  resolve_with_better_quality,
    bool                  pretend_singular,
@@ -400,6 +478,40 @@ bool PDFullSpaceSolver::SolveOnce(
    const IteratesVector& rhs,
    IteratesVector&       res
 )
+{
+   std::vector<SmartPtr<const IteratesVector> > rhsV(1);
+   rhsV[0] = &rhs;
+   std::vector<SmartPtr<IteratesVector> > resV(1);
+   resV[0] = &res;
+   return SolveOnce(resolve_with_better_quality, pretend_singular, W, J_c, J_d, Px_L, Px_U, Pd_L, Pd_U, z_L, z_U, v_L, v_U,
+                    slack_x_L, slack_x_U, slack_s_L, slack_s_U, sigma_x, sigma_s, alpha, beta, rhsV, resV);
+}
+
+bool PDFullSpaceSolver::SolveOnce(
+   bool                                          resolve_with_better_quality,
+   bool                                          pretend_singular,
+   const SymMatrix&                              W,
+   const Matrix&                                 J_c,
+   const Matrix&                                 J_d,
+   const Matrix&                                 Px_L,
+   const Matrix&                                 Px_U,
+   const Matrix&                                 Pd_L,
+   const Matrix&                                 Pd_U,
+   const Vector&                                 z_L,
+   const Vector&                                 z_U,
+   const Vector&                                 v_L,
+   const Vector&                                 v_U,
+   const Vector&                                 slack_x_L,
+   const Vector&                                 slack_x_U,
+   const Vector&                                 slack_s_L,
+   const Vector&                                 slack_s_U,
+   const Vector&                                 sigma_x,
+   const Vector&                                 sigma_s,
+   Number                                        alpha,
+   Number                                        beta,
+   std::vector<SmartPtr<const IteratesVector> >& rhsV,
+   std::vector<SmartPtr<IteratesVector> >&       resV
+)
 {
    // TO DO LIST:
    //
@@ -415,17 +527,44 @@ bool PDFullSpaceSolver::SolveOnce(
 
    IpData().TimingStats().PDSystemSolverSolveOnce().Start();
 
-   // Compute the right hand side for the augmented system formulation
-   SmartPtr<Vector> augRhs_x = rhs.x()->MakeNewCopy();
-   Px_L.AddMSinvZ(1.0, slack_x_L, *rhs.z_L(), *augRhs_x);
-   Px_U.AddMSinvZ(-1.0, slack_x_U, *rhs.z_U(), *augRhs_x);
-
-   SmartPtr<Vector> augRhs_s = rhs.s()->MakeNewCopy();
-   Pd_L.AddMSinvZ(1.0, slack_s_L, *rhs.v_L(), *augRhs_s);
-   Pd_U.AddMSinvZ(-1.0, slack_s_U, *rhs.v_U(), *augRhs_s);
-
-   // Get space into which we can put the solution of the augmented system
-   SmartPtr<IteratesVector> sol = res.MakeNewIteratesVector(true);
+   const Index nrhs = (Index) rhsV.size();
+   DBG_ASSERT(nrhs > 0);
+   DBG_ASSERT(nrhs == (Index)resV.size());
+
+   // Compute the right hand sides for the augmented system formulation
+   // and get space into which we can put the solutions of the augmented system
+   std::vector<SmartPtr<const Vector> > augRhs_xV(nrhs);
+   std::vector<SmartPtr<const Vector> > augRhs_sV(nrhs);
+   std::vector<SmartPtr<const Vector> > augRhs_cV(nrhs);
+   std::vector<SmartPtr<const Vector> > augRhs_dV(nrhs);
+   std::vector<SmartPtr<IteratesVector> > solV(nrhs);
+   std::vector<SmartPtr<Vector> > sol_xV(nrhs);
+   std::vector<SmartPtr<Vector> > sol_sV(nrhs);
+   std::vector<SmartPtr<Vector> > sol_cV(nrhs);
+   std::vector<SmartPtr<Vector> > sol_dV(nrhs);
+   for( Index i = 0; i < nrhs; i++ )
+   {
+      const IteratesVector& rhs = *rhsV[i];
+
+      SmartPtr<Vector> augRhs_x = rhs.x()->MakeNewCopy();
+      Px_L.AddMSinvZ(1.0, slack_x_L, *rhs.z_L(), *augRhs_x);
+      Px_U.AddMSinvZ(-1.0, slack_x_U, *rhs.z_U(), *augRhs_x);
+      augRhs_xV[i] = ConstPtr(augRhs_x);
+
+      SmartPtr<Vector> augRhs_s = rhs.s()->MakeNewCopy();
+      Pd_L.AddMSinvZ(1.0, slack_s_L, *rhs.v_L(), *augRhs_s);
+      Pd_U.AddMSinvZ(-1.0, slack_s_U, *rhs.v_U(), *augRhs_s);
+      augRhs_sV[i] = ConstPtr(augRhs_s);
+
+      augRhs_cV[i] = rhs.y_c();
+      augRhs_dV[i] = rhs.y_d();
+
+      solV[i] = resV[i]->MakeNewIteratesVector(true);
+      sol_xV[i] = solV[i]->x_NonConst();
+      sol_sV[i] = solV[i]->s_NonConst();
+      sol_cV[i] = solV[i]->y_c_NonConst();
+      sol_dV[i] = solV[i]->y_d_NonConst();
+   }
 
    // Now check whether any data has changed
    std::vector<const TaggedObject*> deps(13);
@@ -473,9 +612,8 @@ bool PDFullSpaceSolver::SolveOnce(
       // method has already asked the augSysSolver to increase the
       // quality at the end solve, and we are now getting the solution
       // with that better quality
-      retval = augSysSolver_->Solve(&W, 1.0, &sigma_x, delta_x, &sigma_s, delta_s, &J_c, NULL, delta_c, &J_d, NULL,
-                                    delta_d, *augRhs_x, *augRhs_s, *rhs.y_c(), *rhs.y_d(), *sol->x_NonConst(), *sol->s_NonConst(),
-                                    *sol->y_c_NonConst(), *sol->y_d_NonConst(), false, 0);
+      retval = augSysSolver_->MultiSolve(&W, 1.0, &sigma_x, delta_x, &sigma_s, delta_s, &J_c, NULL, delta_c, &J_d, NULL,
+                                         delta_d, augRhs_xV, augRhs_sV, augRhs_cV, augRhs_dV, sol_xV, sol_sV, sol_cV, sol_dV, false, 0);
       if( retval != SYMSOLVER_SUCCESS )
       {
          IpData().TimingStats().PDSystemSolverSolveOnce().End();
@@ -484,7 +622,7 @@ bool PDFullSpaceSolver::SolveOnce(
    }
    else
    {
-      const Index numberOfEVals = rhs.y_c()->Dim() + rhs.y_d()->Dim();
+      const Index numberOfEVals = rhsV[0]->y_c()->Dim() + rhsV[0]->y_d()->Dim();
       // counter for the number of trial evaluations
       // ToDo is not at the correct place
       Index count = 0;
@@ -517,15 +655,15 @@ bool PDFullSpaceSolver::SolveOnce(
             {
                check_inertia = false;
             }
-            retval = augSysSolver_->Solve(&W, 1.0, &sigma_x, delta_x, &sigma_s, delta_s, &J_c, NULL, delta_c, &J_d,
-                                          NULL, delta_d, *augRhs_x, *augRhs_s, *rhs.y_c(), *rhs.y_d(), *sol->x_NonConst(), *sol->s_NonConst(),
-                                          *sol->y_c_NonConst(), *sol->y_d_NonConst(), check_inertia, numberOfEVals);
+            retval = augSysSolver_->MultiSolve(&W, 1.0, &sigma_x, delta_x, &sigma_s, delta_s, &J_c, NULL, delta_c, &J_d,
+                                               NULL, delta_d, augRhs_xV, augRhs_sV, augRhs_cV, augRhs_dV, sol_xV, sol_sV, sol_cV, sol_dV,
+                                               check_inertia, numberOfEVals);
          }
          if( retval == SYMSOLVER_FATAL_ERROR )
          {
             return false;
          }
-         if( retval == SYMSOLVER_SINGULAR && (rhs.y_c()->Dim() + rhs.y_d()->Dim() > 0) )
+         if( retval == SYMSOLVER_SINGULAR && numberOfEVals > 0 )
          {
 
             // Get new perturbation factors from the perturbation
@@ -598,6 +736,8 @@ bool PDFullSpaceSolver::SolveOnce(
             if (neg_values != numberOfEVals)
             {
                // check if we have a direction of sufficient positive curvature
+               // (for the solution of the first right hand side)
+               const IteratesVector* sol = GetRawPtr(solV[0]);
                SmartPtr<Vector> x_tmp = sol->x()->MakeNew();
                W.MultVector(1., *sol->x(), 0., *x_tmp);
                Number xWx = x_tmp->Dot(*sol->x());
@@ -650,14 +790,20 @@ bool PDFullSpaceSolver::SolveOnce(
       IpData().setPDPert(delta_x, delta_s, delta_c, delta_d);
    }
 
-   // Compute the remaining sol Vectors
-   Px_L.SinvBlrmZMTdBr(-1., slack_x_L, *rhs.z_L(), z_L, *sol->x(), *sol->z_L_NonConst());
-   Px_U.SinvBlrmZMTdBr(1., slack_x_U, *rhs.z_U(), z_U, *sol->x(), *sol->z_U_NonConst());
-   Pd_L.SinvBlrmZMTdBr(-1., slack_s_L, *rhs.v_L(), v_L, *sol->s(), *sol->v_L_NonConst());
-   Pd_U.SinvBlrmZMTdBr(1., slack_s_U, *rhs.v_U(), v_U, *sol->s(), *sol->v_U_NonConst());
+   for( Index i = 0; i < nrhs; i++ )
+   {
+      const IteratesVector& rhs = *rhsV[i];
+      IteratesVector& sol = *solV[i];
 
-   // Finally let's assemble the res result vectors
-   res.AddOneVector(alpha, *sol, beta);
+      // Compute the remaining sol Vectors
+      Px_L.SinvBlrmZMTdBr(-1., slack_x_L, *rhs.z_L(), z_L, *sol.x(), *sol.z_L_NonConst());
+      Px_U.SinvBlrmZMTdBr(1., slack_x_U, *rhs.z_U(), z_U, *sol.x(), *sol.z_U_NonConst());
+      Pd_L.SinvBlrmZMTdBr(-1., slack_s_L, *rhs.v_L(), v_L, *sol.s(), *sol.v_L_NonConst());
+      Pd_U.SinvBlrmZMTdBr(1., slack_s_U, *rhs.v_U(), v_U, *sol.s(), *sol.v_U_NonConst());
+
+      // Finally let's assemble the res result vectors
+      resV[i]->AddOneVector(alpha, sol, beta);
+   }
 
    IpData().TimingStats().PDSystemSolverSolveOnce().End();
 
@@ -26,6 +26,13 @@ namespace Ipopt
  *  to solve the system more accurately (e.g. by increasing the
  *  pivot tolerance).  If that doesn't help or is not possible, we
  *  treat the system, as if it is singular (i.e. increase delta's).
+ *
+ *  Since the residuals are always computed in double precision, the
+ *  iterative refinement also recovers the accuracy of solutions
+ *  computed with a factorization in single precision (see option
+ *  ldl_single_precision).  If the refinement stagnates, asking the
+ *  linear solver to improve the quality of its solutions makes it
+ *  switch to a factorization in double precision.
  */
 class PDFullSpaceSolver: public PDSystemSolver
 {
@@ -61,6 +68,22 @@ public:
       bool                  improve_solution = false
    );
 
+   /** Solve the primal dual system for several right hand sides.
+    *
+    *  The factorization of the augmented system is computed (and, if
+    *  necessary, modified) once, and all right hand sides are solved
+    *  for with one backsolve of the augmented system solver.  Unless
+    *  allow_inexact is true, iterative refinement is then done for
+    *  every right hand side separately.
+    */
+   virtual bool MultiSolve(
+      const std::vector<Number>&                    alphaV,
+      const std::vector<Number>&                    betaV,
+      std::vector<SmartPtr<const IteratesVector> >& rhsV,
+      std::vector<SmartPtr<IteratesVector> >&       resV,
+      bool                                          allow_inexact = false
+   );
+
    /** Methods for IpoptType */
    ///@{
    static void RegisterOptions(
@@ -172,6 +195,35 @@ private:
       IteratesVector&       res
    );
 
+   /** Like SolveOnce, but for several right hand sides, which are
+    *  solved for with one backsolve of the augmented system solver.
+    */
+   bool SolveOnce(
+      bool                                          resolve_with_better_quality,
+      bool                                          pretend_singular,
+      const SymMatrix&                              W,
+      const Matrix&                                 J_c,
+      const Matrix&                                 J_d,
+      const Matrix&                                 Px_L,
+      const Matrix&                                 Px_U,
+      const Matrix&                                 Pd_L,
+      const Matrix&                                 Pd_U,
+      const Vector&                                 z_L,
+      const Vector&                                 z_U,
+      const Vector&                                 v_L,
+      const Vector&                                 v_U,
+      const Vector&                                 slack_x_L,
+      const Vector&                                 slack_x_U,
+      const Vector&                                 slack_s_L,
+      const Vector&                                 slack_s_U,
+      const Vector&                                 sigma_x,
+      const Vector&                                 sigma_s,
+      Number                                        alpha,
+      Number                                        beta,
+      std::vector<SmartPtr<const IteratesVector> >& rhsV,
+      std::vector<SmartPtr<IteratesVector> >&       resV
+   );
+
    /** Internal function for computing the residual (resid) given the
     * right hand side (rhs) and the solution of the system (res).
     */
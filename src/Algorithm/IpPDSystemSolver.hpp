@@ -12,6 +12,8 @@
 #include "IpAlgStrategy.hpp"
 #include "IpIteratesVector.hpp"
 
+#include <vector>
+
 namespace Ipopt
 {
 
@@ -114,6 +116,35 @@ public:
       bool                  improve_solution = false
    ) = 0;
 
+   /** Solve the primal dual system for several right hand sides.
+    *
+    *  The i-th solution is computed as in Solve with alphaV[i],
+    *  betaV[i], rhsV[i], and resV[i].  An implementation should make
+    *  use of the fact that all right hand sides are known at the same
+    *  time, e.g., by solving for them with one backsolve.  The default
+    *  implementation solves for one right hand side after the other.
+    *
+    *  @since 3.14.5
+    */
+   virtual bool MultiSolve(
+      const std::vector<Number>&                    alphaV,
+      const std::vector<Number>&                    betaV,
+      std::vector<SmartPtr<const IteratesVector> >& rhsV,
+      std::vector<SmartPtr<IteratesVector> >&       resV,
+      bool                                          allow_inexact = false
+   )
+   {
+      DBG_ASSERT(rhsV.size() == resV.size());
+      for( size_t i = 0; i < rhsV.size(); i++ )
+      {
+         if( !Solve(alphaV[i], betaV[i], *rhsV[i], *resV[i], allow_inexact) )
+         {
+            return false;
+         }
+      }
+      return true;
+   }
+
 private:
    /**@name Default Compiler Generated Methods
     * (Hidden to avoid implicit creation/calling).
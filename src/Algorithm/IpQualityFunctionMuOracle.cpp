@@ -182,13 +182,13 @@ bool QualityFunctionMuOracle::CalculateMu(
    tmp_v_L_ = IpNLP().d_L()->MakeNew();
    tmp_v_U_ = IpNLP().d_U()->MakeNew();
 
-   /////////////////////////////////////
-   // Compute the affine scaling step //
-   /////////////////////////////////////
+   ////////////////////////////////////////////////////////////
+   // Compute the affine scaling step and the centering step //
+   ////////////////////////////////////////////////////////////
 
    Jnlst().Printf(J_DETAILED, J_BARRIER_UPDATE,
-                  "Solving the Primal Dual System for the affine step\n");
-   // First get the right hand side
+                  "Solving the Primal Dual System for the affine step and the centering step\n");
+   // First get the right hand side for the affine step
    SmartPtr<IteratesVector> rhs_aff = IpData().curr()->MakeNewIteratesVector(false);
    rhs_aff->Set_x(*IpCq().curr_grad_lag_x());
    rhs_aff->Set_s(*IpCq().curr_grad_lag_s());
@@ -202,29 +202,9 @@ bool QualityFunctionMuOracle::CalculateMu(
    // Get space for the affine scaling step
    SmartPtr<IteratesVector> step_aff = IpData().curr()->MakeNewIteratesVector(true);
 
-   // Now solve the primal-dual system to get the step.  We allow a
-   // somewhat inexact solution, iterative refinement will be done
-   // after mu is known
-   bool allow_inexact = true;
-   bool retval = pd_solver_->Solve(-1.0, 0.0, *rhs_aff, *step_aff, allow_inexact);
-   if( !retval )
-   {
-      Jnlst().Printf(J_DETAILED, J_BARRIER_UPDATE,
-                     "The linear system could not be solved for the affine step!\n");
-      return false;
-   }
-
-   DBG_PRINT_VECTOR(2, "step_aff", *step_aff);
-
-   /////////////////////////////////////
-   // Compute the pure centering step //
-   /////////////////////////////////////
-
    Number avrg_compl = IpCq().curr_avrg_compl();
 
-   Jnlst().Printf(J_DETAILED, J_BARRIER_UPDATE,
-                  "Solving the Primal Dual System for the centering step\n");
-   // First get the right hand side
+   // Now get the right hand side for the pure centering step
    SmartPtr<IteratesVector> rhs_cen = IpData().curr()->MakeNewIteratesVector(true);
    rhs_cen->x_NonConst()->AddOneVector(-avrg_compl, *IpCq().grad_kappa_times_damping_x(), 0.);
    rhs_cen->s_NonConst()->AddOneVector(-avrg_compl, *IpCq().grad_kappa_times_damping_s(), 0.);
@@ -239,16 +219,29 @@ bool QualityFunctionMuOracle::CalculateMu(
    // Get space for the centering step
    SmartPtr<IteratesVector> step_cen = IpData().curr()->MakeNewIteratesVector(true);
 
-   // Now solve the primal-dual system to get the step
-   allow_inexact = true;
-   retval = pd_solver_->Solve(1.0, 0.0, *rhs_cen, *step_cen, allow_inexact);
+   // Now solve the primal-dual system for both right hand sides at
+   // once, since they are independent.  We allow a somewhat inexact
+   // solution, iterative refinement will be done after mu is known
+   std::vector<Number> alphaV(2);
+   std::vector<Number> betaV(2, 0.);
+   std::vector<SmartPtr<const IteratesVector> > rhsV(2);
+   std::vector<SmartPtr<IteratesVector> > stepV(2);
+   alphaV[0] = -1.;
+   rhsV[0] = ConstPtr(rhs_aff);
+   stepV[0] = step_aff;
+   alphaV[1] = 1.;
+   rhsV[1] = ConstPtr(rhs_cen);
+   stepV[1] = step_cen;
+   bool allow_inexact = true;
+   bool retval = pd_solver_->MultiSolve(alphaV, betaV, rhsV, stepV, allow_inexact);
    if( !retval )
    {
       Jnlst().Printf(J_DETAILED, J_BARRIER_UPDATE,
-                     "The linear system could not be solved for the centering step!\n");
+                     "The linear system could not be solved for the affine step and the centering step!\n");
       return false;
    }
 
+   DBG_PRINT_VECTOR(2, "step_aff", *step_aff);
    DBG_PRINT_VECTOR(2, "step_cen", *step_cen);
 
    // Start the timing for the quality function search here
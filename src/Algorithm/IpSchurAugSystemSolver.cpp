@@ -0,0 +1,714 @@
+// Copyright (C) 2021 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpSchurAugSystemSolver.hpp"
+#include "IpDiagMatrix.hpp"
+#include "IpSymTMatrix.hpp"
+#include "IpLowRankUpdateSymMatrix.hpp"
+#include "IpMultiVectorMatrix.hpp"
+#include "IpTripletHelper.hpp"
+#include "IpBlas.hpp"
+#include "IpLapack.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace Ipopt
+{
+#if IPOPT_VERBOSITY > 0
+static const Index dbg_verbosity = 0;
+#endif
+
+/** number of rows of the transposed Jacobian that are processed at once in the assembly of the Schur complement */
+static const Index schur_block_size = 512;
+
+SchurAugSystemSolver::SchurAugSystemSolver(
+   AugSystemSolver& aug_system_solver
+)
+   : AugSystemSolver(),
+     aug_system_solver_(&aug_system_solver),
+     max_dim_(500),
+     use_schur_(false),
+     have_factorization_(false),
+     w_tag_(0),
+     w_factor_(0.),
+     d_x_tag_(0),
+     delta_x_(0.),
+     d_s_tag_(0),
+     delta_s_(0.),
+     j_c_tag_(0),
+     d_c_tag_(0),
+     delta_c_(0.),
+     j_d_tag_(0),
+     d_d_tag_(0),
+     delta_d_(0.),
+     n_x_(0),
+     n_s_(0),
+     m_c_(0),
+     m_d_(0),
+     k_v_(0),
+     k_u_(0),
+     nnz_c_(-1),
+     nnz_d_(-1),
+     dim_(0),
+     cholesky_(false),
+     num_neg_evals_(-1)
+{
+   DBG_START_METH("SchurAugSystemSolver::SchurAugSystemSolver()", dbg_verbosity);
+   DBG_ASSERT(IsValid(aug_system_solver_));
+}
+
+SchurAugSystemSolver::~SchurAugSystemSolver()
+{
+   DBG_START_METH("SchurAugSystemSolver::~SchurAugSystemSolver()", dbg_verbosity);
+}
+
+void SchurAugSystemSolver::RegisterOptions(
+   SmartPtr<RegisteredOptions> roptions
+)
+{
+   roptions->AddBoolOption(
+      "schur_complement_aug_solver",
+      "Whether to solve the augmented system with the dense Schur complement of the constraints if possible.",
+      false,
+      "If the Hessian is diagonal or a diagonal plus a low-rank update (limited-memory quasi-Newton approximation), "
+      "the primal variables are eliminated and the Schur complement of the constraints, "
+      "whose dimension is the number of constraints plus the rank of the update, is factorized by dense linear algebra. "
+      "This is much cheaper than the factorization of the augmented system for problems with many variables and few constraints. "
+      "For other Hessians, the augmented system is solved by the linear solver.");
+   roptions->AddLowerBoundedIntegerOption(
+      "schur_complement_max_dim",
+      "Maximal dimension of the dense Schur complement.",
+      1,
+      500,
+      "If the number of constraints plus the rank of the Hessian update exceeds this value, "
+      "the augmented system is solved by the linear solver.");
+}
+
+bool SchurAugSystemSolver::InitializeImpl(
+   const OptionsList& options,
+   const std::string& prefix
+)
+{
+   options.GetIntegerValue("schur_complement_max_dim", max_dim_, prefix);
+
+   use_schur_ = false;
+   have_factorization_ = false;
+   nnz_c_ = -1;
+   nnz_d_ = -1;
+   jt_ptr_.clear();
+   num_neg_evals_ = -1;
+
+   return aug_system_solver_->Initialize(Jnlst(), IpNLP(), IpData(), IpCq(), options, prefix);
+}
+
+ESymSolverStatus SchurAugSystemSolver::Solve(
+   const SymMatrix* W,
+   Number           W_factor,
+   const Vector*    D_x,
+   Number           delta_x,
+   const Vector*    D_s,
+   Number           delta_s,
+   const Matrix*    J_c,
+   const Vector*    D_c,
+   Number           delta_c,
+   const Matrix*    J_d,
+   const Vector*    D_d,
+   Number           delta_d,
+   const Vector&    rhs_x,
+   const Vector&    rhs_s,
+   const Vector&    rhs_c,
+   const Vector&    rhs_d,
+   Vector&          sol_x,
+   Vector&          sol_s,
+   Vector&          sol_c,
+   Vector&          sol_d,
+   bool             check_NegEVals,
+   Index            numberOfNegEVals
+)
+{
+   DBG_START_METH("SchurAugSystemSolver::Solve", dbg_verbosity);
+   DBG_ASSERT(J_c != NULL);  // since we de-ref this pointer below
+   DBG_ASSERT(J_d != NULL);  // since we de-ref this pointer below
+
+   if( !use_schur_ || !have_factorization_
+       || AugmentedSystemRequiresChange(W, W_factor, D_x, delta_x, D_s, delta_s, *J_c, D_c, delta_c, *J_d, D_d,
+                                        delta_d) )
+   {
+      use_schur_ = false;
+      have_factorization_ = false;
+      n_x_ = rhs_x.Dim();
+      n_s_ = rhs_s.Dim();
+      m_c_ = rhs_c.Dim();
+      m_d_ = rhs_d.Dim();
+
+      if( ExtractHessian(W, W_factor, rhs_x) && m_c_ + m_d_ + k_v_ + k_u_ <= max_dim_ )
+      {
+         // the diagonal of the (1,1) block, which must be nonsingular
+         use_schur_ = true;
+         std::vector<Number> tmp;
+         if( D_x && n_x_ > 0 )
+         {
+            tmp.resize(n_x_);
+            TripletHelper::FillValuesFromVector(n_x_, *D_x, &tmp[0]);
+         }
+         for( Index i = 0; i < n_x_ && use_schur_; i++ )
+         {
+            Number d = dx_inv_[i] + delta_x;
+            if( D_x )
+            {
+               d += tmp[i];
+            }
+            use_schur_ = (d != 0.);
+            dx_inv_[i] = 1. / d;
+         }
+         ds_inv_.assign(n_s_, delta_s);
+         if( D_s && n_s_ > 0 )
+         {
+            tmp.resize(n_s_);
+            TripletHelper::FillValuesFromVector(n_s_, *D_s, &tmp[0]);
+            for( Index i = 0; i < n_s_; i++ )
+            {
+               ds_inv_[i] += tmp[i];
+            }
+         }
+         for( Index i = 0; i < n_s_ && use_schur_; i++ )
+         {
+            use_schur_ = (ds_inv_[i] != 0.);
+            ds_inv_[i] = 1. / ds_inv_[i];
+         }
+      }
+
+      if( use_schur_ )
+      {
+         if( HaveIpData() )
+         {
+            IpData().TimingStats().LinearSystemFactorization().Start();
+         }
+         ESymSolverStatus retval = UpdateFactorization(*J_c, D_c, delta_c, *J_d, D_d, delta_d, check_NegEVals,
+                                   numberOfNegEVals);
+         if( HaveIpData() )
+         {
+            IpData().TimingStats().LinearSystemFactorization().End();
+         }
+         if( retval != SYMSOLVER_SUCCESS )
+         {
+            Jnlst().Printf(J_DETAILED, J_SOLVE_PD_SYSTEM,
+                           "SchurAugSystemSolver: factorization of the Schur complement returned retval = %d.\n", retval);
+            return retval;
+         }
+
+         // Store the tags
+         w_tag_ = W ? W->GetTag() : 0;
+         w_factor_ = W_factor;
+         d_x_tag_ = D_x ? D_x->GetTag() : 0;
+         delta_x_ = delta_x;
+         d_s_tag_ = D_s ? D_s->GetTag() : 0;
+         delta_s_ = delta_s;
+         j_c_tag_ = J_c->GetTag();
+         d_c_tag_ = D_c ? D_c->GetTag() : 0;
+         delta_c_ = delta_c;
+         j_d_tag_ = J_d->GetTag();
+         d_d_tag_ = D_d ? D_d->GetTag() : 0;
+         delta_d_ = delta_d;
+         have_factorization_ = true;
+      }
+   }
+
+   if( !use_schur_ )
+   {
+      return aug_system_solver_->Solve(W, W_factor, D_x, delta_x, D_s, delta_s, J_c, D_c, delta_c, J_d, D_d, delta_d,
+                                       rhs_x, rhs_s, rhs_c, rhs_d, sol_x, sol_s, sol_c, sol_d, check_NegEVals, numberOfNegEVals);
+   }
+
+   if( HaveIpData() )
+   {
+      IpData().TimingStats().LinearSystemBackSolve().Start();
+   }
+
+   const Index m_cd = m_c_ + m_d_;
+   const Index k = k_v_ + k_u_;
+
+   // y = D^{-1} rhs for the primal variables
+   std::vector<Number> y_x(n_x_);
+   std::vector<Number> y_s(n_s_);
+   TripletHelper::FillValuesFromVector(n_x_, rhs_x, n_x_ > 0 ? &y_x[0] : NULL);
+   for( Index i = 0; i < n_x_; i++ )
+   {
+      y_x[i] *= dx_inv_[i];
+   }
+   TripletHelper::FillValuesFromVector(n_s_, rhs_s, n_s_ > 0 ? &y_s[0] : NULL);
+   for( Index i = 0; i < n_s_; i++ )
+   {
+      y_s[i] *= ds_inv_[i];
+   }
+
+   // right hand side B y - rhs for the multipliers
+   std::vector<Number> lambda(dim_);
+   SmartPtr<Vector> tmp_x = rhs_x.MakeNew();
+   TripletHelper::PutValuesInVector(n_x_, n_x_ > 0 ? &y_x[0] : NULL, *tmp_x);
+   SmartPtr<Vector> tmp_c = rhs_c.MakeNewCopy();
+   J_c->MultVector(1., *tmp_x, -1., *tmp_c);
+   SmartPtr<Vector> tmp_d = rhs_d.MakeNewCopy();
+   J_d->MultVector(1., *tmp_x, -1., *tmp_d);
+   if( m_c_ > 0 )
+   {
+      TripletHelper::FillValuesFromVector(m_c_, *tmp_c, &lambda[0]);
+   }
+   if( m_d_ > 0 )
+   {
+      TripletHelper::FillValuesFromVector(m_d_, *tmp_d, &lambda[m_c_]);
+   }
+   for( Index i = 0; i < m_d_; i++ )
+   {
+      lambda[m_c_ + i] -= y_s[i];
+   }
+   if( k > 0 )
+   {
+      IpBlasGemm(true, false, k, 1, n_x_, 1., &z_[0], n_x_, &y_x[0], n_x_, 0., &lambda[m_cd], k);
+   }
+
+   if( dim_ > 0 )
+   {
+      SolveSchur(&lambda[0]);
+   }
+
+   // back substitution
+   TripletHelper::PutValuesInVector(m_c_, m_c_ > 0 ? &lambda[0] : NULL, sol_c);
+   TripletHelper::PutValuesInVector(m_d_, m_d_ > 0 ? &lambda[m_c_] : NULL, sol_d);
+
+   tmp_x->Copy(rhs_x);
+   J_c->TransMultVector(-1., sol_c, 1., *tmp_x);
+   J_d->TransMultVector(-1., sol_d, 1., *tmp_x);
+   TripletHelper::FillValuesFromVector(n_x_, *tmp_x, n_x_ > 0 ? &y_x[0] : NULL);
+   if( k > 0 )
+   {
+      IpBlasGemm(false, false, n_x_, 1, k, -1., &z_[0], n_x_, &lambda[m_cd], k, 1., &y_x[0], n_x_);
+   }
+   for( Index i = 0; i < n_x_; i++ )
+   {
+      y_x[i] *= dx_inv_[i];
+   }
+   TripletHelper::PutValuesInVector(n_x_, n_x_ > 0 ? &y_x[0] : NULL, sol_x);
+
+   TripletHelper::FillValuesFromVector(n_s_, rhs_s, n_s_ > 0 ? &y_s[0] : NULL);
+   for( Index i = 0; i < n_s_; i++ )
+   {
+      y_s[i] = (y_s[i] + lambda[m_c_ + i]) * ds_inv_[i];
+   }
+   TripletHelper::PutValuesInVector(n_s_, n_s_ > 0 ? &y_s[0] : NULL, sol_s);
+
+   if( HaveIpData() )
+   {
+      IpData().TimingStats().LinearSystemBackSolve().End();
+   }
+
+   return SYMSOLVER_SUCCESS;
+}
+
+bool SchurAugSystemSolver::ExtractHessian(
+   const SymMatrix* W,
+   Number           W_factor,
+   const Vector&    proto_x
+)
+{
+   DBG_START_METH("SchurAugSystemSolver::ExtractHessian", dbg_verbosity);
+
+   dx_inv_.assign(n_x_, 0.);
+   z_.clear();
+   k_v_ = 0;
+   k_u_ = 0;
+   if( !W || W_factor == 0. )
+   {
+      return true;
+   }
+
+   const DiagMatrix* W_diag = dynamic_cast<const DiagMatrix*>(W);
+   const SymTMatrix* W_triplet = dynamic_cast<const SymTMatrix*>(W);
+   const LowRankUpdateSymMatrix* W_lowrank = dynamic_cast<const LowRankUpdateSymMatrix*>(W);
+   if( W_diag )
+   {
+      TripletHelper::FillValuesFromVector(n_x_, *W_diag->GetDiag(), n_x_ > 0 ? &dx_inv_[0] : NULL);
+   }
+   else if( W_triplet )
+   {
+      const Index* irows = W_triplet->Irows();
+      const Index* jcols = W_triplet->Jcols();
+      const Number* values = W_triplet->Values();
+      for( Index i = 0; i < W_triplet->Nonzeros(); i++ )
+      {
+         if( irows[i] != jcols[i] )
+         {
+            return false;
+         }
+         dx_inv_[irows[i] - 1] += values[i];
+      }
+   }
+   else if( W_lowrank )
+   {
+      SmartPtr<const Matrix> P_LR = W_lowrank->P_LowRank();
+      SmartPtr<Vector> full_x = proto_x.MakeNew();
+
+      SmartPtr<const Vector> B0 = W_lowrank->GetDiag();
+      if( IsValid(B0) )
+      {
+         if( IsValid(P_LR) && W_lowrank->ReducedDiag() )
+         {
+            P_LR->MultVector(1., *B0, 0., *full_x);
+            TripletHelper::FillValuesFromVector(n_x_, *full_x, n_x_ > 0 ? &dx_inv_[0] : NULL);
+         }
+         else
+         {
+            TripletHelper::FillValuesFromVector(n_x_, *B0, n_x_ > 0 ? &dx_inv_[0] : NULL);
+         }
+      }
+
+      SmartPtr<const MultiVectorMatrix> V = W_lowrank->GetV();
+      SmartPtr<const MultiVectorMatrix> U = W_lowrank->GetU();
+      k_v_ = IsValid(V) ? V->NCols() : 0;
+      k_u_ = IsValid(U) ? U->NCols() : 0;
+      z_.resize((size_t) n_x_ * (k_v_ + k_u_));
+      for( Index j = 0; j < k_v_ + k_u_; j++ )
+      {
+         SmartPtr<const Vector> col = j < k_v_ ? V->GetVector(j) : U->GetVector(j - k_v_);
+         if( IsValid(P_LR) )
+         {
+            P_LR->MultVector(1., *col, 0., *full_x);
+            col = ConstPtr(full_x);
+         }
+         TripletHelper::FillValuesFromVector(n_x_, *col, n_x_ > 0 ? &z_[(size_t) j * n_x_] : NULL);
+      }
+      if( W_factor != 1. )
+      {
+         IpBlasScal((Index) z_.size(), std::sqrt(W_factor), z_.empty() ? NULL : &z_[0], 1);
+      }
+   }
+   else
+   {
+      return false;
+   }
+
+   if( W_factor != 1. )
+   {
+      for( Index i = 0; i < n_x_; i++ )
+      {
+         dx_inv_[i] *= W_factor;
+      }
+   }
+   return true;
+}
+
+void SchurAugSystemSolver::InitializeJacobianStructure(
+   const Matrix& J_c,
+   const Matrix& J_d
+)
+{
+   DBG_START_METH("SchurAugSystemSolver::InitializeJacobianStructure", dbg_verbosity);
+
+   const Index nnz = nnz_c_ + nnz_d_;
+   std::vector<Index> irow(nnz);
+   std::vector<Index> jcol(nnz);
+   if( nnz_c_ > 0 )
+   {
+      TripletHelper::FillRowCol(nnz_c_, J_c, &irow[0], &jcol[0]);
+   }
+   if( nnz_d_ > 0 )
+   {
+      TripletHelper::FillRowCol(nnz_d_, J_d, &irow[nnz_c_], &jcol[nnz_c_], m_c_);
+   }
+
+   jt_ptr_.assign(n_x_ + 1, 0);
+   for( Index i = 0; i < nnz; i++ )
+   {
+      jt_ptr_[jcol[i]]++;
+   }
+   for( Index j = 0; j < n_x_; j++ )
+   {
+      jt_ptr_[j + 1] += jt_ptr_[j];
+   }
+   jt_row_.resize(nnz);
+   jt_src_.resize(nnz);
+   std::vector<Index> next(jt_ptr_.begin(), jt_ptr_.end() - 1);
+   for( Index i = 0; i < nnz; i++ )
+   {
+      const Index j = jcol[i] - 1;
+      jt_row_[next[j]] = irow[i] - 1;
+      jt_src_[next[j]++] = i;
+   }
+   j_vals_.resize(nnz);
+}
+
+ESymSolverStatus SchurAugSystemSolver::UpdateFactorization(
+   const Matrix& J_c,
+   const Vector* D_c,
+   Number        delta_c,
+   const Matrix& J_d,
+   const Vector* D_d,
+   Number        delta_d,
+   bool          check_NegEVals,
+   Index         numberOfNegEVals
+)
+{
+   DBG_START_METH("SchurAugSystemSolver::UpdateFactorization", dbg_verbosity);
+
+   const Index m_cd = m_c_ + m_d_;
+   const Index k = k_v_ + k_u_;
+   dim_ = m_cd + k;
+
+   const Index nnz_c = TripletHelper::GetNumberEntries(J_c);
+   const Index nnz_d = TripletHelper::GetNumberEntries(J_d);
+   if( nnz_c != nnz_c_ || nnz_d != nnz_d_ || (Index) jt_ptr_.size() != n_x_ + 1 )
+   {
+      nnz_c_ = nnz_c;
+      nnz_d_ = nnz_d;
+      InitializeJacobianStructure(J_c, J_d);
+   }
+   if( nnz_c_ > 0 )
+   {
+      TripletHelper::FillValues(nnz_c_, J_c, &j_vals_[0]);
+   }
+   if( nnz_d_ > 0 )
+   {
+      TripletHelper::FillValues(nnz_d_, J_d, &j_vals_[nnz_c_]);
+   }
+
+   Index neg_diag = 0;
+   for( Index i = 0; i < n_x_; i++ )
+   {
+      if( dx_inv_[i] < 0. )
+      {
+         neg_diag++;
+      }
+   }
+   for( Index i = 0; i < n_s_; i++ )
+   {
+      if( ds_inv_[i] < 0. )
+      {
+         neg_diag++;
+      }
+   }
+
+   if( dim_ == 0 )
+   {
+      num_neg_evals_ = neg_diag;
+      if( check_NegEVals && num_neg_evals_ != numberOfNegEVals )
+      {
+         return SYMSOLVER_WRONG_INERTIA;
+      }
+      return SYMSOLVER_SUCCESS;
+   }
+
+   // M = [J_c; J_d; V^T; U^T] D_x^{-1} [J_c; J_d; V^T; U^T]^T, assembled from blocks of
+   // rows of the transpose; with a positive diagonal, only the lower triangle is computed
+   schur_.assign((size_t) dim_ * dim_, 0.);
+   bool positive = (neg_diag == 0);
+   std::vector<Number> G((size_t) schur_block_size * dim_);
+   std::vector<Number> DG;
+   if( !positive )
+   {
+      DG.resize(G.size());
+   }
+   for( Index j0 = 0; j0 < n_x_; j0 += schur_block_size )
+   {
+      const Index nb = Min(schur_block_size, n_x_ - j0);
+      std::fill(G.begin(), G.begin() + (size_t) nb * dim_, 0.);
+      for( Index j = j0; j < j0 + nb; j++ )
+      {
+         for( Index q = jt_ptr_[j]; q < jt_ptr_[j + 1]; q++ )
+         {
+            G[(j - j0) + (size_t) jt_row_[q] * nb] += j_vals_[jt_src_[q]];
+         }
+         for( Index t = 0; t < k; t++ )
+         {
+            G[(j - j0) + (size_t) (m_cd + t) * nb] = z_[j + (size_t) t * n_x_];
+         }
+      }
+      if( positive )
+      {
+         for( Index j = j0; j < j0 + nb; j++ )
+         {
+            const Number s = std::sqrt(dx_inv_[j]);
+            for( Index c = 0; c < dim_; c++ )
+            {
+               G[(j - j0) + (size_t) c * nb] *= s;
+            }
+         }
+         IpBlasSyrk(true, dim_, nb, 1., &G[0], nb, 1., &schur_[0], dim_);
+      }
+      else
+      {
+         for( Index j = j0; j < j0 + nb; j++ )
+         {
+            for( Index c = 0; c < dim_; c++ )
+            {
+               DG[(j - j0) + (size_t) c * nb] = dx_inv_[j] * G[(j - j0) + (size_t) c * nb];
+            }
+         }
+         IpBlasGemm(true, false, dim_, dim_, nb, 1., &G[0], nb, &DG[0], nb, 1., &schur_[0], dim_);
+      }
+   }
+
+   // + E, including the contribution of the slacks to the rows of J_d
+   std::vector<Number> tmp;
+   if( D_c && m_c_ > 0 )
+   {
+      tmp.resize(m_c_);
+      TripletHelper::FillValuesFromVector(m_c_, *D_c, &tmp[0]);
+   }
+   for( Index i = 0; i < m_c_; i++ )
+   {
+      schur_[i + (size_t) i * dim_] += delta_c + (D_c ? tmp[i] : 0.);
+   }
+   if( D_d && m_d_ > 0 )
+   {
+      tmp.resize(m_d_);
+      TripletHelper::FillValuesFromVector(m_d_, *D_d, &tmp[0]);
+   }
+   for( Index i = 0; i < m_d_; i++ )
+   {
+      const Index r = m_c_ + i;
+      schur_[r + (size_t) r * dim_] += delta_d + (D_d ? tmp[i] : 0.) + ds_inv_[i];
+   }
+   for( Index t = 0; t < k; t++ )
+   {
+      const Index r = m_cd + t;
+      schur_[r + (size_t) r * dim_] += (t < k_v_) ? 1. : -1.;
+   }
+
+   // try Cholesky first; otherwise compute the eigenvalues for the inertia
+   Index num_pos;
+   std::vector<Number> M(schur_);
+   Index info;
+   IpLapackPotrf(dim_, &schur_[0], dim_, info);
+   if( info == 0 )
+   {
+      cholesky_ = true;
+      num_pos = dim_;
+   }
+   else
+   {
+      cholesky_ = false;
+      schur_.swap(M);
+      eigvals_.resize(dim_);
+      IpLapackSyev(true, dim_, &schur_[0], dim_, &eigvals_[0], info);
+      if( info != 0 )
+      {
+         Jnlst().Printf(J_DETAILED, J_SOLVE_PD_SYSTEM,
+                        "SchurAugSystemSolver: eigenvalue decomposition of the Schur complement failed with info = %" IPOPT_INDEX_FORMAT ".\n", info);
+         return SYMSOLVER_SINGULAR;
+      }
+      Number maxabs = 0.;
+      for( Index i = 0; i < dim_; i++ )
+      {
+         maxabs = Max(maxabs, std::abs(eigvals_[i]));
+      }
+      const Number tol = std::numeric_limits<Number>::epsilon() * dim_ * maxabs;
+      num_pos = 0;
+      for( Index i = 0; i < dim_; i++ )
+      {
+         if( !(std::abs(eigvals_[i]) > tol) )
+         {
+            Jnlst().Printf(J_DETAILED, J_SOLVE_PD_SYSTEM,
+                           "SchurAugSystemSolver: Schur complement is singular.\n");
+            return SYMSOLVER_SINGULAR;
+         }
+         if( eigvals_[i] > 0. )
+         {
+            num_pos++;
+         }
+      }
+   }
+
+   // the rows for V contribute k_v negative eigenvalues that do not belong to the augmented system
+   num_neg_evals_ = neg_diag + num_pos - k_v_;
+   if( check_NegEVals && num_neg_evals_ != numberOfNegEVals )
+   {
+      Jnlst().Printf(J_DETAILED, J_SOLVE_PD_SYSTEM,
+                     "SchurAugSystemSolver: wrong inertia, %" IPOPT_INDEX_FORMAT " negative eigenvalues instead of %" IPOPT_INDEX_FORMAT ".\n",
+                     num_neg_evals_, numberOfNegEVals);
+      return SYMSOLVER_WRONG_INERTIA;
+   }
+
+   return SYMSOLVER_SUCCESS;
+}
+
+void SchurAugSystemSolver::SolveSchur(
+   Number* rhs
+) const
+{
+   if( cholesky_ )
+   {
+      IpLapackPotrs(dim_, 1, &schur_[0], dim_, rhs, dim_);
+      return;
+   }
+
+   // M^{-1} = Q diag(eigvals)^{-1} Q^T
+   std::vector<Number> tmp(dim_);
+   IpBlasGemv(true, dim_, dim_, 1., &schur_[0], dim_, rhs, 1, 0., &tmp[0], 1);
+   for( Index i = 0; i < dim_; i++ )
+   {
+      tmp[i] /= eigvals_[i];
+   }
+   IpBlasGemv(false, dim_, dim_, 1., &schur_[0], dim_, &tmp[0], 1, 0., rhs, 1);
+}
+
+bool SchurAugSystemSolver::AugmentedSystemRequiresChange(
+   const SymMatrix* W,
+   Number           W_factor,
+   const Vector*    D_x,
+   Number           delta_x,
+   const Vector*    D_s,
+   Number           delta_s,
+   const Matrix&    J_c,
+   const Vector*    D_c,
+   Number           delta_c,
+   const Matrix&    J_d,
+   const Vector*    D_d,
+   Number           delta_d
+)
+{
+   DBG_START_METH("SchurAugSystemSolver::AugmentedSystemRequiresChange", dbg_verbosity);
+
+   if( (W && W->GetTag() != w_tag_) || (!W && w_tag_ != 0) || (W_factor != w_factor_)
+       || (D_x && D_x->GetTag() != d_x_tag_) || (!D_x && d_x_tag_ != 0) || (delta_x != delta_x_)
+       || (D_s && D_s->GetTag() != d_s_tag_) || (!D_s && d_s_tag_ != 0) || (delta_s != delta_s_)
+       || (J_c.GetTag() != j_c_tag_) || (D_c && D_c->GetTag() != d_c_tag_) || (!D_c && d_c_tag_ != 0)
+       || (delta_c != delta_c_) || (J_d.GetTag() != j_d_tag_) || (D_d && D_d->GetTag() != d_d_tag_)
+       || (!D_d && d_d_tag_ != 0) || (delta_d != delta_d_) )
+   {
+      return true;
+   }
+
+   return false;
+}
+
+Index SchurAugSystemSolver::NumberOfNegEVals() const
+{
+   if( use_schur_ )
+   {
+      return num_neg_evals_;
+   }
+   return aug_system_solver_->NumberOfNegEVals();
+}
+
+bool SchurAugSystemSolver::ProvidesInertia() const
+{
+   if( use_schur_ )
+   {
+      return true;
+   }
+   return aug_system_solver_->ProvidesInertia();
+}
+
+bool SchurAugSystemSolver::IncreaseQuality()
+{
+   if( use_schur_ )
+   {
+      // the Schur complement is factorized by dense linear algebra already
+      return false;
+   }
+   return aug_system_solver_->IncreaseQuality();
+}
+
+} // namespace Ipopt
@@ -0,0 +1,280 @@
+// Copyright (C) 2021 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IP_SCHURAUGSYSTEMSOLVER_HPP__
+#define __IP_SCHURAUGSYSTEMSOLVER_HPP__
+
+#include "IpAugSystemSolver.hpp"
+
+#include <vector>
+
+namespace Ipopt
+{
+
+/** Solver for the augmented system that eliminates the primal
+ *  variables and factorizes the dense Schur complement of the
+ *  constraints.
+ *
+ *  If the Hessian W is diagonal (a DiagMatrix, or a SymTMatrix with
+ *  only diagonal entries) or a diagonal plus a low-rank update (a
+ *  LowRankUpdateSymMatrix, as for the limited-memory quasi-Newton
+ *  approximations), the (1,1) block of the augmented system
+ *  \f[\left[\begin{array}{cccc}
+ *  W + D_x + \delta_xI & 0 & J_c^T & J_d^T\\
+ *  0 & D_s + \delta_sI & 0 & -I\\
+ *  J_c & 0 & -D_c-\delta_cI & 0\\
+ *  J_d & -I & 0 & -D_d-\delta_dI
+ *  \end{array}\right]\f]
+ *  is a diagonal matrix \f$\tilde D\f$ plus \f$VV^T - UU^T\f$.  The
+ *  columns of V and U are treated as additional constraint rows with
+ *  diagonal \f$-I\f$ and \f$I\f$, respectively, so that the primal
+ *  variables can be eliminated with the diagonal \f$\tilde D\f$ only.
+ *  The resulting Schur complement
+ *  \f$M = B\tilde D^{-1}B^T + E\f$ has the dimension of the number of
+ *  constraints plus the rank of the update.  It is computed with
+ *  BLAS-3 operations from blocks of the transposed Jacobian and
+ *  factorized by a dense Cholesky factorization, or by an eigenvalue
+ *  decomposition if M is not positive definite.  The inertia of the
+ *  augmented system is obtained from the signs of \f$\tilde D\f$ and
+ *  the eigenvalues of M.
+ *
+ *  For problems with many variables and few constraints, this is much
+ *  cheaper than the factorization of the augmented system.  If the
+ *  Hessian does not have this structure, the Schur complement would
+ *  be larger than schur_complement_max_dim, or a diagonal entry of
+ *  \f$\tilde D\f$ is zero, the system is passed on to the given
+ *  augmented system solver.
+ *
+ *  @since 3.14.5
+ */
+class SchurAugSystemSolver: public AugSystemSolver
+{
+public:
+   /**@name Constructors / Destructors */
+   ///@{
+   /** Constructor using the augmented system solver for the matrices that are not handled here */
+   SchurAugSystemSolver(
+      AugSystemSolver& aug_system_solver
+   );
+
+   /** Destructor */
+   virtual ~SchurAugSystemSolver();
+   ///@}
+
+   /** overloaded from AlgorithmStrategyObject */
+   bool InitializeImpl(
+      const OptionsList& options,
+      const std::string& prefix
+   );
+
+   /** Set up the augmented system and solve it for a given right hand side. */
+   virtual ESymSolverStatus Solve(
+      const SymMatrix* W,
+      Number           W_factor,
+      const Vector*    D_x,
+      Number           delta_x,
+      const Vector*    D_s,
+      Number           delta_s,
+      const Matrix*    J_c,
+      const Vector*    D_c,
+      Number           delta_c,
+      const Matrix*    J_d,
+      const Vector*    D_d,
+      Number           delta_d,
+      const Vector&    rhs_x,
+      const Vector&    rhs_s,
+      const Vector&    rhs_c,
+      const Vector&    rhs_d,
+      Vector&          sol_x,
+      Vector&          sol_s,
+      Vector&          sol_c,
+      Vector&          sol_d,
+      bool             check_NegEVals,
+      Index            numberOfNegEVals
+   );
+
+   /** Number of negative eigenvalues detected during last solve. */
+   virtual Index NumberOfNegEVals() const;
+
+   /** Query whether inertia is computed by linear solver. */
+   virtual bool ProvidesInertia() const;
+
+   /** Request to increase quality of solution for next solve. */
+   virtual bool IncreaseQuality();
+
+   /** Methods for IpoptType */
+   ///@{
+   static void RegisterOptions(
+      SmartPtr<RegisteredOptions> roptions
+   );
+   ///@}
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    *
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called.
+    */
+   ///@{
+   /** Default constructor. */
+   SchurAugSystemSolver();
+
+   /** Copy Constructor */
+   SchurAugSystemSolver(
+      const SchurAugSystemSolver&
+   );
+
+   void operator=(
+      const SchurAugSystemSolver&
+   );
+   ///@}
+
+   /** The augmented system solver for the matrices that are not handled by the Schur complement */
+   SmartPtr<AugSystemSolver> aug_system_solver_;
+
+   /** Maximal dimension of the Schur complement */
+   Index max_dim_;
+
+   /** Whether the most recent matrix has been handled by the Schur complement */
+   bool use_schur_;
+
+   /** Whether the factorization of the Schur complement is valid for the matrix given by the tags */
+   bool have_factorization_;
+
+   /**@name Tags and values to track in order to decide whether the
+    *  matrix has to be updated compared to the most recent call of
+    *  the Solve method. A tag is 0 if the object has been given as NULL.
+    */
+   ///@{
+   TaggedObject::Tag w_tag_;
+   Number w_factor_;
+   TaggedObject::Tag d_x_tag_;
+   Number delta_x_;
+   TaggedObject::Tag d_s_tag_;
+   Number delta_s_;
+   TaggedObject::Tag j_c_tag_;
+   TaggedObject::Tag d_c_tag_;
+   Number delta_c_;
+   TaggedObject::Tag j_d_tag_;
+   TaggedObject::Tag d_d_tag_;
+   Number delta_d_;
+   ///@}
+
+   /** @name Dimensions */
+   ///@{
+   Index n_x_;
+   Index n_s_;
+   Index m_c_;
+   Index m_d_;
+   /** Number of columns of V */
+   Index k_v_;
+   /** Number of columns of U */
+   Index k_u_;
+   ///@}
+
+   /** @name Transposed Jacobian [J_c; J_d] in CSR format, for the assembly of the Schur complement */
+   ///@{
+   Index nnz_c_;
+   Index nnz_d_;
+   std::vector<Index> jt_ptr_;
+   /** Constraint (row of M) of every entry */
+   std::vector<Index> jt_row_;
+   /** Position in j_vals_ of every entry */
+   std::vector<Index> jt_src_;
+   /** Values of J_c and J_d in triplet format */
+   std::vector<Number> j_vals_;
+   ///@}
+
+   /** @name Elimination of the primal variables */
+   ///@{
+   /** Inverse of the diagonal \f$\tilde D\f$ for x */
+   std::vector<Number> dx_inv_;
+   /** Inverse of the diagonal \f$\tilde D\f$ for s */
+   std::vector<Number> ds_inv_;
+   /** Columns of V and U in the x space (column-major, n_x_ rows) */
+   std::vector<Number> z_;
+   ///@}
+
+   /** @name Factorization of the Schur complement */
+   ///@{
+   /** Dimension of M */
+   Index dim_;
+   /** Cholesky factor (lower triangle) or eigenvectors of M, column-major */
+   std::vector<Number> schur_;
+   /** Eigenvalues of M if no Cholesky factorization could be computed */
+   std::vector<Number> eigvals_;
+   /** Whether schur_ holds a Cholesky factor */
+   bool cholesky_;
+   ///@}
+
+   /** Number of negative eigenvalues of the most recent matrix */
+   Index num_neg_evals_;
+
+   /** @name Internal functions */
+   ///@{
+   /** Get the diagonal and the low-rank update from W.
+    *
+    *  Fills dx_inv_ with the diagonal of W_factor*W and z_ with the
+    *  columns of V and U.
+    *
+    *  @return false, if W does not have a supported structure
+    */
+   bool ExtractHessian(
+      const SymMatrix* W,
+      Number           W_factor,
+      const Vector&    proto_x
+   );
+
+   /** Set up the structure of the transposed Jacobian */
+   void InitializeJacobianStructure(
+      const Matrix& J_c,
+      const Matrix& J_d
+   );
+
+   /** Compute and factorize the Schur complement */
+   ESymSolverStatus UpdateFactorization(
+      const Matrix& J_c,
+      const Vector* D_c,
+      Number        delta_c,
+      const Matrix& J_d,
+      const Vector* D_d,
+      Number        delta_d,
+      bool          check_NegEVals,
+      Index         numberOfNegEVals
+   );
+
+   /** Solve with the factorization of the Schur complement */
+   void SolveSchur(
+      Number* rhs
+   ) const;
+
+   /** Method that compares the tags of the data for the matrix with
+    *  those from the previous call.
+    *
+    *  @return true, if there was a change and the factorization has to be updated
+    */
+   bool AugmentedSystemRequiresChange(
+      const SymMatrix* W,
+      Number           W_factor,
+      const Vector*    D_x,
+      Number           delta_x,
+      const Vector*    D_s,
+      Number           delta_s,
+      const Matrix&    J_c,
+      const Vector*    D_c,
+      Number           delta_c,
+      const Matrix&    J_d,
+      const Vector*    D_d,
+      Number           delta_d
+   );
+   ///@}
+};
+
+} // namespace Ipopt
+
+#endif
@@ -116,6 +116,116 @@ void TimingStatistics::DisableTimes()
    h_eval_time_.Disable();
 }
 
+TimedTask TimingStatistics::* const TimingStatistics::timed_tasks_[] =
+{
+   &TimingStatistics::OverallAlgorithm_,
+   &TimingStatistics::PrintProblemStatistics_,
+   &TimingStatistics::InitializeIterates_,
+   &TimingStatistics::UpdateHessian_,
+   &TimingStatistics::OutputIteration_,
+   &TimingStatistics::UpdateBarrierParameter_,
+   &TimingStatistics::ComputeSearchDirection_,
+   &TimingStatistics::ComputeAcceptableTrialPoint_,
+   &TimingStatistics::AcceptTrialPoint_,
+   &TimingStatistics::CheckConvergence_,
+   &TimingStatistics::PDSystemSolverTotal_,
+   &TimingStatistics::PDSystemSolverSolveOnce_,
+   &TimingStatistics::ComputeResiduals_,
+   &TimingStatistics::StdAugSystemSolverMultiSolve_,
+   &TimingStatistics::LinearSystemScaling_,
+   &TimingStatistics::LinearSystemSymbolicFactorization_,
+   &TimingStatistics::LinearSystemFactorization_,
+   &TimingStatistics::LinearSystemBackSolve_,
+   &TimingStatistics::LinearSystemStructureConverter_,
+   &TimingStatistics::LinearSystemStructureConverterInit_,
+   &TimingStatistics::QualityFunctionSearch_,
+   &TimingStatistics::TryCorrector_,
+   &TimingStatistics::Task1_,
+   &TimingStatistics::Task2_,
+   &TimingStatistics::Task3_,
+   &TimingStatistics::Task4_,
+   &TimingStatistics::Task5_,
+   &TimingStatistics::Task6_,
+   &TimingStatistics::f_eval_time_,
+   &TimingStatistics::grad_f_eval_time_,
+   &TimingStatistics::c_eval_time_,
+   &TimingStatistics::jac_c_eval_time_,
+   &TimingStatistics::d_eval_time_,
+   &TimingStatistics::jac_d_eval_time_,
+   &TimingStatistics::h_eval_time_
+};
+
+const char* const TimingStatistics::timed_task_names_[] =
+{
+   "OverallAlgorithm",
+   "PrintProblemStatistics",
+   "InitializeIterates",
+   "UpdateHessian",
+   "OutputIteration",
+   "UpdateBarrierParameter",
+   "ComputeSearchDirection",
+   "ComputeAcceptableTrialPoint",
+   "AcceptTrialPoint",
+   "CheckConvergence",
+   "PDSystemSolverTotal",
+   "PDSystemSolverSolveOnce",
+   "ComputeResiduals",
+   "StdAugSystemSolverMultiSolve",
+   "LinearSystemScaling",
+   "LinearSystemSymbolicFactorization",
+   "LinearSystemFactorization",
+   "LinearSystemBackSolve",
+   "LinearSystemStructureConverter",
+   "LinearSystemStructureConverterInit",
+   "QualityFunctionSearch",
+   "TryCorrector",
+   "Task1",
+   "Task2",
+   "Task3",
+   "Task4",
+   "Task5",
+   "Task6",
+   "f_eval_time",
+   "grad_f_eval_time",
+   "c_eval_time",
+   "jac_c_eval_time",
+   "d_eval_time",
+   "jac_d_eval_time",
+   "h_eval_time"
+};
+
+Index TimingStatistics::NumTimedTasks()
+{
+   return (Index) (sizeof(timed_tasks_) / sizeof(timed_tasks_[0]));
+}
+
+const char* TimingStatistics::TimedTaskName(
+   Index i
+)
+{
+   DBG_ASSERT(i >= 0 && i < NumTimedTasks());
+   return timed_task_names_[i];
+}
+
+const TimedTask& TimingStatistics::GetTimedTask(
+   Index i
+) const
+{
+   DBG_ASSERT(i >= 0 && i < NumTimedTasks());
+   return this->*timed_tasks_[i];
+}
+
+TimingStatistics::TimingStatistics()
+   : symbolic_cache_hits_(0),
+     symbolic_cache_misses_(0),
+     symbolic_cache_saved_time_(0.)
+{
+   for( Index i = 0; i < NumTimedTasks(); i++ )
+   {
+      (this->*timed_tasks_[i]).SetProfiler(&profiler_, timed_task_names_[i]);
+   }
+}
+
 void TimingStatistics::ResetTimes()
 {
    OverallAlgorithm_.Reset();
@@ -153,6 +263,10 @@ void TimingStatistics::ResetTimes()
    jac_c_eval_time_.Reset();
    jac_d_eval_time_.Reset();
    h_eval_time_.Reset();
+   symbolic_cache_hits_ = 0;
+   symbolic_cache_misses_ = 0;
+   symbolic_cache_saved_time_ = 0.;
+   profiler_.Reset();
 }
 
 void TimingStatistics::PrintAllTimingStatistics(
@@ -223,6 +337,9 @@ void TimingStatistics::PrintAllTimingStatistics(
    if( LinearSystemSymbolicFactorization_.IsEnabled() )
       jnlst.Printf(level, category,
                    " LinearSystemSymbolicFactorization..: %10.3f (sys: %10.3f wall: %10.3f)\n", LinearSystemSymbolicFactorization_.TotalCpuTime(), LinearSystemSymbolicFactorization_.TotalSysTime(), LinearSystemSymbolicFactorization_.TotalWallclockTime());
+   if( symbolic_cache_hits_ + symbolic_cache_misses_ > 0 )
+      jnlst.Printf(level, category,
+                   "  SymbolicFactorizationCache........: %10" IPOPT_INDEX_FORMAT " hits, %" IPOPT_INDEX_FORMAT " misses, %.3f wallclock seconds saved\n", symbolic_cache_hits_, symbolic_cache_misses_, symbolic_cache_saved_time_);
    if( LinearSystemFactorization_.IsEnabled() )
       jnlst.Printf(level, category,
                    " LinearSystemFactorization..........: %10.3f (sys: %10.3f wall: %10.3f)\n", LinearSystemFactorization_.TotalCpuTime(), LinearSystemFactorization_.TotalSysTime(), LinearSystemFactorization_.TotalWallclockTime());
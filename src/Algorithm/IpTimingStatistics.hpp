@@ -21,8 +21,7 @@ public:
    /**@name Constructors/Destructors */
    ///@{
    /** Default constructor. */
-   TimingStatistics()
-   { }
+   TimingStatistics();
 
    /** Destructor */
    virtual ~TimingStatistics()
@@ -42,9 +41,79 @@ public:
    /// @since 3.14.0
    Number TotalFunctionEvaluationWallclockTime() const;
 
-   /** Method for resetting all times. */
+   /** Method for resetting all times.
+    *
+    *  Also removes all data recorded by the profiler.
+    */
    void ResetTimes();
 
+   /** Profiler that records the nesting of the timed tasks.
+    *
+    *  The profiler is disabled by default.  When it is enabled, every
+    *  enabled timed task opens a scope with its name in the profiler
+    *  while it is started.
+    *  @since 3.14.5
+    */
+   Profiler& GetProfiler()
+   {
+      return profiler_;
+   }
+
+   /// @since 3.14.5
+   const Profiler& GetProfiler() const
+   {
+      return profiler_;
+   }
+
+   /**@name Statistics of the symbolic factorization cache.
+    *
+    *  Linear solvers that use the SymbolicFactorizationCache record here
+    *  whether a symbolic factorization could be taken from the cache.
+    *  These counters are reset by ResetTimes.
+    */
+   ///@{
+   /** Record that a symbolic factorization was taken from the cache,
+    *  saving the given wallclock time.
+    *  @since 3.14.5
+    */
+   void AddSymbolicFactorizationCacheHit(
+      Number saved_time
+   )
+   {
+      symbolic_cache_hits_++;
+      symbolic_cache_saved_time_ += saved_time;
+   }
+
+   /** Record that a symbolic factorization was not found in the cache.
+    *  @since 3.14.5
+    */
+   void AddSymbolicFactorizationCacheMiss()
+   {
+      symbolic_cache_misses_++;
+   }
+
+   /// number of symbolic factorizations that were taken from the cache
+   /// @since 3.14.5
+   Index SymbolicFactorizationCacheHits() const
+   {
+      return symbolic_cache_hits_;
+   }
+
+   /// number of symbolic factorizations that were not found in the cache
+   /// @since 3.14.5
+   Index SymbolicFactorizationCacheMisses() const
+   {
+      return symbolic_cache_misses_;
+   }
+
+   /// wallclock time that the symbolic factorizations taken from the cache took when they were computed
+   /// @since 3.14.5
+   Number SymbolicFactorizationCacheSavedTime() const
+   {
+      return symbolic_cache_saved_time_;
+   }
+   ///@}
+
    /** Method for enabling all timed tasked.
     * @since 3.14.0
     */
@@ -62,6 +131,29 @@ public:
       EJournalCategory  category
    ) const;
 
+   /**@name Enumeration of all timed tasks.
+    *
+    *  Allows to loop over all timed tasks, e.g., to record their times
+    *  in every iteration.
+    */
+   ///@{
+   /// number of timed tasks
+   /// @since 3.14.5
+   static Index NumTimedTasks();
+
+   /// name of the i-th timed task, 0 <= i < NumTimedTasks()
+   /// @since 3.14.5
+   static const char* TimedTaskName(
+      Index i
+   );
+
+   /// i-th timed task, 0 <= i < NumTimedTasks()
+   /// @since 3.14.5
+   const TimedTask& GetTimedTask(
+      Index i
+   ) const;
+   ///@}
+
    /**@name Accessor methods to all timed tasks. */
    ///@{
    TimedTask& OverallAlgorithm()
@@ -316,6 +408,22 @@ private:
    TimedTask jac_d_eval_time_;
    TimedTask h_eval_time_;
    ///@}
+
+   /** All timed tasks, in the order of the enumeration */
+   static TimedTask TimingStatistics::* const timed_tasks_[];
+
+   /** Names of all timed tasks, in the order of the enumeration */
+   static const char* const timed_task_names_[];
+
+   /** Profiler in which the timed tasks open their scopes */
+   Profiler profiler_;
+
+   /**@name Statistics of the symbolic factorization cache */
+   ///@{
+   Index symbolic_cache_hits_;
+   Index symbolic_cache_misses_;
+   Number symbolic_cache_saved_time_;
+   ///@}
 };
 
 } // namespace Ipopt
@@ -0,0 +1,376 @@
+// Copyright (C) 2021 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpoptConfig.h"
+#include "IpIncompleteLdl.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+namespace Ipopt
+{
+#if IPOPT_VERBOSITY > 0
+static const Index dbg_verbosity = 0;
+#endif
+
+namespace
+{
+/** order candidate entries of a column by decreasing magnitude */
+class LargerMagnitude
+{
+public:
+   LargerMagnitude(
+      const std::vector<Number>& w
+   )
+      : w_(w)
+   { }
+
+   bool operator()(
+      Index i,
+      Index j
+   ) const
+   {
+      return std::abs(w_[i]) > std::abs(w_[j]);
+   }
+
+private:
+   const std::vector<Number>& w_;
+};
+}
+
+IncompleteLdlPreconditioner::IncompleteLdlPreconditioner(
+   Number droptol,
+   Number fill_factor,
+   Number pivtol,
+   bool   scaling,
+   Index  pattern_reuse
+)
+   : droptol_(droptol),
+     fill_factor_(fill_factor),
+     pivtol_(pivtol),
+     scaling_(scaling),
+     pattern_reuse_(pattern_reuse),
+     dim_(0),
+     have_pattern_(false),
+     new_pattern_(false),
+     refactorizations_(0),
+     pattern_perturbed_pivots_(0),
+     perturbed_pivots_(0),
+     negevals_(0)
+{ }
+
+IncompleteLdlPreconditioner::~IncompleteLdlPreconditioner()
+{ }
+
+void IncompleteLdlPreconditioner::InitializeStructure(
+   Index        dim,
+   const Index* ia,
+   const Index* ja
+)
+{
+   DBG_START_METH("IncompleteLdlPreconditioner::InitializeStructure", dbg_verbosity);
+
+   dim_ = dim;
+   ia_.assign(ia, ia + dim + 1);
+   ja_.assign(ja, ja + ia[dim]);
+   have_pattern_ = false;
+   L_ptr_.clear();
+   L_row_.clear();
+   L_val_.clear();
+   D_.clear();
+}
+
+void IncompleteLdlPreconditioner::ComputeScaling(
+   const Number* values
+)
+{
+   scale_.assign(dim_, 1.);
+   rowmax_.assign(dim_, 0.);
+   // a few sweeps of symmetric infinity-norm equilibration (Ruiz)
+   const Index sweeps = scaling_ ? 3 : 0;
+   for( Index sweep = 0; sweep <= sweeps; sweep++ )
+   {
+      std::fill(rowmax_.begin(), rowmax_.end(), 0.);
+      for( Index i = 0; i < dim_; i++ )
+      {
+         for( Index p = ia_[i]; p < ia_[i + 1]; p++ )
+         {
+            const Index j = ja_[p];
+            const Number v = std::abs(values[p] * scale_[i] * scale_[j]);
+            rowmax_[i] = Max(rowmax_[i], v);
+            rowmax_[j] = Max(rowmax_[j], v);
+         }
+      }
+      if( sweep == sweeps )
+      {
+         break;
+      }
+      for( Index i = 0; i < dim_; i++ )
+      {
+         if( rowmax_[i] > 0. )
+         {
+            scale_[i] /= std::sqrt(rowmax_[i]);
+         }
+      }
+   }
+}
+
+ESymSolverStatus IncompleteLdlPreconditioner::Factorize(
+   const Number* values
+)
+{
+   DBG_START_METH("IncompleteLdlPreconditioner::Factorize", dbg_verbosity);
+
+   ComputeScaling(values);
+
+   new_pattern_ = !have_pattern_ || refactorizations_ >= pattern_reuse_;
+   FactorColumns(values, new_pattern_);
+   if( !new_pattern_ && perturbed_pivots_ > pattern_perturbed_pivots_ )
+   {
+      // the pattern does not fit the values anymore
+      new_pattern_ = true;
+      FactorColumns(values, true);
+   }
+
+   if( new_pattern_ )
+   {
+      have_pattern_ = true;
+      refactorizations_ = 0;
+      pattern_perturbed_pivots_ = perturbed_pivots_;
+   }
+   else
+   {
+      refactorizations_++;
+   }
+
+   for( Index k = 0; k < dim_; k++ )
+   {
+      if( !IsFiniteNumber(D_[k]) )
+      {
+         have_pattern_ = false;
+         return SYMSOLVER_SINGULAR;
+      }
+   }
+   return SYMSOLVER_SUCCESS;
+}
+
+void IncompleteLdlPreconditioner::FactorColumns(
+   const Number* values,
+   bool          new_pattern
+)
+{
+   DBG_START_METH("IncompleteLdlPreconditioner::FactorColumns", dbg_verbosity);
+
+   // maximal number of entries in a column of L
+   const Number avg_nnz = dim_ > 0 ? (Number) ia_[dim_] / (Number) dim_ : 0.;
+   const Index lfil = (Index) Min((Number) dim_, std::ceil(fill_factor_ * avg_nnz));
+
+   if( new_pattern )
+   {
+      L_ptr_.assign(1, 0);
+      L_row_.clear();
+      L_val_.clear();
+   }
+   D_.resize(dim_);
+
+   // w holds the current column; marker[i] == k if row i is in the pattern of column k
+   std::vector<Number> w(dim_, 0.);
+   std::vector<Index> marker(dim_, -1);
+   std::vector<Index> rows;
+   rows.reserve(dim_);
+
+   // Columns j < k that have an entry in row k are found through
+   // linked lists: every column is in the list of the row of its
+   // first entry that has not yet been used for an update.
+   std::vector<Index> row_head(dim_, -1);
+   std::vector<Index> col_link(dim_, -1);
+   std::vector<Index> next_pos(dim_, 0);
+
+   perturbed_pivots_ = 0;
+   negevals_ = 0;
+
+   for( Index k = 0; k < dim_; k++ )
+   {
+      rows.clear();
+      marker[k] = k;
+      w[k] = 0.;
+      if( !new_pattern )
+      {
+         for( Index q = L_ptr_[k]; q < L_ptr_[k + 1]; q++ )
+         {
+            const Index i = L_row_[q];
+            marker[i] = k;
+            w[i] = 0.;
+            rows.push_back(i);
+         }
+      }
+
+      // scatter column k of the lower triangle, which is row k of the upper triangle
+      for( Index p = ia_[k]; p < ia_[k + 1]; p++ )
+      {
+         const Index i = ja_[p];
+         if( marker[i] != k )
+         {
+            if( !new_pattern )
+            {
+               continue;
+            }
+            marker[i] = k;
+            w[i] = 0.;
+            rows.push_back(i);
+         }
+         w[i] += values[p] * scale_[k] * scale_[i];
+      }
+
+      // updates from the columns j < k with L(k,j) != 0
+      Index j = row_head[k];
+      while( j >= 0 )
+      {
+         const Index next_j = col_link[j];
+         const Index p = next_pos[j];
+         DBG_ASSERT(L_row_[p] == k);
+         const Number f = L_val_[p] * D_[j];
+         w[k] -= f * L_val_[p];
+         for( Index q = p + 1; q < L_ptr_[j + 1]; q++ )
+         {
+            const Index i = L_row_[q];
+            if( marker[i] != k )
+            {
+               if( !new_pattern )
+               {
+                  continue;
+               }
+               marker[i] = k;
+               w[i] = 0.;
+               rows.push_back(i);
+            }
+            w[i] -= f * L_val_[q];
+         }
+         next_pos[j] = p + 1;
+         if( p + 1 < L_ptr_[j + 1] )
+         {
+            const Index r = L_row_[p + 1];
+            col_link[j] = row_head[r];
+            row_head[r] = j;
+         }
+         j = next_j;
+      }
+      row_head[k] = -1;
+
+      // pivot, perturbed if it is tiny
+      Number d = w[k];
+      const Number threshold = pivtol_ * (rowmax_[k] > 0. ? rowmax_[k] : 1.);
+      if( !(std::abs(d) >= threshold) )
+      {
+         d = (d < 0.) ? -threshold : threshold;
+         perturbed_pivots_++;
+      }
+      if( d < 0. )
+      {
+         negevals_++;
+      }
+      D_[k] = d;
+
+      if( new_pattern )
+      {
+         // drop small entries and keep only the lfil largest ones
+         const Number droptol = droptol_ * rowmax_[k];
+         Index nkeep = 0;
+         for( size_t r = 0; r < rows.size(); r++ )
+         {
+            if( droptol_ == 0. || std::abs(w[rows[r]]) > droptol )
+            {
+               rows[nkeep++] = rows[r];
+            }
+         }
+         rows.resize(nkeep);
+         if( nkeep > lfil )
+         {
+            std::nth_element(rows.begin(), rows.begin() + lfil, rows.end(), LargerMagnitude(w));
+            rows.resize(lfil);
+         }
+         std::sort(rows.begin(), rows.end());
+         for( size_t r = 0; r < rows.size(); r++ )
+         {
+            L_row_.push_back(rows[r]);
+            L_val_.push_back(w[rows[r]] / d);
+         }
+         L_ptr_.push_back((Index) L_row_.size());
+      }
+      else
+      {
+         for( Index q = L_ptr_[k]; q < L_ptr_[k + 1]; q++ )
+         {
+            L_val_[q] = w[L_row_[q]] / d;
+         }
+      }
+
+      // put column k into the list of the row of its first entry
+      next_pos[k] = L_ptr_[k];
+      if( L_ptr_[k] < L_ptr_[k + 1] )
+      {
+         const Index r = L_row_[L_ptr_[k]];
+         col_link[k] = row_head[r];
+         row_head[r] = k;
+      }
+   }
+}
+
+void IncompleteLdlPreconditioner::Apply(
+   const Number* r,
+   Number*       z
+) const
+{
+   for( Index i = 0; i < dim_; i++ )
+   {
+      z[i] = scale_[i] * r[i];
+   }
+
+   // z = L^{-1} z
+   for( Index k = 0; k < dim_; k++ )
+   {
+      const Number zk = z[k];
+      if( zk != 0. )
+      {
+         for( Index q = L_ptr_[k]; q < L_ptr_[k + 1]; q++ )
+         {
+            z[L_row_[q]] -= L_val_[q] * zk;
+         }
+      }
+   }
+
+   // z = D^{-1} z
+   if( PositiveDefinite() )
+   {
+      for( Index k = 0; k < dim_; k++ )
+      {
+         z[k] /= std::abs(D_[k]);
+      }
+   }
+   else
+   {
+      for( Index k = 0; k < dim_; k++ )
+      {
+         z[k] /= D_[k];
+      }
+   }
+
+   // z = L^{-T} z
+   for( Index k = dim_ - 1; k >= 0; k-- )
+   {
+      Number zk = z[k];
+      for( Index q = L_ptr_[k]; q < L_ptr_[k + 1]; q++ )
+      {
+         zk -= L_val_[q] * z[L_row_[q]];
+      }
+      z[k] = zk;
+   }
+
+   for( Index i = 0; i < dim_; i++ )
+   {
+      z[i] *= scale_[i];
+   }
+}
+
+} // namespace Ipopt
@@ -0,0 +1,187 @@
+// Copyright (C) 2021 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPINCOMPLETELDL_HPP__
+#define __IPINCOMPLETELDL_HPP__
+
+#include "IpSymPreconditioner.hpp"
+
+#include <vector>
+
+namespace Ipopt
+{
+
+/** Incomplete LDL^T factorization of a sparse symmetric indefinite
+ *  matrix with threshold dropping and fill control, to be used as
+ *  preconditioner.
+ *
+ *  The factor is computed column by column in the natural order
+ *  (Crout form, with linked lists to find the columns that update a
+ *  column).  For an augmented system with the primal variables first,
+ *  the pivots of the constraint rows are then taken from the
+ *  (incomplete) Schur complement, so that 1x1 pivots suffice.  In
+ *  column k, an entry is dropped if its magnitude is below droptol
+ *  times the largest entry of row k of the matrix, and only the
+ *  largest fill_factor * nnz(A)/dim entries are kept.  Pivots that
+ *  are tiny relative to the largest entry of their row are perturbed
+ *  away from zero.  The matrix is equilibrated symmetrically before
+ *  the factorization if requested.
+ *
+ *  The sparsity pattern of the factor depends on the values.  When
+ *  only the values change, Factorize recomputes the factor on the
+ *  pattern of the previous factorization, which needs no selection or
+ *  sorting of entries, for up to pattern_reuse times, and computes a
+ *  new pattern afterwards or if more pivots had to be perturbed than
+ *  for the original pattern.
+ *
+ *  With droptol = 0 and a fill_factor of at least dim, the complete
+ *  LDL^T factorization is computed.
+ *
+ *  If the preconditioner has to be positive definite, |D| is used
+ *  instead of D in Apply.
+ *
+ *  @since 3.14.5
+ */
+class IncompleteLdlPreconditioner: public SymPreconditioner
+{
+public:
+   /** @name Constructor/Destructor */
+   ///@{
+   IncompleteLdlPreconditioner(
+      Number droptol,
+      Number fill_factor,
+      Number pivtol,
+      bool   scaling,
+      Index  pattern_reuse
+   );
+
+   virtual ~IncompleteLdlPreconditioner();
+   ///@}
+
+   virtual void InitializeStructure(
+      Index        dim,
+      const Index* ia,
+      const Index* ja
+   );
+
+   virtual ESymSolverStatus Factorize(
+      const Number* values
+   );
+
+   virtual void Apply(
+      const Number* r,
+      Number*       z
+   ) const;
+
+   /** Let the next Factorize compute a new pattern of the factor */
+   void ResetPattern()
+   {
+      have_pattern_ = false;
+   }
+
+   /** @name Information about the most recent factorization */
+   ///@{
+   /** Number of entries of L (without the unit diagonal) */
+   Index FactorNonzeros() const
+   {
+      return (Index) L_row_.size();
+   }
+
+   /** Number of perturbed pivots */
+   Index NumberOfPerturbedPivots() const
+   {
+      return perturbed_pivots_;
+   }
+
+   /** Number of negative entries of D */
+   Index NumberOfNegEVals() const
+   {
+      return negevals_;
+   }
+
+   /** Whether the pattern of the factor has been recomputed */
+   bool NewPattern() const
+   {
+      return new_pattern_;
+   }
+   ///@}
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called. */
+   ///@{
+   /** Default Constructor */
+   IncompleteLdlPreconditioner();
+
+   /** Copy Constructor */
+   IncompleteLdlPreconditioner(
+      const IncompleteLdlPreconditioner&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const IncompleteLdlPreconditioner&
+   );
+   ///@}
+
+   /** Compute symmetric equilibration factors and the largest scaled entry of every row */
+   void ComputeScaling(
+      const Number* values
+   );
+
+   /** Compute the factor, either with a new pattern or on the pattern of the current factor */
+   void FactorColumns(
+      const Number* values,
+      bool          new_pattern
+   );
+
+   /** @name Parameters */
+   ///@{
+   Number droptol_;
+   Number fill_factor_;
+   Number pivtol_;
+   bool scaling_;
+   Index pattern_reuse_;
+   ///@}
+
+   /** @name Structure of the matrix */
+   ///@{
+   Index dim_;
+   std::vector<Index> ia_;
+   std::vector<Index> ja_;
+   ///@}
+
+   /** Scaling factors */
+   std::vector<Number> scale_;
+   /** Largest scaled entry of every row */
+   std::vector<Number> rowmax_;
+
+   /** @name Factor L (unit lower triangular, without the diagonal) in compressed sparse column format */
+   ///@{
+   std::vector<Index> L_ptr_;
+   std::vector<Index> L_row_;
+   std::vector<Number> L_val_;
+   ///@}
+   /** Diagonal D */
+   std::vector<Number> D_;
+
+   /** @name Information about the pattern and the most recent factorization */
+   ///@{
+   bool have_pattern_;
+   bool new_pattern_;
+   Index refactorizations_;
+   Index pattern_perturbed_pivots_;
+   Index perturbed_pivots_;
+   Index negevals_;
+   ///@}
+};
+
+} // namespace Ipopt
+
+#endif
@@ -0,0 +1,396 @@
+// Copyright (C) 2021 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpoptConfig.h"
+#include "IpLdlSolverInterface.hpp"
+#include "IpSymbolicFactorizationCache.hpp"
+
+#include <cmath>
+
+namespace Ipopt
+{
+#if IPOPT_VERBOSITY > 0
+static const Index dbg_verbosity = 0;
+#endif
+
+/** Analysis of the built-in LDL^T solver as stored in the SymbolicFactorizationCache */
+class LdlSymbolicData: public SymbolicFactorizationData
+{
+public:
+   SmartPtr<MultifrontalLdl> ldl;
+
+   SymbolicFactorizationData* Clone() const
+   {
+      LdlSymbolicData* copy = new LdlSymbolicData();
+      copy->ldl = new MultifrontalLdl();
+      copy->ldl->CopyAnalysis(*ldl);
+      return copy;
+   }
+};
+
+LdlSolverInterface::LdlSolverInterface()
+   : dim_(0),
+     nonzeros_(0),
+     a_(NULL),
+     negevals_(-1),
+     initialized_(false),
+     pivtol_changed_(false),
+     pivtol_(1e-8),
+     pivtolmax_(1e-4),
+     nemin_(16),
+     scaling_(true),
+     single_precision_(false),
+     num_threads_(1),
+     symbolic_cache_size_(0),
+     warm_start_same_structure_(false)
+{
+   DBG_START_METH("LdlSolverInterface::LdlSolverInterface()", dbg_verbosity);
+}
+
+LdlSolverInterface::~LdlSolverInterface()
+{
+   DBG_START_METH("LdlSolverInterface::~LdlSolverInterface()", dbg_verbosity);
+   delete[] a_;
+}
+
+void LdlSolverInterface::RegisterOptions(
+   SmartPtr<RegisteredOptions> roptions
+)
+{
+   roptions->AddBoundedNumberOption(
+      "ldl_pivtol",
+      "Pivot tolerance for the built-in LDL^T solver.",
+      0.0, true,
+      0.5, false,
+      1e-8,
+      "A smaller number pivots for sparsity, a larger number pivots for stability.");
+   roptions->AddBoundedNumberOption(
+      "ldl_pivtolmax",
+      "Maximum pivot tolerance for the built-in LDL^T solver.",
+      0.0, true,
+      0.5, false,
+      1e-4,
+      "Ipopt may increase pivtol as high as ldl_pivtolmax to get a more accurate solution to the linear system.");
+   roptions->AddLowerBoundedIntegerOption(
+      "ldl_num_threads",
+      "Number of threads used by the built-in LDL^T solver.",
+      0,
+      1,
+      "Independent fronts of the assembly tree are factorized concurrently. "
+      "If set to 0, the number of hardware threads is used.");
+   roptions->AddLowerBoundedIntegerOption(
+      "ldl_nemin",
+      "Node amalgamation parameter for the built-in LDL^T solver.",
+      1,
+      16,
+      "Two nodes in the assembly tree are merged if both have fewer than this number of pivot columns "
+      "and not too many explicit zeros are introduced.",
+      true);
+   roptions->AddBoolOption(
+      "ldl_scaling",
+      "Whether the built-in LDL^T solver equilibrates the matrix before factorization.",
+      true,
+      "If enabled, the matrix is scaled symmetrically such that all rows have approximately unit infinity-norm.",
+      true);
+   roptions->AddBoolOption(
+      "ldl_single_precision",
+      "Whether the built-in LDL^T solver factorizes the matrix in single precision.",
+      false,
+      "If enabled, the factor is computed and stored in single precision, which halves the memory required for it. "
+      "The accuracy of the solution is recovered by the iterative refinement on the full system, "
+      "for which the residuals are computed in double precision. "
+      "If the iterative refinement stagnates, the solver switches to a factorization in double precision "
+      "for the remainder of the optimization. "
+      "This option has no effect if Ipopt has been built for single precision.");
+}
+
+bool LdlSolverInterface::InitializeImpl(
+   const OptionsList& options,
+   const std::string& prefix
+)
+{
+   options.GetNumericValue("ldl_pivtol", pivtol_, prefix);
+   if( options.GetNumericValue("ldl_pivtolmax", pivtolmax_, prefix) )
+   {
+      ASSERT_EXCEPTION(pivtolmax_ >= pivtol_, OPTION_INVALID, "Option \"ldl_pivtolmax\": This value must be between "
+                       "ldl_pivtol and 0.5.");
+   }
+   else
+   {
+      pivtolmax_ = Max(pivtolmax_, pivtol_);
+   }
+   options.GetIntegerValue("ldl_num_threads", num_threads_, prefix);
+   options.GetIntegerValue("ldl_nemin", nemin_, prefix);
+   options.GetBoolValue("ldl_scaling", scaling_, prefix);
+   options.GetBoolValue("ldl_single_precision", single_precision_, prefix);
+   // The following option is registered by OrigIpoptNLP
+   options.GetBoolValue("warm_start_same_structure", warm_start_same_structure_, prefix);
+   // The following option is registered by TSymLinearSolver
+   options.GetIntegerValue("symbolic_factorization_cache", symbolic_cache_size_, prefix);
+
+   if( num_threads_ == 0 )
+   {
+      num_threads_ = ThreadPool::HardwareConcurrency();
+   }
+   if( num_threads_ > 1 )
+   {
+      if( IsNull(pool_) || pool_->NumThreads() != num_threads_ )
+      {
+         pool_ = new ThreadPool(num_threads_);
+      }
+   }
+   else
+   {
+      pool_ = NULL;
+   }
+
+   // Reset all private data
+   initialized_ = false;
+   pivtol_changed_ = false;
+
+   if( !warm_start_same_structure_ )
+   {
+      dim_ = 0;
+      nonzeros_ = 0;
+      ldl_ = NULL;
+   }
+   else
+   {
+      ASSERT_EXCEPTION(IsValid(ldl_), INVALID_WARMSTART,
+                       "LdlSolverInterface called with warm_start_same_structure, but the problem is solved for the first time.");
+   }
+
+   return true;
+}
+
+ESymSolverStatus LdlSolverInterface::InitializeStructure(
+   Index        dim,
+   Index        nonzeros,
+   const Index* /*ia*/,
+   const Index* /*ja*/
+)
+{
+   DBG_START_METH("LdlSolverInterface::InitializeStructure", dbg_verbosity);
+
+   if( warm_start_same_structure_ )
+   {
+      ASSERT_EXCEPTION(dim_ == dim && nonzeros_ == nonzeros, INVALID_WARMSTART,
+                       "LdlSolverInterface called with warm_start_same_structure, but the problem size has changed.");
+      initialized_ = true;
+      return SYMSOLVER_SUCCESS;
+   }
+
+   dim_ = dim;
+   nonzeros_ = nonzeros;
+
+   delete[] a_;
+   a_ = NULL;
+   a_ = new Number[nonzeros_];
+
+   // The analysis is done with the first matrix, since it uses the
+   // values to choose 2x2 pivots.
+   ldl_ = NULL;
+
+   initialized_ = true;
+
+   return SYMSOLVER_SUCCESS;
+}
+
+Number* LdlSolverInterface::GetValuesArrayPtr()
+{
+   DBG_START_METH("LdlSolverInterface::GetValuesArrayPtr", dbg_verbosity);
+   DBG_ASSERT(initialized_);
+   return a_;
+}
+
+ESymSolverStatus LdlSolverInterface::MultiSolve(
+   bool         new_matrix,
+   const Index* ia,
+   const Index* ja,
+   Index        nrhs,
+   Number*      rhs_vals,
+   bool         check_NegEVals,
+   Index        numberOfNegEVals
+)
+{
+   DBG_START_METH("LdlSolverInterface::MultiSolve", dbg_verbosity);
+   DBG_ASSERT(!check_NegEVals || ProvidesInertia());
+   DBG_ASSERT(initialized_);
+
+   if( IsNull(ldl_) )
+   {
+      SymbolicFactorization(ia, ja);
+   }
+
+   // Since we keep our own copy of the values, a change of the pivot
+   // tolerance or the precision does not require the caller to provide
+   // them again.
+   if( new_matrix || pivtol_changed_ )
+   {
+      pivtol_changed_ = false;
+      ESymSolverStatus retval = Factorization(check_NegEVals, numberOfNegEVals);
+      if( retval != SYMSOLVER_SUCCESS )
+      {
+         DBG_PRINT((1, "FACTORIZATION FAILED!\n"));
+         return retval;
+      }
+   }
+
+   if( HaveIpData() )
+   {
+      IpData().TimingStats().LinearSystemBackSolve().Start();
+   }
+   ldl_->Solve(nrhs, rhs_vals);
+   if( HaveIpData() )
+   {
+      IpData().TimingStats().LinearSystemBackSolve().End();
+   }
+
+   return SYMSOLVER_SUCCESS;
+}
+
+void LdlSolverInterface::SymbolicFactorization(
+   const Index* ia,
+   const Index* ja
+)
+{
+   DBG_START_METH("LdlSolverInterface::SymbolicFactorization", dbg_verbosity);
+
+   if( HaveIpData() )
+   {
+      IpData().TimingStats().LinearSystemSymbolicFactorization().Start();
+   }
+
+   // the analysis depends on the structure and on nemin
+   char key[64];
+   Snprintf(key, 63, "ldl nemin=%" IPOPT_INDEX_FORMAT, nemin_);
+
+   SymbolicFactorizationData* cached = NULL;
+   Number analysis_time = 0.;
+   if( symbolic_cache_size_ > 0 )
+   {
+      cached = SymbolicFactorizationCache::Lookup(key, dim_, dim_ + 1, ia, ia[dim_], ja, analysis_time);
+   }
+
+   if( cached != NULL )
+   {
+      ldl_ = static_cast<LdlSymbolicData*>(cached)->ldl;
+      delete cached;
+      if( HaveIpData() )
+      {
+         IpData().TimingStats().AddSymbolicFactorizationCacheHit(analysis_time);
+      }
+      Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                     "LDL analysis taken from the symbolic factorization cache.\n");
+   }
+   else
+   {
+      const Number start_time = WallclockTime();
+      ldl_ = new MultifrontalLdl();
+      ldl_->Analyze(dim_, ia, ja, a_, nemin_);
+      analysis_time = WallclockTime() - start_time;
+
+      if( symbolic_cache_size_ > 0 )
+      {
+         LdlSymbolicData data;
+         data.ldl = ldl_;
+         SymbolicFactorizationCache::Store(symbolic_cache_size_, key, dim_, dim_ + 1, ia, ia[dim_], ja, data, analysis_time);
+         if( HaveIpData() )
+         {
+            IpData().TimingStats().AddSymbolicFactorizationCacheMiss();
+         }
+      }
+   }
+
+   Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                  "LDL analysis: %" IPOPT_INDEX_FORMAT " fronts, predicted number of entries in L: %g\n",
+                  ldl_->NumberOfFronts(), ldl_->PredictedFactorEntries());
+
+   if( HaveIpData() )
+   {
+      IpData().TimingStats().LinearSystemSymbolicFactorization().End();
+   }
+}
+
+ESymSolverStatus LdlSolverInterface::Factorization(
+   bool  check_NegEVals,
+   Index numberOfNegEVals
+)
+{
+   DBG_START_METH("LdlSolverInterface::Factorization", dbg_verbosity);
+
+   if( HaveIpData() )
+   {
+      IpData().TimingStats().LinearSystemFactorization().Start();
+   }
+
+   ESymSolverStatus retval = ldl_->Factorize(a_, pivtol_, scaling_, GetRawPtr(pool_), single_precision_);
+   negevals_ = ldl_->NumberOfNegEVals();
+
+   if( HaveIpData() )
+   {
+      IpData().TimingStats().LinearSystemFactorization().End();
+   }
+
+   if( retval != SYMSOLVER_SUCCESS )
+   {
+      Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                     "LDL factorization detected a singular matrix.\n");
+      return retval;
+   }
+
+   Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                  "LDL factorization (%s precision): %g entries in L, %" IPOPT_INDEX_FORMAT " 2x2 pivots, %" IPOPT_INDEX_FORMAT " delayed pivots, %" IPOPT_INDEX_FORMAT " negative eigenvalues.\n",
+                  ldl_->SinglePrecision() ? "single" : "double", ldl_->FactorEntries(), ldl_->NumberOf2x2Pivots(),
+                  ldl_->NumberOfDelayedPivots(), negevals_);
+
+   if( check_NegEVals && numberOfNegEVals != negevals_ )
+   {
+      Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                     "In LdlSolverInterface::Factorization: negevals_ = %" IPOPT_INDEX_FORMAT ", but numberOfNegEVals = %" IPOPT_INDEX_FORMAT "\n", negevals_,
+                     numberOfNegEVals);
+      return SYMSOLVER_WRONG_INERTIA;
+   }
+
+   return SYMSOLVER_SUCCESS;
+}
+
+Index LdlSolverInterface::NumberOfNegEVals() const
+{
+   DBG_START_METH("LdlSolverInterface::NumberOfNegEVals", dbg_verbosity);
+   DBG_ASSERT(ProvidesInertia());
+   DBG_ASSERT(initialized_);
+   return negevals_;
+}
+
+bool LdlSolverInterface::IncreaseQuality()
+{
+   DBG_START_METH("LdlSolverInterface::IncreaseQuality", dbg_verbosity);
+   if( single_precision_ && IsValid(ldl_) && ldl_->SinglePrecision() )
+   {
+      // the accuracy of the single precision factor is not sufficient
+      // for the iterative refinement to converge
+      Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                     "Switching LDL factorization from single to double precision.\n");
+      single_precision_ = false;
+      pivtol_changed_ = true;
+      return true;
+   }
+
+   if( pivtol_ == pivtolmax_ )
+   {
+      return false;
+   }
+
+   pivtol_changed_ = true;
+
+   Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                  "Increasing pivot tolerance for LDL from %7.2e ", pivtol_);
+   pivtol_ = Min(pivtolmax_, std::pow(pivtol_, Number(0.75)));
+   Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                  "to %7.2e.\n", pivtol_);
+   return true;
+}
+
+} // namespace Ipopt
@@ -0,0 +1,188 @@
+// Copyright (C) 2021 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPLDLSOLVERINTERFACE_HPP__
+#define __IPLDLSOLVERINTERFACE_HPP__
+
+#include "IpSparseSymLinearSolverInterface.hpp"
+#include "IpMultifrontalLdl.hpp"
+#include "IpThreadPool.hpp"
+
+namespace Ipopt
+{
+
+/** Interface to the built-in multifrontal LDL^T solver (MultifrontalLdl),
+ *  derived from SparseSymLinearSolverInterface.
+ *
+ *  This solver does not require any third-party library and is
+ *  therefore always available.  Independent fronts of the assembly
+ *  tree are factorized in parallel on a ThreadPool.
+ */
+class LdlSolverInterface: public SparseSymLinearSolverInterface
+{
+public:
+   /** @name Constructor/Destructor */
+   ///@{
+   /** Constructor */
+   LdlSolverInterface();
+
+   /** Destructor */
+   virtual ~LdlSolverInterface();
+   ///@}
+
+   bool InitializeImpl(
+      const OptionsList& options,
+      const std::string& prefix
+   );
+
+   /** @name Methods for requesting solution of the linear system. */
+   ///@{
+   virtual ESymSolverStatus InitializeStructure(
+      Index        dim,
+      Index        nonzeros,
+      const Index* ia,
+      const Index* ja
+   );
+
+   virtual Number* GetValuesArrayPtr();
+
+   virtual ESymSolverStatus MultiSolve(
+      bool         new_matrix,
+      const Index* ia,
+      const Index* ja,
+      Index        nrhs,
+      Number*      rhs_vals,
+      bool         check_NegEVals,
+      Index        numberOfNegEVals
+   );
+
+   virtual Index NumberOfNegEVals() const;
+   ///@}
+
+   //* @name Options of Linear solver */
+   ///@{
+   virtual bool IncreaseQuality();
+
+   virtual bool ProvidesInertia() const
+   {
+      return true;
+   }
+
+   EMatrixFormat MatrixFormat() const
+   {
+      return CSR_Format_0_Offset;
+   }
+   ///@}
+
+   static void RegisterOptions(
+      SmartPtr<RegisteredOptions> roptions
+   );
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called. */
+   ///@{
+   /** Copy Constructor */
+   LdlSolverInterface(
+      const LdlSolverInterface&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const LdlSolverInterface&
+   );
+   ///@}
+
+   /** @name Information about the matrix */
+   ///@{
+   /** Number of rows and columns of the matrix */
+   Index dim_;
+
+   /** Number of nonzeros of the matrix */
+   Index nonzeros_;
+
+   /** Values of the matrix (kept so that we can refactorize after
+    *  a change of the pivot tolerance without asking for them again) */
+   Number* a_;
+   ///@}
+
+   /** @name Information about most recent factorization/solve */
+   ///@{
+   /** Number of negative eigenvalues */
+   Index negevals_;
+   ///@}
+
+   /** @name Initialization flags */
+   ///@{
+   /** Flag indicating if internal data is initialized.
+    *  For initialization, this object needs to have seen a matrix.
+    */
+   bool initialized_;
+   /** Flag indicating if the matrix has to be refactorized because
+    *  the pivot tolerance or the precision has been changed.
+    */
+   bool pivtol_changed_;
+   ///@}
+
+   /** @name Solver specific data/options */
+   ///@{
+   /** Pivot tolerance */
+   Number pivtol_;
+
+   /** Maximal pivot tolerance */
+   Number pivtolmax_;
+
+   /** Maximal number of columns of fronts that are amalgamated */
+   Index nemin_;
+
+   /** Whether the matrix is equilibrated before factorization */
+   bool scaling_;
+   /** Whether the matrix is factorized in single precision.
+    *
+    *  This is reset to false if the quality of the solution has to
+    *  be increased.
+    */
+   bool single_precision_;
+
+   /** Number of threads used for the factorization */
+   Index num_threads_;
+
+   /** Maximal number of entries of the symbolic factorization cache (0 if not used) */
+   Index symbolic_cache_size_;
+
+   /** Flag indicating whether the TNLP with identical structure has
+    *  already been solved before.
+    */
+   bool warm_start_same_structure_;
+   ///@}
+
+   /** Factorization engine */
+   SmartPtr<MultifrontalLdl> ldl_;
+
+   /** Thread pool for the factorization (NULL if single-threaded) */
+   SmartPtr<ThreadPool> pool_;
+
+   /** @name Internal functions */
+   ///@{
+   /** Symbolic analysis of the matrix with structure ia, ja and the values in a_. */
+   void SymbolicFactorization(
+      const Index* ia,
+      const Index* ja
+   );
+
+   /** Factorize the matrix in a_ and check its inertia. */
+   ESymSolverStatus Factorization(
+      bool  check_NegEVals,
+      Index numberOfNegEVals
+   );
+   ///@}
+};
+
+} // namespace Ipopt
+#endif
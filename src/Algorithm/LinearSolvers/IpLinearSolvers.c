@@ -60,6 +60,8 @@ IpoptLinearSolver IpoptGetAvailableLinearSolvers(
    solvers |= IPOPTLINEARSOLVER_MUMPS;
 #endif
 
+   solvers |= IPOPTLINEARSOLVER_LDL;
+
 #if defined(IPOPT_HAS_LINEARSOLVERLOADER)
    if( !buildinonly )
    {
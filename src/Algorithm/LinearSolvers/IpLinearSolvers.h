@@ -21,6 +21,7 @@
 #define IPOPTLINEARSOLVER_SPRAL   0x100u
 #define IPOPTLINEARSOLVER_WSMP    0x200u
 #define IPOPTLINEARSOLVER_MUMPS   0x400u
+#define IPOPTLINEARSOLVER_LDL     0x800u  /**< built-in multifrontal LDL^T solver @since 3.14.5 */
 
 #ifdef __cplusplus
 extern "C"
@@ -17,6 +17,7 @@
 #include "IpMa97SolverInterface.hpp"
 #include "IpMa28TDependencyDetector.hpp"
 #include "IpPardisoSolverInterface.hpp"
+#include "IpLdlSolverInterface.hpp"
 #ifdef IPOPT_HAS_PARDISO_MKL
 #include "IpPardisoMKLSolverInterface.hpp"
 #endif
@@ -75,6 +76,12 @@ void RegisterOptions_LinearSolvers(
    }
 #endif
 
+   if( availablesolvers & IPOPTLINEARSOLVER_LDL )
+   {
+      roptions->SetRegisteringCategory("LDL Linear Solver");
+      LdlSolverInterface::RegisterOptions(roptions);
+   }
+
 #ifdef IPOPT_HAS_MUMPS
    if( availablesolvers & IPOPTLINEARSOLVER_MUMPS )
    {
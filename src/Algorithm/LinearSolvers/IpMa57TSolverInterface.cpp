@@ -7,9 +7,12 @@
 
 #include "IpoptConfig.h"
 #include "IpMa57TSolverInterface.hpp"
+#include "IpSymbolicFactorizationCache.hpp"
 
 #include <cmath>
 #include <iostream>
+#include <string>
+#include <vector>
 
 #ifdef IPOPT_HAS_HSL
 #include "CoinHslConfig.h"
@@ -52,6 +55,22 @@ static IPOPT_DECL_MA57C(*user_ma57c) = NULL;
 static IPOPT_DECL_MA57E(*user_ma57e) = NULL;
 static IPOPT_DECL_MA57I(*user_ma57i) = NULL;
 
+/** Result of MA57AD as stored in the SymbolicFactorizationCache */
+class Ma57SymbolicData: public SymbolicFactorizationData
+{
+public:
+   /** KEEP array */
+   std::vector<ma57int> keep;
+   /** INFO(9) and INFO(10): suggested lengths of FACT and IFACT */
+   ma57int lfact;
+   ma57int lifact;
+
+   SymbolicFactorizationData* Clone() const
+   {
+      return new Ma57SymbolicData(*this);
+   }
+};
+
 const char* ma57_err_msg[] =
 {
    "Operation successful.\n",
@@ -167,6 +186,7 @@ Ma57TSolverInterface::Ma57TSolverInterface(
    initialized_(false),
    pivtol_changed_(false),
    refactorize_(false),
+   symbolic_cache_size_(0),
    wd_keep_(NULL),
    wd_iwork_(NULL),
    wd_fact_(NULL),
@@ -339,6 +359,8 @@ bool Ma57TSolverInterface::InitializeImpl(
    // The following option is registered by OrigIpoptNLP
    options.GetBoolValue("warm_start_same_structure", warm_start_same_structure_, prefix);
    DBG_ASSERT(!warm_start_same_structure_ && "warm_start_same_structure not yet implemented");
+   // The following option is registered by TSymLinearSolver
+   options.GetIntegerValue("symbolic_factorization_cache", symbolic_cache_size_, prefix);
 
    bool ma57_automatic_scaling;
    options.GetBoolValue("ma57_automatic_scaling", ma57_automatic_scaling, prefix);
@@ -556,7 +578,67 @@ ESymSolverStatus Ma57TSolverInterface::SymbolicFactorization(
       airn_ma57int = (ma57int*) (void*) const_cast<Index*>(airn);
       ajcn_ma57int = (ma57int*) (void*) const_cast<Index*>(ajcn);
    }
-   ma57a(&n, &ne, airn_ma57int, ajcn_ma57int, &wd_lkeep_, wd_keep_, wd_iwork_, wd_icntl_, wd_info_, wd_rinfo_);
+
+   // the analysis depends on the structure and on the control parameters
+   std::string key = "ma57";
+   for( int i = 0; i < 20; ++i )
+   {
+      char buf[32];
+      Snprintf(buf, 31, " %d", (int) wd_icntl_[i]);
+      key += buf;
+   }
+
+   SymbolicFactorizationData* cached = NULL;
+   Number analysis_time = 0.;
+   if( symbolic_cache_size_ > 0 )
+   {
+      cached = SymbolicFactorizationCache::Lookup(key, dim_, nonzeros_, airn, nonzeros_, ajcn, analysis_time);
+   }
+
+   if( cached != NULL )
+   {
+      Ma57SymbolicData* data = static_cast<Ma57SymbolicData*>(cached);
+      DBG_ASSERT((ma57int) data->keep.size() == wd_lkeep_);
+      for( ma57int k = 0; k < wd_lkeep_; k++ )
+      {
+         wd_keep_[k] = data->keep[k];
+      }
+      wd_info_[0] = 0;
+      wd_info_[8] = data->lfact;
+      wd_info_[9] = data->lifact;
+      delete cached;
+      if( HaveIpData() )
+      {
+         IpData().TimingStats().AddSymbolicFactorizationCacheHit(analysis_time);
+      }
+      Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                     "MA57 analysis taken from the symbolic factorization cache.\n");
+   }
+   else
+   {
+      const Number start_time = WallclockTime();
+      ma57a(&n, &ne, airn_ma57int, ajcn_ma57int, &wd_lkeep_, wd_keep_, wd_iwork_, wd_icntl_, wd_info_, wd_rinfo_);
+      analysis_time = WallclockTime() - start_time;
+
+      if( wd_info_[0] < 0 )
+      {
+         Jnlst().Printf(J_ERROR, J_LINEAR_ALGEBRA,
+                        "*** Error from MA57AD *** INFO(0) = %" IPOPT_INDEX_FORMAT "\n", wd_info_[0]);
+      }
+      else if( symbolic_cache_size_ > 0 )
+      {
+         Ma57SymbolicData data;
+         data.keep.assign(wd_keep_, wd_keep_ + wd_lkeep_);
+         data.lfact = wd_info_[8];
+         data.lifact = wd_info_[9];
+         SymbolicFactorizationCache::Store(symbolic_cache_size_, key, dim_, nonzeros_, airn, nonzeros_, ajcn, data, analysis_time);
+         if( HaveIpData() )
+         {
+            IpData().TimingStats().AddSymbolicFactorizationCacheMiss();
+         }
+      }
+   }
+
    // free copy-casted ma57int arrays, no longer needed
    if( sizeof(ma57int) != sizeof(Index) )
    {
@@ -564,12 +646,6 @@ ESymSolverStatus Ma57TSolverInterface::SymbolicFactorization(
       delete[] ajcn_ma57int;
    }
 
-   if( wd_info_[0] < 0 )
-   {
-      Jnlst().Printf(J_ERROR, J_LINEAR_ALGEBRA,
-                     "*** Error from MA57AD *** INFO(0) = %" IPOPT_INDEX_FORMAT "\n", wd_info_[0]);
-   }
-
    wd_lfact_ = 0;
    wd_lifact_ = 0;
    ComputeMemIncrease(wd_lfact_, (Number)wd_info_[8] * ma57_pre_alloc_, 0, "double working space for MA57");
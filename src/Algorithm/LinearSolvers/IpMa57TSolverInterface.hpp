@@ -260,6 +260,8 @@ private:
     *  already been solved before.
     */
    bool warm_start_same_structure_;
+   /** Maximal number of entries of the symbolic factorization cache (0 if not used) */
+   Index symbolic_cache_size_;
    ///@}
 
    /** @name Data for the linear solver.
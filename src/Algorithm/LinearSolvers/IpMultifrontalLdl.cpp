@@ -0,0 +1,1624 @@
+// Copyright (C) 2021 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpMultifrontalLdl.hpp"
+#include "IpBlas.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+#if __cplusplus >= 201103L
+#include <atomic>
+#include <functional>
+#include <memory>
+#endif
+
+namespace Ipopt
+{
+#if IPOPT_VERBOSITY > 0
+static const Index dbg_verbosity = 0;
+#endif
+
+/** pivots with absolute value below this are considered zero (CNTL(2) in MA57) */
+static const Number small_pivot = 1e-20;
+
+/** rows whose diagonal is smaller than this times their largest
+ *  off-diagonal entry (after scaling) are paired by the analysis */
+static const Number weak_diagonal = 1e-4;
+
+/** maximal fraction of explicit zeros in a front created by amalgamation */
+static const Number max_zero_fraction = 0.3;
+
+/** matrices with (scaled) entries larger than this are not factorized in single precision */
+static const Number max_single_value = 1e30;
+
+MultifrontalLdl::MultifrontalLdl()
+   : dim_(0),
+     nonzeros_(0),
+     predicted_factor_entries_(0.),
+     pivtol_(1e-8),
+     single_precision_(false),
+     negevals_(0),
+     delayed_pivots_(0),
+     twobytwo_pivots_(0),
+     factor_entries_(0.)
+{ }
+
+MultifrontalLdl::~MultifrontalLdl()
+{ }
+
+void MultifrontalLdl::MinimumDegreeOrdering(
+   Index                     n,
+   const std::vector<Index>& adj_ptr,
+   const std::vector<Index>& adj,
+   const std::vector<Index>& weight,
+   std::vector<Index>&       order
+)
+{
+   DBG_START_FUN("MultifrontalLdl::MinimumDegreeOrdering", dbg_verbosity);
+
+   // This is a simplified approximate minimum degree algorithm on the
+   // quotient graph (Amestoy, Davis, Duff), with element absorption
+   // but without supervariable detection.  Every node stands for
+   // weight[i] variables, and all degrees are counted in variables.
+   // Dense rows are removed from the graph and ordered last.
+   enum
+   {
+      VARIABLE, ELEMENT, ABSORBED, DENSE
+   };
+
+   order.resize(n);
+   if( n == 0 )
+   {
+      return;
+   }
+
+   const Index dense = Max(Index(16), Index(10. * std::sqrt((double) n)));
+
+   std::vector<char> status(n, VARIABLE);
+   std::vector<Index> dense_vars;
+   for( Index i = 0; i < n; i++ )
+   {
+      if( adj_ptr[i + 1] - adj_ptr[i] > dense )
+      {
+         status[i] = DENSE;
+         dense_vars.push_back(i);
+      }
+   }
+   const Index nsparse = n - (Index) dense_vars.size();
+   Index nleft = 0;
+   for( Index i = 0; i < n; i++ )
+   {
+      if( status[i] != DENSE )
+      {
+         nleft += weight[i];
+      }
+   }
+
+   std::vector<std::vector<Index> > A(n);  // variable adjacency
+   std::vector<std::vector<Index> > E(n);  // adjacent elements
+   std::vector<std::vector<Index> > Le(n); // variables of element
+   std::vector<Index> deg(n, 0);
+   for( Index i = 0; i < n; i++ )
+   {
+      if( status[i] == DENSE )
+      {
+         continue;
+      }
+      for( Index k = adj_ptr[i]; k < adj_ptr[i + 1]; k++ )
+      {
+         if( status[adj[k]] != DENSE )
+         {
+            A[i].push_back(adj[k]);
+            deg[i] += weight[adj[k]];
+         }
+      }
+   }
+
+   // degree lists
+   std::vector<Index> head(nleft + 1, -1);
+   std::vector<Index> next(n, -1);
+   std::vector<Index> prev(n, -1);
+   Index mindeg = nleft;
+   for( Index i = 0; i < n; i++ )
+   {
+      if( status[i] != DENSE )
+      {
+         next[i] = head[deg[i]];
+         if( head[deg[i]] >= 0 )
+         {
+            prev[head[deg[i]]] = i;
+         }
+         head[deg[i]] = i;
+         mindeg = Min(mindeg, deg[i]);
+      }
+   }
+
+   std::vector<Index> mark(n, -1);
+   std::vector<Index> wflag(n, -1);
+   std::vector<Index> wcnt(n, 0);
+   std::vector<Index> lew(n, 0); // weight of the variables of an element
+   std::vector<Index> aw(n, 0);  // weight of the variables in A
+   std::vector<Index> Lp;
+
+   for( Index nelim = 0; nelim < nsparse; nelim++ )
+   {
+      // select variable of minimum (approximate) degree
+      while( head[mindeg] < 0 )
+      {
+         mindeg++;
+      }
+      const Index p = head[mindeg];
+      head[mindeg] = next[p];
+      if( next[p] >= 0 )
+      {
+         prev[next[p]] = -1;
+      }
+      order[nelim] = p;
+
+      // construct the new element Lp
+      mark[p] = nelim;
+      Lp.clear();
+      Index wLp = 0;
+      for( size_t k = 0; k < E[p].size(); k++ )
+      {
+         const Index e = E[p][k];
+         if( status[e] != ELEMENT )
+         {
+            continue;
+         }
+         for( size_t l = 0; l < Le[e].size(); l++ )
+         {
+            const Index v = Le[e][l];
+            if( status[v] == VARIABLE && mark[v] != nelim )
+            {
+               mark[v] = nelim;
+               Lp.push_back(v);
+               wLp += weight[v];
+            }
+         }
+         status[e] = ABSORBED;
+         std::vector<Index>().swap(Le[e]);
+      }
+      for( size_t k = 0; k < A[p].size(); k++ )
+      {
+         const Index v = A[p][k];
+         if( status[v] == VARIABLE && mark[v] != nelim )
+         {
+            mark[v] = nelim;
+            Lp.push_back(v);
+            wLp += weight[v];
+         }
+      }
+      status[p] = ELEMENT;
+      std::vector<Index>().swap(A[p]);
+      std::vector<Index>().swap(E[p]);
+      Le[p] = Lp;
+      lew[p] = wLp;
+      nleft -= weight[p];
+
+      // remove the variables in Lp from the degree lists and prune their adjacency
+      for( size_t k = 0; k < Lp.size(); k++ )
+      {
+         const Index i = Lp[k];
+         if( prev[i] >= 0 )
+         {
+            next[prev[i]] = next[i];
+         }
+         else
+         {
+            head[deg[i]] = next[i];
+         }
+         if( next[i] >= 0 )
+         {
+            prev[next[i]] = prev[i];
+         }
+
+         Index len = 0;
+         for( size_t l = 0; l < E[i].size(); l++ )
+         {
+            if( status[E[i][l]] == ELEMENT )
+            {
+               E[i][len++] = E[i][l];
+            }
+         }
+         E[i].resize(len);
+         E[i].push_back(p);
+
+         len = 0;
+         aw[i] = 0;
+         for( size_t l = 0; l < A[i].size(); l++ )
+         {
+            const Index v = A[i][l];
+            if( status[v] == VARIABLE && mark[v] != nelim )
+            {
+               A[i][len++] = v;
+               aw[i] += weight[v];
+            }
+         }
+         A[i].resize(len);
+      }
+
+      // compute the weight of Le \ Lp for all elements adjacent to Lp
+      for( size_t k = 0; k < Lp.size(); k++ )
+      {
+         const Index i = Lp[k];
+         for( size_t l = 0; l < E[i].size(); l++ )
+         {
+            const Index e = E[i][l];
+            if( e == p )
+            {
+               continue;
+            }
+            if( wflag[e] != nelim )
+            {
+               wflag[e] = nelim;
+               wcnt[e] = lew[e];
+            }
+            wcnt[e] -= weight[i];
+         }
+      }
+
+      // approximate degree update; elements that are subsets of Lp are absorbed
+      for( size_t k = 0; k < Lp.size(); k++ )
+      {
+         const Index i = Lp[k];
+         Index d = aw[i] + wLp - weight[i];
+         Index len = 0;
+         for( size_t l = 0; l < E[i].size(); l++ )
+         {
+            const Index e = E[i][l];
+            if( e != p )
+            {
+               if( status[e] != ELEMENT )
+               {
+                  continue;
+               }
+               if( wcnt[e] == 0 )
+               {
+                  status[e] = ABSORBED;
+                  std::vector<Index>().swap(Le[e]);
+                  continue;
+               }
+               d += wcnt[e];
+            }
+            E[i][len++] = e;
+         }
+         E[i].resize(len);
+         d = Min(d, Min(nleft - weight[i], deg[i] + wLp));
+         d = Max(d, Index(0));
+         deg[i] = d;
+
+         prev[i] = -1;
+         next[i] = head[d];
+         if( head[d] >= 0 )
+         {
+            prev[head[d]] = i;
+         }
+         head[d] = i;
+         mindeg = Min(mindeg, d);
+      }
+   }
+
+   // dense variables go last, sorted by degree
+   std::vector<std::pair<Index, Index> > dsort;
+   for( size_t k = 0; k < dense_vars.size(); k++ )
+   {
+      const Index i = dense_vars[k];
+      dsort.push_back(std::make_pair(adj_ptr[i + 1] - adj_ptr[i], i));
+   }
+   std::sort(dsort.begin(), dsort.end());
+   for( size_t k = 0; k < dsort.size(); k++ )
+   {
+      order[nsparse + k] = dsort[k].second;
+   }
+}
+
+void MultifrontalLdl::Analyze(
+   Index         dim,
+   const Index*  ia,
+   const Index*  ja,
+   const Number* values,
+   Index         nemin
+)
+{
+   DBG_START_METH("MultifrontalLdl::Analyze", dbg_verbosity);
+
+   dim_ = dim;
+   nonzeros_ = dim > 0 ? ia[dim] : 0;
+   fronts_.clear();
+   perm_.resize(dim);
+   nz_row_.resize(nonzeros_);
+   nz_col_.resize(nonzeros_);
+
+   const Index n = dim;
+
+   // symmetric adjacency structure without diagonal; adj_nz holds the
+   // position of the corresponding nonzero
+   std::vector<Index> adj_ptr(n + 1, 0);
+   for( Index r = 0; r < n; r++ )
+   {
+      for( Index k = ia[r]; k < ia[r + 1]; k++ )
+      {
+         nz_row_[k] = r;
+         nz_col_[k] = ja[k];
+         if( ja[k] != r )
+         {
+            adj_ptr[r + 1]++;
+            adj_ptr[ja[k] + 1]++;
+         }
+      }
+   }
+   for( Index i = 0; i < n; i++ )
+   {
+      adj_ptr[i + 1] += adj_ptr[i];
+   }
+   std::vector<Index> adj(adj_ptr[n]);
+   std::vector<Index> adj_nz(adj_ptr[n]);
+   {
+      std::vector<Index> fill(adj_ptr.begin(), adj_ptr.end() - (n > 0 ? 1 : 0));
+      for( Index r = 0; r < n; r++ )
+      {
+         for( Index k = ia[r]; k < ia[r + 1]; k++ )
+         {
+            const Index c = ja[k];
+            if( c != r )
+            {
+               adj_nz[fill[r]] = k;
+               adj[fill[r]++] = c;
+               adj_nz[fill[c]] = k;
+               adj[fill[c]++] = r;
+            }
+         }
+      }
+   }
+
+   // Rows with a (relatively) zero diagonal, such as the constraint
+   // rows of a KKT system, are not acceptable as 1x1 pivots.  Each of
+   // them is paired with its largest off-diagonal entry, and the pair
+   // is ordered as one node, so that it ends up in the pivot block of
+   // a single front, where it is available as a 2x2 pivot.
+   std::vector<Index> mate(n, -1);
+   if( values != NULL )
+   {
+      ComputeScaling(values);
+      std::vector<Number> diag(n, 0.);
+      std::vector<Number> offmax(n, 0.);
+      for( Index k = 0; k < nonzeros_; k++ )
+      {
+         const Index r = nz_row_[k];
+         const Index c = nz_col_[k];
+         const Number v = std::abs(values[k] * scaling_[r] * scaling_[c]);
+         if( r == c )
+         {
+            diag[r] += v;
+         }
+         else
+         {
+            offmax[r] = Max(offmax[r], v);
+            offmax[c] = Max(offmax[c], v);
+         }
+      }
+      // rows with few entries first, since they have fewer choices
+      std::vector<std::pair<Index, Index> > weak;
+      for( Index i = 0; i < n; i++ )
+      {
+         if( offmax[i] > 0. && diag[i] <= weak_diagonal * offmax[i] )
+         {
+            weak.push_back(std::make_pair(adj_ptr[i + 1] - adj_ptr[i], i));
+         }
+      }
+      std::sort(weak.begin(), weak.end());
+      for( size_t w = 0; w < weak.size(); w++ )
+      {
+         const Index i = weak[w].second;
+         if( mate[i] >= 0 )
+         {
+            continue;
+         }
+         Index best = -1;
+         Number bestval = 0.;
+         for( Index l = adj_ptr[i]; l < adj_ptr[i + 1]; l++ )
+         {
+            const Index j = adj[l];
+            const Number v = std::abs(values[adj_nz[l]] * scaling_[i] * scaling_[j]);
+            if( mate[j] < 0 && v > bestval )
+            {
+               best = j;
+               bestval = v;
+            }
+         }
+         if( best >= 0 )
+         {
+            mate[i] = best;
+            mate[best] = i;
+         }
+      }
+   }
+
+   // compressed graph with one node per variable or pair of variables
+   std::vector<Index> node(n);
+   std::vector<Index> node_var;    // first variable of a node
+   std::vector<Index> node_mate;   // second variable of a node, or -1
+   std::vector<Index> weight;
+   for( Index i = 0; i < n; i++ )
+   {
+      if( mate[i] >= 0 && mate[i] < i )
+      {
+         node[i] = node[mate[i]];
+         continue;
+      }
+      node[i] = (Index) node_var.size();
+      node_var.push_back(i);
+      node_mate.push_back(mate[i]);
+      weight.push_back(mate[i] >= 0 ? 2 : 1);
+   }
+   const Index nn = (Index) node_var.size();
+   std::vector<Index> cadj_ptr(nn + 1, 0);
+   std::vector<Index> cadj;
+   {
+      std::vector<Index> mark(nn, -1);
+      for( Index c = 0; c < nn; c++ )
+      {
+         mark[c] = c;
+         for( Index t = 0; t < weight[c]; t++ )
+         {
+            const Index v = t == 0 ? node_var[c] : node_mate[c];
+            for( Index l = adj_ptr[v]; l < adj_ptr[v + 1]; l++ )
+            {
+               const Index d = node[adj[l]];
+               if( mark[d] != c )
+               {
+                  mark[d] = c;
+                  cadj.push_back(d);
+               }
+            }
+         }
+         cadj_ptr[c + 1] = (Index) cadj.size();
+      }
+   }
+
+   // fill-reducing ordering of the nodes
+   std::vector<Index> order;
+   MinimumDegreeOrdering(nn, cadj_ptr, cadj, weight, order);
+   std::vector<Index> iorder(nn);
+   for( Index k = 0; k < nn; k++ )
+   {
+      iorder[order[k]] = k;
+   }
+
+   // elimination tree (Liu's algorithm with path compression)
+   std::vector<Index> parent(nn, -1);
+   {
+      std::vector<Index> ancestor(nn, -1);
+      for( Index k = 0; k < nn; k++ )
+      {
+         const Index ok = order[k];
+         for( Index l = cadj_ptr[ok]; l < cadj_ptr[ok + 1]; l++ )
+         {
+            Index i = iorder[cadj[l]];
+            while( i != -1 && i < k )
+            {
+               const Index inext = ancestor[i];
+               ancestor[i] = k;
+               if( inext == -1 )
+               {
+                  parent[i] = k;
+               }
+               i = inext;
+            }
+         }
+      }
+   }
+
+   // postorder of the elimination tree
+   std::vector<Index> post;
+   post.reserve(nn);
+   {
+      std::vector<Index> first_child(nn, -1);
+      std::vector<Index> sibling(nn, -1);
+      for( Index j = nn - 1; j >= 0; j-- )
+      {
+         if( parent[j] >= 0 )
+         {
+            sibling[j] = first_child[parent[j]];
+            first_child[parent[j]] = j;
+         }
+      }
+      std::vector<Index> stack;
+      for( Index r = 0; r < nn; r++ )
+      {
+         if( parent[r] >= 0 )
+         {
+            continue;
+         }
+         stack.push_back(r);
+         while( !stack.empty() )
+         {
+            const Index j = stack.back();
+            if( first_child[j] >= 0 )
+            {
+               // descend into the next unvisited child
+               const Index c = first_child[j];
+               first_child[j] = sibling[c];
+               stack.push_back(c);
+            }
+            else
+            {
+               post.push_back(j);
+               stack.pop_back();
+            }
+         }
+      }
+   }
+   DBG_ASSERT((Index) post.size() == nn);
+
+   // compose ordering and postorder; from here on, nodes are numbered
+   // in this order
+   std::vector<Index> ipost(nn);
+   for( Index k = 0; k < nn; k++ )
+   {
+      ipost[post[k]] = k;
+   }
+   std::vector<Index> nperm(nn);
+   std::vector<Index> inperm(nn);
+   std::vector<Index> eparent(nn);
+   std::vector<Index> nweight(nn);
+   for( Index k = 0; k < nn; k++ )
+   {
+      nperm[k] = order[post[k]];
+      inperm[nperm[k]] = k;
+      eparent[k] = parent[post[k]] < 0 ? -1 : ipost[parent[post[k]]];
+      nweight[k] = weight[nperm[k]];
+   }
+
+   // column counts of L (in variables) via row subtrees
+   std::vector<Index> colcount(nweight);
+   std::vector<Index> nchild(nn, 0);
+   {
+      std::vector<Index> mark(nn, -1);
+      for( Index i = 0; i < nn; i++ )
+      {
+         mark[i] = i;
+         const Index oi = nperm[i];
+         for( Index l = cadj_ptr[oi]; l < cadj_ptr[oi + 1]; l++ )
+         {
+            Index j = inperm[cadj[l]];
+            if( j > i )
+            {
+               continue;
+            }
+            while( mark[j] != i )
+            {
+               mark[j] = i;
+               colcount[j] += nweight[i];
+               j = eparent[j];
+            }
+         }
+         if( eparent[i] >= 0 )
+         {
+            nchild[eparent[i]]++;
+         }
+      }
+   }
+
+   // fundamental supernodes
+   std::vector<Index> sn_first;
+   std::vector<Index> node2sn(nn);
+   for( Index j = 0; j < nn; j++ )
+   {
+      if( j == 0 || eparent[j - 1] != j || nchild[j] != 1 || colcount[j - 1] != colcount[j] + nweight[j - 1] )
+      {
+         sn_first.push_back(j);
+      }
+      node2sn[j] = (Index) sn_first.size() - 1;
+   }
+   const Index nsn = (Index) sn_first.size();
+   sn_first.push_back(nn);
+
+   std::vector<Index> sn_parent(nsn);
+   std::vector<std::vector<Index> > sn_children(nsn);
+   std::vector<Index> sn_ncols(nsn, 0);
+   for( Index s = 0; s < nsn; s++ )
+   {
+      const Index last = sn_first[s + 1] - 1;
+      sn_parent[s] = eparent[last] < 0 ? -1 : node2sn[eparent[last]];
+      if( sn_parent[s] >= 0 )
+      {
+         sn_children[sn_parent[s]].push_back(s);
+      }
+      for( Index j = sn_first[s]; j <= last; j++ )
+      {
+         sn_ncols[s] += nweight[j];
+      }
+   }
+
+   // row structure of the supernodes
+   std::vector<std::vector<Index> > sn_rows(nsn);
+   std::vector<Index> sn_nrows(nsn, 0);
+   {
+      std::vector<Index> mark(nn, -1);
+      for( Index s = 0; s < nsn; s++ )
+      {
+         const Index last = sn_first[s + 1] - 1;
+         std::vector<Index>& rows = sn_rows[s];
+         for( Index j = sn_first[s]; j <= last; j++ )
+         {
+            const Index oj = nperm[j];
+            for( Index l = cadj_ptr[oj]; l < cadj_ptr[oj + 1]; l++ )
+            {
+               const Index i = inperm[cadj[l]];
+               if( i > last && mark[i] != s )
+               {
+                  mark[i] = s;
+                  rows.push_back(i);
+               }
+            }
+         }
+         for( size_t c = 0; c < sn_children[s].size(); c++ )
+         {
+            const std::vector<Index>& crows = sn_rows[sn_children[s][c]];
+            for( size_t l = 0; l < crows.size(); l++ )
+            {
+               const Index i = crows[l];
+               if( i > last && mark[i] != s )
+               {
+                  mark[i] = s;
+                  rows.push_back(i);
+               }
+            }
+         }
+         std::sort(rows.begin(), rows.end());
+         for( size_t l = 0; l < rows.size(); l++ )
+         {
+            sn_nrows[s] += nweight[rows[l]];
+         }
+      }
+   }
+
+   // amalgamation: a child is merged into its parent if the merge
+   // does not introduce explicit zeros into the factor, or if both
+   // have fewer than nemin columns and the fraction of explicit zeros
+   // in the merged front stays small.  The columns of the merged
+   // children precede those of the parent in the front.
+   std::vector<bool> merged(nsn, false);
+   {
+      std::vector<Number> zeros(nsn, 0.);
+      for( Index s = 0; s < nsn; s++ )
+      {
+         for( size_t k = 0; k < sn_children[s].size(); k++ )
+         {
+            const Index c = sn_children[s][k];
+            // zeros in the columns of c, which are not coupled to the
+            // columns of the children that were merged into s before
+            const Number z = (Number) sn_ncols[c] * (Number)(sn_ncols[s] + sn_nrows[s] - sn_nrows[c]);
+            const Number nc = (Number)(sn_ncols[s] + sn_ncols[c]);
+            const Number entries = nc * (nc + 1.) / 2. + nc * (Number) sn_nrows[s];
+            const Number newzeros = zeros[s] + zeros[c] + z;
+            if( z == 0. || (sn_ncols[c] < nemin && sn_ncols[s] < nemin && newzeros <= max_zero_fraction * entries) )
+            {
+               merged[c] = true;
+               sn_ncols[s] += sn_ncols[c];
+               zeros[s] = newzeros;
+               std::vector<Index>().swap(sn_rows[c]);
+            }
+         }
+      }
+   }
+   std::vector<Index> leader(nsn);
+   for( Index s = nsn - 1; s >= 0; s-- )
+   {
+      leader[s] = merged[s] ? leader[sn_parent[s]] : s;
+   }
+
+   // create the fronts; ordering them by their top supernode gives a
+   // postorder of the assembly tree
+   std::vector<Index> sn2front(nsn, -1);
+   for( Index s = 0; s < nsn; s++ )
+   {
+      if( merged[s] )
+      {
+         continue;
+      }
+      sn2front[s] = (Index) fronts_.size();
+      fronts_.push_back(Front());
+      Front& f = fronts_.back();
+      f.first = 0;
+      f.ncols = 0;
+      f.parent = sn_parent[s] < 0 ? -1 : leader[sn_parent[s]];
+      f.asm_begin = f.asm_end = 0;
+      f.nelim = f.ndelay = 0;
+      f.negevals = f.n2x2 = 0;
+      f.singular = false;
+   }
+   const Index nfronts = (Index) fronts_.size();
+   std::vector<Index> front_sn_ptr(nfronts + 1, 0);
+   for( Index s = 0; s < nsn; s++ )
+   {
+      front_sn_ptr[sn2front[leader[s]] + 1]++;
+   }
+   for( Index f = 0; f < nfronts; f++ )
+   {
+      front_sn_ptr[f + 1] += front_sn_ptr[f];
+   }
+   std::vector<Index> front_sn(nsn);
+   {
+      std::vector<Index> fill(front_sn_ptr.begin(), front_sn_ptr.end() - 1);
+      for( Index s = 0; s < nsn; s++ )
+      {
+         front_sn[fill[sn2front[leader[s]]]++] = s;
+      }
+   }
+
+   // final numbering of the variables: the columns of every front are
+   // contiguous, and the two variables of a node are adjacent
+   std::vector<Index> iperm(n);
+   std::vector<Index> node_pos(nn);
+   std::vector<Index> col2front(n);
+   Index next = 0;
+   for( Index f = 0; f < nfronts; f++ )
+   {
+      Front& front = fronts_[f];
+      front.first = next;
+      for( Index t = front_sn_ptr[f]; t < front_sn_ptr[f + 1]; t++ )
+      {
+         const Index s = front_sn[t];
+         for( Index j = sn_first[s]; j < sn_first[s + 1]; j++ )
+         {
+            const Index c = nperm[j];
+            node_pos[j] = next;
+            col2front[next] = f;
+            perm_[next++] = node_var[c];
+            if( node_mate[c] >= 0 )
+            {
+               col2front[next] = f;
+               perm_[next++] = node_mate[c];
+            }
+         }
+      }
+      front.ncols = next - front.first;
+   }
+   DBG_ASSERT(next == n);
+   for( Index k = 0; k < n; k++ )
+   {
+      iperm[perm_[k]] = k;
+   }
+
+   predicted_factor_entries_ = 0.;
+   for( Index f = 0; f < nfronts; f++ )
+   {
+      Front& front = fronts_[f];
+      const Index s = front_sn[front_sn_ptr[f + 1] - 1];
+      const std::vector<Index>& rows = sn_rows[s];
+      front.rows.reserve(sn_nrows[s]);
+      for( size_t l = 0; l < rows.size(); l++ )
+      {
+         const Index j = rows[l];
+         front.rows.push_back(node_pos[j]);
+         if( nweight[j] == 2 )
+         {
+            front.rows.push_back(node_pos[j] + 1);
+         }
+      }
+      std::sort(front.rows.begin(), front.rows.end());
+      if( front.parent >= 0 )
+      {
+         front.parent = sn2front[front.parent];
+         fronts_[front.parent].children.push_back(f);
+      }
+      const Number nc = (Number) front.ncols;
+      predicted_factor_entries_ += nc * (nc + 1.) / 2. + nc * (Number) front.rows.size();
+   }
+
+   // assembly map for the original entries; an entry belongs to the
+   // front of its smaller (permuted) index
+   std::vector<Index> cnt(nfronts + 1, 0);
+   for( Index k = 0; k < nonzeros_; k++ )
+   {
+      const Index j = Min(iperm[nz_row_[k]], iperm[nz_col_[k]]);
+      cnt[col2front[j] + 1]++;
+   }
+   for( Index f = 0; f < nfronts; f++ )
+   {
+      cnt[f + 1] += cnt[f];
+      fronts_[f].asm_begin = cnt[f];
+      fronts_[f].asm_end = cnt[f + 1];
+   }
+   asm_nz_.resize(nonzeros_);
+   asm_row_.resize(nonzeros_);
+   asm_col_.resize(nonzeros_);
+   for( Index k = 0; k < nonzeros_; k++ )
+   {
+      const Index a = iperm[nz_row_[k]];
+      const Index b = iperm[nz_col_[k]];
+      const Index i = Max(a, b);
+      const Index j = Min(a, b);
+      const Index f = col2front[j];
+      const Front& front = fronts_[f];
+      const Index pos = cnt[f]++;
+      asm_nz_[pos] = k;
+      asm_col_[pos] = j - front.first;
+      if( i < front.first + front.ncols )
+      {
+         asm_row_[pos] = i - front.first;
+      }
+      else
+      {
+         asm_row_[pos] = front.ncols + (Index)(std::lower_bound(front.rows.begin(), front.rows.end(), i) - front.rows.begin());
+         DBG_ASSERT(front.rows[asm_row_[pos] - front.ncols] == i);
+      }
+   }
+}
+
+void MultifrontalLdl::CopyAnalysis(
+   const MultifrontalLdl& other
+)
+{
+   DBG_START_METH("MultifrontalLdl::CopyAnalysis", dbg_verbosity);
+
+   dim_ = other.dim_;
+   nonzeros_ = other.nonzeros_;
+   perm_ = other.perm_;
+   nz_row_ = other.nz_row_;
+   nz_col_ = other.nz_col_;
+   asm_nz_ = other.asm_nz_;
+   asm_row_ = other.asm_row_;
+   asm_col_ = other.asm_col_;
+   predicted_factor_entries_ = other.predicted_factor_entries_;
+
+   const Index nfronts = (Index) other.fronts_.size();
+   fronts_.clear();
+   fronts_.resize(nfronts);
+   for( Index f = 0; f < nfronts; f++ )
+   {
+      const Front& src = other.fronts_[f];
+      Front& front = fronts_[f];
+      front.first = src.first;
+      front.ncols = src.ncols;
+      front.rows = src.rows;
+      front.parent = src.parent;
+      front.children = src.children;
+      front.asm_begin = src.asm_begin;
+      front.asm_end = src.asm_end;
+      front.nelim = 0;
+      front.ndelay = 0;
+      front.negevals = 0;
+      front.n2x2 = 0;
+      front.singular = false;
+   }
+
+   values_.clear();
+   scaling_.clear();
+   single_precision_ = false;
+   negevals_ = 0;
+   delayed_pivots_ = 0;
+   twobytwo_pivots_ = 0;
+   factor_entries_ = 0.;
+}
+
+void MultifrontalLdl::ComputeScaling(
+   const Number* values
+)
+{
+   // a few sweeps of symmetric infinity-norm equilibration (Ruiz)
+   scaling_.assign(dim_, 1.);
+   std::vector<Number> colmax(dim_);
+   for( Index sweep = 0; sweep < 3; sweep++ )
+   {
+      std::fill(colmax.begin(), colmax.end(), 0.);
+      for( Index k = 0; k < nonzeros_; k++ )
+      {
+         const Index r = nz_row_[k];
+         const Index c = nz_col_[k];
+         const Number v = std::abs(values[k] * scaling_[r] * scaling_[c]);
+         colmax[r] = Max(colmax[r], v);
+         colmax[c] = Max(colmax[c], v);
+      }
+      for( Index i = 0; i < dim_; i++ )
+      {
+         if( colmax[i] > 0. )
+         {
+            scaling_[i] /= std::sqrt(colmax[i]);
+         }
+      }
+   }
+}
+
+template<typename T>
+void MultifrontalLdl::FactorFrontImpl(
+   Index                   fidx,
+   Index*                  pos,
+   std::vector<T> Front::* L,
+   std::vector<T> Front::* cb
+)
+{
+   Front& f = fronts_[fidx];
+
+   // collect the variables of the front: own columns, delayed pivots of the children, rows
+   Index ndelay_in = 0;
+   for( size_t c = 0; c < f.children.size(); c++ )
+   {
+      ndelay_in += fronts_[f.children[c]].ndelay;
+   }
+   const Index p = f.ncols + ndelay_in;
+   const Index nf = p + (Index) f.rows.size();
+   f.vars.resize(nf);
+   for( Index k = 0; k < f.ncols; k++ )
+   {
+      f.vars[k] = f.first + k;
+   }
+   Index idx = f.ncols;
+   for( size_t c = 0; c < f.children.size(); c++ )
+   {
+      const Front& child = fronts_[f.children[c]];
+      for( Index k = 0; k < child.ndelay; k++ )
+      {
+         f.vars[idx++] = child.vars[child.nelim + k];
+      }
+   }
+   for( size_t k = 0; k < f.rows.size(); k++ )
+   {
+      f.vars[idx++] = f.rows[k];
+   }
+   for( Index k = 0; k < nf; k++ )
+   {
+      pos[f.vars[k]] = k;
+   }
+
+   // assemble original entries (full storage)
+   std::vector<T> F((size_t) nf * (size_t) nf, 0.);
+   for( Index a = f.asm_begin; a < f.asm_end; a++ )
+   {
+      Index r = asm_row_[a];
+      const Index c = asm_col_[a];
+      if( r >= f.ncols )
+      {
+         r += ndelay_in;
+      }
+      const T v = (T) values_[asm_nz_[a]];
+      F[r + (size_t) c * nf] += v;
+      if( r != c )
+      {
+         F[c + (size_t) r * nf] += v;
+      }
+   }
+
+   // extend-add the contribution blocks of the children
+   std::vector<Index> loc;
+   for( size_t c = 0; c < f.children.size(); c++ )
+   {
+      Front& child = fronts_[f.children[c]];
+      const Index m = (Index) child.vars.size() - child.nelim;
+      loc.resize(m);
+      for( Index i = 0; i < m; i++ )
+      {
+         loc[i] = pos[child.vars[child.nelim + i]];
+      }
+      for( Index j = 0; j < m; j++ )
+      {
+         T* Fj = &F[(size_t) loc[j] * nf];
+         const T* cbj = &(child.*cb)[(size_t) j * m];
+         for( Index i = 0; i < m; i++ )
+         {
+            Fj[loc[i]] += cbj[i];
+         }
+      }
+      std::vector<T>().swap(child.*cb);
+   }
+
+   // partial factorization of the fully summed columns 0..p-1.
+   // Only the columns 0..p-1 are kept up to date (in full); the
+   // trailing block is updated with one BLAS-3 call at the end.
+   const Index m2 = nf - p;
+   std::vector<T> W((size_t) m2 * (size_t) p);
+   f.d.assign(p, 0.);
+   f.e.assign(p, 0.);
+   f.negevals = 0;
+   f.n2x2 = 0;
+   f.singular = false;
+
+   const Number u = pivtol_;
+   bool force = false;
+   Index k = 0;
+   while( k < p )
+   {
+      // search for an acceptable 1x1 or 2x2 pivot among the remaining fully summed columns
+      Index piv = -1;
+      Index piv2 = -1;
+      const Number uu = force ? 0. : u;
+      for( Index j = k; j < p && piv < 0; j++ )
+      {
+         const T* Fj = &F[(size_t) j * nf];
+         T colmax = 0.;
+         T fsmax = 0.;
+         Index r = -1;
+         for( Index i = k; i < nf; i++ )
+         {
+            if( i == j )
+            {
+               continue;
+            }
+            const T v = std::abs(Fj[i]);
+            colmax = Max(colmax, v);
+            if( i < p && v > fsmax )
+            {
+               fsmax = v;
+               r = i;
+            }
+         }
+         const T ajj = std::abs(Fj[j]);
+         if( ajj > small_pivot && ajj >= uu * colmax )
+         {
+            piv = j;
+            break;
+         }
+         if( r < 0 || fsmax <= small_pivot )
+         {
+            continue;
+         }
+         // try the 2x2 pivot (j,r)
+         const T* Fr = &F[(size_t) r * nf];
+         const T a = Fj[j];
+         const T b = Fj[r];
+         const T c = Fr[r];
+         const T det = a * c - b * b;
+         if( std::abs(det) <= small_pivot * std::abs(b) )
+         {
+            continue;
+         }
+         T gj = 0.;
+         T gr = 0.;
+         for( Index i = k; i < nf; i++ )
+         {
+            if( i != j && i != r )
+            {
+               gj = Max(gj, std::abs(Fj[i]));
+               gr = Max(gr, std::abs(Fr[i]));
+            }
+         }
+         if( uu * (std::abs(c) * gj + std::abs(b) * gr) <= std::abs(det)
+             && uu * (std::abs(b) * gj + std::abs(a) * gr) <= std::abs(det) )
+         {
+            piv = j;
+            piv2 = r;
+         }
+      }
+
+      if( piv < 0 )
+      {
+         if( f.parent >= 0 )
+         {
+            // delay remaining pivots to the parent
+            break;
+         }
+         if( !force )
+         {
+            // in a root, accept any nonzero pivot
+            force = true;
+            continue;
+         }
+         f.singular = true;
+         break;
+      }
+      force = false;
+
+      // move pivot(s) to position k (and k+1)
+      const Index npiv = piv2 >= 0 ? 2 : 1;
+      Index swap_src[2] = { piv, piv2 };
+      for( Index t = 0; t < npiv; t++ )
+      {
+         const Index dst = k + t;
+         const Index src = swap_src[t];
+         if( src == dst )
+         {
+            continue;
+         }
+         if( t == 0 && piv2 == dst )
+         {
+            // second pivot will be moved away from dst by this swap
+            swap_src[1] = src;
+         }
+         std::swap(f.vars[src], f.vars[dst]);
+         std::swap_ranges(F.begin() + (size_t) src * nf, F.begin() + (size_t)(src + 1) * nf, F.begin() + (size_t) dst * nf);
+         for( Index col = 0; col < p; col++ )
+         {
+            std::swap(F[src + (size_t) col * nf], F[dst + (size_t) col * nf]);
+         }
+      }
+
+      T* Fk = &F[(size_t) k * nf];
+      if( npiv == 1 )
+      {
+         const T d = Fk[k];
+         f.d[k] = d;
+         if( d < 0. )
+         {
+            f.negevals++;
+         }
+         for( Index i = 0; i < m2; i++ )
+         {
+            W[i + (size_t) k * m2] = Fk[p + i];
+         }
+         for( Index j = k + 1; j < p; j++ )
+         {
+            const T lj = Fk[j] / d;
+            if( lj == 0. )
+            {
+               continue;
+            }
+            T* Fj = &F[(size_t) j * nf];
+            for( Index i = k + 1; i < nf; i++ )
+            {
+               Fj[i] -= Fk[i] * lj;
+            }
+         }
+         const T dinv = T(1.) / d;
+         for( Index i = k + 1; i < nf; i++ )
+         {
+            Fk[i] *= dinv;
+         }
+      }
+      else
+      {
+         T* Fk1 = &F[(size_t)(k + 1) * nf];
+         const T a = Fk[k];
+         const T b = Fk[k + 1];
+         const T c = Fk1[k + 1];
+         const T det = a * c - b * b;
+         f.d[k] = a;
+         f.d[k + 1] = c;
+         f.e[k] = b;
+         f.n2x2++;
+         if( det < 0. )
+         {
+            f.negevals++;
+         }
+         else if( a + c < 0. )
+         {
+            f.negevals += 2;
+         }
+         for( Index i = 0; i < m2; i++ )
+         {
+            W[i + (size_t) k * m2] = Fk[p + i];
+            W[i + (size_t)(k + 1) * m2] = Fk1[p + i];
+         }
+         for( Index j = k + 2; j < p; j++ )
+         {
+            // row j of L times D
+            const T w1 = Fk[j];
+            const T w2 = Fk1[j];
+            const T l1 = (w1 * c - w2 * b) / det;
+            const T l2 = (w2 * a - w1 * b) / det;
+            if( l1 == 0. && l2 == 0. )
+            {
+               continue;
+            }
+            T* Fj = &F[(size_t) j * nf];
+            for( Index i = k + 2; i < nf; i++ )
+            {
+               Fj[i] -= Fk[i] * l1 + Fk1[i] * l2;
+            }
+         }
+         for( Index i = k + 2; i < nf; i++ )
+         {
+            const T w1 = Fk[i];
+            const T w2 = Fk1[i];
+            Fk[i] = (w1 * c - w2 * b) / det;
+            Fk1[i] = (w2 * a - w1 * b) / det;
+         }
+         Fk[k + 1] = 0.;
+      }
+      k += npiv;
+   }
+   const Index q = k;
+   f.nelim = q;
+   f.ndelay = f.singular ? 0 : p - q;
+
+   // update of the trailing block: T -= L_T * (L_T D)^T
+   if( q > 0 && m2 > 0 )
+   {
+      IpBlasGemm(false, true, m2, m2, q, T(-1.), &F[p], nf, &W[0], m2, T(1.), &F[p + (size_t) p * nf], nf);
+   }
+
+   // store the factor
+   (f.*L).assign(F.begin(), F.begin() + (size_t) q * nf);
+   f.d.resize(q);
+   f.e.resize(q);
+
+   // contribution block: delayed columns and trailing block
+   const Index m = nf - q;
+   if( f.parent >= 0 && m > 0 )
+   {
+      (f.*cb).resize((size_t) m * m);
+      for( Index j = 0; j < m; j++ )
+      {
+         const T* Fj = &F[q + (size_t)(q + j) * nf];
+         for( Index i = j; i < m; i++ )
+         {
+            (f.*cb)[i + (size_t) j * m] = Fj[i];
+            (f.*cb)[j + (size_t) i * m] = Fj[i];
+         }
+      }
+   }
+   else
+   {
+      std::vector<T>().swap(f.*cb);
+   }
+}
+
+void MultifrontalLdl::FactorFront(
+   Index  fidx,
+   Index* pos
+)
+{
+   if( single_precision_ )
+   {
+      FactorFrontImpl<float>(fidx, pos, &Front::Lsingle, &Front::cbsingle);
+   }
+   else
+   {
+      FactorFrontImpl<Number>(fidx, pos, &Front::L, &Front::cb);
+   }
+}
+
+#if __cplusplus >= 201103L
+namespace
+{
+/** task that factorizes one front and submits its parent once all
+ *  children of the parent are done */
+class FrontTask: public ThreadPoolTask
+{
+public:
+   FrontTask()
+      : front(-1),
+        parent(NULL),
+        pending(0),
+        work(NULL)
+   { }
+
+   Index front;
+   FrontTask* parent;
+   std::atomic<Index> pending;
+   std::vector<std::vector<Index> >* work;
+   std::function<void(Index, Index*)> factor;
+
+   void Run(
+      ThreadPool& pool,
+      Index       worker
+   )
+   {
+      factor(front, &(*work)[worker][0]);
+      if( parent != NULL && --parent->pending == 0 )
+      {
+         pool.Submit(parent);
+      }
+   }
+};
+}
+#endif
+
+void MultifrontalLdl::FactorFronts(
+   ThreadPool* pool
+)
+{
+   const Index nfronts = (Index) fronts_.size();
+#if __cplusplus >= 201103L
+   if( pool != NULL && pool->NumThreads() > 1 && nfronts > 1 )
+   {
+      std::vector<std::vector<Index> > work(pool->NumThreads(), std::vector<Index>(dim_));
+      std::unique_ptr<FrontTask[]> tasks(new FrontTask[nfronts]);
+      for( Index f = 0; f < nfronts; f++ )
+      {
+         tasks[f].front = f;
+         tasks[f].parent = fronts_[f].parent >= 0 ? &tasks[fronts_[f].parent] : NULL;
+         tasks[f].pending = (Index) fronts_[f].children.size();
+         tasks[f].work = &work;
+         tasks[f].factor = [this](Index front, Index* pos)
+         {
+            FactorFront(front, pos);
+         };
+      }
+      for( Index f = 0; f < nfronts; f++ )
+      {
+         if( fronts_[f].children.empty() )
+         {
+            pool->Submit(&tasks[f]);
+         }
+      }
+      pool->Wait();
+   }
+   else
+#else
+   (void) pool;
+#endif
+   {
+      std::vector<Index> pos(dim_);
+      for( Index f = 0; f < nfronts; f++ )
+      {
+         FactorFront(f, pos.empty() ? NULL : &pos[0]);
+      }
+   }
+}
+
+bool MultifrontalLdl::SingleFactorIsValid() const
+{
+   for( size_t f = 0; f < fronts_.size(); f++ )
+   {
+      const Front& front = fronts_[f];
+      if( front.singular )
+      {
+         return false;
+      }
+      for( Index k = 0; k < front.nelim; k++ )
+      {
+         if( !IsFiniteNumber(front.d[k]) || !IsFiniteNumber(front.e[k]) )
+         {
+            return false;
+         }
+      }
+      for( size_t k = 0; k < front.Lsingle.size(); k++ )
+      {
+         if( !IsFiniteNumber((Number) front.Lsingle[k]) )
+         {
+            return false;
+         }
+      }
+   }
+   return true;
+}
+
+ESymSolverStatus MultifrontalLdl::Factorize(
+   const Number* values,
+   Number        pivtol,
+   bool          scale,
+   ThreadPool*   pool,
+   bool          single_precision
+)
+{
+   DBG_START_METH("MultifrontalLdl::Factorize", dbg_verbosity);
+
+   pivtol_ = pivtol;
+   if( scale )
+   {
+      ComputeScaling(values);
+      values_.resize(nonzeros_);
+      for( Index k = 0; k < nonzeros_; k++ )
+      {
+         values_[k] = values[k] * scaling_[nz_row_[k]] * scaling_[nz_col_[k]];
+      }
+   }
+   else
+   {
+      scaling_.clear();
+      values_.assign(values, values + nonzeros_);
+   }
+
+   // single precision is only used if it differs from Number and all
+   // values can be represented
+   single_precision_ = single_precision && sizeof(float) < sizeof(Number);
+   for( Index k = 0; k < nonzeros_ && single_precision_; k++ )
+   {
+      single_precision_ = std::abs(values_[k]) <= max_single_value;
+   }
+
+   FactorFronts(pool);
+   if( single_precision_ && !SingleFactorIsValid() )
+   {
+      DBG_PRINT((1, "Single precision factorization failed, repeating in double precision.\n"));
+      single_precision_ = false;
+      FactorFronts(pool);
+   }
+
+   const Index nfronts = (Index) fronts_.size();
+   negevals_ = 0;
+   delayed_pivots_ = 0;
+   twobytwo_pivots_ = 0;
+   factor_entries_ = 0.;
+   bool singular = false;
+   for( Index f = 0; f < nfronts; f++ )
+   {
+      Front& front = fronts_[f];
+      // release the factor of a previous factorization in the other precision
+      if( single_precision_ )
+      {
+         std::vector<Number>().swap(front.L);
+      }
+      else
+      {
+         std::vector<float>().swap(front.Lsingle);
+      }
+      negevals_ += front.negevals;
+      delayed_pivots_ += front.ndelay;
+      twobytwo_pivots_ += front.n2x2;
+      const Number q = (Number) front.nelim;
+      factor_entries_ += q * (q + 1.) / 2. + q * (Number)(front.vars.size() - front.nelim);
+      singular = singular || front.singular;
+   }
+
+   return singular ? SYMSOLVER_SINGULAR : SYMSOLVER_SUCCESS;
+}
+
+template<typename T>
+void MultifrontalLdl::SolveImpl(
+   Index                         nrhs,
+   Number*                       rhs,
+   const std::vector<T> Front::* L
+) const
+{
+   const Index n = dim_;
+   if( n == 0 || nrhs == 0 )
+   {
+      return;
+   }
+   const bool scaled = !scaling_.empty();
+
+   // permute (and scale) right-hand sides
+   std::vector<T> y((size_t) n * nrhs);
+   for( Index r = 0; r < nrhs; r++ )
+   {
+      const Number* b = rhs + (size_t) r * n;
+      T* yr = &y[(size_t) r * n];
+      for( Index k = 0; k < n; k++ )
+      {
+         yr[k] = (T) (scaled ? b[perm_[k]] * scaling_[perm_[k]] : b[perm_[k]]);
+      }
+   }
+
+   const Index nfronts = (Index) fronts_.size();
+   std::vector<T> yl;
+
+   // forward substitution with L
+   for( Index fi = 0; fi < nfronts; fi++ )
+   {
+      const Front& f = fronts_[fi];
+      const Index nf = (Index) f.vars.size();
+      const Index q = f.nelim;
+      if( q == 0 )
+      {
+         continue;
+      }
+      yl.resize((size_t) nf * nrhs);
+      for( Index r = 0; r < nrhs; r++ )
+      {
+         const T* yr = &y[(size_t) r * n];
+         T* ylr = &yl[(size_t) r * nf];
+         for( Index i = 0; i < nf; i++ )
+         {
+            ylr[i] = yr[f.vars[i]];
+         }
+         for( Index k = 0; k < q; k++ )
+         {
+            const T* Lk = &(f.*L)[(size_t) k * nf];
+            const T yk = ylr[k];
+            if( yk == 0. )
+            {
+               continue;
+            }
+            for( Index i = k + 1; i < q; i++ )
+            {
+               ylr[i] -= Lk[i] * yk;
+            }
+         }
+      }
+      if( nf > q )
+      {
+         IpBlasGemm(false, false, nf - q, nrhs, q, T(-1.), &(f.*L)[q], nf, &yl[0], nf, T(1.), &yl[q], nf);
+      }
+      for( Index r = 0; r < nrhs; r++ )
+      {
+         T* yr = &y[(size_t) r * n];
+         const T* ylr = &yl[(size_t) r * nf];
+         for( Index i = 0; i < nf; i++ )
+         {
+            yr[f.vars[i]] = ylr[i];
+         }
+      }
+   }
+
+   // solve with D
+   for( Index fi = 0; fi < nfronts; fi++ )
+   {
+      const Front& f = fronts_[fi];
+      const Index q = f.nelim;
+      for( Index k = 0; k < q; k++ )
+      {
+         if( f.e[k] == 0. )
+         {
+            for( Index r = 0; r < nrhs; r++ )
+            {
+               y[f.vars[k] + (size_t) r * n] /= f.d[k];
+            }
+         }
+         else
+         {
+            const T a = (T) f.d[k];
+            const T b = (T) f.e[k];
+            const T c = (T) f.d[k + 1];
+            const T det = a * c - b * b;
+            for( Index r = 0; r < nrhs; r++ )
+            {
+               T& y1 = y[f.vars[k] + (size_t) r * n];
+               T& y2 = y[f.vars[k + 1] + (size_t) r * n];
+               const T t1 = (c * y1 - b * y2) / det;
+               const T t2 = (a * y2 - b * y1) / det;
+               y1 = t1;
+               y2 = t2;
+            }
+            k++;
+         }
+      }
+   }
+
+   // backward substitution with L^T
+   for( Index fi = nfronts - 1; fi >= 0; fi-- )
+   {
+      const Front& f = fronts_[fi];
+      const Index nf = (Index) f.vars.size();
+      const Index q = f.nelim;
+      if( q == 0 )
+      {
+         continue;
+      }
+      yl.resize((size_t) nf * nrhs);
+      for( Index r = 0; r < nrhs; r++ )
+      {
+         const T* yr = &y[(size_t) r * n];
+         T* ylr = &yl[(size_t) r * nf];
+         for( Index i = 0; i < nf; i++ )
+         {
+            ylr[i] = yr[f.vars[i]];
+         }
+      }
+      if( nf > q )
+      {
+         IpBlasGemm(true, false, q, nrhs, nf - q, T(-1.), &(f.*L)[q], nf, &yl[q], nf, T(1.), &yl[0], nf);
+      }
+      for( Index r = 0; r < nrhs; r++ )
+      {
+         T* yr = &y[(size_t) r * n];
+         T* ylr = &yl[(size_t) r * nf];
+         for( Index k = q - 1; k >= 0; k-- )
+         {
+            const T* Lk = &(f.*L)[(size_t) k * nf];
+            T s = ylr[k];
+            for( Index i = k + 1; i < q; i++ )
+            {
+               s -= Lk[i] * ylr[i];
+            }
+            ylr[k] = s;
+            yr[f.vars[k]] = s;
+         }
+      }
+   }
+
+   // permute back (and scale) solution
+   for( Index r = 0; r < nrhs; r++ )
+   {
+      Number* x = rhs + (size_t) r * n;
+      const T* yr = &y[(size_t) r * n];
+      for( Index k = 0; k < n; k++ )
+      {
+         x[perm_[k]] = scaled ? yr[k] * scaling_[perm_[k]] : yr[k];
+      }
+   }
+}
+
+void MultifrontalLdl::Solve(
+   Index   nrhs,
+   Number* rhs
+) const
+{
+   DBG_START_METH("MultifrontalLdl::Solve", dbg_verbosity);
+
+   if( single_precision_ )
+   {
+      SolveImpl<float>(nrhs, rhs, &Front::Lsingle);
+   }
+   else
+   {
+      SolveImpl<Number>(nrhs, rhs, &Front::L);
+   }
+}
+
+} // namespace Ipopt
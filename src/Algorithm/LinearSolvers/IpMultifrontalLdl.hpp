@@ -0,0 +1,327 @@
+// Copyright (C) 2021 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPMULTIFRONTALLDL_HPP__
+#define __IPMULTIFRONTALLDL_HPP__
+
+#include "IpUtils.hpp"
+#include "IpReferenced.hpp"
+#include "IpSymLinearSolver.hpp"
+#include "IpThreadPool.hpp"
+
+#include <vector>
+
+namespace Ipopt
+{
+
+/** Multifrontal LDL^T factorization of sparse symmetric indefinite matrices.
+ *
+ *  The matrix is given as the upper triangular part in compressed
+ *  sparse row format with 0-offset (see TripletToCSRConverter).
+ *
+ *  Analyze computes a fill-reducing ordering (approximate minimum
+ *  degree), the elimination tree, and the supernodes (fundamental
+ *  supernodes, amalgamated while both fronts have fewer than nemin
+ *  pivots or if no explicit zeros are introduced).  If values are
+ *  given, rows with a tiny diagonal (such as the constraint rows of
+ *  a KKT matrix) are paired with their largest off-diagonal entry
+ *  beforehand, and every pair is ordered as one node, so that it can
+ *  be eliminated as a 2x2 pivot instead of being delayed.  Factorize assembles the frontal matrices along the
+ *  assembly tree and factorizes their fully summed part with
+ *  Bunch-Kaufman type 1x1 and 2x2 pivots, subject to the threshold
+ *  test of Duff and Reid (as in MA57).  Pivots that fail this test
+ *  are delayed to the parent front.  The update of the contribution
+ *  block is done with one BLAS-3 call per front.
+ *
+ *  The fronts of independent subtrees are factorized in parallel if
+ *  a ThreadPool with more than one thread is given: every front is a
+ *  task that is submitted as soon as all its children are done.
+ *
+ *  On request, the frontal matrices, the contribution blocks, and
+ *  the factor are computed and stored in single precision, which
+ *  halves the memory for the factor.  The solutions are then only
+ *  accurate to single precision and have to be improved by iterative
+ *  refinement with residuals computed in double precision.
+ */
+class MultifrontalLdl: public ReferencedObject
+{
+public:
+   /** @name Constructor/Destructor */
+   ///@{
+   MultifrontalLdl();
+
+   virtual ~MultifrontalLdl();
+   ///@}
+
+   /** Symbolic analysis for a matrix with given structure.
+    *
+    *  ia and ja describe the upper triangular part in CSR format with
+    *  0-offset.  values may be NULL; otherwise, they are used to
+    *  choose 2x2 pivots for rows with a tiny diagonal.  The arrays are
+    *  not referenced after this call.
+    */
+   void Analyze(
+      Index         dim,
+      const Index*  ia,
+      const Index*  ja,
+      const Number* values,
+      Index         nemin
+   );
+
+   /** Copy the symbolic analysis of another object.
+    *
+    *  The data of a factorization of this object is discarded, so
+    *  Factorize has to be called before the next Solve.
+    */
+   void CopyAnalysis(
+      const MultifrontalLdl& other
+   );
+
+   /** Numerical factorization.
+    *
+    *  values are the nonzero elements in the order given by the ja
+    *  array in Analyze.  pivtol is the relative pivot tolerance u of
+    *  the threshold test (0 < u <= 0.5).  If scale is true, the matrix
+    *  is equilibrated before it is factorized.  If pool is not NULL,
+    *  it is used to factorize independent fronts concurrently.
+    *
+    *  If single_precision is true, the factorization is computed in
+    *  single precision.  If the (scaled) values are too large for
+    *  single precision, or if the single precision factorization is
+    *  singular or produces non-finite numbers, the factorization is
+    *  computed in double precision instead (see SinglePrecision()).
+    *
+    *  @return SYMSOLVER_SUCCESS or SYMSOLVER_SINGULAR.
+    */
+   ESymSolverStatus Factorize(
+      const Number* values,
+      Number        pivtol,
+      bool          scale,
+      ThreadPool*   pool,
+      bool          single_precision
+   );
+
+   /** Solve with the most recent factorization for nrhs right-hand
+    *  sides, which are stored one after the other in rhs and are
+    *  overwritten by the solutions.
+    */
+   void Solve(
+      Index   nrhs,
+      Number* rhs
+   ) const;
+
+   /** @name Information about the analysis and the most recent factorization */
+   ///@{
+   /** Dimension of the matrix */
+   Index Dim() const
+   {
+      return dim_;
+   }
+
+   /** Number of fronts in the assembly tree */
+   Index NumberOfFronts() const
+   {
+      return (Index) fronts_.size();
+   }
+
+   /** Number of entries in L predicted by the analysis */
+   Number PredictedFactorEntries() const
+   {
+      return predicted_factor_entries_;
+   }
+
+   /** Number of entries in L of the most recent factorization */
+   Number FactorEntries() const
+   {
+      return factor_entries_;
+   }
+
+   /** Number of negative eigenvalues of the most recently factorized matrix */
+   Index NumberOfNegEVals() const
+   {
+      return negevals_;
+   }
+
+   /** Number of pivots that were delayed in the most recent factorization */
+   Index NumberOfDelayedPivots() const
+   {
+      return delayed_pivots_;
+   }
+
+   /** Number of 2x2 pivots in the most recent factorization */
+   Index NumberOf2x2Pivots() const
+   {
+      return twobytwo_pivots_;
+   }
+
+   /** Whether the most recent factorization was computed in single precision */
+   bool SinglePrecision() const
+   {
+      return single_precision_;
+   }
+   ///@}
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called. */
+   ///@{
+   /** Copy Constructor */
+   MultifrontalLdl(
+      const MultifrontalLdl&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const MultifrontalLdl&
+   );
+   ///@}
+
+   /** A front (amalgamated supernode) in the assembly tree. */
+   struct Front
+   {
+      /** @name Symbolic data */
+      ///@{
+      /** First column (in permuted numbering) eliminated in this front */
+      Index first;
+      /** Number of columns assigned to this front by the analysis */
+      Index ncols;
+      /** Rows (in permuted numbering) below the pivot block, sorted */
+      std::vector<Index> rows;
+      /** Parent front, or -1 for a root */
+      Index parent;
+      /** Child fronts */
+      std::vector<Index> children;
+      /** Range of this front in the assembly arrays */
+      Index asm_begin;
+      Index asm_end;
+      ///@}
+
+      /** @name Numeric data of the most recent factorization */
+      ///@{
+      /** Variables of the front in pivot order */
+      std::vector<Index> vars;
+      /** Number of pivots eliminated in this front */
+      Index nelim;
+      /** Number of pivots delayed to the parent */
+      Index ndelay;
+      /** Columns of L (vars.size() x nelim, column-major) */
+      std::vector<Number> L;
+      /** Columns of L if factorized in single precision */
+      std::vector<float> Lsingle;
+      /** Diagonal of D */
+      std::vector<Number> d;
+      /** Subdiagonal of D; nonzero entry k marks a 2x2 pivot in k,k+1 */
+      std::vector<Number> e;
+      /** Contribution block for the parent (full storage) */
+      std::vector<Number> cb;
+      /** Contribution block if factorized in single precision */
+      std::vector<float> cbsingle;
+      /** Number of negative eigenvalues of D */
+      Index negevals;
+      /** Number of 2x2 pivots */
+      Index n2x2;
+      /** Whether a zero pivot was encountered */
+      bool singular;
+      ///@}
+   };
+
+   /** Compute a fill-reducing ordering (approximate minimum degree)
+    *  of the graph given by adj_ptr and adj, where node i stands for
+    *  weight[i] variables.
+    */
+   static void MinimumDegreeOrdering(
+      Index                     n,
+      const std::vector<Index>& adj_ptr,
+      const std::vector<Index>& adj,
+      const std::vector<Index>& weight,
+      std::vector<Index>&       order
+   );
+
+   /** Assemble and partially factorize front f in the precision of
+    *  the current factorization.
+    *
+    *  pos is a workspace of length dim_.
+    */
+   void FactorFront(
+      Index  f,
+      Index* pos
+   );
+
+   /** Assemble and partially factorize front f with arithmetic in T,
+    *  storing the factor in member L and the contribution block in
+    *  member cb of the front.
+    */
+   template<typename T>
+   void FactorFrontImpl(
+      Index                   f,
+      Index*                  pos,
+      std::vector<T> Front::* L,
+      std::vector<T> Front::* cb
+   );
+
+   /** Factorize all fronts, concurrently if pool is not NULL */
+   void FactorFronts(
+      ThreadPool* pool
+   );
+
+   /** Check that a single precision factorization is nonsingular and finite */
+   bool SingleFactorIsValid() const;
+
+   /** Solve with the factor in member L of the fronts with arithmetic in T */
+   template<typename T>
+   void SolveImpl(
+      Index                         nrhs,
+      Number*                       rhs,
+      const std::vector<T> Front::* L
+   ) const;
+
+   /** Compute symmetric equilibration factors for the matrix values */
+   void ComputeScaling(
+      const Number* values
+   );
+
+   /** @name Symbolic data */
+   ///@{
+   Index dim_;
+   Index nonzeros_;
+   /** Permutation: perm_[k] is the original index of the k-th pivot */
+   std::vector<Index> perm_;
+   /** Row index (original numbering) of every nonzero */
+   std::vector<Index> nz_row_;
+   /** Column index (original numbering) of every nonzero */
+   std::vector<Index> nz_col_;
+   /** Fronts in a topological (postorder) order */
+   std::vector<Front> fronts_;
+   /** Assembly map: nonzero, local row, and local column of original entries */
+   std::vector<Index> asm_nz_;
+   std::vector<Index> asm_row_;
+   std::vector<Index> asm_col_;
+   Number predicted_factor_entries_;
+   ///@}
+
+   /** @name Numeric data */
+   ///@{
+   /** Scaled matrix values used during factorization */
+   std::vector<Number> values_;
+   /** Scaling factors (original numbering); empty if not scaled */
+   std::vector<Number> scaling_;
+   /** Pivot tolerance used in the current factorization */
+   Number pivtol_;
+   /** Whether the current factorization is in single precision */
+   bool single_precision_;
+   Index negevals_;
+   Index delayed_pivots_;
+   Index twobytwo_pivots_;
+   Number factor_entries_;
+   ///@}
+};
+
+} // namespace Ipopt
+
+#endif
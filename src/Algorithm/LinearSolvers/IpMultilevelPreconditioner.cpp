@@ -0,0 +1,640 @@
+// Copyright (C) 2021 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpoptConfig.h"
+#include "IpMultilevelPreconditioner.hpp"
+
+#include <cmath>
+#include <algorithm>
+#include <utility>
+
+namespace Ipopt
+{
+#if IPOPT_VERBOSITY > 0
+static const Index dbg_verbosity = 0;
+#endif
+
+/** damping factor of the Jacobi smoother */
+static const Number jacobi_omega = 2. / 3.;
+
+MultilevelBlockPreconditioner::MultilevelBlockPreconditioner(
+   Index  coarse_size,
+   Index  max_levels,
+   Number strength,
+   Number schur_droptol,
+   Number schur_fill,
+   Number pivtol,
+   Index  pattern_reuse
+)
+   : coarse_size_(coarse_size),
+     max_levels_(max_levels),
+     strength_(strength),
+     schur_droptol_(schur_droptol),
+     schur_fill_(schur_fill),
+     pivtol_(pivtol),
+     pattern_reuse_(pattern_reuse),
+     dim_(0),
+     n11_(-1),
+     refactorizations_(0)
+{ }
+
+MultilevelBlockPreconditioner::~MultilevelBlockPreconditioner()
+{ }
+
+void MultilevelBlockPreconditioner::InitializeStructure(
+   Index        dim,
+   const Index* ia,
+   const Index* ja
+)
+{
+   DBG_START_METH("MultilevelBlockPreconditioner::InitializeStructure", dbg_verbosity);
+
+   if( n11_ < 0 || n11_ > dim )
+   {
+      n11_ = dim;
+   }
+   dim_ = dim;
+   const Index n2 = dim - n11_;
+
+   // level 0 is H in full CSR format
+   levels_.clear();
+   levels_.resize(n11_ > 0 ? 1 : 0);
+   if( n11_ > 0 )
+   {
+      Level& H = levels_[0];
+      H.n = n11_;
+      H.ptr.assign(n11_ + 1, 0);
+      for( Index i = 0; i < n11_; i++ )
+      {
+         for( Index p = ia[i]; p < ia[i + 1]; p++ )
+         {
+            const Index j = ja[p];
+            if( j < n11_ )
+            {
+               H.ptr[i + 1]++;
+               if( j != i )
+               {
+                  H.ptr[j + 1]++;
+               }
+            }
+         }
+      }
+      for( Index i = 0; i < n11_; i++ )
+      {
+         H.ptr[i + 1] += H.ptr[i];
+      }
+      H.col.resize(H.ptr[n11_]);
+      h_src_.resize(H.ptr[n11_]);
+      std::vector<Index> next(H.ptr.begin(), H.ptr.end() - 1);
+      for( Index i = 0; i < n11_; i++ )
+      {
+         for( Index p = ia[i]; p < ia[i + 1]; p++ )
+         {
+            const Index j = ja[p];
+            if( j < n11_ )
+            {
+               H.col[next[i]] = j;
+               h_src_[next[i]++] = p;
+               if( j != i )
+               {
+                  H.col[next[j]] = i;
+                  h_src_[next[j]++] = p;
+               }
+            }
+         }
+      }
+      H.val.resize(H.ptr[n11_]);
+   }
+
+   // the columns of B are the parts of the rows of H's block row beyond n11
+   bt_ptr_.assign(n11_ + 1, 0);
+   bt_row_.clear();
+   bt_src_.clear();
+   for( Index i = 0; i < n11_; i++ )
+   {
+      for( Index p = ia[i]; p < ia[i + 1]; p++ )
+      {
+         if( ja[p] >= n11_ )
+         {
+            bt_row_.push_back(ja[p] - n11_);
+            bt_src_.push_back(p);
+         }
+      }
+      bt_ptr_[i + 1] = (Index) bt_row_.size();
+   }
+   c_src_.assign(n2, -1);
+   for( Index i = n11_; i < dim; i++ )
+   {
+      for( Index p = ia[i]; p < ia[i + 1]; p++ )
+      {
+         if( ja[p] == i )
+         {
+            c_src_[i - n11_] = p;
+         }
+      }
+   }
+
+   // structure of S = B |diag(H)|^{-1} B^T + C: the diagonal and all pairs of rows of a column of B
+   schur_ldl_ = NULL;
+   s_ptr_.clear();
+   s_col_.clear();
+   s_pos_.clear();
+   s_diag_.clear();
+   if( n2 > 0 )
+   {
+      std::vector<std::pair<Index, Index> > entries;
+      for( Index r = 0; r < n2; r++ )
+      {
+         entries.push_back(std::make_pair(r, r));
+      }
+      for( Index i = 0; i < n11_; i++ )
+      {
+         for( Index a = bt_ptr_[i]; a < bt_ptr_[i + 1]; a++ )
+         {
+            for( Index b = a; b < bt_ptr_[i + 1]; b++ )
+            {
+               entries.push_back(std::make_pair(Min(bt_row_[a], bt_row_[b]), Max(bt_row_[a], bt_row_[b])));
+            }
+         }
+      }
+      std::sort(entries.begin(), entries.end());
+      entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+
+      s_ptr_.assign(n2 + 1, 0);
+      s_col_.resize(entries.size());
+      for( size_t e = 0; e < entries.size(); e++ )
+      {
+         s_ptr_[entries[e].first + 1]++;
+         s_col_[e] = entries[e].second;
+      }
+      for( Index r = 0; r < n2; r++ )
+      {
+         s_ptr_[r + 1] += s_ptr_[r];
+      }
+      s_val_.resize(entries.size());
+
+      // the rows are sorted, so the diagonal is the first entry of every row
+      s_diag_.assign(s_ptr_.begin(), s_ptr_.end() - 1);
+      for( Index i = 0; i < n11_; i++ )
+      {
+         for( Index a = bt_ptr_[i]; a < bt_ptr_[i + 1]; a++ )
+         {
+            for( Index b = a; b < bt_ptr_[i + 1]; b++ )
+            {
+               const Index r = Min(bt_row_[a], bt_row_[b]);
+               const Index c = Max(bt_row_[a], bt_row_[b]);
+               const Index* pos = std::lower_bound(&s_col_[0] + s_ptr_[r], &s_col_[0] + s_ptr_[r + 1], c);
+               s_pos_.push_back((Index) (pos - &s_col_[0]));
+            }
+         }
+      }
+
+      schur_ldl_ = new IncompleteLdlPreconditioner(schur_droptol_, schur_fill_, pivtol_, true, pattern_reuse_);
+      schur_ldl_->SetPositiveDefinite(true);
+      schur_ldl_->InitializeStructure(n2, &s_ptr_[0], &s_col_[0]);
+   }
+
+   coarsest_ldl_ = NULL;
+   refactorizations_ = 0;
+}
+
+ESymSolverStatus MultilevelBlockPreconditioner::Factorize(
+   const Number* values
+)
+{
+   DBG_START_METH("MultilevelBlockPreconditioner::Factorize", dbg_verbosity);
+
+   if( n11_ > 0 )
+   {
+      Level& H = levels_[0];
+      for( size_t p = 0; p < H.val.size(); p++ )
+      {
+         H.val[p] = values[h_src_[p]];
+      }
+
+      if( IsNull(coarsest_ldl_) || refactorizations_ >= pattern_reuse_ )
+      {
+         BuildHierarchy();
+         refactorizations_ = 0;
+      }
+      else
+      {
+         for( Index l = 0; l + 1 < (Index) levels_.size(); l++ )
+         {
+            ComputeCoarseValues(l);
+         }
+         refactorizations_++;
+      }
+      for( Index l = 0; l < (Index) levels_.size(); l++ )
+      {
+         ComputeInverseDiagonal(l);
+      }
+
+      const Level& C = levels_.back();
+      for( size_t p = 0; p < coarsest_src_.size(); p++ )
+      {
+         coarsest_val_[p] = C.val[coarsest_src_[p]];
+      }
+      coarsest_ldl_->SetPositiveDefinite(PositiveDefinite());
+      ESymSolverStatus retval = coarsest_ldl_->Factorize(&coarsest_val_[0]);
+      if( retval != SYMSOLVER_SUCCESS )
+      {
+         coarsest_ldl_ = NULL;
+         return retval;
+      }
+   }
+
+   if( IsValid(schur_ldl_) )
+   {
+      const Index n2 = dim_ - n11_;
+      std::fill(s_val_.begin(), s_val_.end(), 0.);
+      // B |diag(H)|^{-1} B^T
+      Index k = 0;
+      for( Index i = 0; i < n11_; i++ )
+      {
+         for( Index a = bt_ptr_[i]; a < bt_ptr_[i + 1]; a++ )
+         {
+            const Number f = values[bt_src_[a]] * levels_[0].inv_diag[i];
+            for( Index b = a; b < bt_ptr_[i + 1]; b++ )
+            {
+               s_val_[s_pos_[k++]] += f * values[bt_src_[b]];
+            }
+         }
+      }
+      // + C, where -C is the diagonal of the (2,2) block
+      for( Index r = 0; r < n2; r++ )
+      {
+         if( c_src_[r] >= 0 )
+         {
+            s_val_[s_diag_[r]] -= values[c_src_[r]];
+         }
+      }
+      ESymSolverStatus retval = schur_ldl_->Factorize(&s_val_[0]);
+      if( retval != SYMSOLVER_SUCCESS )
+      {
+         return retval;
+      }
+   }
+
+   return SYMSOLVER_SUCCESS;
+}
+
+void MultilevelBlockPreconditioner::BuildHierarchy()
+{
+   DBG_START_METH("MultilevelBlockPreconditioner::BuildHierarchy", dbg_verbosity);
+
+   levels_.resize(1);
+   Index l = 0;
+   while( levels_[l].n > coarse_size_ && l + 1 < max_levels_ && Coarsen(l) )
+   {
+      ComputeCoarseValues(l);
+      l++;
+   }
+   levels_[l].agg.clear();
+   levels_[l].coarse_pos.clear();
+   for( Index k = 0; k <= l; k++ )
+   {
+      levels_[k].work.resize(3 * levels_[k].n);
+   }
+
+   InitializeCoarsest();
+}
+
+bool MultilevelBlockPreconditioner::Coarsen(
+   Index l
+)
+{
+   DBG_START_METH("MultilevelBlockPreconditioner::Coarsen", dbg_verbosity);
+
+   Level& A = levels_[l];
+   const Index n = A.n;
+
+   std::vector<Number> diag(n, 0.);
+   for( Index i = 0; i < n; i++ )
+   {
+      for( Index p = A.ptr[i]; p < A.ptr[i + 1]; p++ )
+      {
+         if( A.col[p] == i )
+         {
+            diag[i] += A.val[p];
+         }
+      }
+   }
+
+   // strong connections
+   std::vector<bool> strong(A.col.size(), false);
+   std::vector<bool> isolated(n, true);
+   for( Index i = 0; i < n; i++ )
+   {
+      for( Index p = A.ptr[i]; p < A.ptr[i + 1]; p++ )
+      {
+         const Index j = A.col[p];
+         if( j != i && A.val[p] != 0. && std::abs(A.val[p]) >= strength_ * std::sqrt(std::abs(diag[i] * diag[j])) )
+         {
+            strong[p] = true;
+            isolated[i] = false;
+         }
+      }
+   }
+
+   // greedy aggregation; rows without strong connections are not interpolated
+   std::vector<Index>& agg = A.agg;
+   agg.assign(n, -1);
+   Index nc = 0;
+   // pass 1: rows whose strong neighbors are all free form an aggregate with them
+   for( Index i = 0; i < n; i++ )
+   {
+      if( isolated[i] || agg[i] >= 0 )
+      {
+         continue;
+      }
+      bool all_free = true;
+      for( Index p = A.ptr[i]; p < A.ptr[i + 1] && all_free; p++ )
+      {
+         if( strong[p] && agg[A.col[p]] >= 0 )
+         {
+            all_free = false;
+         }
+      }
+      if( all_free )
+      {
+         agg[i] = nc;
+         for( Index p = A.ptr[i]; p < A.ptr[i + 1]; p++ )
+         {
+            if( strong[p] )
+            {
+               agg[A.col[p]] = nc;
+            }
+         }
+         nc++;
+      }
+   }
+   // pass 2: remaining rows join the aggregate of their strongest aggregated neighbor
+   std::vector<Index> agg1(agg);
+   for( Index i = 0; i < n; i++ )
+   {
+      if( isolated[i] || agg1[i] >= 0 )
+      {
+         continue;
+      }
+      Number best = 0.;
+      for( Index p = A.ptr[i]; p < A.ptr[i + 1]; p++ )
+      {
+         if( strong[p] && agg1[A.col[p]] >= 0 && std::abs(A.val[p]) > best )
+         {
+            best = std::abs(A.val[p]);
+            agg[i] = agg1[A.col[p]];
+         }
+      }
+   }
+   // pass 3: rows that are still free form aggregates with their free strong neighbors
+   for( Index i = 0; i < n; i++ )
+   {
+      if( isolated[i] || agg[i] >= 0 )
+      {
+         continue;
+      }
+      agg[i] = nc;
+      for( Index p = A.ptr[i]; p < A.ptr[i + 1]; p++ )
+      {
+         if( strong[p] && agg[A.col[p]] < 0 )
+         {
+            agg[A.col[p]] = nc;
+         }
+      }
+      nc++;
+   }
+
+   if( nc == 0 || nc > 0.9 * n )
+   {
+      agg.clear();
+      return false;
+   }
+
+   // structure of P^T A P
+   std::vector<Index> members_ptr(nc + 1, 0);
+   for( Index i = 0; i < n; i++ )
+   {
+      if( agg[i] >= 0 )
+      {
+         members_ptr[agg[i] + 1]++;
+      }
+   }
+   for( Index c = 0; c < nc; c++ )
+   {
+      members_ptr[c + 1] += members_ptr[c];
+   }
+   std::vector<Index> members(members_ptr[nc]);
+   std::vector<Index> next(members_ptr.begin(), members_ptr.end() - 1);
+   for( Index i = 0; i < n; i++ )
+   {
+      if( agg[i] >= 0 )
+      {
+         members[next[agg[i]]++] = i;
+      }
+   }
+
+   Level C;
+   C.n = nc;
+   C.ptr.assign(1, 0);
+   A.coarse_pos.assign(A.col.size(), -1);
+   std::vector<Index> marker(nc, -1);
+   for( Index c = 0; c < nc; c++ )
+   {
+      for( Index m = members_ptr[c]; m < members_ptr[c + 1]; m++ )
+      {
+         const Index i = members[m];
+         for( Index p = A.ptr[i]; p < A.ptr[i + 1]; p++ )
+         {
+            const Index cj = agg[A.col[p]];
+            if( cj < 0 )
+            {
+               continue;
+            }
+            if( marker[cj] < C.ptr[c] )
+            {
+               marker[cj] = (Index) C.col.size();
+               C.col.push_back(cj);
+            }
+            A.coarse_pos[p] = marker[cj];
+         }
+      }
+      C.ptr.push_back((Index) C.col.size());
+   }
+   C.val.resize(C.col.size());
+
+   levels_.resize(l + 2);
+   levels_[l + 1] = C;
+   return true;
+}
+
+void MultilevelBlockPreconditioner::ComputeCoarseValues(
+   Index l
+)
+{
+   const Level& A = levels_[l];
+   Level& C = levels_[l + 1];
+   std::fill(C.val.begin(), C.val.end(), 0.);
+   for( size_t p = 0; p < A.val.size(); p++ )
+   {
+      if( A.coarse_pos[p] >= 0 )
+      {
+         C.val[A.coarse_pos[p]] += A.val[p];
+      }
+   }
+}
+
+void MultilevelBlockPreconditioner::ComputeInverseDiagonal(
+   Index l
+)
+{
+   Level& A = levels_[l];
+   A.inv_diag.resize(A.n);
+   for( Index i = 0; i < A.n; i++ )
+   {
+      Number d = 0.;
+      Number rowmax = 0.;
+      for( Index p = A.ptr[i]; p < A.ptr[i + 1]; p++ )
+      {
+         if( A.col[p] == i )
+         {
+            d += A.val[p];
+         }
+         rowmax = Max(rowmax, std::abs(A.val[p]));
+      }
+      if( d != 0. )
+      {
+         A.inv_diag[i] = 1. / std::abs(d);
+      }
+      else
+      {
+         A.inv_diag[i] = rowmax > 0. ? 1. / rowmax : 1.;
+      }
+   }
+}
+
+void MultilevelBlockPreconditioner::InitializeCoarsest()
+{
+   DBG_START_METH("MultilevelBlockPreconditioner::InitializeCoarsest", dbg_verbosity);
+
+   const Level& C = levels_.back();
+   std::vector<Index> ia(1, 0);
+   std::vector<Index> ja;
+   coarsest_src_.clear();
+   for( Index i = 0; i < C.n; i++ )
+   {
+      for( Index p = C.ptr[i]; p < C.ptr[i + 1]; p++ )
+      {
+         if( C.col[p] >= i )
+         {
+            ja.push_back(C.col[p]);
+            coarsest_src_.push_back(p);
+         }
+      }
+      ia.push_back((Index) ja.size());
+   }
+   coarsest_val_.resize(coarsest_src_.size());
+
+   if( C.n <= coarse_size_ )
+   {
+      coarsest_ldl_ = new IncompleteLdlPreconditioner(0., (Number) C.n, pivtol_, true, pattern_reuse_);
+   }
+   else
+   {
+      coarsest_ldl_ = new IncompleteLdlPreconditioner(schur_droptol_, schur_fill_, pivtol_, true, pattern_reuse_);
+   }
+   coarsest_ldl_->InitializeStructure(C.n, &ia[0], ja.empty() ? NULL : &ja[0]);
+}
+
+void MultilevelBlockPreconditioner::VCycle(
+   Index         l,
+   const Number* b,
+   Number*       x
+) const
+{
+   if( l + 1 == (Index) levels_.size() )
+   {
+      coarsest_ldl_->Apply(b, x);
+      return;
+   }
+
+   const Level& A = levels_[l];
+   const Level& C = levels_[l + 1];
+   const Index n = A.n;
+   Number* r = &A.work[2 * n];
+   Number* bc = &C.work[0];
+   Number* xc = &C.work[C.n];
+
+   // pre-smoothing, starting from zero
+   for( Index i = 0; i < n; i++ )
+   {
+      x[i] = jacobi_omega * A.inv_diag[i] * b[i];
+   }
+
+   // coarse grid correction
+   for( Index i = 0; i < n; i++ )
+   {
+      Number ri = b[i];
+      for( Index p = A.ptr[i]; p < A.ptr[i + 1]; p++ )
+      {
+         ri -= A.val[p] * x[A.col[p]];
+      }
+      r[i] = ri;
+   }
+   std::fill(bc, bc + C.n, 0.);
+   for( Index i = 0; i < n; i++ )
+   {
+      if( A.agg[i] >= 0 )
+      {
+         bc[A.agg[i]] += r[i];
+      }
+   }
+   VCycle(l + 1, bc, xc);
+   for( Index i = 0; i < n; i++ )
+   {
+      if( A.agg[i] >= 0 )
+      {
+         x[i] += xc[A.agg[i]];
+      }
+   }
+
+   // post-smoothing
+   for( Index i = 0; i < n; i++ )
+   {
+      Number ri = b[i];
+      for( Index p = A.ptr[i]; p < A.ptr[i + 1]; p++ )
+      {
+         ri -= A.val[p] * x[A.col[p]];
+      }
+      r[i] = ri;
+   }
+   for( Index i = 0; i < n; i++ )
+   {
+      x[i] += jacobi_omega * A.inv_diag[i] * r[i];
+   }
+}
+
+void MultilevelBlockPreconditioner::Apply(
+   const Number* r,
+   Number*       z
+) const
+{
+   if( n11_ > 0 )
+   {
+      VCycle(0, r, z);
+   }
+   if( IsValid(schur_ldl_) )
+   {
+      schur_ldl_->Apply(r + n11_, z + n11_);
+      if( !PositiveDefinite() )
+      {
+         for( Index i = n11_; i < dim_; i++ )
+         {
+            z[i] = -z[i];
+         }
+      }
+   }
+}
+
+} // namespace Ipopt
@@ -0,0 +1,227 @@
+// Copyright (C) 2021 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPMULTILEVELPRECONDITIONER_HPP__
+#define __IPMULTILEVELPRECONDITIONER_HPP__
+
+#include "IpSymPreconditioner.hpp"
+#include "IpIncompleteLdl.hpp"
+#include "IpSmartPtr.hpp"
+
+#include <vector>
+
+namespace Ipopt
+{
+
+/** Block diagonal preconditioner for an augmented system
+ *  \f[\left[\begin{array}{cc} H & B^T\\ B & -C\end{array}\right]\f]
+ *  with an algebraic multigrid cycle for the (1,1) block.
+ *
+ *  The size of the (1,1) block H has to be set with SetBlockSize
+ *  before InitializeStructure.  The preconditioner is
+ *  \f$\mbox{diag}(M_H, \pm S)\f$, where \f$M_H^{-1}\f$ is one V-cycle
+ *  of an aggregation-based algebraic multigrid method for H and S is
+ *  an incomplete LDL^T factorization of the approximate Schur
+ *  complement \f$B\,|\mbox{diag}(H)|^{-1}B^T + C\f$.  The sign of the
+ *  second block is negative unless the preconditioner has to be
+ *  positive definite.
+ *
+ *  The multigrid hierarchy is built from the strong connections
+ *  \f$|h_{ij}| \geq \theta \sqrt{|h_{ii} h_{jj}|}\f$ by greedy
+ *  aggregation and piecewise constant interpolation; rows without
+ *  strong connections are left to the smoother.  Every level uses one
+ *  sweep of damped Jacobi as pre- and post-smoother, and the coarsest
+ *  level is factorized completely if it has at most coarse_size rows,
+ *  and incompletely otherwise.  Since the aggregates
+ *  depend on the values, they are computed anew only after
+ *  pattern_reuse factorizations; in between, only the values of the
+ *  coarse matrices and the factors are recomputed.
+ *
+ *  If the preconditioner has to be positive definite, the V-cycle is
+ *  positive definite only if H is (close to) positive definite.  For
+ *  an indefinite H, an iterative solver like MINRES then reports a
+ *  breakdown, and the caller should increase the regularization.
+ *
+ *  @since 3.14.5
+ */
+class MultilevelBlockPreconditioner: public SymPreconditioner
+{
+public:
+   /** @name Constructor/Destructor */
+   ///@{
+   /** Constructor.
+    *
+    *  @param coarse_size    the coarsening stops at this number of rows
+    *  @param max_levels     maximal number of levels of the multigrid hierarchy
+    *  @param strength       threshold theta for strong connections
+    *  @param schur_droptol  drop tolerance for the incomplete factorization of S
+    *  @param schur_fill     fill factor for the incomplete factorization of S
+    *  @param pivtol         pivot tolerance for the factorizations
+    *  @param pattern_reuse  number of factorizations with the same aggregates
+    */
+   MultilevelBlockPreconditioner(
+      Index  coarse_size,
+      Index  max_levels,
+      Number strength,
+      Number schur_droptol,
+      Number schur_fill,
+      Number pivtol,
+      Index  pattern_reuse
+   );
+
+   virtual ~MultilevelBlockPreconditioner();
+   ///@}
+
+   /** Set the size of the (1,1) block */
+   void SetBlockSize(
+      Index n11
+   )
+   {
+      n11_ = n11;
+   }
+
+   virtual void InitializeStructure(
+      Index        dim,
+      const Index* ia,
+      const Index* ja
+   );
+
+   virtual ESymSolverStatus Factorize(
+      const Number* values
+   );
+
+   virtual void Apply(
+      const Number* r,
+      Number*       z
+   ) const;
+
+   /** Number of levels of the multigrid hierarchy */
+   Index NumberOfLevels() const
+   {
+      return (Index) levels_.size();
+   }
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called. */
+   ///@{
+   /** Default Constructor */
+   MultilevelBlockPreconditioner();
+
+   /** Copy Constructor */
+   MultilevelBlockPreconditioner(
+      const MultilevelBlockPreconditioner&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const MultilevelBlockPreconditioner&
+   );
+   ///@}
+
+   /** A level of the multigrid hierarchy; the matrix is stored in full (both triangles) CSR format */
+   struct Level
+   {
+      Index n;
+      std::vector<Index> ptr;
+      std::vector<Index> col;
+      std::vector<Number> val;
+      /** Inverse of the absolute diagonal, for the Jacobi smoother */
+      std::vector<Number> inv_diag;
+      /** Aggregate (row of the next level) of every row, or -1; empty on the coarsest level */
+      std::vector<Index> agg;
+      /** Position in the values of the next level of every entry, or -1 */
+      std::vector<Index> coarse_pos;
+      /** Work space: right hand side, solution and residual */
+      mutable std::vector<Number> work;
+   };
+
+   /** Compute the aggregates of level l and build level l+1 */
+   bool Coarsen(
+      Index l
+   );
+
+   /** Compute the values of level l+1 from level l */
+   void ComputeCoarseValues(
+      Index l
+   );
+
+   /** Compute the inverse of the absolute diagonal of level l */
+   void ComputeInverseDiagonal(
+      Index l
+   );
+
+   /** Compute the aggregates and the structure of all levels */
+   void BuildHierarchy();
+
+   /** Set up the structure of the complete factorization of the coarsest level */
+   void InitializeCoarsest();
+
+   /** Apply one V-cycle for level l: x = M_l^{-1} b */
+   void VCycle(
+      Index         l,
+      const Number* b,
+      Number*       x
+   ) const;
+
+   /** @name Parameters */
+   ///@{
+   Index coarse_size_;
+   Index max_levels_;
+   Number strength_;
+   Number schur_droptol_;
+   Number schur_fill_;
+   Number pivtol_;
+   Index pattern_reuse_;
+   ///@}
+
+   /** @name Structure of the augmented system */
+   ///@{
+   Index dim_;
+   Index n11_;
+   /** Position in the values of the augmented system of every entry of H (level 0) */
+   std::vector<Index> h_src_;
+   /** Matrix B^T in CSR format (the columns of B), with the positions of its entries in the values of the augmented system */
+   std::vector<Index> bt_ptr_;
+   std::vector<Index> bt_row_;
+   std::vector<Index> bt_src_;
+   /** Position in the values of the augmented system of the diagonal of -C, or -1 */
+   std::vector<Index> c_src_;
+   ///@}
+
+   /** @name Approximate Schur complement S (upper triangle in CSR format) */
+   ///@{
+   std::vector<Index> s_ptr_;
+   std::vector<Index> s_col_;
+   std::vector<Number> s_val_;
+   /** Position in s_val_ of every product B(r,i) B(r2,i) with r <= r2, in the order of the loops in Factorize */
+   std::vector<Index> s_pos_;
+   /** Position in s_val_ of the diagonal of every row of S */
+   std::vector<Index> s_diag_;
+   SmartPtr<IncompleteLdlPreconditioner> schur_ldl_;
+   ///@}
+
+   /** Multigrid hierarchy */
+   std::vector<Level> levels_;
+
+   /** @name Factorization of the coarsest level */
+   ///@{
+   /** Position in the values of the coarsest level of every entry of its upper triangle */
+   std::vector<Index> coarsest_src_;
+   std::vector<Number> coarsest_val_;
+   SmartPtr<IncompleteLdlPreconditioner> coarsest_ldl_;
+   ///@}
+
+   /** Number of factorizations since the aggregates have been computed */
+   Index refactorizations_;
+};
+
+} // namespace Ipopt
+
+#endif
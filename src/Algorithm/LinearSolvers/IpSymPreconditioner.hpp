@@ -0,0 +1,119 @@
+// Copyright (C) 2021 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPSYMPRECONDITIONER_HPP__
+#define __IPSYMPRECONDITIONER_HPP__
+
+#include "IpUtils.hpp"
+#include "IpReferenced.hpp"
+#include "IpSymLinearSolver.hpp"
+
+namespace Ipopt
+{
+
+/** Base class for preconditioners of sparse symmetric (indefinite)
+ *  matrices, such as the augmented system, for iterative solvers.
+ *
+ *  The matrix is given by its upper triangular part in compressed
+ *  sparse row format with 0-offset, as produced by
+ *  TripletToCSRConverter.  InitializeStructure is called whenever the
+ *  structure changes and Factorize for every new set of values.
+ *  Implementations keep everything that depends only on the structure
+ *  (or that can be reused for similar values) between calls of
+ *  Factorize, so that the preconditioner for the matrices of
+ *  consecutive interior point iterations can be recomputed cheaply.
+ *
+ *  Apply computes z = M^{-1} r.  Methods like MINRES require that M
+ *  is positive definite, while SQMR can use an indefinite M, which
+ *  usually approximates an indefinite matrix better.  This can be
+ *  selected with SetPositiveDefinite.
+ *
+ *  @since 3.14.5
+ */
+class SymPreconditioner: public ReferencedObject
+{
+public:
+   /** @name Constructor/Destructor */
+   ///@{
+   SymPreconditioner()
+      : positive_definite_(false)
+   { }
+
+   virtual ~SymPreconditioner()
+   { }
+   ///@}
+
+   /** Set the structure of the matrix.
+    *
+    *  ia and ja describe the upper triangular part in CSR format with
+    *  0-offset.  The arrays are not referenced after this call.
+    */
+   virtual void InitializeStructure(
+      Index        dim,
+      const Index* ia,
+      const Index* ja
+   ) = 0;
+
+   /** Compute the preconditioner for new values of the matrix.
+    *
+    *  values are the nonzero elements in the order given by the ja
+    *  array in InitializeStructure.
+    *
+    *  @return SYMSOLVER_SUCCESS, or SYMSOLVER_SINGULAR if no usable
+    *  preconditioner could be computed
+    */
+   virtual ESymSolverStatus Factorize(
+      const Number* values
+   ) = 0;
+
+   /** Apply the preconditioner: z = M^{-1} r.
+    *
+    *  r and z must not overlap.
+    */
+   virtual void Apply(
+      const Number* r,
+      Number*       z
+   ) const = 0;
+
+   /** Whether M has to be positive definite */
+   void SetPositiveDefinite(
+      bool positive_definite
+   )
+   {
+      positive_definite_ = positive_definite;
+   }
+
+   /** Whether M is positive definite */
+   bool PositiveDefinite() const
+   {
+      return positive_definite_;
+   }
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called. */
+   ///@{
+   /** Copy Constructor */
+   SymPreconditioner(
+      const SymPreconditioner&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const SymPreconditioner&
+   );
+   ///@}
+
+   /** Whether M has to be positive definite */
+   bool positive_definite_;
+};
+
+} // namespace Ipopt
+
+#endif
@@ -0,0 +1,233 @@
+// Copyright (C) 2021 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpoptConfig.h"
+#include "IpSymbolicFactorizationCache.hpp"
+
+#include <list>
+#include <vector>
+#include <cstddef>
+
+#if __cplusplus >= 201103L && defined(IPOPT_HAS_THREADS)
+#define IPOPT_SYMBOLICCACHE_LOCKED
+#include <mutex>
+#endif
+
+namespace Ipopt
+{
+
+namespace
+{
+
+/** one cached symbolic factorization */
+struct CacheEntry
+{
+   std::string                key;
+   std::size_t                hash;
+   Index                      dim;
+   std::vector<Index>         idx1;
+   std::vector<Index>         idx2;
+   SymbolicFactorizationData* data;
+   Number                     analysis_time;
+};
+
+/** entries of the cache, most recently used first; frees the data of all entries at exit */
+class CacheEntries: public std::list<CacheEntry>
+{
+public:
+   ~CacheEntries()
+   {
+      for( iterator it = begin(); it != end(); ++it )
+      {
+         delete it->data;
+      }
+   }
+};
+
+CacheEntries& Entries()
+{
+   static CacheEntries entries;
+   return entries;
+}
+
+#ifdef IPOPT_SYMBOLICCACHE_LOCKED
+std::mutex& Mutex()
+{
+   static std::mutex mutex;
+   return mutex;
+}
+#define IPOPT_SYMBOLICCACHE_LOCK std::lock_guard<std::mutex> lock(Mutex())
+#else
+#define IPOPT_SYMBOLICCACHE_LOCK
+#endif
+
+/** FNV-1a hash of the key and the structure */
+std::size_t HashStructure(
+   const std::string& key,
+   Index              dim,
+   Index              len1,
+   const Index*       idx1,
+   Index              len2,
+   const Index*       idx2
+)
+{
+   std::size_t hash = 2166136261u;
+   for( std::string::const_iterator c = key.begin(); c != key.end(); ++c )
+   {
+      hash = (hash ^ (std::size_t)(unsigned char) *c) * 16777619u;
+   }
+   hash = (hash ^ (std::size_t) dim) * 16777619u;
+   hash = (hash ^ (std::size_t) len1) * 16777619u;
+   for( Index k = 0; k < len1; k++ )
+   {
+      hash = (hash ^ (std::size_t) idx1[k]) * 16777619u;
+   }
+   hash = (hash ^ (std::size_t) len2) * 16777619u;
+   for( Index k = 0; k < len2; k++ )
+   {
+      hash = (hash ^ (std::size_t) idx2[k]) * 16777619u;
+   }
+   return hash;
+}
+
+bool SameIndices(
+   const std::vector<Index>& stored,
+   Index                     len,
+   const Index*              idx
+)
+{
+   if( (Index) stored.size() != len )
+   {
+      return false;
+   }
+   for( Index k = 0; k < len; k++ )
+   {
+      if( stored[k] != idx[k] )
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
+/** find the entry for a structure; returns Entries().end() if there is none */
+CacheEntries::iterator Find(
+   std::size_t        hash,
+   const std::string& key,
+   Index              dim,
+   Index              len1,
+   const Index*       idx1,
+   Index              len2,
+   const Index*       idx2
+)
+{
+   CacheEntries& entries = Entries();
+   for( CacheEntries::iterator it = entries.begin(); it != entries.end(); ++it )
+   {
+      if( it->hash == hash && it->dim == dim && it->key == key && SameIndices(it->idx1, len1, idx1)
+          && SameIndices(it->idx2, len2, idx2) )
+      {
+         return it;
+      }
+   }
+   return entries.end();
+}
+
+} // namespace
+
+SymbolicFactorizationData* SymbolicFactorizationCache::Lookup(
+   const std::string& key,
+   Index              dim,
+   Index              len1,
+   const Index*       idx1,
+   Index              len2,
+   const Index*       idx2,
+   Number&            analysis_time
+)
+{
+   const std::size_t hash = HashStructure(key, dim, len1, idx1, len2, idx2);
+
+   IPOPT_SYMBOLICCACHE_LOCK;
+   CacheEntries& entries = Entries();
+   CacheEntries::iterator it = Find(hash, key, dim, len1, idx1, len2, idx2);
+   if( it == entries.end() )
+   {
+      return NULL;
+   }
+
+   // move the entry to the front of the list
+   entries.splice(entries.begin(), entries, it);
+   analysis_time = it->analysis_time;
+   return it->data->Clone();
+}
+
+void SymbolicFactorizationCache::Store(
+   Index                            max_entries,
+   const std::string&               key,
+   Index                            dim,
+   Index                            len1,
+   const Index*                     idx1,
+   Index                            len2,
+   const Index*                     idx2,
+   const SymbolicFactorizationData& data,
+   Number                           analysis_time
+)
+{
+   if( max_entries <= 0 )
+   {
+      return;
+   }
+
+   const std::size_t hash = HashStructure(key, dim, len1, idx1, len2, idx2);
+   SymbolicFactorizationData* copy = data.Clone();
+
+   IPOPT_SYMBOLICCACHE_LOCK;
+   CacheEntries& entries = Entries();
+   CacheEntries::iterator it = Find(hash, key, dim, len1, idx1, len2, idx2);
+   if( it != entries.end() )
+   {
+      // another solve stored the same structure in the meantime
+      delete it->data;
+      it->data = copy;
+      it->analysis_time = analysis_time;
+      entries.splice(entries.begin(), entries, it);
+   }
+   else
+   {
+      entries.push_front(CacheEntry());
+      CacheEntry& entry = entries.front();
+      entry.key = key;
+      entry.hash = hash;
+      entry.dim = dim;
+      entry.idx1.assign(idx1, idx1 + len1);
+      entry.idx2.assign(idx2, idx2 + len2);
+      entry.data = copy;
+      entry.analysis_time = analysis_time;
+   }
+
+   while( (Index) entries.size() > max_entries )
+   {
+      delete entries.back().data;
+      entries.pop_back();
+   }
+}
+
+void SymbolicFactorizationCache::Clear()
+{
+   IPOPT_SYMBOLICCACHE_LOCK;
+   CacheEntries& entries = Entries();
+   for( CacheEntries::iterator it = entries.begin(); it != entries.end(); ++it )
+   {
+      delete it->data;
+   }
+   entries.clear();
+}
+
+Index SymbolicFactorizationCache::NumEntries()
+{
+   IPOPT_SYMBOLICCACHE_LOCK;
+   return (Index) Entries().size();
+}
+
+} // namespace Ipopt
@@ -0,0 +1,130 @@
+// Copyright (C) 2021 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPSYMBOLICFACTORIZATIONCACHE_HPP__
+#define __IPSYMBOLICFACTORIZATIONCACHE_HPP__
+
+#include "IpTypes.hpp"
+
+#include <string>
+
+namespace Ipopt
+{
+
+/** Base class for the result of a symbolic factorization as it is
+ *  stored in the SymbolicFactorizationCache by a linear solver
+ *  interface.
+ */
+class SymbolicFactorizationData
+{
+public:
+   virtual ~SymbolicFactorizationData()
+   { }
+
+   /** Create a deep copy of this data.
+    *
+    *  The copy must not share any reference-counted object with
+    *  this data, since it may be handed to another thread.
+    */
+   virtual SymbolicFactorizationData* Clone() const = 0;
+};
+
+/** Process-wide cache of symbolic factorizations.
+ *
+ *  Linear solver interfaces store the result of their ordering and
+ *  symbolic analysis together with the sparsity structure of the
+ *  matrix they were computed for.  When a matrix with the same
+ *  structure is analyzed again, e.g., in a later solve of the same
+ *  problem or in a batch of problems with identical structure, the
+ *  analysis can be taken from the cache.
+ *
+ *  Entries are found via a hash of the structure, but the structure
+ *  is always compared completely.  An entry is identified by a key,
+ *  which has to contain the name of the linear solver and all its
+ *  parameters that influence the symbolic factorization, and up to
+ *  two index arrays describing the structure (e.g., the row and
+ *  column indices of a matrix in triplet format, or the row starts
+ *  and column indices of a matrix in CSR format).
+ *
+ *  All methods are thread-safe.  Data is copied when it is stored
+ *  and when it is retrieved.
+ *  @since 3.14.5
+ */
+class SymbolicFactorizationCache
+{
+public:
+   /** Look for a symbolic factorization of the given structure.
+    *
+    *  @param key           linear solver name and parameters
+    *  @param dim           dimension of the matrix
+    *  @param len1          length of idx1
+    *  @param idx1          first array describing the structure
+    *  @param len2          length of idx2
+    *  @param idx2          second array describing the structure
+    *  @param analysis_time on output, the wallclock time that the
+    *                       symbolic factorization took when it was computed
+    *
+    *  @return a copy of the cached data, which has to be deleted by
+    *    the caller, or NULL if there is no entry for the structure
+    */
+   static SymbolicFactorizationData* Lookup(
+      const std::string& key,
+      Index              dim,
+      Index              len1,
+      const Index*       idx1,
+      Index              len2,
+      const Index*       idx2,
+      Number&            analysis_time
+   );
+
+   /** Store a copy of a symbolic factorization for the given structure.
+    *
+    *  If the cache holds more than max_entries entries afterwards,
+    *  the least recently used entries are removed.
+    */
+   static void Store(
+      Index                            max_entries,
+      const std::string&               key,
+      Index                            dim,
+      Index                            len1,
+      const Index*                     idx1,
+      Index                            len2,
+      const Index*                     idx2,
+      const SymbolicFactorizationData& data,
+      Number                           analysis_time
+   );
+
+   /** Remove all entries */
+   static void Clear();
+
+   /** Number of entries in the cache */
+   static Index NumEntries();
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called. */
+   ///@{
+   /** Default Constructor */
+   SymbolicFactorizationCache();
+
+   /** Copy Constructor */
+   SymbolicFactorizationCache(
+      const SymbolicFactorizationCache&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const SymbolicFactorizationCache&
+   );
+   ///@}
+};
+
+} // namespace Ipopt
+
+#endif
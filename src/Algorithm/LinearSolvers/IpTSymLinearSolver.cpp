@@ -7,6 +7,8 @@
 #include "IpTSymLinearSolver.hpp"
 #include "IpTripletHelper.hpp"
 #include "IpBlas.hpp"
+#include "IpDenseVector.hpp"
+#include "IpCompoundVector.hpp"
 
 namespace Ipopt
 {
@@ -14,6 +16,63 @@ namespace Ipopt
 static const Index dbg_verbosity = 0;
 #endif
 
+/** alignment of the staging buffer in bytes */
+static const size_t staging_alignment = 64;
+
+/** Start of the values of a vector if they are stored in one
+ *  contiguous array of length dim, that is, if the vector is a
+ *  DenseVector, or a CompoundVector whose components are stored one
+ *  after the other; NULL otherwise.
+ *
+ *  Since the values are going to be overwritten, the vector is marked
+ *  as changed.
+ */
+static Number* ContiguousValues(
+   Vector& vector,
+   Index   dim
+)
+{
+   if( vector.Dim() != dim )
+   {
+      return NULL;
+   }
+
+   DenseVector* dv = dynamic_cast<DenseVector*>(&vector);
+   if( dv != NULL )
+   {
+      return dim > 0 ? dv->Values() : NULL;
+   }
+
+   CompoundVector* cv = dynamic_cast<CompoundVector*>(&vector);
+   if( cv != NULL && cv->NComps() > 0 )
+   {
+      Number* start = NULL;
+      Number* next = NULL;
+      for( Index i = 0; i < cv->NComps(); i++ )
+      {
+         SmartPtr<Vector> comp = cv->GetCompNonConst(i);
+         const Index comp_dim = comp->Dim();
+         if( comp_dim == 0 )
+         {
+            continue;
+         }
+         Number* comp_values = ContiguousValues(*comp, comp_dim);
+         if( comp_values == NULL || (next != NULL && comp_values != next) )
+         {
+            return NULL;
+         }
+         if( start == NULL )
+         {
+            start = comp_values;
+         }
+         next = comp_values + comp_dim;
+      }
+      return start;
+   }
+
+   return NULL;
+}
+
 TSymLinearSolver::TSymLinearSolver(
    SmartPtr<SparseSymLinearSolverInterface> solver_interface,
    SmartPtr<TSymScalingMethod>              scaling_method
@@ -29,7 +88,8 @@ TSymLinearSolver::TSymLinearSolver(
      scaling_method_(scaling_method),
      scaling_factors_(NULL),
      airn_(NULL),
-     ajcn_(NULL)
+     ajcn_(NULL),
+     staging_(NULL)
 {
    DBG_START_METH("TSymLinearSolver::TSymLinearSolver()", dbg_verbosity);
    DBG_ASSERT(IsValid(solver_interface));
@@ -56,6 +116,29 @@ void TSymLinearSolver::RegisterOptions(
       "This can be quite expensive. "
       "Choosing \"yes\" means that the algorithm will start the scaling method only "
       "when the solutions to the linear system seem not good, and then use it until the end.");
+   roptions->AddLowerBoundedIntegerOption(
+      "csr_conversion_num_threads",
+      "Number of threads used to convert the KKT matrix into compressed sparse row format.",
+      0,
+      1,
+      "This is only used for linear solvers that require the matrix in compressed sparse row format "
+      "and only for large matrices. "
+      "If set to 0, the number of hardware threads is used.",
+      true);
+   roptions->AddLowerBoundedIntegerOption(
+      "symbolic_factorization_cache",
+      "Number of symbolic factorizations that are kept for later solves with the same matrix structure.",
+      0,
+      0,
+      "If positive, the linear solver stores the result of its ordering and symbolic analysis in a "
+      "cache that is shared by all solves in the process and reuses it when a matrix with the same "
+      "sparsity structure (and solver parameters) is analyzed again, e.g., when the same problem "
+      "is solved repeatedly or a batch of structurally identical problems is solved. "
+      "The least recently used entries are removed if the cache holds more entries. "
+      "Currently, this is only supported by the linear solvers ldl and ma57. "
+      "Since ldl uses the values of the first matrix to choose 2x2 pivots in its analysis, "
+      "the pivot sequence may differ from a solve without the cache.",
+      true);
 }
 
 bool TSymLinearSolver::InitializeImpl(
@@ -97,20 +180,23 @@ bool TSymLinearSolver::InitializeImpl(
       nonzeros_compressed_ = 0;
       have_structure_ = false;
 
+      Index num_threads;
+      options.GetIntegerValue("csr_conversion_num_threads", num_threads, prefix);
+
       matrix_format_ = solver_interface_->MatrixFormat();
       switch( matrix_format_ )
       {
          case SparseSymLinearSolverInterface::CSR_Format_0_Offset:
-            triplet_to_csr_converter_ = new TripletToCSRConverter(0);
+            triplet_to_csr_converter_ = new TripletToCSRConverter(0, TripletToCSRConverter::Triangular_Format, num_threads);
             break;
          case SparseSymLinearSolverInterface::CSR_Format_1_Offset:
-            triplet_to_csr_converter_ = new TripletToCSRConverter(1);
+            triplet_to_csr_converter_ = new TripletToCSRConverter(1, TripletToCSRConverter::Triangular_Format, num_threads);
             break;
          case SparseSymLinearSolverInterface::CSR_Full_Format_0_Offset:
-            triplet_to_csr_converter_ = new TripletToCSRConverter(0, TripletToCSRConverter::Full_Format);
+            triplet_to_csr_converter_ = new TripletToCSRConverter(0, TripletToCSRConverter::Full_Format, num_threads);
             break;
          case SparseSymLinearSolverInterface::CSR_Full_Format_1_Offset:
-            triplet_to_csr_converter_ = new TripletToCSRConverter(1, TripletToCSRConverter::Full_Format);
+            triplet_to_csr_converter_ = new TripletToCSRConverter(1, TripletToCSRConverter::Full_Format, num_threads);
             break;
          case SparseSymLinearSolverInterface::Triplet_Format:
             triplet_to_csr_converter_ = NULL;
@@ -196,9 +282,22 @@ ESymSolverStatus TSymLinearSolver::MultiSolve(
       new_matrix = true;
    }
 
-   // Retrieve the right hand sides and scale if required
+   // Retrieve the right hand sides and scale if required.
+   // If there is only one right hand side and the solution vector
+   // stores its values in one contiguous array, the system is solved
+   // in place in the solution vector.  Otherwise, the right hand
+   // sides and solutions are kept in the staging buffer.
    Index nrhs = (Index) rhsV.size();
-   Number* rhs_vals = new Number[dim_ * nrhs];
+   Number* rhs_vals = NULL;
+   if( nrhs == 1 )
+   {
+      rhs_vals = ContiguousValues(*solV[0], dim_);
+   }
+   const bool in_place = rhs_vals != NULL;
+   if( !in_place )
+   {
+      rhs_vals = StagingBuffer((size_t) dim_ * nrhs);
+   }
    for( Index irhs = 0; irhs < nrhs; irhs++ )
    {
       TripletHelper::FillValuesFromVector(dim_, *rhsV[irhs], &rhs_vals[irhs * (dim_)]);
@@ -302,15 +401,30 @@ ESymSolverStatus TSymLinearSolver::MultiSolve(
                               "Tsol[%5" IPOPT_INDEX_FORMAT ",%5" IPOPT_INDEX_FORMAT "] = %23.16e\n", irhs, i, rhs_vals[irhs * (dim_) + i]);
             }
          }
-         TripletHelper::PutValuesInVector(dim_, &rhs_vals[irhs * (dim_)], *solV[irhs]);
+         if( !in_place )
+         {
+            TripletHelper::PutValuesInVector(dim_, &rhs_vals[irhs * (dim_)], *solV[irhs]);
+         }
       }
    }
 
-   delete[] rhs_vals;
-
    return retval;
 }
 
+Number* TSymLinearSolver::StagingBuffer(
+   size_t len
+)
+{
+   const size_t padding = staging_alignment / sizeof(Number);
+   if( staging_storage_.size() < len + padding )
+   {
+      staging_storage_.resize(len + padding);
+      const size_t misalignment = reinterpret_cast<size_t>(&staging_storage_[0]) % staging_alignment;
+      staging_ = &staging_storage_[0] + (misalignment == 0 ? 0 : (staging_alignment - misalignment) / sizeof(Number));
+   }
+   return staging_;
+}
+
 ESymSolverStatus TSymLinearSolver::InitializeStructure(
    const SymMatrix& sym_A
 )
@@ -459,6 +573,26 @@ void TSymLinearSolver::GiveMatrixToSolver(
    DBG_PRINT((1, "new_matrix = %d\n", new_matrix));
 
    Number* pa = solver_interface_->GetValuesArrayPtr();
+
+   // Without scaling, the values can be added directly into the
+   // compressed format, without going through a triplet array
+   if( !use_scaling_ && matrix_format_ != SparseSymLinearSolverInterface::Triplet_Format
+       && triplet_to_csr_converter_->iPosCompressed() != NULL )
+   {
+      if( HaveIpData() )
+      {
+         IpData().TimingStats().LinearSystemStructureConverter().Start();
+      }
+      const Number zero = 0.;
+      IpBlasCopy(nonzeros_compressed_, &zero, 0, pa, 1);
+      TripletHelper::AddValuesAtPositions(nonzeros_triplet_, sym_A, 1., triplet_to_csr_converter_->iPosCompressed(), pa);
+      if( HaveIpData() )
+      {
+         IpData().TimingStats().LinearSystemStructureConverter().End();
+      }
+      return;
+   }
+
    Number* atriplet;
 
    if( matrix_format_ != SparseSymLinearSolverInterface::Triplet_Format )
@@ -625,6 +759,7 @@ ESymSolverStatus TSymLinearSolver::DetermineDependentRows(
    }
 
    Number* pa = solver_interface_->GetValuesArrayPtr();
+
    Number* atriplet;
 
    if( matrix_format_ != SparseSymLinearSolverInterface::Triplet_Format )
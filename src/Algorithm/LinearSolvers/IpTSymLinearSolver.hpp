@@ -195,6 +195,18 @@ private:
    SparseSymLinearSolverInterface::EMatrixFormat matrix_format_;
    ///@}
 
+   /** @name Staging buffer for right hand sides and solutions */
+   ///@{
+   /** Storage of the staging buffer, including padding for its alignment.
+    *
+    *  The buffer is kept between calls of MultiSolve, so that it is not
+    *  allocated (and its pages touched for the first time) for every solve.
+    */
+   std::vector<Number> staging_storage_;
+   /** Aligned start of the staging buffer within staging_storage_ */
+   Number* staging_;
+   ///@}
+
    /** @name Algorithmic parameters */
    ///@{
    /** Flag indicating whether the TNLP with identical structure has
@@ -221,6 +233,11 @@ private:
       bool             new_matrix,
       const SymMatrix& sym_A
    );
+
+   /** Get a staging buffer for len numbers, aligned to a cache line */
+   Number* StagingBuffer(
+      size_t len
+   );
    ///@}
 };
 
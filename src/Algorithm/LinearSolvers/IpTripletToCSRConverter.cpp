@@ -7,6 +7,7 @@
 #include "IpTripletToCSRConverter.hpp"
 #include <vector>
 #include <algorithm>
+#include <utility>
 
 #include <cstddef>
 
@@ -16,9 +17,180 @@ namespace Ipopt
 static const Index dbg_verbosity = 0;
 #endif
 
+/** Minimal number of triplet entries for which the conversion is distributed over several threads */
+static const Index parallel_threshold = 50000;
+
+/** Execute a list of tasks, on the pool if there is more than one. */
+template<class T>
+static void RunTasks(
+   ThreadPool*     pool,
+   std::vector<T>& tasks
+)
+{
+   if( tasks.size() > 1 )
+   {
+      for( size_t t = 0; t < tasks.size(); t++ )
+      {
+         pool->Submit(&tasks[t]);
+      }
+      pool->Wait();
+   }
+   else
+   {
+      tasks[0].Compute();
+   }
+}
+
+/** Task that counts the entries per row for a chunk of the triplet entries. */
+class TripletRowCountTask: public ThreadPoolTask
+{
+public:
+   const Index* irow;
+   Index begin;
+   Index end;
+   Index* count;
+
+   void Run(
+      ThreadPool& /*pool*/,
+      Index       /*worker*/
+   )
+   {
+      Compute();
+   }
+
+   void Compute()
+   {
+      for( Index k = begin; k < end; k++ )
+      {
+         count[irow[k]]++;
+      }
+   }
+};
+
+/** Task that places a chunk of the triplet entries at their row positions. */
+class TripletRowScatterTask: public ThreadPoolTask
+{
+public:
+   const Index* irow;
+   Index begin;
+   Index end;
+   Index* next;
+   Index* order;
+
+   void Run(
+      ThreadPool& /*pool*/,
+      Index       /*worker*/
+   )
+   {
+      Compute();
+   }
+
+   void Compute()
+   {
+      for( Index k = begin; k < end; k++ )
+      {
+         order[next[irow[k]]++] = k;
+      }
+   }
+};
+
+/** Comparison of two triplet entries of the same row by column and position. */
+class TripletColumnLess
+{
+public:
+   TripletColumnLess(
+      const Index* jcol
+   )
+      : jcol_(jcol)
+   { }
+
+   bool operator()(
+      Index k1,
+      Index k2
+   ) const
+   {
+      return jcol_[k1] < jcol_[k2] || (jcol_[k1] == jcol_[k2] && k1 < k2);
+   }
+
+private:
+   const Index* jcol_;
+};
+
+/** Task that sorts the entries of a range of rows by column. */
+class TripletRowSortTask: public ThreadPoolTask
+{
+public:
+   const Index* jcol;
+   const Index* rowstart;
+   Index begin;
+   Index end;
+   Index* order;
+
+   void Run(
+      ThreadPool& /*pool*/,
+      Index       /*worker*/
+   )
+   {
+      Compute();
+   }
+
+   void Compute()
+   {
+      TripletColumnLess less(jcol);
+      for( Index i = begin; i < end; i++ )
+      {
+         if( rowstart[i + 1] - rowstart[i] > 1 )
+         {
+            std::sort(order + rowstart[i], order + rowstart[i + 1], less);
+         }
+      }
+   }
+};
+
+/** Task that converts the values of a range of compressed entries. */
+class TripletToCSRConvertTask: public ThreadPoolTask
+{
+public:
+   const TripletToCSRConverter* converter;
+   const Number* a_triplet;
+   Number* a_compressed;
+   Index begin;
+   Index end;
+   Index dbegin;
+   Index dend;
+
+   void Run(
+      ThreadPool& /*pool*/,
+      Index       /*worker*/
+   )
+   {
+      Compute();
+   }
+
+   void Compute()
+   {
+      converter->ConvertRange(a_triplet, a_compressed, begin, end, dbegin, dend);
+   }
+};
+
+/** Comparison of repeated entries by their position in the compressed matrix. */
+class DoubleEntryLess
+{
+public:
+   bool operator()(
+      const std::pair<Index, Index>& d1,
+      const std::pair<Index, Index>& d2
+   ) const
+   {
+      return d1.first < d2.first;
+   }
+};
+
 TripletToCSRConverter::TripletToCSRConverter(
-   Index offset,
-   ETriFull hf /*= Triangular_Format*/)
+   Index    offset,
+   ETriFull hf /*= Triangular_Format*/,
+   Index    num_threads /*= 1*/
+)
    : offset_(offset),
      hf_(hf),
      ia_(NULL),
@@ -29,9 +201,19 @@ TripletToCSRConverter::TripletToCSRConverter(
      initialized_(false),
      ipos_first_(NULL),
      ipos_double_triplet_(NULL),
-     ipos_double_compressed_(NULL)
+     ipos_double_compressed_(NULL),
+     ipos_compressed_(NULL)
 {
    DBG_ASSERT(offset == 0 || offset == 1);
+
+   if( num_threads <= 0 )
+   {
+      num_threads = ThreadPool::HardwareConcurrency();
+   }
+   if( num_threads > 1 )
+   {
+      pool_ = new ThreadPool(num_threads);
+   }
 }
 
 TripletToCSRConverter::~TripletToCSRConverter()
@@ -41,6 +223,7 @@ TripletToCSRConverter::~TripletToCSRConverter()
    delete[] ipos_first_;
    delete[] ipos_double_triplet_;
    delete[] ipos_double_compressed_;
+   delete[] ipos_compressed_;
 }
 
 Index TripletToCSRConverter::InitializeConverter(
@@ -62,20 +245,12 @@ Index TripletToCSRConverter::InitializeConverter(
    delete[] ipos_first_;
    delete[] ipos_double_triplet_;
    delete[] ipos_double_compressed_;
+   delete[] ipos_compressed_;
+   ipos_compressed_ = NULL;
 
    dim_ = dim;
    nonzeros_triplet_ = nonzeros;
 
-   // Create a list with all triplet entries
-   std::vector<TripletEntry> entry_list(nonzeros);
-   std::vector<TripletEntry>::iterator list_iterator = entry_list.begin();
-   for( Index i = 0; i < nonzeros; i++ )
-   {
-      list_iterator->Set(airn[i], ajcn[i], i);
-      ++list_iterator;
-   }
-   DBG_ASSERT(list_iterator == entry_list.end());
-
    if( DBG_VERBOSITY() >= 2 )
    {
       for( Index i = 0; i < nonzeros; i++ )
@@ -84,8 +259,82 @@ Index TripletToCSRConverter::InitializeConverter(
       }
    }
 
-   // sort the list
-   std::sort(entry_list.begin(), entry_list.end());
+   // Store all entries in the upper triangle
+   std::vector<Index> irow(nonzeros);
+   std::vector<Index> jcol(nonzeros);
+   for( Index i = 0; i < nonzeros; i++ )
+   {
+      irow[i] = Min(airn[i], ajcn[i]);
+      jcol[i] = Max(airn[i], ajcn[i]);
+   }
+
+   // Sort the entries by row (counting sort, stable in the triplet
+   // position), and then sort each row by column.  rowstart[i] is the
+   // beginning of row i (counted from 1) in order.
+   Index nchunks = 1;
+   if( IsValid(pool_) && nonzeros >= parallel_threshold )
+   {
+      nchunks = pool_->NumThreads();
+   }
+   std::vector<Index> order(nonzeros);
+   std::vector<Index> rowstart(dim_ + 2, 0);
+   {
+      std::vector<Index> count(nchunks * (dim_ + 1), 0);
+      std::vector<TripletRowCountTask> counttasks(nchunks);
+      for( Index t = 0; t < nchunks; t++ )
+      {
+         counttasks[t].irow = &irow[0];
+         counttasks[t].begin = (Index) ((size_t) nonzeros * t / nchunks);
+         counttasks[t].end = (Index) ((size_t) nonzeros * (t + 1) / nchunks);
+         counttasks[t].count = &count[t * (dim_ + 1)];
+      }
+      RunTasks(GetRawPtr(pool_), counttasks);
+
+      // Turn the counts into the insert positions of the chunks
+      Index pos = 0;
+      for( Index i = 1; i <= dim_; i++ )
+      {
+         rowstart[i] = pos;
+         for( Index t = 0; t < nchunks; t++ )
+         {
+            Index c = count[t * (dim_ + 1) + i];
+            count[t * (dim_ + 1) + i] = pos;
+            pos += c;
+         }
+      }
+      rowstart[dim_ + 1] = pos;
+      DBG_ASSERT(pos == nonzeros);
+
+      std::vector<TripletRowScatterTask> scattertasks(nchunks);
+      for( Index t = 0; t < nchunks; t++ )
+      {
+         scattertasks[t].irow = &irow[0];
+         scattertasks[t].begin = counttasks[t].begin;
+         scattertasks[t].end = counttasks[t].end;
+         scattertasks[t].next = &count[t * (dim_ + 1)];
+         scattertasks[t].order = &order[0];
+      }
+      RunTasks(GetRawPtr(pool_), scattertasks);
+   }
+   {
+      // Rows are distributed such that every chunk gets about the same number of entries
+      std::vector<TripletRowSortTask> sorttasks(nchunks);
+      Index row = 1;
+      for( Index t = 0; t < nchunks; t++ )
+      {
+         Index target = (Index) ((size_t) nonzeros * (t + 1) / nchunks);
+         sorttasks[t].jcol = &jcol[0];
+         sorttasks[t].rowstart = &rowstart[0];
+         sorttasks[t].begin = row;
+         while( row <= dim_ && (t == nchunks - 1 || rowstart[row + 1] <= target) )
+         {
+            row++;
+         }
+         sorttasks[t].end = row;
+         sorttasks[t].order = &order[0];
+      }
+      RunTasks(GetRawPtr(pool_), sorttasks);
+   }
 
    // Now got through the list and compute ipos_ arrays and the
    // number of elements in the compressed format
@@ -114,42 +363,42 @@ Index TripletToCSRConverter::InitializeConverter(
    }
 
    // Take care of possible empty rows
-   list_iterator = entry_list.begin();
-   while( cur_row < list_iterator->IRow() )
+   Index k = order[0];
+   while( cur_row < irow[k] )
    {
       ia_[cur_row - 1] = 0;
       cur_row++;
    }
    ia_[cur_row - 1] = 0;
-   ja_tmp[0] = list_iterator->JCol();
-   ipos_first_tmp[0] = list_iterator->PosTriplet();
+   ja_tmp[0] = jcol[k];
+   ipos_first_tmp[0] = k;
    if( hf_ == Full_Format )
    {
       // Count in both lower and upper triangles. Count diagonal only once.
       nonzeros_compressed_full++;
       rc_tmp[cur_row - 1]++;
-      if( cur_row != list_iterator->JCol() )
+      if( cur_row != jcol[k] )
       {
          nonzeros_compressed_full++;
-         rc_tmp[list_iterator->JCol() - 1]++;
+         rc_tmp[jcol[k] - 1]++;
       }
    }
 
-   ++list_iterator;
    Index idouble = 0;
    Index idouble_full = 0;
-   while( list_iterator != entry_list.end() )
+   for( Index l = 1; l < nonzeros; l++ )
    {
-      Index irow = list_iterator->IRow();
-      Index jcol = list_iterator->JCol();
-      if( cur_row == irow && ja_tmp[nonzeros_compressed_] == jcol )
+      k = order[l];
+      Index row = irow[k];
+      Index col = jcol[k];
+      if( cur_row == row && ja_tmp[nonzeros_compressed_] == col )
       {
          // This element appears repeatedly, add to the double list
-         ipos_double_triplet_tmp[idouble] = list_iterator->PosTriplet();
+         ipos_double_triplet_tmp[idouble] = k;
          ipos_double_compressed_tmp[idouble] = nonzeros_compressed_;
          idouble++;
          idouble_full++;
-         if( hf_ == Full_Format && irow != jcol )
+         if( hf_ == Full_Format && row != col )
          {
             idouble_full++;
          }
@@ -161,26 +410,23 @@ Index TripletToCSRConverter::InitializeConverter(
          {
             // Count in both lower and upper triangles. Count diagonal only once.
             nonzeros_compressed_full++;
-            rc_tmp[jcol - 1]++;
-            if( irow != jcol )
+            rc_tmp[col - 1]++;
+            if( row != col )
             {
                nonzeros_compressed_full++;
-               rc_tmp[irow - 1]++;
+               rc_tmp[row - 1]++;
             }
          }
          nonzeros_compressed_++;
-         ja_tmp[nonzeros_compressed_] = jcol;
-         ipos_first_tmp[nonzeros_compressed_] = list_iterator->PosTriplet();
-         if( cur_row != irow )
+         ja_tmp[nonzeros_compressed_] = col;
+         ipos_first_tmp[nonzeros_compressed_] = k;
+         // this may be in a new row, possibly after empty rows
+         while( cur_row < row )
          {
-            // this is in a new row
-
             ia_[cur_row] = nonzeros_compressed_;
             cur_row++;
          }
       }
-
-      ++list_iterator;
    }
    nonzeros_compressed_++;
    for( Index i = cur_row; i <= dim_; i++ )
@@ -233,6 +479,17 @@ Index TripletToCSRConverter::InitializeConverter(
       delete[] ipos_double_triplet_tmp;
       delete[] ipos_double_compressed_tmp;
       num_doubles_ = nonzeros_triplet_ - nonzeros_compressed_;
+
+      // Compute the inverse map of the triplet positions
+      ipos_compressed_ = new Index[nonzeros_triplet_];
+      for( Index i = 0; i < nonzeros_compressed_; i++ )
+      {
+         ipos_compressed_[ipos_first_[i]] = i;
+      }
+      for( Index i = 0; i < num_doubles_; i++ )
+      {
+         ipos_compressed_[ipos_double_triplet_[i]] = ipos_double_compressed_[i];
+      }
    }
    else   // hf_==Full_Format
    {
@@ -298,8 +555,25 @@ Index TripletToCSRConverter::InitializeConverter(
       // Set nonzeros_compressed_ to correct size
       nonzeros_compressed_ = nonzeros_compressed_full;
       num_doubles_ = idouble_full;
+
+      // Sort the repeated elements by their position in the compressed
+      // matrix, so that ConvertValues can split them into ranges.
+      // Keeping the order for the same position keeps the summation order.
+      std::vector<std::pair<Index, Index> > doubles(num_doubles_);
+      for( Index i = 0; i < num_doubles_; i++ )
+      {
+         doubles[i] = std::make_pair(ipos_double_compressed_[i], ipos_double_triplet_[i]);
+      }
+      std::stable_sort(doubles.begin(), doubles.end(), DoubleEntryLess());
+      for( Index i = 0; i < num_doubles_; i++ )
+      {
+         ipos_double_compressed_[i] = doubles[i].first;
+         ipos_double_triplet_[i] = doubles[i].second;
+      }
    }
 
+   ComputeRuns();
+
    initialized_ = true;
 
    if( DBG_VERBOSITY() >= 2 )
@@ -336,14 +610,25 @@ void TripletToCSRConverter::ConvertValues(
    DBG_ASSERT(nonzeros_triplet_ == nonzeros_triplet);
    DBG_ASSERT(nonzeros_compressed_ == nonzeros_compressed);
 
-   for( Index i = 0; i < nonzeros_compressed_; i++ )
+   Index nchunks = 1;
+   if( IsValid(pool_) && nonzeros_triplet_ >= parallel_threshold )
    {
-      a_compressed[i] = a_triplet[ipos_first_[i]];
+      nchunks = pool_->NumThreads();
    }
-   for( Index i = 0; i < num_doubles_; i++ )
+   std::vector<TripletToCSRConvertTask> tasks(nchunks);
+   for( Index t = 0; t < nchunks; t++ )
    {
-      a_compressed[ipos_double_compressed_[i]] += a_triplet[ipos_double_triplet_[i]];
+      tasks[t].converter = this;
+      tasks[t].a_triplet = a_triplet;
+      tasks[t].a_compressed = a_compressed;
+      tasks[t].begin = (Index) ((size_t) nonzeros_compressed_ * t / nchunks);
+      tasks[t].end = (Index) ((size_t) nonzeros_compressed_ * (t + 1) / nchunks);
+      tasks[t].dbegin = (Index) (std::lower_bound(ipos_double_compressed_, ipos_double_compressed_ + num_doubles_,
+                                 tasks[t].begin) - ipos_double_compressed_);
+      tasks[t].dend = (Index) (std::lower_bound(ipos_double_compressed_, ipos_double_compressed_ + num_doubles_,
+                               tasks[t].end) - ipos_double_compressed_);
    }
+   RunTasks(GetRawPtr(pool_), tasks);
 
    if( DBG_VERBOSITY() >= 2 )
    {
@@ -358,4 +643,81 @@ void TripletToCSRConverter::ConvertValues(
    }
 }
 
+void TripletToCSRConverter::ComputeRuns()
+{
+   run_compressed_.clear();
+   run_triplet_.clear();
+   run_len_.clear();
+
+   Index nruns = 1;
+   for( Index i = 1; i < nonzeros_compressed_; i++ )
+   {
+      if( ipos_first_[i] != ipos_first_[i - 1] + 1 )
+      {
+         nruns++;
+      }
+   }
+
+   // Copying runs only pays off if they are not too short
+   if( 4 * nruns > nonzeros_compressed_ )
+   {
+      return;
+   }
+
+   run_compressed_.reserve(nruns);
+   run_triplet_.reserve(nruns);
+   run_len_.reserve(nruns);
+   run_compressed_.push_back(0);
+   run_triplet_.push_back(ipos_first_[0]);
+   for( Index i = 1; i < nonzeros_compressed_; i++ )
+   {
+      if( ipos_first_[i] != ipos_first_[i - 1] + 1 )
+      {
+         run_len_.push_back(i - run_compressed_.back());
+         run_compressed_.push_back(i);
+         run_triplet_.push_back(ipos_first_[i]);
+      }
+   }
+   run_len_.push_back(nonzeros_compressed_ - run_compressed_.back());
+}
+
+void TripletToCSRConverter::ConvertRange(
+   const Number* a_triplet,
+   Number*       a_compressed,
+   Index         begin,
+   Index         end,
+   Index         dbegin,
+   Index         dend
+) const
+{
+   if( !run_compressed_.empty() )
+   {
+      // find the run that contains begin
+      Index r = (Index) (std::upper_bound(run_compressed_.begin(), run_compressed_.end(), begin) - run_compressed_.begin()) - 1;
+      Index nruns = (Index) run_compressed_.size();
+      for( ; r < nruns && run_compressed_[r] < end; r++ )
+      {
+         Index first = Max(begin, run_compressed_[r]);
+         Index last = Min(end, run_compressed_[r] + run_len_[r]);
+         Index shift = run_triplet_[r] - run_compressed_[r];
+         for( Index i = first; i < last; i++ )
+         {
+            a_compressed[i] = a_triplet[i + shift];
+         }
+      }
+   }
+   else
+   {
+      for( Index i = begin; i < end; i++ )
+      {
+         a_compressed[i] = a_triplet[ipos_first_[i]];
+      }
+   }
+
+   for( Index i = dbegin; i < dend; i++ )
+   {
+      a_compressed[ipos_double_compressed_[i]] += a_triplet[ipos_double_triplet_[i]];
+   }
+}
+
 } // namespace Ipopt
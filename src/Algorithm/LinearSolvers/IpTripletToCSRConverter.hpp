@@ -9,6 +9,11 @@
 
 #include "IpUtils.hpp"
 #include "IpReferenced.hpp"
+#include "IpSmartPtr.hpp"
+#include "IpThreadPool.hpp"
+
+#include <vector>
+
 namespace Ipopt
 {
 
@@ -18,75 +23,17 @@ namespace Ipopt
  *  format for the lower triangular part).
  *
  *  In the description for this class, we assume that we discuss the CSR format.
+ *
+ *  The triplet entries are sorted by a counting sort on the rows,
+ *  followed by sorting the (short) rows by column.  The values are
+ *  converted by copying contiguous runs of the triplet array and
+ *  adding the values of repeated entries.  If more than one thread
+ *  is requested, both steps are distributed over a ThreadPool for
+ *  large matrices.  The result does not depend on the number of
+ *  threads.
  */
 class TripletToCSRConverter: public ReferencedObject
 {
-   /** Class for one triplet position entry. */
-   class TripletEntry
-   {
-   public:
-
-      /** Set the values of an entry */
-      void Set(
-         Index i_row,
-         Index j_col,
-         Index i_pos_triplet
-      )
-      {
-         if( i_row > j_col )
-         {
-            i_row_ = j_col;
-            j_col_ = i_row;
-         }
-         else
-         {
-            i_row_ = i_row;
-            j_col_ = j_col;
-         }
-         i_pos_triplet_ = i_pos_triplet;
-      }
-
-      /** @name Accessor methods. */
-      ///@{
-      /** Row position. */
-      Index IRow() const
-      {
-         return i_row_;
-      }
-
-      /** Column position. */
-      Index JCol() const
-      {
-         return j_col_;
-      }
-
-      /** Index in original triplet matrix. */
-      Index PosTriplet() const
-      {
-         return i_pos_triplet_;
-      }
-      ///@}
-
-      /** Comparison operator.
-       *
-       * This is required for the sort function.
-       */
-      bool operator<(
-         const TripletEntry& Tentry
-      ) const
-      {
-         return ((i_row_ < Tentry.i_row_) || (i_row_ == Tentry.i_row_ && j_col_ < Tentry.j_col_));
-      }
-
-   private:
-      /** @name Entry content. */
-      ///@{
-      Index i_row_;
-      Index j_col_;
-      Index i_pos_triplet_;
-      ///@}
-   };
-
 public:
    /** Enum to specify half or full matrix storage */
    enum ETriFull
@@ -104,10 +51,13 @@ public:
     * If offset is 0, then the counting of indices in the compressed
     * format starts a 0 (C-style numbering); if offset is 1, then the
     * counting starts at 1 (Fortran-type numbering).
+    * num_threads is the number of threads used for the conversion;
+    * if it is not positive, the number of hardware threads is used.
     */
    TripletToCSRConverter(
       Index    offset,
-      ETriFull hf = Triangular_Format
+      ETriFull hf = Triangular_Format,
+      Index    num_threads = 1
    );
 
    /** Destructor */
@@ -155,6 +105,18 @@ public:
       DBG_ASSERT(initialized_);
       return ipos_first_;
    }
+
+   /** Return the position in the condensed format for every triplet entry.
+    *
+    *  The value of the i-th triplet entry has to be added to the
+    *  iPosCompressed()[i]-th entry of the condensed format (counted from 0).
+    *  This is only available for Triangular_Format, otherwise NULL is returned.
+    */
+   const Index* iPosCompressed() const
+   {
+      DBG_ASSERT(initialized_);
+      return ipos_compressed_;
+   }
    ///@}
 
    /** Convert the values of the nonzero elements.
@@ -240,7 +202,44 @@ private:
 
    /** Position of multiple elements in compressed matrix. */
    Index* ipos_double_compressed_;
+
+   /** Position in compressed matrix for every element of the triplet matrix
+    *  (only for Triangular_Format). */
+   Index* ipos_compressed_;
+   ///@}
+
+   /** @name Contiguous runs in ipos_first_.
+    *
+    *  Run k copies run_len_[k] consecutive values from position
+    *  run_triplet_[k] of the triplet format to position
+    *  run_compressed_[k] of the compressed format.  These are only
+    *  used if the runs are long enough on average.
+    */
+   ///@{
+   std::vector<Index> run_compressed_;
+   std::vector<Index> run_triplet_;
+   std::vector<Index> run_len_;
    ///@}
+
+   /** Thread pool for the conversion (NULL if single-threaded) */
+   SmartPtr<ThreadPool> pool_;
+
+   /** Compute the runs of ipos_first_. */
+   void ComputeRuns();
+
+   /** Convert the values for the compressed positions in [begin, end)
+    *  and the repeated entries in [dbegin, dend).
+    */
+   void ConvertRange(
+      const Number* a_triplet,
+      Number*       a_compressed,
+      Index         begin,
+      Index         end,
+      Index         dbegin,
+      Index         dend
+   ) const;
+
+   friend class TripletToCSRConvertTask;
 };
 
 } // namespace Ipopt
@@ -0,0 +1,330 @@
+// Copyright (C) 2021 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpAsyncFileWriter.hpp"
+
+#include <cstring>
+
+#ifdef IPOPT_ASYNCWRITER_THREADED
+#include <chrono>
+#include <system_error>
+#endif
+
+namespace Ipopt
+{
+
+#ifdef IPOPT_ASYNCWRITER_THREADED
+/** time after which the writer thread looks for new text when it has not been woken up */
+static const std::chrono::milliseconds writer_poll_interval(10);
+#endif
+
+AsyncFileWriter::AsyncFileWriter(
+   std::size_t capacity
+)
+   : file_(NULL)
+#ifdef IPOPT_ASYNCWRITER_THREADED
+   , buffer_(capacity > 0 ? capacity : 1),
+     head_(0),
+     tail_(0),
+     flush_requested_(0),
+     flush_done_(0),
+     stop_(false),
+     running_(false)
+#endif
+{
+#ifndef IPOPT_ASYNCWRITER_THREADED
+   (void) capacity;
+#endif
+}
+
+AsyncFileWriter::~AsyncFileWriter()
+{
+   Close();
+}
+
+bool AsyncFileWriter::Open(
+   const char* fname
+)
+{
+   Close();
+
+   if( strcmp("stdout", fname) == 0 )
+   {
+      file_ = stdout;
+   }
+   else if( strcmp("stderr", fname) == 0 )
+   {
+      file_ = stderr;
+   }
+   else
+   {
+      file_ = fopen(fname, "w+");
+      if( file_ == NULL )
+      {
+         return false;
+      }
+   }
+
+#ifdef IPOPT_ASYNCWRITER_THREADED
+   // if no thread can be started, the text is written immediately
+   running_ = Start();
+#endif
+
+   return true;
+}
+
+void AsyncFileWriter::Close()
+{
+#ifdef IPOPT_ASYNCWRITER_THREADED
+   if( running_ )
+   {
+      Stop();
+   }
+#endif
+   if( file_ && file_ != stdout && file_ != stderr )
+   {
+      fclose(file_);
+   }
+   else if( file_ )
+   {
+      fflush(file_);
+   }
+   file_ = NULL;
+}
+
+void AsyncFileWriter::Write(
+   const char* str,
+   std::size_t len
+)
+{
+   if( file_ == NULL )
+   {
+      return;
+   }
+
+#ifdef IPOPT_ASYNCWRITER_THREADED
+   if( running_ )
+   {
+      const std::size_t capacity = buffer_.size();
+      std::size_t head = head_.load(std::memory_order_relaxed);
+      while( len > 0 )
+      {
+         std::size_t space = capacity - (head - tail_.load(std::memory_order_acquire));
+         if( space == 0 )
+         {
+            // buffer is full: wake up the writer and wait until it made some room
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_writer_.notify_one();
+            wake_producer_.wait(lock, [&]
+            {
+               return head - tail_.load(std::memory_order_acquire) < capacity;
+            });
+            continue;
+         }
+
+         // copy as much as fits, possibly wrapping around the end of the buffer
+         const std::size_t n = len < space ? len : space;
+         const std::size_t start = head % capacity;
+         const std::size_t first = n < capacity - start ? n : capacity - start;
+         memcpy(&buffer_[start], str, first);
+         if( first < n )
+         {
+            memcpy(&buffer_[0], str + first, n - first);
+         }
+         head += n;
+         head_.store(head, std::memory_order_release);
+         str += n;
+         len -= n;
+      }
+
+      // the writer polls regularly, but should not wait if the buffer fills up
+      if( head - tail_.load(std::memory_order_relaxed) > capacity / 2 )
+      {
+         wake_writer_.notify_one();
+      }
+      return;
+   }
+#endif
+
+   fwrite(str, 1, len, file_);
+}
+
+void AsyncFileWriter::Printf(
+   const char* pformat,
+   va_list     ap
+)
+{
+   if( file_ == NULL )
+   {
+      return;
+   }
+
+#ifdef IPOPT_ASYNCWRITER_THREADED
+   if( running_ )
+   {
+      char str[1024];
+      va_list apcopy;
+      va_copy(apcopy, ap);
+      int len = vsnprintf(str, sizeof(str), pformat, apcopy);
+      va_end(apcopy);
+      if( len < 0 )
+      {
+         return;
+      }
+      if( (std::size_t) len < sizeof(str) )
+      {
+         Write(str, (std::size_t) len);
+         return;
+      }
+
+      // the message is too long for the stack buffer: format again into a larger buffer
+      if( format_buffer_.size() < (std::size_t) len + 1 )
+      {
+         format_buffer_.resize((std::size_t) len + 1);
+      }
+      len = vsnprintf(&format_buffer_[0], format_buffer_.size(), pformat, ap);
+      if( len > 0 )
+      {
+         Write(&format_buffer_[0], (std::size_t) len);
+      }
+      return;
+   }
+#endif
+
+   vfprintf(file_, pformat, ap);
+}
+
+void AsyncFileWriter::RequestFlush()
+{
+   if( file_ == NULL )
+   {
+      return;
+   }
+
+#ifdef IPOPT_ASYNCWRITER_THREADED
+   if( running_ )
+   {
+      flush_requested_.fetch_add(1);
+      std::lock_guard<std::mutex> lock(mutex_);
+      wake_writer_.notify_one();
+      return;
+   }
+#endif
+
+   fflush(file_);
+}
+
+void AsyncFileWriter::Sync()
+{
+   if( file_ == NULL )
+   {
+      return;
+   }
+
+#ifdef IPOPT_ASYNCWRITER_THREADED
+   if( running_ )
+   {
+      const std::size_t ticket = flush_requested_.fetch_add(1) + 1;
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_writer_.notify_one();
+      wake_producer_.wait(lock, [&]
+      {
+         return flush_done_.load() >= ticket;
+      });
+      return;
+   }
+#endif
+
+   fflush(file_);
+}
+
+#ifdef IPOPT_ASYNCWRITER_THREADED
+bool AsyncFileWriter::Start()
+{
+   head_.store(0);
+   tail_.store(0);
+   flush_requested_.store(0);
+   flush_done_.store(0);
+   stop_.store(false);
+   try
+   {
+      thread_ = std::thread(&AsyncFileWriter::Run, this);
+   }
+   catch( const std::system_error& )
+   {
+      return false;
+   }
+   return true;
+}
+
+void AsyncFileWriter::Stop()
+{
+   stop_.store(true);
+   {
+      std::lock_guard<std::mutex> lock(mutex_);
+      wake_writer_.notify_one();
+   }
+   thread_.join();
+   running_ = false;
+}
+
+void AsyncFileWriter::Run()
+{
+   const std::size_t capacity = buffer_.size();
+   for( ;; )
+   {
+      // read the requests before the head, so that all text that was
+      // put into the buffer before a flush or stop request is written
+      const bool stop = stop_.load();
+      const std::size_t flush_requested = flush_requested_.load();
+      const std::size_t head = head_.load(std::memory_order_acquire);
+      const std::size_t tail = tail_.load(std::memory_order_relaxed);
+
+      if( head != tail )
+      {
+         const std::size_t start = tail % capacity;
+         const std::size_t n = head - tail;
+         const std::size_t first = n < capacity - start ? n : capacity - start;
+         fwrite(&buffer_[start], 1, first, file_);
+         if( first < n )
+         {
+            fwrite(&buffer_[0], 1, n - first, file_);
+         }
+         tail_.store(head, std::memory_order_release);
+      }
+
+      const bool flush = flush_requested != flush_done_.load();
+      if( flush )
+      {
+         fflush(file_);
+         flush_done_.store(flush_requested);
+      }
+
+      if( head != tail || flush )
+      {
+         // wake up a producer that waits for room in the buffer or for a flush
+         std::lock_guard<std::mutex> lock(mutex_);
+         wake_producer_.notify_all();
+      }
+
+      if( stop && head == tail )
+      {
+         fflush(file_);
+         return;
+      }
+
+      if( head == tail )
+      {
+         std::unique_lock<std::mutex> lock(mutex_);
+         wake_writer_.wait_for(lock, writer_poll_interval, [&]
+         {
+            return stop_.load() || flush_requested_.load() != flush_done_.load()
+                   || head_.load(std::memory_order_relaxed) - tail_.load(std::memory_order_relaxed) > capacity / 2;
+         });
+      }
+   }
+}
+#endif
+
+} // namespace Ipopt
@@ -0,0 +1,165 @@
+// Copyright (C) 2021 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPASYNCFILEWRITER_HPP__
+#define __IPASYNCFILEWRITER_HPP__
+
+#include "IpoptConfig.h"
+#include "IpTypes.hpp"
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstddef>
+#include <vector>
+
+#if __cplusplus >= 201103L && defined(IPOPT_HAS_THREADS) && defined(HAVE_VSNPRINTF) && defined(IPOPT_HAS_VA_COPY)
+#define IPOPT_ASYNCWRITER_THREADED
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace Ipopt
+{
+
+/** Writer that passes text to a file from a background thread.
+ *
+ *  Text is copied into a ring buffer by the thread that calls Write
+ *  or Printf and written to the file by a writer thread.  The ring
+ *  buffer has a single producer and a single consumer: the positions
+ *  of the producer and the consumer are atomic counters, so that
+ *  copying text into the buffer does not need a lock.  The producer
+ *  only blocks if the buffer is full, the writer thread sleeps while
+ *  the buffer is empty.
+ *
+ *  Write and Printf must not be called concurrently from several
+ *  threads.
+ *
+ *  If Ipopt has been compiled without thread support, text is
+ *  written to the file immediately.
+ *  @since 3.14.5
+ */
+class AsyncFileWriter
+{
+public:
+   /** Constructor.
+    *
+    *  @param capacity size of the ring buffer in bytes
+    */
+   AsyncFileWriter(
+      std::size_t capacity
+   );
+
+   /** Destructor; writes all pending text and closes the file */
+   ~AsyncFileWriter();
+
+   /** Open a file; stdout and stderr refer to the standard streams.
+    *
+    *  Writes all pending text to and closes a previously opened file.
+    *
+    *  @return false if the file could not be opened
+    */
+   bool Open(
+      const char* fname
+   );
+
+   /** Append a string */
+   void Write(
+      const char* str,
+      std::size_t len
+   );
+
+   /** Append a formatted string */
+   void Printf(
+      const char* pformat,
+      va_list     ap
+   );
+
+   /** Ask the writer thread to write all pending text and to flush the file, without waiting for it */
+   void RequestFlush();
+
+   /** Write all pending text and flush the file; returns when done */
+   void Sync();
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called. */
+   ///@{
+   /** Default Constructor */
+   AsyncFileWriter();
+
+   /** Copy Constructor */
+   AsyncFileWriter(
+      const AsyncFileWriter&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const AsyncFileWriter&
+   );
+   ///@}
+
+   /** Close the file, if any */
+   void Close();
+
+   /** File that is written, NULL if none */
+   FILE* file_;
+
+#ifdef IPOPT_ASYNCWRITER_THREADED
+   /** Start the writer thread; returns false if no thread could be created */
+   bool Start();
+
+   /** Write all pending text and stop the writer thread */
+   void Stop();
+
+   /** Main loop of the writer thread */
+   void Run();
+
+   /** Ring buffer */
+   std::vector<char> buffer_;
+
+   /** Number of bytes put into the buffer so far; only changed by the producer */
+   std::atomic<std::size_t> head_;
+
+   /** Number of bytes written to the file so far; only changed by the writer thread */
+   std::atomic<std::size_t> tail_;
+
+   /** Number of flushes requested so far */
+   std::atomic<std::size_t> flush_requested_;
+
+   /** Number of flushes done so far */
+   std::atomic<std::size_t> flush_done_;
+
+   /** Whether the writer thread should exit when the buffer is empty */
+   std::atomic<bool> stop_;
+
+   /** Whether the writer thread is running */
+   bool running_;
+
+   /** Mutex protecting the sleeps of both threads */
+   std::mutex mutex_;
+
+   /** Wakes up the writer thread */
+   std::condition_variable wake_writer_;
+
+   /** Wakes up the producer when space became free or a flush is done */
+   std::condition_variable wake_producer_;
+
+   /** Writer thread */
+   std::thread thread_;
+
+   /** Buffer for formatting strings that do not fit into the stack buffer of Printf */
+   std::vector<char> format_buffer_;
+#endif
+};
+
+} // namespace Ipopt
+
+#endif
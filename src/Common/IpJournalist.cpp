@@ -7,6 +7,7 @@
 #include "IpoptConfig.h"
 #include "IpJournalist.hpp"
 #include "IpDebug.hpp"
+#include "IpAsyncFileWriter.hpp"
 
 #include <cstdio>
 #include <cstring>
@@ -289,6 +290,13 @@ void Journalist::FlushBuffer() const
 SmartPtr<Journal> Journalist::GetJournal(
    const std::string& journal_name
 )
+{
+   return static_cast<const Journalist*>(this)->GetJournal(journal_name);
+}
+
+SmartPtr<Journal> Journalist::GetJournal(
+   const std::string& journal_name
+) const
 {
    SmartPtr<Journal> retValue = NULL;
 
@@ -461,6 +469,62 @@ void FileJournal::FlushBufferImpl()
    }
 }
 
+///////////////////////////////////////////////////////////////////////////
+//               Implementation of the AsyncFileJournal class            //
+///////////////////////////////////////////////////////////////////////////
+
+AsyncFileJournal::AsyncFileJournal(
+   const std::string& name,
+   EJournalLevel      default_level,
+   std::size_t        buffer_size
+)
+   : Journal(name, default_level),
+     writer_(new AsyncFileWriter(buffer_size))
+{ }
+
+AsyncFileJournal::~AsyncFileJournal()
+{
+   delete writer_;
+}
+
+bool AsyncFileJournal::Open(const char* fname)
+{
+   return writer_->Open(fname);
+}
+
+void AsyncFileJournal::Sync()
+{
+   writer_->Sync();
+}
+
+void AsyncFileJournal::PrintImpl(
+   EJournalCategory /*category*/,
+   EJournalLevel    /*level*/,
+   const char*      str
+)
+{
+   DBG_START_METH("AsyncFileJournal::Print", 0);
+   writer_->Write(str, strlen(str));
+   DBG_EXEC(0, writer_->Sync());
+}
+
+void AsyncFileJournal::PrintfImpl(
+   EJournalCategory /*category*/,
+   EJournalLevel    /*level*/,
+   const char*      pformat,
+   va_list          ap
+)
+{
+   DBG_START_METH("AsyncFileJournal::Printf", 0);
+   writer_->Printf(pformat, ap);
+   DBG_EXEC(0, writer_->Sync());
+}
+
+void AsyncFileJournal::FlushBufferImpl()
+{
+   writer_->RequestFlush();
+}
+
 ///////////////////////////////////////////////////////////////////////////
 //                 Implementation of the StreamJournal class               //
 ///////////////////////////////////////////////////////////////////////////
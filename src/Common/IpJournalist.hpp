@@ -13,6 +13,7 @@
 #include "IpSmartPtr.hpp"
 
 #include <cstdarg>
+#include <cstddef>
 #include <cstdio>
 #include <string>
 #include <vector>
@@ -24,6 +25,7 @@ namespace Ipopt
 // forward declarations
 class Journal;
 class FileJournal;
+class AsyncFileWriter;
 
 /**@name Journalist Enumerations. */
 ///@{
@@ -242,6 +244,16 @@ public:
       const std::string& location_name
    );
 
+   /** Get an existing journal from a const Journalist.
+    *
+    *  This allows algorithm objects, which only see a const Journalist,
+    *  to find journals that have been added for a special purpose.
+    *  @since 3.14.5
+    */
+   SmartPtr<Journal> GetJournal(
+      const std::string& location_name
+   ) const;
+
    /** Delete all journals currently known by the journalist. */
    virtual void DeleteAllJournals();
    ///@}
@@ -489,6 +501,101 @@ private:
    FILE* file_;
 };
 
+/** AsyncFileJournal class.
+ *
+ * This is a Journal implementation that writes to a file like
+ * FileJournal, but from a background thread: the printing code only
+ * formats the message and copies it into a buffer, so that it does
+ * not wait for the file system.  FlushBuffer asks the writer thread
+ * to flush the file, but does not wait for it.  Use Sync to wait
+ * until all output has been written.  All output is written when the
+ * journal is destroyed.
+ *
+ * If Ipopt has been compiled without thread support, this journal
+ * behaves like a FileJournal.
+ * @since 3.14.5
+ */
+class IPOPTLIB_EXPORT AsyncFileJournal: public Journal
+{
+public:
+   /** Constructor. */
+   AsyncFileJournal(
+      const std::string& name,
+      EJournalLevel      default_level,
+      std::size_t        buffer_size = 1 << 20 /**< size of the buffer in bytes */
+   );
+
+   /** Destructor. */
+   virtual ~AsyncFileJournal();
+
+   /** Open a new file for the output location.
+    *
+    *  Special Names: stdout means stdout,
+    *               : stderr means stderr.
+    *
+    *  @return false only if the file with the given name could not be opened
+    */
+   virtual bool Open(
+      const char* fname
+   );
+
+   /** Write all pending output and flush the file; returns when done. */
+   virtual void Sync();
+
+protected:
+   /**@name Implementation version of Print methods
+    *
+    * Overloaded from Journal base class.
+    */
+   ///@{
+   /** Print to the designated output location */
+   virtual void PrintImpl(
+      EJournalCategory /*category*/,
+      EJournalLevel    /*level*/,
+      const char*      str
+   );
+
+   /** Printf to the designated output location */
+   virtual void PrintfImpl(
+      EJournalCategory /*category*/,
+      EJournalLevel    /*level*/,
+      const char*      pformat,
+      va_list          ap
+   );
+
+   /** Flush output buffer.*/
+   virtual void FlushBufferImpl();
+   ///@}
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    *
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called.
+    */
+   ///@{
+   /** Default Constructor */
+   AsyncFileJournal();
+
+   /** Copy Constructor */
+   AsyncFileJournal(
+      const AsyncFileJournal&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const AsyncFileJournal&
+   );
+   ///@}
+
+   /** Writer for the output destination */
+   AsyncFileWriter* writer_;
+};
+
 /** StreamJournal class.
  *
  * This is a particular Journal implementation that writes to a stream for output.
@@ -0,0 +1,266 @@
+// Copyright (C) 2021 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpoptConfig.h"
+#include "IpProfiler.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace Ipopt
+{
+
+namespace
+{
+
+#if __cplusplus >= 201103L
+thread_local Profiler* active_profiler = NULL;
+#else
+Profiler* active_profiler = NULL;
+#endif
+
+/** accumulated data of all nodes with the same name, for the flat profile */
+struct FlatEntry
+{
+   const char* name;
+   Index       calls;
+   Number      walltime;
+   Number      selftime;
+   Number      counters[PROFILE_NUM_COUNTERS];
+};
+
+bool LargerSelfTime(
+   const FlatEntry& a,
+   const FlatEntry& b
+)
+{
+   return a.selftime > b.selftime;
+}
+
+const char* const profile_header =
+   "%-44s %8s %10s %10s %10s %10s %8s %8s %10s\n";
+
+const char* const profile_line =
+   "%-44s %8" IPOPT_INDEX_FORMAT " %10.3f %10.3f %10.0f %10.1f %8.0f %8.0f %10.1f\n";
+
+} // namespace
+
+Profiler::Profiler()
+   : enabled_(false)
+{
+   Reset();
+}
+
+Profiler::~Profiler()
+{
+   if( active_profiler == this )
+   {
+      active_profiler = NULL;
+   }
+}
+
+void Profiler::Reset()
+{
+   nodes_.resize(1);
+   Node& root = nodes_[0];
+   root.name = "(outside of timed tasks)";
+   root.parent = -1;
+   root.children.clear();
+   root.calls = 0;
+   root.walltime = 0.;
+   root.start = 0.;
+   for( int c = 0; c < PROFILE_NUM_COUNTERS; c++ )
+   {
+      root.counters[c] = 0.;
+   }
+   stack_.assign(1, 0);
+}
+
+Index Profiler::Enter(
+   const char* name,
+   Number      walltime
+)
+{
+   if( !enabled_ )
+   {
+      return -1;
+   }
+
+   const Index parent = stack_.back();
+   Index node = -1;
+   const std::vector<Index>& children = nodes_[parent].children;
+   for( std::vector<Index>::const_iterator it = children.begin(); it != children.end(); ++it )
+   {
+      if( nodes_[*it].name == name || strcmp(nodes_[*it].name, name) == 0 )
+      {
+         node = *it;
+         break;
+      }
+   }
+
+   if( node < 0 )
+   {
+      node = (Index) nodes_.size();
+      nodes_.push_back(Node());
+      Node& newnode = nodes_.back();
+      newnode.name = name;
+      newnode.parent = parent;
+      newnode.calls = 0;
+      newnode.walltime = 0.;
+      for( int c = 0; c < PROFILE_NUM_COUNTERS; c++ )
+      {
+         newnode.counters[c] = 0.;
+      }
+      nodes_[parent].children.push_back(node);
+   }
+
+   nodes_[node].calls++;
+   nodes_[node].start = walltime;
+   stack_.push_back(node);
+   return node;
+}
+
+void Profiler::Leave(
+   Index  node,
+   Number walltime
+)
+{
+   if( node <= 0 || std::find(stack_.begin() + 1, stack_.end(), node) == stack_.end() )
+   {
+      return;
+   }
+
+   for( ;; )
+   {
+      const Index top = stack_.back();
+      stack_.pop_back();
+      nodes_[top].walltime += walltime - nodes_[top].start;
+      if( top == node )
+      {
+         break;
+      }
+   }
+}
+
+Number Profiler::SelfTime(
+   Index node
+) const
+{
+   Number selftime = nodes_[node].walltime;
+   const std::vector<Index>& children = nodes_[node].children;
+   for( std::vector<Index>::const_iterator it = children.begin(); it != children.end(); ++it )
+   {
+      selftime -= nodes_[*it].walltime;
+   }
+   return Max(selftime, 0.);
+}
+
+void Profiler::PrintNode(
+   const Journalist& jnlst,
+   EJournalLevel     level,
+   EJournalCategory  category,
+   Index             node,
+   Index             depth
+) const
+{
+   const Node& n = nodes_[node];
+   std::string name(2 * depth, ' ');
+   name += n.name;
+   jnlst.Printf(level, category, profile_line, name.c_str(), n.calls, n.walltime, SelfTime(node),
+                n.counters[PROFILE_VECTOR_OPS], n.counters[PROFILE_VECTOR_BYTES] / 1048576.,
+                n.counters[PROFILE_MATVEC_PRODUCTS], n.counters[PROFILE_ALLOCATIONS],
+                n.counters[PROFILE_ALLOCATED_BYTES] / 1048576.);
+   for( std::vector<Index>::const_iterator it = n.children.begin(); it != n.children.end(); ++it )
+   {
+      PrintNode(jnlst, level, category, *it, depth + 1);
+   }
+}
+
+void Profiler::PrintReport(
+   const Journalist& jnlst,
+   EJournalLevel     level,
+   EJournalCategory  category
+) const
+{
+   if( !jnlst.ProduceOutput(level, category) )
+   {
+      return;
+   }
+
+   jnlst.Printf(level, category, "\n\nProfile as call tree (wallclock seconds, counters excluding children):\n\n");
+   jnlst.Printf(level, category, profile_header, "scope", "calls", "total", "self", "vec ops", "vec MB",
+                "matvecs", "allocs", "alloc MB");
+   const std::vector<Index>& children = nodes_[0].children;
+   for( std::vector<Index>::const_iterator it = children.begin(); it != children.end(); ++it )
+   {
+      PrintNode(jnlst, level, category, *it, 0);
+   }
+   const Node& root = nodes_[0];
+   jnlst.Printf(level, category, profile_line, root.name, root.calls, 0., 0.,
+                root.counters[PROFILE_VECTOR_OPS], root.counters[PROFILE_VECTOR_BYTES] / 1048576.,
+                root.counters[PROFILE_MATVEC_PRODUCTS], root.counters[PROFILE_ALLOCATIONS],
+                root.counters[PROFILE_ALLOCATED_BYTES] / 1048576.);
+
+   // sum up the nodes with the same name
+   std::vector<FlatEntry> flat;
+   for( Index node = 1; node < (Index) nodes_.size(); node++ )
+   {
+      const Node& n = nodes_[node];
+      std::vector<FlatEntry>::iterator entry = flat.begin();
+      while( entry != flat.end() && strcmp(entry->name, n.name) != 0 )
+      {
+         ++entry;
+      }
+      if( entry == flat.end() )
+      {
+         FlatEntry newentry;
+         newentry.name = n.name;
+         newentry.calls = 0;
+         newentry.walltime = 0.;
+         newentry.selftime = 0.;
+         for( int c = 0; c < PROFILE_NUM_COUNTERS; c++ )
+         {
+            newentry.counters[c] = 0.;
+         }
+         flat.push_back(newentry);
+         entry = flat.end() - 1;
+      }
+      entry->calls += n.calls;
+      entry->walltime += n.walltime;
+      entry->selftime += SelfTime(node);
+      for( int c = 0; c < PROFILE_NUM_COUNTERS; c++ )
+      {
+         entry->counters[c] += n.counters[c];
+      }
+   }
+   std::stable_sort(flat.begin(), flat.end(), LargerSelfTime);
+
+   jnlst.Printf(level, category, "\n\nFlat profile (sorted by self time):\n\n");
+   jnlst.Printf(level, category, profile_header, "scope", "calls", "total", "self", "vec ops", "vec MB",
+                "matvecs", "allocs", "alloc MB");
+   for( std::vector<FlatEntry>::const_iterator entry = flat.begin(); entry != flat.end(); ++entry )
+   {
+      jnlst.Printf(level, category, profile_line, entry->name, entry->calls, entry->walltime, entry->selftime,
+                   entry->counters[PROFILE_VECTOR_OPS], entry->counters[PROFILE_VECTOR_BYTES] / 1048576.,
+                   entry->counters[PROFILE_MATVEC_PRODUCTS], entry->counters[PROFILE_ALLOCATIONS],
+                   entry->counters[PROFILE_ALLOCATED_BYTES] / 1048576.);
+   }
+}
+
+Profiler* Profiler::Active()
+{
+   return active_profiler;
+}
+
+Profiler* Profiler::SetActive(
+   Profiler* profiler
+)
+{
+   Profiler* previous = active_profiler;
+   active_profiler = profiler;
+   return previous;
+}
+
+} // namespace Ipopt
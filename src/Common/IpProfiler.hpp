@@ -0,0 +1,265 @@
+// Copyright (C) 2021 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPPROFILER_HPP__
+#define __IPPROFILER_HPP__
+
+#include "IpTypes.hpp"
+#include "IpUtils.hpp"
+#include "IpJournalist.hpp"
+
+#include <vector>
+
+namespace Ipopt
+{
+
+/** Counters that are recorded by the Profiler.
+ * @since 3.14.5
+ */
+enum EProfileCounter
+{
+   PROFILE_VECTOR_OPS = 0,   /**< number of operations on dense vectors */
+   PROFILE_VECTOR_BYTES,     /**< bytes of vector elements read or written by these operations */
+   PROFILE_MATVEC_PRODUCTS,  /**< number of products of a triplet matrix with a vector */
+   PROFILE_ALLOCATIONS,      /**< number of allocations of storage for the values of vectors and triplet matrices */
+   PROFILE_ALLOCATED_BYTES,  /**< bytes allocated by these allocations */
+   PROFILE_NUM_COUNTERS
+};
+
+/** Hierarchical profiler of nested scopes.
+ *
+ *  The profiler builds a call tree of named scopes: entering a scope
+ *  creates (or reuses) a child of the currently open scope.  For every
+ *  node of the tree, the number of calls and the wallclock time are
+ *  recorded, as well as a number of counters (see EProfileCounter)
+ *  for the events that happen while the node is the innermost open
+ *  scope.
+ *
+ *  The timed tasks of TimingStatistics open and close scopes of the
+ *  profiler of the TimingStatistics when it is enabled, so that the
+ *  call tree follows the nesting of the timed tasks.  Additional
+ *  scopes can be opened with ProfileScope.
+ *
+ *  Counters are recorded in the active profiler of the current
+ *  thread, see SetActive and ProfileCount, since the linear algebra
+ *  objects do not know about the TimingStatistics of a solve.
+ *
+ *  At the end, PrintReport prints the call tree and a flat profile,
+ *  where the nodes with the same name are summed up.
+ *  @since 3.14.5
+ */
+class IPOPTLIB_EXPORT Profiler
+{
+public:
+   /** Constructor; the profiler is disabled initially */
+   Profiler();
+
+   /** Destructor */
+   ~Profiler();
+
+   /** Enable recording */
+   void Enable()
+   {
+      enabled_ = true;
+   }
+
+   /** Disable recording; Enter returns -1 and Count has no effect */
+   void Disable()
+   {
+      enabled_ = false;
+   }
+
+   /** Whether recording is enabled */
+   bool IsEnabled() const
+   {
+      return enabled_;
+   }
+
+   /** Remove all recorded data */
+   void Reset();
+
+   /** Open a scope as child of the innermost open scope.
+    *
+    *  @param name     name of the scope, must stay valid as long as the profiler is used (e.g., a string literal)
+    *  @param walltime current wallclock time
+    *  @return node of the scope, to be passed to Leave, or -1 if recording is disabled
+    */
+   Index Enter(
+      const char* name,
+      Number      walltime
+   );
+
+   /** Close a scope.
+    *
+    *  Scopes that have been opened after the given one and that are
+    *  still open (e.g., because an exception has been thrown) are
+    *  closed as well.  Nothing happens if the scope is not open.
+    */
+   void Leave(
+      Index  node,
+      Number walltime
+   );
+
+   /** Add to a counter of the innermost open scope */
+   void Count(
+      EProfileCounter counter,
+      Number          amount
+   )
+   {
+      if( enabled_ )
+      {
+         nodes_[stack_.back()].counters[counter] += amount;
+      }
+   }
+
+   /** Print the call tree and the flat profile */
+   void PrintReport(
+      const Journalist& jnlst,
+      EJournalLevel     level,
+      EJournalCategory  category
+   ) const;
+
+   /** Profiler that receives the counters recorded by the current thread, or NULL */
+   static Profiler* Active();
+
+   /** Set the profiler that receives the counters recorded by the current thread.
+    *
+    *  If Ipopt has been compiled without C++11 support, there is only
+    *  one active profiler for all threads.
+    *
+    *  @return the previously active profiler
+    */
+   static Profiler* SetActive(
+      Profiler* profiler
+   );
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called. */
+   ///@{
+   /** Copy Constructor */
+   Profiler(
+      const Profiler&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const Profiler&
+   );
+   ///@}
+
+   /** Node of the call tree */
+   struct Node
+   {
+      const char*        name;
+      Index              parent;
+      std::vector<Index> children;
+      Index              calls;
+      Number             walltime;
+      Number             start;
+      Number             counters[PROFILE_NUM_COUNTERS];
+   };
+
+   /** Print a node and its children in the call tree */
+   void PrintNode(
+      const Journalist& jnlst,
+      EJournalLevel     level,
+      EJournalCategory  category,
+      Index             node,
+      Index             depth
+   ) const;
+
+   /** Wallclock time of a node without the time of its children */
+   Number SelfTime(
+      Index node
+   ) const;
+
+   /** Whether recording is enabled */
+   bool enabled_;
+
+   /** Nodes of the call tree; node 0 is the root, which collects the counters outside of any scope */
+   std::vector<Node> nodes_;
+
+   /** Open scopes, innermost last; starts with the root */
+   std::vector<Index> stack_;
+};
+
+/** Add to a counter of the active profiler of the current thread, if any.
+ * @since 3.14.5
+ */
+inline void ProfileCount(
+   EProfileCounter counter,
+   Number          amount
+)
+{
+   Profiler* profiler = Profiler::Active();
+   if( profiler != NULL )
+   {
+      profiler->Count(counter, amount);
+   }
+}
+
+/** Scope of the active profiler of the current thread that is open during the lifetime of this object.
+ * @since 3.14.5
+ */
+class IPOPTLIB_EXPORT ProfileScope
+{
+public:
+   /** Open a scope with the given name, which must stay valid as long as the profiler is used */
+   ProfileScope(
+      const char* name
+   )
+      : profiler_(Profiler::Active()),
+        node_(-1)
+   {
+      if( profiler_ != NULL && profiler_->IsEnabled() )
+      {
+         node_ = profiler_->Enter(name, WallclockTime());
+      }
+   }
+
+   /** Close the scope */
+   ~ProfileScope()
+   {
+      if( node_ >= 0 )
+      {
+         profiler_->Leave(node_, WallclockTime());
+      }
+   }
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called. */
+   ///@{
+   /** Default Constructor */
+   ProfileScope();
+
+   /** Copy Constructor */
+   ProfileScope(
+      const ProfileScope&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const ProfileScope&
+   );
+   ///@}
+
+   Profiler* profiler_;
+   Index     node_;
+};
+
+} // namespace Ipopt
+
+#endif
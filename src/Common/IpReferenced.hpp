@@ -12,6 +12,13 @@
 
 #include <list>
 
+#ifdef IPOPT_ATOMIC_REFCOUNT
+#if __cplusplus < 201103L && !(defined(_MSC_VER) && _MSC_VER >= 1900)
+#error "Ipopt has been build with atomic reference counts, which requires C++11"
+#endif
+#include <atomic>
+#endif
+
 #if IPOPT_CHECKLEVEL > 3
 #define IP_DEBUG_REFERENCED
 #endif
@@ -165,6 +172,29 @@ class Referencer { };
  * counts. To avoid this pitfall, we use an intrusive reference counting
  * technique where the reference count is stored in the object being
  * referenced.
+ *
+ * Thread-safety:
+ * By default, the reference count is a plain integer.  Therefore, a
+ * ReferencedObject must not be referenced by SmartPtr's that are
+ * created, copied, or released in different threads at the same time.
+ * If Ipopt has been configured with --enable-atomic-refcount (macro
+ * IPOPT_ATOMIC_REFCOUNT in IpoptConfig.h), the reference count is
+ * updated atomically, so that SmartPtr's to the same object can be
+ * used concurrently.  This does not make the object itself safe for
+ * concurrent use.  Objects that are not modified during an
+ * optimization and can therefore be shared by IpoptApplication's that
+ * run in different threads are
+ *  - RegisteredOptions, once all options have been registered,
+ *    together with its RegisteredOption's and RegisteredCategory's,
+ *  - objects of user classes that are only read during the
+ *    optimization, e.g., problem data that is referenced by several
+ *    TNLP's.
+ *
+ * OptionsList, Journalist, TNLP, IpoptApplication, and all objects
+ * that are created during an optimization (vectors, matrices, spaces,
+ * ...) must not be shared.  In particular, a TaggedObject must not be
+ * shared, since cached results attach themselves as observers to the
+ * objects they depend on.
  */
 class IPOPTLIB_EXPORT ReferencedObject
 {
@@ -173,6 +203,27 @@ public:
       : reference_count_(0)
    { }
 
+   /** Copy constructor.
+    *
+    *  The copy is a new object, which is not referenced yet.
+    */
+   ReferencedObject(
+      const ReferencedObject&
+   )
+      : reference_count_(0)
+   { }
+
+   /** Assignment operator.
+    *
+    *  The references to an object do not change by an assignment.
+    */
+   ReferencedObject& operator=(
+      const ReferencedObject&
+   )
+   {
+      return *this;
+   }
+
    virtual ~ReferencedObject()
    {
       DBG_ASSERT(reference_count_ == 0);
@@ -185,13 +236,22 @@ public:
       const Referencer* referencer
    ) const;
 
+   /** Decrease the reference count.
+    *
+    *  @return the reference count after the decrease; the object can be
+    *    deleted if this is 0
+    */
    inline
-   void ReleaseRef(
+   Index ReleaseRef(
       const Referencer* referencer
    ) const;
 
 private:
+#ifdef IPOPT_ATOMIC_REFCOUNT
+   mutable std::atomic<Index> reference_count_;
+#else
    mutable Index reference_count_;
+#endif
 
 #   ifdef IP_DEBUG_REFERENCED
    mutable std::list<const Referencer*> referencers_;
@@ -213,7 +273,13 @@ void ReferencedObject::AddRef(
 ) const
 {
    //    DBG_START_METH("ReferencedObject::AddRef(const Referencer* referencer)", 0);
+#ifdef IPOPT_ATOMIC_REFCOUNT
+   // a new reference can only be created from an existing one,
+   // so no ordering with other memory operations is required
+   reference_count_.fetch_add(1, std::memory_order_relaxed);
+#else
    reference_count_++;
+#endif
    //    DBG_PRINT((1, "New reference_count_ = %" IPOPT_INDEX_FORMAT "\n", reference_count_));
 #   ifdef IP_DEBUG_REFERENCED
    referencers_.push_back(referencer);
@@ -223,13 +289,19 @@ void ReferencedObject::AddRef(
 }
 
 inline
-void ReferencedObject::ReleaseRef(
+Index ReferencedObject::ReleaseRef(
    const Referencer* referencer
 ) const
 {
    //    DBG_START_METH("ReferencedObject::ReleaseRef(const Referencer* referencer)",
    //                   0);
-   reference_count_--;
+#ifdef IPOPT_ATOMIC_REFCOUNT
+   // all modifications of the object by other threads have to be visible
+   // to the thread that deletes it
+   Index count = reference_count_.fetch_sub(1, std::memory_order_acq_rel) - 1;
+#else
+   Index count = --reference_count_;
+#endif
    //    DBG_PRINT((1, "New reference_count_ = %" IPOPT_INDEX_FORMAT "\n", reference_count_));
 
 #   ifdef IP_DEBUG_REFERENCED
@@ -255,6 +327,8 @@ void ReferencedObject::ReleaseRef(
 #   else
    (void) referencer;
 #   endif
+
+   return count;
 }
 
 } // namespace Ipopt
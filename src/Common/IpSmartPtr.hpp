@@ -637,8 +637,7 @@ void SmartPtr<T>::ReleasePointer_()
 
    if( ptr_ )
    {
-      ptr_->ReleaseRef(this);
-      if( ptr_->ReferenceCount() == 0 )
+      if( ptr_->ReleaseRef(this) == 0 )
       {
          delete ptr_;
       }
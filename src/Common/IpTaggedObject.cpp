@@ -32,8 +32,16 @@ namespace Ipopt
 /** Global data that is incremented every time ANY TaggedObject changes.
  *
  * This allows us to obtain a unique Tag when the object changes.
+ *
+ * With atomic reference counts, objects may be shared between threads,
+ * so the tags need to be unique over all threads.  Otherwise, each
+ * thread has its own counter.
  */
+#ifdef IPOPT_ATOMIC_REFCOUNT
+static std::atomic<TaggedObject::Tag> unique_tag(1);
+#else
 static IPOPT_THREAD_LOCAL TaggedObject::Tag unique_tag =  1;
+#endif
 
 /** Objects derived from TaggedObject MUST call this
  *  method every time their internal state changes to
@@ -42,9 +50,13 @@ static IPOPT_THREAD_LOCAL TaggedObject::Tag unique_tag =  1;
 void TaggedObject::ObjectChanged()
 {
    DBG_START_METH("TaggedObject::ObjectChanged()", 0);
+#ifdef IPOPT_ATOMIC_REFCOUNT
+   tag_ = unique_tag.fetch_add(1, std::memory_order_relaxed);
+#else
    tag_ = unique_tag;
    unique_tag++;
-   DBG_ASSERT(unique_tag < std::numeric_limits<Tag>::max());
+#endif
+   DBG_ASSERT(tag_ < std::numeric_limits<Tag>::max() - 1);
    // The Notify method from the Subject base class notifies all
    // registered Observers that this subject has changed.
    Notify(Observer::NT_Changed);
@@ -57,8 +57,17 @@ namespace Ipopt
 class IPOPTLIB_EXPORT TaggedObject : public ReferencedObject, public Subject
 {
 public:
+#ifdef IPOPT_ATOMIC_REFCOUNT
+   /** Type for the Tag values
+    *
+    *  With atomic reference counts, all threads draw tags from one
+    *  counter, so it needs to be wider.
+    */
+   typedef unsigned long long Tag;
+#else
    /** Type for the Tag values */
    typedef unsigned int Tag;
+#endif
 
    /** Constructor. */
    TaggedObject()
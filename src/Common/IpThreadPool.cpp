@@ -0,0 +1,324 @@
+// Copyright (C) 2021 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpThreadPool.hpp"
+#include "IpDebug.hpp"
+
+#include <deque>
+#include <vector>
+
+#if __cplusplus >= 201103L && defined(IPOPT_HAS_THREADS)
+#define IPOPT_THREADPOOL_THREADED
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace Ipopt
+{
+
+#ifdef IPOPT_THREADPOOL_THREADED
+
+namespace
+{
+
+/** task queue owned by one worker */
+struct WorkerQueue
+{
+   std::mutex                  mutex;
+   std::deque<ThreadPoolTask*> tasks;
+};
+
+struct ThreadPoolImpl
+{
+   ThreadPool*               pool;
+   std::vector<WorkerQueue*> queues;
+   std::vector<std::thread>  threads;
+
+   /** number of tasks that have been submitted but not finished yet */
+   std::atomic<long>         pending;
+   /** number of tasks sitting in a queue */
+   std::atomic<long>         queued;
+   /** counter for distributing tasks that are submitted from outside */
+   std::atomic<unsigned long> next_queue;
+
+   std::mutex                idle_mutex;
+   std::condition_variable   idle_cv;
+   bool                      shutdown;
+
+   bool PopTask(
+      Index            worker,
+      ThreadPoolTask*& task
+   );
+
+   void Push(
+      Index           worker,
+      ThreadPoolTask* task
+   );
+
+   void Notify(
+      bool all
+   );
+
+   void WorkerLoop(
+      Index worker
+   );
+};
+
+/** pool and worker index of the current thread, if it executes tasks */
+thread_local ThreadPoolImpl* current_pool = NULL;
+thread_local Index current_worker = 0;
+
+bool ThreadPoolImpl::PopTask(
+   Index            worker,
+   ThreadPoolTask*& task
+)
+{
+   const Index n = (Index) queues.size();
+
+   // own queue first, newest task
+   {
+      WorkerQueue& q = *queues[worker];
+      std::lock_guard<std::mutex> lock(q.mutex);
+      if( !q.tasks.empty() )
+      {
+         task = q.tasks.back();
+         q.tasks.pop_back();
+         --queued;
+         return true;
+      }
+   }
+
+   // steal oldest task from another worker
+   for( Index k = 1; k < n; k++ )
+   {
+      WorkerQueue& q = *queues[(worker + k) % n];
+      std::lock_guard<std::mutex> lock(q.mutex);
+      if( !q.tasks.empty() )
+      {
+         task = q.tasks.front();
+         q.tasks.pop_front();
+         --queued;
+         return true;
+      }
+   }
+
+   return false;
+}
+
+void ThreadPoolImpl::Notify(
+   bool all
+)
+{
+   // acquire the mutex so that a thread that just checked the wait
+   // predicate cannot miss the notification
+   {
+      std::lock_guard<std::mutex> lock(idle_mutex);
+   }
+   if( all )
+   {
+      idle_cv.notify_all();
+   }
+   else
+   {
+      idle_cv.notify_one();
+   }
+}
+
+void ThreadPoolImpl::Push(
+   Index           worker,
+   ThreadPoolTask* task
+)
+{
+   {
+      WorkerQueue& q = *queues[worker];
+      std::lock_guard<std::mutex> lock(q.mutex);
+      q.tasks.push_back(task);
+      ++queued;
+   }
+   Notify(false);
+}
+
+void ThreadPoolImpl::WorkerLoop(
+   Index worker
+)
+{
+   current_pool = this;
+   current_worker = worker;
+
+   while( true )
+   {
+      ThreadPoolTask* task;
+      if( PopTask(worker, task) )
+      {
+         task->Run(*pool, worker);
+         if( --pending == 0 )
+         {
+            Notify(true);
+         }
+         continue;
+      }
+
+      std::unique_lock<std::mutex> lock(idle_mutex);
+      idle_cv.wait(lock, [this]
+      {
+         return shutdown || queued > 0;
+      });
+      if( shutdown && queued == 0 )
+      {
+         break;
+      }
+   }
+
+   current_pool = NULL;
+}
+
+} // namespace
+
+ThreadPool::ThreadPool(
+   Index num_threads
+)
+   : num_threads_(num_threads > 0 ? num_threads : HardwareConcurrency())
+{
+   ThreadPoolImpl* impl = new ThreadPoolImpl();
+   impl->pool = this;
+   impl->pending = 0;
+   impl->queued = 0;
+   impl->next_queue = 0;
+   impl->shutdown = false;
+   for( Index i = 0; i < num_threads_; i++ )
+   {
+      impl->queues.push_back(new WorkerQueue());
+   }
+   // worker 0 is the thread that calls Wait()
+   for( Index i = 1; i < num_threads_; i++ )
+   {
+      impl->threads.push_back(std::thread(&ThreadPoolImpl::WorkerLoop, impl, i));
+   }
+   impl_ = impl;
+}
+
+ThreadPool::~ThreadPool()
+{
+   ThreadPoolImpl* impl = static_cast<ThreadPoolImpl*>(impl_);
+   Wait();
+   {
+      std::lock_guard<std::mutex> lock(impl->idle_mutex);
+      impl->shutdown = true;
+   }
+   impl->idle_cv.notify_all();
+   for( size_t i = 0; i < impl->threads.size(); i++ )
+   {
+      impl->threads[i].join();
+   }
+   for( size_t i = 0; i < impl->queues.size(); i++ )
+   {
+      delete impl->queues[i];
+   }
+   delete impl;
+}
+
+void ThreadPool::Submit(
+   ThreadPoolTask* task
+)
+{
+   DBG_ASSERT(task != NULL);
+   ThreadPoolImpl* impl = static_cast<ThreadPoolImpl*>(impl_);
+
+   ++impl->pending;
+   Index worker;
+   if( current_pool == impl )
+   {
+      worker = current_worker;
+   }
+   else
+   {
+      worker = (Index)(impl->next_queue++ % (unsigned long) num_threads_);
+   }
+   impl->Push(worker, task);
+}
+
+void ThreadPool::Wait()
+{
+   ThreadPoolImpl* impl = static_cast<ThreadPoolImpl*>(impl_);
+   DBG_ASSERT(current_pool == NULL || current_pool == impl);
+
+   ThreadPoolImpl* prev_pool = current_pool;
+   Index prev_worker = current_worker;
+   current_pool = impl;
+   current_worker = 0;
+
+   while( impl->pending > 0 )
+   {
+      ThreadPoolTask* task;
+      if( impl->PopTask(0, task) )
+      {
+         task->Run(*this, 0);
+         if( --impl->pending == 0 )
+         {
+            impl->Notify(true);
+         }
+         continue;
+      }
+
+      std::unique_lock<std::mutex> lock(impl->idle_mutex);
+      impl->idle_cv.wait(lock, [impl]
+      {
+         return impl->pending == 0 || impl->queued > 0;
+      });
+   }
+
+   current_pool = prev_pool;
+   current_worker = prev_worker;
+}
+
+Index ThreadPool::HardwareConcurrency()
+{
+   Index n = (Index) std::thread::hardware_concurrency();
+   return n > 0 ? n : 1;
+}
+
+#else // IPOPT_THREADPOOL_THREADED
+
+ThreadPool::ThreadPool(
+   Index /*num_threads*/
+)
+   : num_threads_(1),
+     impl_(new std::deque<ThreadPoolTask*>())
+{ }
+
+ThreadPool::~ThreadPool()
+{
+   Wait();
+   delete static_cast<std::deque<ThreadPoolTask*>*>(impl_);
+}
+
+void ThreadPool::Submit(
+   ThreadPoolTask* task
+)
+{
+   DBG_ASSERT(task != NULL);
+   static_cast<std::deque<ThreadPoolTask*>*>(impl_)->push_back(task);
+}
+
+void ThreadPool::Wait()
+{
+   std::deque<ThreadPoolTask*>& tasks = *static_cast<std::deque<ThreadPoolTask*>*>(impl_);
+   while( !tasks.empty() )
+   {
+      ThreadPoolTask* task = tasks.back();
+      tasks.pop_back();
+      task->Run(*this, 0);
+   }
+}
+
+Index ThreadPool::HardwareConcurrency()
+{
+   return 1;
+}
+
+#endif // IPOPT_THREADPOOL_THREADED
+
+} // namespace Ipopt
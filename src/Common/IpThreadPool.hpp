@@ -0,0 +1,125 @@
+// Copyright (C) 2021 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPTHREADPOOL_HPP__
+#define __IPTHREADPOOL_HPP__
+
+#include "IpTypes.hpp"
+#include "IpReferenced.hpp"
+
+namespace Ipopt
+{
+
+class ThreadPool;
+
+/** Base class for a unit of work that can be executed by a ThreadPool.
+ *
+ *  The pool does not take ownership of tasks: a task object must
+ *  stay alive until ThreadPool::Wait returned.  Run must not throw.
+ */
+class ThreadPoolTask
+{
+public:
+   virtual ~ThreadPoolTask()
+   { }
+
+   /** Execute the task.
+    *
+    *  worker is the index (0 <= worker < pool.NumThreads()) of the
+    *  thread that executes the task.  It can be used to address
+    *  per-thread workspace.  Further tasks can be submitted to the
+    *  pool from within Run.
+    */
+   virtual void Run(
+      ThreadPool& pool,
+      Index       worker
+   ) = 0;
+};
+
+/** A pool of worker threads with work stealing.
+ *
+ *  Every worker owns a double-ended task queue.  Tasks submitted
+ *  from within a running task go to the queue of the submitting
+ *  worker, which processes its own queue in LIFO order (good for
+ *  locality when walking up a task tree).  Idle workers steal the
+ *  oldest task from the queue of another worker.
+ *
+ *  The thread that calls Wait acts as worker 0, so a pool with
+ *  one thread does not start any additional threads and simply
+ *  executes the submitted tasks in Wait.  If Ipopt has been
+ *  compiled without C++11 support, the pool always behaves like
+ *  a pool with one thread.
+ *
+ *  A pool is meant to be driven by a single thread at a time,
+ *  i.e., Submit (from outside of a task) and Wait must not be
+ *  called concurrently from several threads.
+ *  @since 3.14.5
+ */
+class ThreadPool: public ReferencedObject
+{
+public:
+   /** Constructor.
+    *
+    *  If num_threads is not positive, the number of hardware
+    *  threads is used.
+    */
+   ThreadPool(
+      Index num_threads
+   );
+
+   /** Destructor; waits for all running tasks and stops the workers. */
+   virtual ~ThreadPool();
+
+   /** Number of threads (including the thread calling Wait) that execute tasks. */
+   Index NumThreads() const
+   {
+      return num_threads_;
+   }
+
+   /** Schedule a task for execution. */
+   void Submit(
+      ThreadPoolTask* task
+   );
+
+   /** Execute tasks until all submitted tasks (and the tasks
+    *  submitted by them) have been finished.
+    */
+   void Wait();
+
+   /** Number of concurrent threads supported by the hardware (at least 1). */
+   static Index HardwareConcurrency();
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called. */
+   ///@{
+   /** Default Constructor */
+   ThreadPool();
+
+   /** Copy Constructor */
+   ThreadPool(
+      const ThreadPool&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const ThreadPool&
+   );
+   ///@}
+
+   /** Number of threads executing tasks */
+   Index num_threads_;
+
+   /** Implementation details (queues, threads, synchronization) */
+   void* impl_;
+};
+
+} // namespace Ipopt
+
+#endif
@@ -8,6 +8,7 @@
 #define __IPTIMEDTASK_HPP__
 
 #include "IpUtils.hpp"
+#include "IpProfiler.hpp"
 
 namespace Ipopt
 {
@@ -25,7 +26,10 @@ public:
       total_walltime_(0.),
       enabled_(true),
       start_called_(false),
-      end_called_(true)
+      end_called_(true),
+      profiler_(NULL),
+      profile_name_(NULL),
+      profile_node_(-1)
    {}
 
    /** Default destructor */
@@ -49,6 +53,22 @@ public:
       enabled_ = false;
    }
 
+   /** Set a profiler in which the task opens a scope while it is started.
+    *
+    *  @param profiler profiler, or NULL to not record the task in a profiler
+    *  @param name     name of the scope, must stay valid as long as the profiler is used
+    *  @since 3.14.5
+    */
+   void SetProfiler(
+      Profiler*   profiler,
+      const char* name
+   )
+   {
+      profiler_ = profiler;
+      profile_name_ = name;
+      profile_node_ = -1;
+   }
+
    /** Method for resetting time to zero. */
    void Reset()
    {
@@ -57,6 +77,7 @@ public:
       total_walltime_ = 0.;
       start_called_ = false;
       end_called_ = true;
+      profile_node_ = -1;
    }
 
    /** Method that is called before execution of the task. */
@@ -74,6 +95,10 @@ public:
       start_cputime_ = CpuTime();
       start_systime_ = SysTime();
       start_walltime_ = WallclockTime();
+      if( profiler_ != NULL && profiler_->IsEnabled() )
+      {
+         profile_node_ = profiler_->Enter(profile_name_, start_walltime_);
+      }
    }
 
    /** Method that is called after execution of the task. */
@@ -90,7 +115,9 @@ public:
       start_called_ = false;
       total_cputime_ += CpuTime() - start_cputime_;
       total_systime_ += SysTime() - start_systime_;
-      total_walltime_ += WallclockTime() - start_walltime_;
+      const Number walltime = WallclockTime();
+      total_walltime_ += walltime - start_walltime_;
+      LeaveProfileScope(walltime);
    }
 
    /** Method that is called after execution of the task for which
@@ -109,7 +136,9 @@ public:
          start_called_ = false;
          total_cputime_ += CpuTime() - start_cputime_;
          total_systime_ += SysTime() - start_systime_;
-         total_walltime_ += WallclockTime() - start_walltime_;
+         const Number walltime = WallclockTime();
+         total_walltime_ += walltime - start_walltime_;
+         LeaveProfileScope(walltime);
       }
       DBG_ASSERT(end_called_);
    }
@@ -192,6 +221,18 @@ private:
    void operator=(const TimedTask&);
    ///@}
 
+   /** Close the scope of the task in the profiler, if one has been opened */
+   void LeaveProfileScope(
+      Number walltime
+   )
+   {
+      if( profile_node_ >= 0 )
+      {
+         profiler_->Leave(profile_node_, walltime);
+         profile_node_ = -1;
+      }
+   }
+
    /** CPU time at beginning of task. */
    Number start_cputime_;
    /** Total CPU time for task measured so far. */
@@ -212,6 +253,13 @@ private:
    bool end_called_;
    ///@}
 
+   /** @name profiler scope */
+   ///@{
+   Profiler*   profiler_;
+   const char* profile_name_;
+   Index       profile_node_;
+   ///@}
+
 };
 } // namespace Ipopt
 
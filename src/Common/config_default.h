@@ -50,6 +50,9 @@
 /* Define to 1 if WSMP is available */
 /* #undef IPOPT_HAS_WSMP */
 
+/* Define to 1 if threads are available */
+#define IPOPT_HAS_THREADS 1
+
 /* Define to be the name of C-function for Inf check */
 #ifdef _MSC_VER
 #define IPOPT_C_FINITE _finite
@@ -20,6 +20,7 @@
 #include "IpNLPBoundsRemover.hpp"
 #include "IpLibraryLoader.hpp"
 #include "IpLinearSolvers.h"
+#include "IpThreadPool.hpp"
 
 #ifdef BUILD_INEXACT
 # include "IpInexactRegOp.hpp"
@@ -386,6 +387,15 @@ void IpoptApplication::RegisterOptions(
       "NOTE: This option only works when read from the ipopt.opt options file! "
       "Determines the verbosity level for the file specified by \"output_file\". "
       "By default it is the same as \"print_level\".");
+   roptions->AddBoolOption(
+      "output_file_async",
+      "Whether to write the output file from a background thread.",
+      false,
+      "NOTE: This option only works when read from the ipopt.opt options file! "
+      "If enabled, the output for the file specified by \"output_file\" is collected in a buffer and written by a separate thread, "
+      "so that the algorithm does not wait for the file system. "
+      "The file is complete when the optimization returns. "
+      "Has no effect if Ipopt has been compiled without thread support.");
    roptions->AddBoolOption(
       "print_user_options",
       "Print all options set by the user.",
@@ -406,6 +416,15 @@ void IpoptApplication::RegisterOptions(
       "This Ipopt library has been compiled in debug mode, and a file \"debug.out\" is produced for every run. "
       "This option determines the verbosity level for this file. "
       "By default it is the same as \"print_level\".");
+   roptions->AddBoolOption(
+      "output_file_async",
+      "Whether to write the output file from a background thread.",
+      false,
+      "NOTE: This option only works when read from the ipopt.opt options file! "
+      "If enabled, the output for the file specified by \"output_file\" is collected in a buffer and written by a separate thread, "
+      "so that the algorithm does not wait for the file system. "
+      "The file is complete when the optimization returns. "
+      "Has no effect if Ipopt has been compiled without thread support.");
 #endif
 
    roptions->AddBoolOption(
@@ -414,6 +433,14 @@ void IpoptApplication::RegisterOptions(
       false,
       "If selected, the program will print the time spend for selected tasks. "
       "This implies timing_statistics=yes.");
+   roptions->AddBoolOption(
+      "print_profile",
+      "Switch to print a profile of the timed tasks.",
+      false,
+      "If selected, the program will print the time spent in the timed tasks as a call tree and as a flat profile, "
+      "together with the number of operations on dense vectors, the bytes they read or wrote, "
+      "the number of products of triplet matrices with vectors, and the number of allocations of storage for vectors and matrices. "
+      "This implies timing_statistics=yes.");
 
    roptions->SetRegisteringCategory("Miscellaneous");
    roptions->AddStringOption1(
@@ -458,6 +485,25 @@ void IpoptApplication::RegisterOptions(
 #endif
 }
 
+/** Wait until all output to the output file has been written, if it is written asynchronously */
+static void SyncOutputFile(
+   Journalist&        jnlst,
+   const OptionsList& options
+)
+{
+   std::string output_filename;
+   options.GetStringValue("output_file", output_filename, "");
+   if( output_filename == "" )
+   {
+      return;
+   }
+   AsyncFileJournal* jrnl = dynamic_cast<AsyncFileJournal*>(GetRawPtr(jnlst.GetJournal("OutputFile:" + output_filename)));
+   if( jrnl != NULL )
+   {
+      jrnl->Sync();
+   }
+}
+
 ApplicationReturnStatus IpoptApplication::OptimizeTNLP(
    const SmartPtr<TNLP>& tnlp
 )
@@ -566,6 +612,120 @@ ApplicationReturnStatus IpoptApplication::OptimizeNLP(
    }
 
    jnlst_->FlushBuffer();
+   SyncOutputFile(*jnlst_, *options_);
+
+   return retValue;
+}
+
+/** Task that solves one problem of a batch with the application of the executing worker. */
+class BatchSolveTask: public ThreadPoolTask
+{
+public:
+   std::vector<SmartPtr<IpoptApplication> >* apps;
+   TNLP* tnlp;
+   ApplicationReturnStatus* status;
+   SmartPtr<SolveStatistics>* statistics;
+
+   void Run(
+      ThreadPool& /*pool*/,
+      Index       worker
+   )
+   {
+      IpoptApplication& app = *(*apps)[worker];
+      try
+      {
+         *status = app.OptimizeTNLP(tnlp);
+         *statistics = app.Statistics();
+      }
+      catch( IpoptException& )
+      {
+         *status = Unrecoverable_Exception;
+      }
+      catch( std::bad_alloc& )
+      {
+         *status = Insufficient_Memory;
+      }
+      catch( ... )
+      {
+         *status = NonIpopt_Exception_Thrown;
+      }
+   }
+};
+
+ApplicationReturnStatus IpoptApplication::OptimizeTNLPs(
+   const std::vector<SmartPtr<TNLP> >&      tnlps,
+   Index                                    num_threads,
+   std::vector<ApplicationReturnStatus>&    status,
+   std::vector<SmartPtr<SolveStatistics> >& statistics
+)
+{
+   DBG_START_METH("IpoptApplication::OptimizeTNLPs", dbg_verbosity);
+
+   const Index nproblems = (Index) tnlps.size();
+   status.assign(nproblems, Internal_Error);
+   statistics.assign(nproblems, SmartPtr<SolveStatistics>());
+   if( nproblems == 0 )
+   {
+      return Solve_Succeeded;
+   }
+
+   if( num_threads <= 0 )
+   {
+      num_threads = ThreadPool::HardwareConcurrency();
+   }
+   num_threads = Min(num_threads, nproblems);
+   SmartPtr<ThreadPool> pool = new ThreadPool(num_threads);
+
+   // The copyright message is printed here since the solves are silent.
+   PrintCopyrightMessage();
+
+   // Every worker gets its own application, so that no objects with
+   // reference counts are shared between the threads (except for the
+   // registered options, if the reference counts are atomic).
+   std::vector<SmartPtr<IpoptApplication> > apps(pool->NumThreads());
+   for( Index w = 0; w < pool->NumThreads(); w++ )
+   {
+      SmartPtr<Journalist> jnlst = new Journalist();
+#ifdef IPOPT_ATOMIC_REFCOUNT
+      SmartPtr<RegisteredOptions> reg_options = reg_options_;
+#else
+      SmartPtr<RegisteredOptions> reg_options = new RegisteredOptions();
+      RegisterAllIpoptOptions(reg_options);
+#endif
+      SmartPtr<OptionsList> options = new OptionsList();
+      *options = *options_;
+      options->SetJournalist(jnlst);
+      options->SetRegisteredOptions(reg_options);
+
+      apps[w] = new IpoptApplication(reg_options, options, jnlst);
+      apps[w]->read_params_dat_ = false;
+      apps[w]->inexact_algorithm_ = inexact_algorithm_;
+      apps[w]->replace_bounds_ = replace_bounds_;
+   }
+
+   std::vector<BatchSolveTask> tasks(nproblems);
+   for( Index i = 0; i < nproblems; i++ )
+   {
+      tasks[i].apps = &apps;
+      tasks[i].tnlp = GetRawPtr(tnlps[i]);
+      tasks[i].status = &status[i];
+      tasks[i].statistics = &statistics[i];
+      pool->Submit(&tasks[i]);
+   }
+   pool->Wait();
+
+   // free the worker applications (and the solver objects they keep) in this thread
+   apps.clear();
+
+   ApplicationReturnStatus retValue = Solve_Succeeded;
+   for( Index i = 0; i < nproblems; i++ )
+   {
+      jnlst_->Printf(J_DETAILED, J_MAIN, "Batch problem %" IPOPT_INDEX_FORMAT ": return status %d\n", i, (int) status[i]);
+      if( retValue == Solve_Succeeded && status[i] != Solve_Succeeded )
+      {
+         retValue = status[i];
+      }
+   }
 
    return retValue;
 }
@@ -582,6 +742,25 @@ ApplicationReturnStatus IpoptApplication::ReOptimizeNLP(
    return call_optimize();
 }
 
+/** Makes a profiler the active profiler of the current thread during its lifetime */
+class ActiveProfilerGuard
+{
+public:
+   ActiveProfilerGuard(
+      Profiler* profiler
+   )
+      : previous_(Profiler::SetActive(profiler))
+   { }
+
+   ~ActiveProfilerGuard()
+   {
+      Profiler::SetActive(previous_);
+   }
+
+private:
+   Profiler* previous_;
+};
+
 ApplicationReturnStatus IpoptApplication::call_optimize()
 {
    // Reset the print-level for the screen output
@@ -621,10 +800,23 @@ ApplicationReturnStatus IpoptApplication::call_optimize()
       bool print_timing_statistics;
       options_->GetBoolValue("print_timing_statistics", print_timing_statistics, "");
       // enable collecting timing statistics if they need to be printed later
-      if( print_timing_statistics )
+      // check whether a profile needs to be printed
+      bool print_profile;
+      options_->GetBoolValue("print_profile", print_profile, "");
+      if( print_timing_statistics || print_profile )
       {
          options_->SetStringValue("timing_statistics", "yes", true, true);
       }
+      Profiler& profiler = p2ip_data->TimingStats().GetProfiler();
+      if( print_profile )
+      {
+         profiler.Enable();
+      }
+      else
+      {
+         profiler.Disable();
+      }
+      ActiveProfilerGuard active_profiler(print_profile ? &profiler : NULL);
 
       // Set up the algorithm
       p2alg->Initialize(*jnlst_, *p2ip_nlp, *p2ip_data, *p2ip_cq, *options_, "");
@@ -714,6 +906,20 @@ ApplicationReturnStatus IpoptApplication::call_optimize()
                      p2ip_nlp->jac_d_evals());
       jnlst_->Printf(J_SUMMARY, J_STATISTICS, "Number of Lagrangian Hessian evaluations             = %" IPOPT_INDEX_FORMAT "\n",
                      p2ip_nlp->h_evals());
+      jnlst_->Printf(J_DETAILED, J_STATISTICS, "\nNumber of objective function values found in cache   = %" IPOPT_INDEX_FORMAT "\n",
+                     p2ip_nlp->f_cache_hits());
+      jnlst_->Printf(J_DETAILED, J_STATISTICS, "Number of objective gradients found in cache         = %" IPOPT_INDEX_FORMAT "\n",
+                     p2ip_nlp->grad_f_cache_hits());
+      jnlst_->Printf(J_DETAILED, J_STATISTICS, "Number of equality constraints found in cache        = %" IPOPT_INDEX_FORMAT "\n",
+                     p2ip_nlp->c_cache_hits());
+      jnlst_->Printf(J_DETAILED, J_STATISTICS, "Number of inequality constraints found in cache      = %" IPOPT_INDEX_FORMAT "\n",
+                     p2ip_nlp->d_cache_hits());
+      jnlst_->Printf(J_DETAILED, J_STATISTICS, "Number of equality constraint Jacobians in cache     = %" IPOPT_INDEX_FORMAT "\n",
+                     p2ip_nlp->jac_c_cache_hits());
+      jnlst_->Printf(J_DETAILED, J_STATISTICS, "Number of inequality constraint Jacobians in cache   = %" IPOPT_INDEX_FORMAT "\n",
+                     p2ip_nlp->jac_d_cache_hits());
+      jnlst_->Printf(J_DETAILED, J_STATISTICS, "Number of Lagrangian Hessians found in cache         = %" IPOPT_INDEX_FORMAT "\n",
+                     p2ip_nlp->h_cache_hits());
       Number wall_time_overall_alg = p2ip_data->TimingStats().OverallAlgorithm().TotalWallclockTime();
       if( p2ip_data->TimingStats().IsFunctionEvaluationTimeEnabled() )
       {
@@ -736,6 +942,11 @@ ApplicationReturnStatus IpoptApplication::call_optimize()
          p2ip_data->TimingStats().PrintAllTimingStatistics(*jnlst_, J_SUMMARY, J_TIMING_STATISTICS);
       }
 
+      if( print_profile )
+      {
+         profiler.PrintReport(*jnlst_, J_SUMMARY, J_TIMING_STATISTICS);
+      }
+
       // Write EXIT message
       if( status == SUCCESS )
       {
@@ -935,6 +1146,7 @@ ApplicationReturnStatus IpoptApplication::call_optimize()
    }
 
    jnlst_->FlushBuffer();
+   SyncOutputFile(*jnlst_, *options_);
 
    return retValue;
 }
@@ -948,7 +1160,20 @@ bool IpoptApplication::OpenOutputFile(
 
    if( IsNull(file_jrnl) )
    {
-      file_jrnl = jnlst_->AddFileJournal("OutputFile:" + file_name, file_name.c_str(), print_level);
+      bool output_file_async;
+      options_->GetBoolValue("output_file_async", output_file_async, "");
+      if( output_file_async )
+      {
+         SmartPtr<AsyncFileJournal> async_jrnl = new AsyncFileJournal("OutputFile:" + file_name, print_level);
+         if( async_jrnl->Open(file_name.c_str()) && jnlst_->AddJournal(GetRawPtr(async_jrnl)) )
+         {
+            file_jrnl = GetRawPtr(async_jrnl);
+         }
+      }
+      else
+      {
+         file_jrnl = jnlst_->AddFileJournal("OutputFile:" + file_name, file_name.c_str(), print_level);
+      }
    }
 
    // Check, if the output file could be created properly
@@ -991,6 +1216,7 @@ void IpoptApplication::RegisterAllIpoptOptions(
    roptions->SetRegisteringCategory("SPRAL Linear Solver", 180000);
    roptions->SetRegisteringCategory("WSMP Linear Solver", 170000);
    roptions->SetRegisteringCategory("Mumps Linear Solver", 160000);
+   roptions->SetRegisteringCategory("LDL Linear Solver", 155000);
    roptions->SetRegisteringCategory("MA28 Linear Solver", 150000);
 
    roptions->SetRegisteringCategory("CG Penalty", -400000);
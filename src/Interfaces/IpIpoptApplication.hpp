@@ -8,6 +8,7 @@
 #define __IPIPOPTAPPLICATION_HPP__
 
 #include <iostream>
+#include <vector>
 
 #include "IpJournalist.hpp"
 #include "IpTNLP.hpp"
@@ -173,6 +174,39 @@ public:
    virtual ApplicationReturnStatus ReOptimizeNLP(
       const SmartPtr<NLP>& nlp
    );
+
+   /** Solve a batch of independent problems that inherit from TNLP.
+    *
+    *  The problems are distributed over a pool of num_threads threads
+    *  (if num_threads is not positive, the number of hardware threads
+    *  is used), where idle threads steal problems from busy ones.
+    *  Every thread solves its problems with its own copy of the
+    *  options of this application, so each solve has its own
+    *  IpoptData and IpoptCalculatedQuantities.  The solves do not
+    *  print any output; the solutions are passed to the
+    *  finalize_solution methods of the TNLPs as usual.
+    *
+    *  All TNLPs must be distinct objects that can be evaluated
+    *  concurrently.  If Ipopt has been built without
+    *  IPOPT_ATOMIC_REFCOUNT, options that have been added to
+    *  RegOptions() by the user are not available to the solves.
+    *
+    *  @param tnlps       problems to solve
+    *  @param num_threads number of threads to use
+    *  @param status      on output, the return status of every problem
+    *  @param statistics  on output, the statistics of every problem
+    *                     (NULL if a solve terminated with a serious problem)
+    *
+    *  @return Solve_Succeeded if all problems have been solved successfully,
+    *    otherwise the status of the first problem that has not
+    *  @since 3.14.5
+    */
+   ApplicationReturnStatus OptimizeTNLPs(
+      const std::vector<SmartPtr<TNLP> >&      tnlps,
+      Index                                    num_threads,
+      std::vector<ApplicationReturnStatus>&    status,
+      std::vector<SmartPtr<SolveStatistics> >& statistics
+   );
    ///@}
 
    /** Method for opening an output file with given print_level.
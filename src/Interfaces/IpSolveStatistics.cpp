@@ -26,6 +26,11 @@ SolveStatistics::SolveStatistics(
      num_obj_grad_evals_(ip_nlp->grad_f_evals()),
      num_constr_jac_evals_(Max(ip_nlp->jac_c_evals(), ip_nlp->jac_d_evals())),
      num_hess_evals_(ip_nlp->h_evals()),
+     num_obj_hits_(ip_nlp->f_cache_hits()),
+     num_constr_hits_(Max(ip_nlp->c_cache_hits(), ip_nlp->d_cache_hits())),
+     num_obj_grad_hits_(ip_nlp->grad_f_cache_hits()),
+     num_constr_jac_hits_(Max(ip_nlp->jac_c_cache_hits(), ip_nlp->jac_d_cache_hits())),
+     num_hess_hits_(ip_nlp->h_cache_hits()),
      scaled_obj_val_(ip_cq->curr_f()),
      obj_val_(ip_cq->unscaled_curr_f()),
      scaled_dual_inf_(ip_cq->curr_dual_infeasibility(NORM_MAX)),
@@ -75,6 +80,21 @@ void SolveStatistics::NumberOfEvaluations(
    num_hess_evals       = num_hess_evals_;
 }
 
+void SolveStatistics::NumberOfCacheHits(
+   Index& num_obj_hits,
+   Index& num_constr_hits,
+   Index& num_obj_grad_hits,
+   Index& num_constr_jac_hits,
+   Index& num_hess_hits
+) const
+{
+   num_obj_hits        = num_obj_hits_;
+   num_constr_hits     = num_constr_hits_;
+   num_obj_grad_hits   = num_obj_grad_hits_;
+   num_constr_jac_hits = num_constr_jac_hits_;
+   num_hess_hits       = num_hess_hits_;
+}
+
 void SolveStatistics::Infeasibilities(
    Number& dual_inf,
    Number& constr_viol,
@@ -80,6 +80,22 @@ public:
       Index& num_hess_evals
    ) const;
 
+   /** Number of NLP function evaluations that were avoided because the result was cached.
+    *
+    *  The number of lookups that did not find a cached result is given
+    *  by NumberOfEvaluations().  How many results are cached can be set
+    *  by the options obj_cache_depth, obj_grad_cache_depth,
+    *  constr_cache_depth, constr_jac_cache_depth, and hessian_cache_depth.
+    *  @since 3.14.5
+    */
+   virtual void NumberOfCacheHits(
+      Index& num_obj_hits,
+      Index& num_constr_hits,
+      Index& num_obj_grad_hits,
+      Index& num_constr_jac_hits,
+      Index& num_hess_hits
+   ) const;
+
    /** Unscaled solution infeasibilities.
     *
     * @deprecated Use Infeasibilities() with 5 arguments instead.
@@ -177,6 +193,16 @@ private:
    Index num_constr_jac_evals_;
    /** Number of Lagrangian Hessian evaluations. */
    Index num_hess_evals_;
+   /** Number of objective function values found in the cache. */
+   Index num_obj_hits_;
+   /** Number of constraint values found in the cache (max of equality and inequality) */
+   Index num_constr_hits_;
+   /** Number of objective gradients found in the cache. */
+   Index num_obj_grad_hits_;
+   /** Number of constraint Jacobians found in the cache (max of equality and inequality) */
+   Index num_constr_jac_hits_;
+   /** Number of Lagrangian Hessians found in the cache. */
+   Index num_hess_hits_;
 
    /** Final scaled value of objective function */
    Number scaled_obj_val_;
@@ -9,6 +9,9 @@
 #include "IpOptionsList.hpp"
 #include "IpIpoptApplication.hpp"
 #include "IpBlas.hpp"
+#include "IpThreadPool.hpp"
+
+#include <vector>
 
 struct IpoptProblemInfo
 {
@@ -287,6 +290,98 @@ enum ApplicationReturnStatus IpoptSolve(
    return ApplicationReturnStatus(status);
 }
 
+/** Task that solves one problem of IpoptSolveBatch. */
+class IpoptSolveTask: public Ipopt::ThreadPoolTask
+{
+public:
+   IpoptProblem                  ipopt_problem;
+   ipnumber*                     x;
+   ipnumber*                     g;
+   ipnumber*                     obj_val;
+   ipnumber*                     mult_g;
+   ipnumber*                     mult_x_L;
+   ipnumber*                     mult_x_U;
+   UserDataPtr                   user_data;
+   enum ApplicationReturnStatus* status;
+
+   void Run(
+      Ipopt::ThreadPool& /*pool*/,
+      ipindex            /*worker*/
+   )
+   {
+      try
+      {
+         *status = IpoptSolve(ipopt_problem, x, g, obj_val, mult_g, mult_x_L, mult_x_U, user_data);
+      }
+      catch( ... )
+      {
+         *status = NonIpopt_Exception_Thrown;
+      }
+   }
+};
+
+enum ApplicationReturnStatus IpoptSolveBatch(
+   ipindex       nproblems,
+   IpoptProblem* ipopt_problems,
+   ipnumber**    x,
+   ipnumber**    g,
+   ipnumber*     obj_val,
+   ipnumber**    mult_g,
+   ipnumber**    mult_x_L,
+   ipnumber**    mult_x_U,
+   UserDataPtr*  user_data,
+   int           num_threads,
+   enum ApplicationReturnStatus* status
+)
+{
+   if( nproblems <= 0 )
+   {
+      return Solve_Succeeded;
+   }
+   if( !ipopt_problems || !x )
+   {
+      return Invalid_Problem_Definition;
+   }
+
+   if( num_threads <= 0 )
+   {
+      num_threads = (int) Ipopt::ThreadPool::HardwareConcurrency();
+   }
+   Ipopt::SmartPtr<Ipopt::ThreadPool> pool = new Ipopt::ThreadPool(num_threads < nproblems ? num_threads : nproblems);
+
+   std::vector<enum ApplicationReturnStatus> statuses(nproblems, Internal_Error);
+   std::vector<IpoptSolveTask> tasks(nproblems);
+   for( ipindex i = 0; i < nproblems; ++i )
+   {
+      tasks[i].ipopt_problem = ipopt_problems[i];
+      tasks[i].x = x[i];
+      tasks[i].g = g ? g[i] : NULL;
+      tasks[i].obj_val = obj_val ? &obj_val[i] : NULL;
+      tasks[i].mult_g = mult_g ? mult_g[i] : NULL;
+      tasks[i].mult_x_L = mult_x_L ? mult_x_L[i] : NULL;
+      tasks[i].mult_x_U = mult_x_U ? mult_x_U[i] : NULL;
+      tasks[i].user_data = user_data ? user_data[i] : NULL;
+      tasks[i].status = &statuses[i];
+      pool->Submit(&tasks[i]);
+   }
+   pool->Wait();
+
+   enum ApplicationReturnStatus retval = Solve_Succeeded;
+   for( ipindex i = 0; i < nproblems; ++i )
+   {
+      if( status )
+      {
+         status[i] = statuses[i];
+      }
+      if( retval == Solve_Succeeded && statuses[i] != Solve_Succeeded )
+      {
+         retval = statuses[i];
+      }
+   }
+
+   return retval;
+}
+
 bool GetIpoptCurrentIterate(
    IpoptProblem    ipopt_problem,
    bool            scaled,
@@ -336,6 +336,37 @@ IPOPTLIB_EXPORT enum ApplicationReturnStatus IPOPT_CALLCONV IpoptSolve(
                                 */
 );
 
+/** Function calling the Ipopt optimization algorithm for several independent problems
+ * previously defined with CreateIpoptProblem.
+ *
+ * The problems are distributed over a pool of threads, where idle threads steal problems from busy ones.
+ * Every problem is solved as by IpoptSolve with its own options, so the callback functions must be safe
+ * to be called concurrently for different problems.
+ * The output of the solves is not synchronized; setting the option print_level to 0 for all problems
+ * is recommended.
+ *
+ * The arrays x, g, obj_val, mult_g, mult_x_L, mult_x_U, user_data, and status have length nproblems and
+ * their entries take the meaning of the corresponding arguments of IpoptSolve.
+ * Except for x, each of these arrays can be NULL to pass NULL to all solves.
+ *
+ * @return Solve_Succeeded if all problems have been solved successfully, otherwise the
+ *   outcome of the first problem that has not
+ * @since 3.14.5
+ */
+IPOPTLIB_EXPORT enum ApplicationReturnStatus IPOPT_CALLCONV IpoptSolveBatch(
+   ipindex       nproblems,      /**< Number of problems to optimize */
+   IpoptProblem* ipopt_problems, /**< Problems that are to be optimized, must be distinct */
+   ipnumber**    x,              /**< Input: Starting points; Output: Optimal solutions */
+   ipnumber**    g,              /**< Values of constraint at final points (output only) */
+   ipnumber*     obj_val,        /**< Final values of objective function (output only) */
+   ipnumber**    mult_g,         /**< Initial and final multipliers for constraints */
+   ipnumber**    mult_x_L,       /**< Initial and final multipliers for lower variable bounds */
+   ipnumber**    mult_x_U,       /**< Initial and final multipliers for upper variable bounds */
+   UserDataPtr*  user_data,      /**< Pointers to user data */
+   int           num_threads,    /**< Number of threads; if not positive, the number of hardware threads is used */
+   enum ApplicationReturnStatus* status /**< Outcome of the optimization of every problem (output only) */
+);
+
 /** Get primal and dual variable values of the current iterate.
  *
  * This method can be used to get the values of the current iterate during the intermediate callback set by SetIntermediateCallback().
@@ -222,6 +222,9 @@ public:
    jboolean using_scaling_parameters;
    jboolean using_LBFGS;
 
+   /// whether the evaluation callbacks get direct buffers that alias the arrays of Ipopt
+   jboolean using_direct_buffers;
+
    SmartPtr<IpoptApplication> application;
 
    // the callback methods
@@ -238,6 +241,63 @@ public:
    jmethodID get_number_of_nonlinear_variables_;
    jmethodID get_list_of_nonlinear_variables_;
 
+   // the callback methods that take direct buffers
+   jmethodID eval_f_direct_;
+   jmethodID eval_grad_f_direct_;
+   jmethodID eval_g_direct_;
+   jmethodID eval_jac_g_direct_;
+   jmethodID eval_h_direct_;
+
+   /** A direct java.nio.ByteBuffer that aliases a native array.
+    *
+    *  Ipopt often passes the same arrays to the callbacks, so the
+    *  buffer is kept (as global reference) and reused as long as
+    *  the address and size of the array do not change.
+    */
+   struct DirectBuffer
+   {
+      const void* ptr;
+      jlong       bytes;
+      jobject     buffer;
+   };
+
+   DirectBuffer x_buffer;
+   DirectBuffer f_buffer;
+   DirectBuffer grad_f_buffer;
+   DirectBuffer g_buffer;
+   DirectBuffer jac_g_buffer;
+   DirectBuffer hess_buffer;
+   DirectBuffer lambda_buffer;
+
+   /** Get a direct buffer for an array, reusing the previous one if possible.
+    *
+    *  @return the buffer, or NULL if ptr is NULL or the JVM does not support direct buffers
+    */
+   jobject GetDirectBuffer(
+      DirectBuffer& cache,
+      const void*   ptr,
+      jlong         bytes
+   );
+
+   /** Release all direct buffers; must be called before the JNI environment becomes invalid */
+   void ReleaseDirectBuffers();
+
+   /** Call eval_jac_g or eval_h with direct buffers */
+   bool eval_matrix_direct(
+      jmethodID     method,
+      Index         n,
+      const Number* x,
+      bool          new_x,
+      Number        obj_factor,
+      Index         m,
+      const Number* lambda,
+      bool          new_lambda,
+      Index         nele,
+      Index*        iRow,
+      Index*        jCol,
+      Number*       values
+   );
+
 private:
    Jipopt(const Jipopt&);
    Jipopt& operator=(const Jipopt&);
@@ -255,9 +315,12 @@ Jipopt::Jipopt(
    : env(env_), solver(solver_), n(n_), m(m_), nele_jac(nele_jac_), nele_hess(nele_hess_), index_style(index_style_),
      mult_gj(NULL), mult_x_Lj(NULL), mult_x_Uj(NULL), xj(NULL), fj(NULL), grad_fj(NULL),
      gj(NULL), jac_gj(NULL), hessj(NULL),
-     using_scaling_parameters(false), using_LBFGS(false),
+     using_scaling_parameters(false), using_LBFGS(false), using_direct_buffers(false),
      application(new IpoptApplication())
 {
+   DirectBuffer nobuffer = { NULL, 0, NULL };
+   x_buffer = f_buffer = grad_f_buffer = g_buffer = jac_g_buffer = hess_buffer = lambda_buffer = nobuffer;
+
    application->RethrowNonIpoptException(false);
 
    // the solver class
@@ -288,10 +351,26 @@ Jipopt::Jipopt(
    get_number_of_nonlinear_variables_ = env->GetMethodID(solverCls, "get_number_of_nonlinear_variables", "()I");
    get_list_of_nonlinear_variables_   = env->GetMethodID(solverCls, "get_list_of_nonlinear_variables", "(I[I)Z");
 
+   // these methods take java.nio.ByteBuffer arguments, which do not depend on the floating-point type
+   eval_f_direct_      = env->GetMethodID(solverCls, "eval_f_direct", "(ILjava/nio/ByteBuffer;ZLjava/nio/ByteBuffer;)Z");
+   eval_grad_f_direct_ = env->GetMethodID(solverCls, "eval_grad_f_direct", "(ILjava/nio/ByteBuffer;ZLjava/nio/ByteBuffer;)Z");
+   eval_g_direct_      = env->GetMethodID(solverCls, "eval_g_direct", "(ILjava/nio/ByteBuffer;ZILjava/nio/ByteBuffer;)Z");
+   eval_jac_g_direct_  = env->GetMethodID(solverCls, "eval_jac_g_direct",
+                                          "(ILjava/nio/ByteBuffer;ZIILjava/nio/ByteBuffer;Ljava/nio/ByteBuffer;Ljava/nio/ByteBuffer;)Z");
+#ifndef IPOPT_SINGLE
+   eval_h_direct_      = env->GetMethodID(solverCls, "eval_h_direct",
+                                          "(ILjava/nio/ByteBuffer;ZDILjava/nio/ByteBuffer;ZILjava/nio/ByteBuffer;Ljava/nio/ByteBuffer;Ljava/nio/ByteBuffer;)Z");
+#else
+   eval_h_direct_      = env->GetMethodID(solverCls, "eval_h_direct",
+                                          "(ILjava/nio/ByteBuffer;ZFILjava/nio/ByteBuffer;ZILjava/nio/ByteBuffer;Ljava/nio/ByteBuffer;Ljava/nio/ByteBuffer;)Z");
+#endif
+
    if( get_bounds_info_ == 0 || get_starting_point_ == 0 || eval_f_ == 0
        || eval_grad_f_ == 0 || eval_g_ == 0 || eval_jac_g_ == 0 || eval_h_ == 0
        || get_scaling_parameters_ == 0 || get_number_of_nonlinear_variables_ == 0
-       || get_list_of_nonlinear_variables_ == 0 )
+       || get_list_of_nonlinear_variables_ == 0
+       || eval_f_direct_ == 0 || eval_grad_f_direct_ == 0 || eval_g_direct_ == 0
+       || eval_jac_g_direct_ == 0 || eval_h_direct_ == 0 )
    {
       std::cerr << "Expected callback methods missing on JIpopt.java" << std::endl;
    }
@@ -306,6 +385,59 @@ Jipopt::Jipopt(
    assert(get_scaling_parameters_ != 0);
    assert(get_number_of_nonlinear_variables_ != 0);
    assert(get_list_of_nonlinear_variables_   != 0);
+   assert(eval_f_direct_      != 0);
+   assert(eval_grad_f_direct_ != 0);
+   assert(eval_g_direct_      != 0);
+   assert(eval_jac_g_direct_  != 0);
+   assert(eval_h_direct_      != 0);
+}
+
+jobject Jipopt::GetDirectBuffer(
+   DirectBuffer& cache,
+   const void*   ptr,
+   jlong         bytes)
+{
+   if( ptr == NULL )
+   {
+      return NULL;
+   }
+
+   if( cache.buffer != NULL )
+   {
+      if( cache.ptr == ptr && cache.bytes == bytes )
+      {
+         return cache.buffer;
+      }
+      env->DeleteGlobalRef(cache.buffer);
+      cache.buffer = NULL;
+   }
+
+   jobject buffer = env->NewDirectByteBuffer(const_cast<void*>(ptr), bytes);
+   if( buffer == NULL )
+   {
+      return NULL;
+   }
+   cache.buffer = env->NewGlobalRef(buffer);
+   cache.ptr = ptr;
+   cache.bytes = bytes;
+   env->DeleteLocalRef(buffer);
+
+   return cache.buffer;
+}
+
+void Jipopt::ReleaseDirectBuffers()
+{
+   DirectBuffer* buffers[] = { &x_buffer, &f_buffer, &grad_f_buffer, &g_buffer, &jac_g_buffer, &hess_buffer, &lambda_buffer };
+   for( size_t i = 0; i < sizeof(buffers) / sizeof(*buffers); ++i )
+   {
+      if( buffers[i]->buffer != NULL )
+      {
+         env->DeleteGlobalRef(buffers[i]->buffer);
+      }
+      buffers[i]->ptr = NULL;
+      buffers[i]->bytes = 0;
+      buffers[i]->buffer = NULL;
+   }
 }
 
 bool Jipopt::get_nlp_info(
@@ -409,6 +541,13 @@ bool Jipopt::eval_f(
    bool          new_x,
    Number&       obj_value)
 {
+   if( using_direct_buffers )
+   {
+      jobject xb = GetDirectBuffer(x_buffer, x, n * (jlong) sizeof(Number));
+      jobject fb = GetDirectBuffer(f_buffer, &obj_value, (jlong) sizeof(Number));
+      return env->CallBooleanMethod(solver, eval_f_direct_, n, xb, (jboolean) new_x, fb);
+   }
+
    /* Copy the native double x to the Java double array xj, if new values */
    if( new_x )
    {
@@ -434,6 +573,13 @@ bool Jipopt::eval_grad_f(
    bool          new_x,
    Number*       grad_f)
 {
+   if( using_direct_buffers )
+   {
+      jobject xb = GetDirectBuffer(x_buffer, x, n * (jlong) sizeof(Number));
+      jobject gb = GetDirectBuffer(grad_f_buffer, grad_f, n * (jlong) sizeof(Number));
+      return env->CallBooleanMethod(solver, eval_grad_f_direct_, n, xb, (jboolean) new_x, gb);
+   }
+
    /* Copy the native double x to the Java double array xj, if new values */
    if( new_x )
    {
@@ -459,6 +605,13 @@ bool Jipopt::eval_g(
    Index         m,
    Number*       g)
 {
+   if( using_direct_buffers )
+   {
+      jobject xb = GetDirectBuffer(x_buffer, x, n * (jlong) sizeof(Number));
+      jobject gb = GetDirectBuffer(g_buffer, g, m * (jlong) sizeof(Number));
+      return env->CallBooleanMethod(solver, eval_g_direct_, n, xb, (jboolean) new_x, m, gb);
+   }
+
    /* Copy the native double x to the Java double array xj, if new values */
    if( new_x )
    {
@@ -488,6 +641,11 @@ bool Jipopt::eval_jac_g(
    Index*        jCol,
    Number*       jac_g)
 {
+   if( using_direct_buffers )
+   {
+      return eval_matrix_direct(eval_jac_g_direct_, n, x, new_x, 0., m, NULL, false, nele_jac, iRow, jCol, jac_g);
+   }
+
    // Copy the native double x to the Java double array xj, if new values
    if( new_x && x != NULL )
    {
@@ -559,6 +717,11 @@ bool Jipopt::eval_h(
    Index*        jCol,
    Number*       hess)
 {
+   if( using_direct_buffers )
+   {
+      return eval_matrix_direct(eval_h_direct_, n, x, new_x, obj_factor, m, lambda, new_lambda, nele_hess, iRow, jCol, hess);
+   }
+
    /* Copy the native double x to the Java double array xj, if new values */
    if( new_x && x != NULL )
    {
@@ -624,6 +787,81 @@ bool Jipopt::eval_h(
    return true;
 }
 
+bool Jipopt::eval_matrix_direct(
+   jmethodID     method,
+   Index         n,
+   const Number* x,
+   bool          new_x,
+   Number        obj_factor,
+   Index         m,
+   const Number* lambda,
+   bool          new_lambda,
+   Index         nele,
+   Index*        iRow,
+   Index*        jCol,
+   Number*       values)
+{
+   jobject xb = GetDirectBuffer(x_buffer, x, n * (jlong) sizeof(Number));
+   jobject vb = NULL;
+   if( values != NULL )
+   {
+      vb = GetDirectBuffer(method == eval_h_direct_ ? hess_buffer : jac_g_buffer, values, nele * (jlong) sizeof(Number));
+   }
+
+   /* The structure is requested only once, so the buffers for the index arrays are not kept.
+    * If Index is not jint, the indices are written into a temporary array of jint first.
+    */
+   jint* iRowtmp = NULL;
+   jint* jColtmp = NULL;
+   jobject iRowb = NULL;
+   jobject jColb = NULL;
+   if( iRow != NULL && jCol != NULL )
+   {
+      if( sizeof(jint) == sizeof(Index) )
+      {
+         iRowtmp = reinterpret_cast<jint*>(iRow);
+         jColtmp = reinterpret_cast<jint*>(jCol);
+      }
+      else
+      {
+         iRowtmp = new jint[nele];
+         jColtmp = new jint[nele];
+      }
+      iRowb = env->NewDirectByteBuffer(iRowtmp, nele * (jlong) sizeof(jint));
+      jColb = env->NewDirectByteBuffer(jColtmp, nele * (jlong) sizeof(jint));
+   }
+
+   bool retval;
+   if( method == eval_h_direct_ )
+   {
+      jobject lb = GetDirectBuffer(lambda_buffer, lambda, m * (jlong) sizeof(Number));
+      retval = env->CallBooleanMethod(solver, method, n, xb, (jboolean) new_x, obj_factor, m, lb, (jboolean) new_lambda, nele,
+                                      iRowb, jColb, vb);
+   }
+   else
+   {
+      retval = env->CallBooleanMethod(solver, method, n, xb, (jboolean) new_x, m, nele, iRowb, jColb, vb);
+   }
+
+   if( iRowb != NULL )
+   {
+      env->DeleteLocalRef(iRowb);
+      env->DeleteLocalRef(jColb);
+   }
+   if( iRowtmp != NULL && sizeof(jint) != sizeof(Index) )
+   {
+      for( Index i = 0; i < nele; ++i )
+      {
+         iRow[i] = (Index) iRowtmp[i];
+         jCol[i] = (Index) jColtmp[i];
+      }
+      delete[] iRowtmp;
+      delete[] jColtmp;
+   }
+
+   return retval;
+}
+
 void Jipopt::finalize_solution(
    SolverReturn               /*status*/,
    Index                      n,
@@ -825,7 +1063,8 @@ extern "C"
       jnumberArray mult_x_Uj,
       jnumberArray callback_grad_f,
       jnumberArray callback_jac_g,
-      jnumberArray callback_hess)
+      jnumberArray callback_hess,
+      jboolean     direct_buffers)
    {
       Jipopt* problem = GetRawPtr(*(SmartPtr<Jipopt>*) pipopt);
 
@@ -843,6 +1082,23 @@ extern "C"
       problem->jac_gj    = callback_jac_g;
       problem->hessj     = callback_hess;
 
+      /* check whether the JVM supports access to native memory via direct buffers */
+      problem->using_direct_buffers = false;
+      if( direct_buffers )
+      {
+         char probe;
+         jobject buffer = env->NewDirectByteBuffer(&probe, 1);
+         if( buffer != NULL )
+         {
+            problem->using_direct_buffers = true;
+            env->DeleteLocalRef(buffer);
+         }
+         else
+         {
+            env->ExceptionClear();
+         }
+      }
+
       ApplicationReturnStatus status;
 
       status = problem->application->Initialize();
@@ -856,6 +1112,9 @@ extern "C"
       /* solve the problem */
       status = problem->application->OptimizeTNLP(problem);
 
+      /* the global references to direct buffers cannot be released without a JNI environment */
+      problem->ReleaseDirectBuffers();
+
       return (jint) status;
    }
 
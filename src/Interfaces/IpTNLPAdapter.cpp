@@ -16,6 +16,7 @@
 #include "IpTDependencyDetector.hpp"
 #include "IpTSymDependencyDetector.hpp"
 #include "IpTripletToCSRConverter.hpp"
+#include "IpThreadPool.hpp"
 
 #ifdef IPOPT_HAS_HSL
 #include "CoinHslConfig.h"
@@ -150,6 +151,37 @@ void TNLPAdapter::RegisterOptions(
       "The Hessian is then not approximated in this space. "
       "If the get_number_of_nonlinear_variables method in the TNLP is implemented, this option is ignored.",
       true);
+   roptions->AddLowerBoundedIntegerOption(
+      "vector_num_threads",
+      "Number of threads used for operations on the vectors of primal variables, constraints, and bounds.",
+      0,
+      1,
+      "Operations such as axpy, dot products, and the fraction-to-the-boundary rule on long vectors are "
+      "distributed over this number of threads. "
+      "If set to 0, the number of hardware threads is used.");
+   roptions->AddLowerBoundedIntegerOption(
+      "vector_parallel_min_dim",
+      "Minimal dimension of a vector for which operations are distributed over several threads.",
+      1,
+      100000,
+      "This is only used if vector_num_threads is not 1.",
+      true);
+   roptions->AddLowerBoundedIntegerOption(
+      "matrix_num_threads",
+      "Number of threads used for products with the constraint Jacobians and the Hessian of the Lagrangian.",
+      0,
+      1,
+      "Products with the Jacobians (and their transposes) and the Hessian are distributed over this number of threads. "
+      "For this purpose, compressed row and column indices of the sparsity structures are built once. "
+      "The result does not depend on the number of threads. "
+      "If set to 0, the number of hardware threads is used.");
+   roptions->AddLowerBoundedIntegerOption(
+      "matrix_parallel_min_nonzeros",
+      "Minimal number of nonzeros of a matrix for which products are distributed over several threads.",
+      0,
+      100000,
+      "This is only used if matrix_num_threads is not 1.",
+      true);
 
    roptions->SetRegisteringCategory("Derivative Checker");
    roptions->AddStringOption4(
@@ -204,6 +236,25 @@ void TNLPAdapter::RegisterOptions(
       1e-7,
       "This determines the relative perturbation of the variable entries.",
       true);
+   roptions->AddBoolOption(
+      "findiff_coloring",
+      "Indicates whether structurally orthogonal columns of the Jacobian are approximated together.",
+      true,
+      "If enabled, the columns of the constraint Jacobian are grouped such that no two columns of a group "
+      "have a nonzero in the same row (Curtis-Powell-Reid). "
+      "The variables of a group are perturbed at the same time, so that the finite difference approximation "
+      "needs one evaluation of the constraints per group instead of one per variable. "
+      "This requires that the sparsity structure given by the TNLP includes all nonzeros of the Jacobian.",
+      true);
+   roptions->AddLowerBoundedIntegerOption(
+      "findiff_num_threads",
+      "Number of threads that evaluate the constraints at perturbed points for the finite difference approximation.",
+      0,
+      1,
+      "If not 1, the constraints are evaluated at the perturbed points for different groups of columns concurrently. "
+      "This requires that eval_g of the TNLP can be called concurrently from several threads. "
+      "If set to 0, the number of hardware threads is used.",
+      true);
    roptions->AddLowerBoundedNumberOption(
       "point_perturbation_radius",
       "Maximal perturbation of an evaluation point.",
@@ -244,10 +295,16 @@ bool TNLPAdapter::ProcessOptions(
    options.GetEnumValue("hessian_approximation", enum_int, prefix);
    hessian_approximation_ = HessianApproximationType(enum_int);
    options.GetIntegerValue("num_linear_variables", num_linear_variables_, prefix);
+   options.GetIntegerValue("vector_num_threads", vector_num_threads_, prefix);
+   options.GetIntegerValue("vector_parallel_min_dim", vector_parallel_min_dim_, prefix);
+   options.GetIntegerValue("matrix_num_threads", matrix_num_threads_, prefix);
+   options.GetIntegerValue("matrix_parallel_min_nonzeros", matrix_parallel_min_nonzeros_, prefix);
 
    options.GetEnumValue("jacobian_approximation", enum_int, prefix);
    jacobian_approximation_ = JacobianApproxEnum(enum_int);
    options.GetNumericValue("findiff_perturbation", findiff_perturbation_, prefix);
+   options.GetBoolValue("findiff_coloring", findiff_coloring_, prefix);
+   options.GetIntegerValue("findiff_num_threads", findiff_num_threads_, prefix);
 
    options.GetNumericValue("point_perturbation_radius", point_perturbation_radius_, prefix);
 
@@ -899,6 +956,22 @@ bool TNLPAdapter::GetSpaces(
       delete[] d_u_map;
       d_u_map = NULL;
 
+      if( vector_num_threads_ != 1 )
+      {
+         // the vector spaces share one thread pool
+         SmartPtr<ThreadPool> pool = new ThreadPool(vector_num_threads_);
+         if( pool->NumThreads() > 1 )
+         {
+            dv_x_space->SetThreadPool(GetRawPtr(pool), vector_parallel_min_dim_);
+            dv_x_l_space->SetThreadPool(GetRawPtr(pool), vector_parallel_min_dim_);
+            dv_x_u_space->SetThreadPool(GetRawPtr(pool), vector_parallel_min_dim_);
+            dc_space->SetThreadPool(GetRawPtr(pool), vector_parallel_min_dim_);
+            dv_d_space->SetThreadPool(GetRawPtr(pool), vector_parallel_min_dim_);
+            dv_d_l_space->SetThreadPool(GetRawPtr(pool), vector_parallel_min_dim_);
+            dv_d_u_space->SetThreadPool(GetRawPtr(pool), vector_parallel_min_dim_);
+         }
+      }
+
       delete[] g_l;
       g_l = NULL;
       delete[] g_u;
@@ -1142,7 +1215,16 @@ bool TNLPAdapter::GetSpaces(
          n_added_constr = n_x_fixed_;
       }
 
-      Jac_c_space_ = new GenTMatrixSpace(n_c + n_added_constr, n_x_var, nz_jac_c_, jac_c_iRow, jac_c_jCol);
+      // the matrix spaces share one thread pool for products
+      SmartPtr<ThreadPool> matrix_pool;
+      if( matrix_num_threads_ != 1 )
+      {
+         matrix_pool = new ThreadPool(matrix_num_threads_);
+      }
+
+      SmartPtr<GenTMatrixSpace> jac_c_space = new GenTMatrixSpace(n_c + n_added_constr, n_x_var, nz_jac_c_, jac_c_iRow, jac_c_jCol);
+      jac_c_space->SetThreadPool(GetRawPtr(matrix_pool), matrix_parallel_min_nonzeros_);
+      Jac_c_space_ = GetRawPtr(jac_c_space);
       delete[] jac_c_iRow;
       jac_c_iRow = NULL;
       delete[] jac_c_jCol;
@@ -1187,7 +1269,9 @@ bool TNLPAdapter::GetSpaces(
          }
       }
       nz_jac_d_ = current_nz;
-      Jac_d_space_ = new GenTMatrixSpace(n_d, n_x_var, nz_jac_d_, jac_d_iRow, jac_d_jCol);
+      SmartPtr<GenTMatrixSpace> jac_d_space = new GenTMatrixSpace(n_d, n_x_var, nz_jac_d_, jac_d_iRow, jac_d_jCol);
+      jac_d_space->SetThreadPool(GetRawPtr(matrix_pool), matrix_parallel_min_nonzeros_);
+      Jac_d_space_ = GetRawPtr(jac_d_space);
       delete[] jac_d_iRow;
       jac_d_iRow = NULL;
       delete[] jac_d_jCol;
@@ -1275,7 +1359,9 @@ bool TNLPAdapter::GetSpaces(
             current_nz = nz_full_h_;
          }
          nz_h_ = current_nz;
-         Hess_lagrangian_space_ = new SymTMatrixSpace(n_x_var, nz_h_, h_iRow, h_jCol);
+         SmartPtr<SymTMatrixSpace> hess_space = new SymTMatrixSpace(n_x_var, nz_h_, h_iRow, h_jCol);
+         hess_space->SetThreadPool(GetRawPtr(matrix_pool), matrix_parallel_min_nonzeros_);
+         Hess_lagrangian_space_ = GetRawPtr(hess_space);
          delete[] full_h_iRow;
          full_h_iRow = NULL;
          delete[] full_h_jCol;
@@ -1991,6 +2077,49 @@ void TNLPAdapter::FinalizeSolution(
 {
    DBG_START_METH("TNLPAdapter::FinalizeSolution", dbg_verbosity);
 
+   if( jnlst_->ProduceOutput(J_DETAILED, J_MAIN) )
+   {
+      // memory of deleted vectors and matrices is reused by the spaces
+      Index pool_hits = 0;
+      Index pool_misses = 0;
+      const VectorSpace* vector_spaces[7] =
+      {
+         GetRawPtr(x_space_), GetRawPtr(c_space_), GetRawPtr(d_space_), GetRawPtr(x_l_space_),
+         GetRawPtr(x_u_space_), GetRawPtr(d_l_space_), GetRawPtr(d_u_space_)
+      };
+      for( int i = 0; i < 7; i++ )
+      {
+         const DenseVectorSpace* dense_space = dynamic_cast<const DenseVectorSpace*>(vector_spaces[i]);
+         if( dense_space != NULL )
+         {
+            pool_hits += dense_space->StoragePoolHits();
+            pool_misses += dense_space->StoragePoolMisses();
+         }
+      }
+      const MatrixSpace* matrix_spaces[3] =
+      {
+         GetRawPtr(Jac_c_space_), GetRawPtr(Jac_d_space_), GetRawPtr(Hess_lagrangian_space_)
+      };
+      for( int i = 0; i < 3; i++ )
+      {
+         const GenTMatrixSpace* gent_space = dynamic_cast<const GenTMatrixSpace*>(matrix_spaces[i]);
+         const SymTMatrixSpace* symt_space = dynamic_cast<const SymTMatrixSpace*>(matrix_spaces[i]);
+         if( gent_space != NULL )
+         {
+            pool_hits += gent_space->StoragePoolHits();
+            pool_misses += gent_space->StoragePoolMisses();
+         }
+         else if( symt_space != NULL )
+         {
+            pool_hits += symt_space->StoragePoolHits();
+            pool_misses += symt_space->StoragePoolMisses();
+         }
+      }
+      jnlst_->Printf(J_DETAILED, J_MAIN,
+                     "\nStorage pools of vectors and matrices: %" IPOPT_INDEX_FORMAT " allocations reused memory, %" IPOPT_INDEX_FORMAT " allocations required new memory.\n",
+                     pool_hits, pool_misses);
+   }
+
    update_local_x(x);
    update_local_lambda(y_c, y_d);
 
@@ -2735,6 +2864,45 @@ bool TNLPAdapter::internal_eval_g(
    return retval;
 }
 
+class TNLPAdapter::FindiffGroupTask: public ThreadPoolTask
+{
+public:
+   FindiffGroupTask(
+      TNLPAdapter* adapter,
+      Index        group,
+      Number*      x_pert,
+      Number*      g_pert
+   )
+      : adapter_(adapter),
+        group_(group),
+        x_pert_(x_pert),
+        g_pert_(g_pert),
+        success_(false)
+   { }
+
+   virtual void Run(
+      ThreadPool& /*pool*/,
+      Index       worker
+   )
+   {
+      // every worker has its own copy of x and its own constraint values
+      success_ = adapter_->eval_findiff_group(group_, x_pert_ + (size_t) worker * adapter_->n_full_x_,
+                                              g_pert_ + (size_t) worker * adapter_->n_full_g_);
+   }
+
+   bool Success() const
+   {
+      return success_;
+   }
+
+private:
+   TNLPAdapter* adapter_;
+   Index        group_;
+   Number*      x_pert_;
+   Number*      g_pert_;
+   bool         success_;
+};
+
 bool TNLPAdapter::internal_eval_jac_g(
    bool new_x
 )
@@ -2758,39 +2926,42 @@ bool TNLPAdapter::internal_eval_jac_g(
       retval = internal_eval_g(new_x);
       if( retval )
       {
-         Number* full_g_pert = new Number[n_full_g_];
-         Number* full_x_pert = new Number[n_full_x_];
-         IpBlasCopy(n_full_x_, full_x_, 1, full_x_pert, 1);
-         // Compute the finite difference Jacobian
-         for( Index ivar = 0; ivar < n_full_x_; ivar++ )
+         // Compute the finite difference Jacobian, one evaluation of the constraints per group of columns
+         const Index ngroups = (Index) findiff_group_ia_.size() - 1;
+         if( IsValid(findiff_pool_) && ngroups > 1 )
          {
-            if( findiff_x_l_[ivar] < findiff_x_u_[ivar] )
+            const Index nthreads = findiff_pool_->NumThreads();
+            std::vector<Number> x_pert((size_t) nthreads * n_full_x_);
+            std::vector<Number> g_pert((size_t) nthreads * n_full_g_);
+            for( Index t = 0; t < nthreads; t++ )
             {
-               const Number xorig = full_x_pert[ivar];
-               Number this_perturbation = findiff_perturbation_ * Max(Number(1.), std::abs(full_x_[ivar]));
-               full_x_pert[ivar] += this_perturbation;
-               if( full_x_pert[ivar] > findiff_x_u_[ivar] )
-               {
-                  // if at upper bound, then change direction towards lower bound
-                  this_perturbation = -this_perturbation;
-                  full_x_pert[ivar] = xorig + this_perturbation;
-               }
-               retval = tnlp_->eval_g(n_full_x_, full_x_pert, true, n_full_g_, full_g_pert);
-               if( !retval )
-               {
-                  break;
-               }
-               for( Index i = findiff_jac_ia_[ivar]; i < findiff_jac_ia_[ivar + 1]; i++ )
-               {
-                  const Index& icon = findiff_jac_ja_[i];
-                  const Index& ipos = findiff_jac_postriplet_[i];
-                  jac_g_[ipos] = (full_g_pert[icon] - full_g_[icon]) / this_perturbation;
-               }
-               full_x_pert[ivar] = xorig;
+               IpBlasCopy(n_full_x_, full_x_, 1, &x_pert[(size_t) t * n_full_x_], 1);
+            }
+            std::vector<FindiffGroupTask> tasks;
+            tasks.reserve(ngroups);
+            for( Index group = 0; group < ngroups; group++ )
+            {
+               tasks.push_back(FindiffGroupTask(this, group, &x_pert[0], &g_pert[0]));
+            }
+            for( Index group = 0; group < ngroups; group++ )
+            {
+               findiff_pool_->Submit(&tasks[group]);
+            }
+            findiff_pool_->Wait();
+            for( Index group = 0; group < ngroups && retval; group++ )
+            {
+               retval = tasks[group].Success();
+            }
+         }
+         else
+         {
+            std::vector<Number> x_pert(full_x_, full_x_ + n_full_x_);
+            std::vector<Number> g_pert(n_full_g_);
+            for( Index group = 0; group < ngroups && retval; group++ )
+            {
+               retval = eval_findiff_group(group, &x_pert[0], &g_pert[0]);
             }
          }
-         delete[] full_g_pert;
-         delete[] full_x_pert;
       }
    }
 
@@ -2802,6 +2973,62 @@ bool TNLPAdapter::internal_eval_jac_g(
    return retval;
 }
 
+bool TNLPAdapter::eval_findiff_group(
+   Index   group,
+   Number* x_pert,
+   Number* g_pert
+)
+{
+   const Index* cols_begin = &findiff_group_cols_[0] + findiff_group_ia_[group];
+   const Index* cols_end = &findiff_group_cols_[0] + findiff_group_ia_[group + 1];
+
+   // perturb all variables of the group
+   bool perturbed = false;
+   for( const Index* col = cols_begin; col != cols_end; ++col )
+   {
+      const Index ivar = *col;
+      if( findiff_x_l_[ivar] < findiff_x_u_[ivar] )
+      {
+         Number this_perturbation = findiff_perturbation_ * Max(Number(1.), std::abs(full_x_[ivar]));
+         if( full_x_[ivar] + this_perturbation > findiff_x_u_[ivar] )
+         {
+            // if at upper bound, then change direction towards lower bound
+            this_perturbation = -this_perturbation;
+         }
+         x_pert[ivar] = full_x_[ivar] + this_perturbation;
+         perturbed = true;
+      }
+   }
+   if( !perturbed )
+   {
+      return true;
+   }
+
+   bool retval = tnlp_->eval_g(n_full_x_, x_pert, true, n_full_g_, g_pert);
+
+   // since the columns of a group have no row in common, each constraint changed due to at most one variable
+   for( const Index* col = cols_begin; col != cols_end; ++col )
+   {
+      const Index ivar = *col;
+      if( findiff_x_l_[ivar] < findiff_x_u_[ivar] )
+      {
+         const Number this_perturbation = x_pert[ivar] - full_x_[ivar];
+         x_pert[ivar] = full_x_[ivar];
+         if( retval )
+         {
+            for( Index i = findiff_jac_ia_[ivar]; i < findiff_jac_ia_[ivar + 1]; i++ )
+            {
+               const Index& icon = findiff_jac_ja_[i];
+               const Index& ipos = findiff_jac_postriplet_[i];
+               jac_g_[ipos] = (g_pert[icon] - full_g_[icon]) / this_perturbation;
+            }
+         }
+      }
+   }
+
+   return retval;
+}
+
 void TNLPAdapter::initialize_findiff_jac(
    const Index* iRow,
    const Index* jCol
@@ -2855,6 +3082,110 @@ void TNLPAdapter::initialize_findiff_jac(
       findiff_jac_postriplet_[i] = postrip[i];
    }
 
+   // Group the columns that have a nonzero; without coloring, every column is a group by itself
+   std::vector<Index> color(n_full_x_, -1);
+   Index ncolors = 0;
+   if( findiff_coloring_ )
+   {
+      // row-wise structure, to find the columns that share a row with a given column
+      std::vector<Index> row_ia(n_full_g_ + 1, 0);
+      for( Index i = 0; i < findiff_jac_nnz_; i++ )
+      {
+         row_ia[findiff_jac_ja_[i] + 1]++;
+      }
+      for( Index irow = 0; irow < n_full_g_; irow++ )
+      {
+         row_ia[irow + 1] += row_ia[irow];
+      }
+      std::vector<Index> row_ja(findiff_jac_nnz_);
+      std::vector<Index> row_pos(row_ia.begin(), row_ia.end() - 1);
+      for( Index ivar = 0; ivar < n_full_x_; ivar++ )
+      {
+         for( Index i = findiff_jac_ia_[ivar]; i < findiff_jac_ia_[ivar + 1]; i++ )
+         {
+            row_ja[row_pos[findiff_jac_ja_[i]]++] = ivar;
+         }
+      }
+
+      // greedy coloring: give each column the smallest color that no column sharing a row has
+      std::vector<Index> forbidden;
+      for( Index ivar = 0; ivar < n_full_x_; ivar++ )
+      {
+         if( findiff_jac_ia_[ivar] == findiff_jac_ia_[ivar + 1] )
+         {
+            continue;
+         }
+         for( Index i = findiff_jac_ia_[ivar]; i < findiff_jac_ia_[ivar + 1]; i++ )
+         {
+            const Index irow = findiff_jac_ja_[i];
+            for( Index j = row_ia[irow]; j < row_ia[irow + 1]; j++ )
+            {
+               const Index c = color[row_ja[j]];
+               if( c >= 0 )
+               {
+                  forbidden[c] = ivar;
+               }
+            }
+         }
+         Index c = 0;
+         while( c < ncolors && forbidden[c] == ivar )
+         {
+            c++;
+         }
+         if( c == ncolors )
+         {
+            forbidden.push_back(-1);
+            ncolors++;
+         }
+         color[ivar] = c;
+      }
+   }
+   else
+   {
+      for( Index ivar = 0; ivar < n_full_x_; ivar++ )
+      {
+         if( findiff_jac_ia_[ivar] < findiff_jac_ia_[ivar + 1] )
+         {
+            color[ivar] = ncolors++;
+         }
+      }
+   }
+
+   findiff_group_ia_.assign(ncolors + 1, 0);
+   for( Index ivar = 0; ivar < n_full_x_; ivar++ )
+   {
+      if( color[ivar] >= 0 )
+      {
+         findiff_group_ia_[color[ivar] + 1]++;
+      }
+   }
+   for( Index c = 0; c < ncolors; c++ )
+   {
+      findiff_group_ia_[c + 1] += findiff_group_ia_[c];
+   }
+   findiff_group_cols_.resize(findiff_group_ia_[ncolors]);
+   std::vector<Index> group_pos(findiff_group_ia_.begin(), findiff_group_ia_.end() - 1);
+   for( Index ivar = 0; ivar < n_full_x_; ivar++ )
+   {
+      if( color[ivar] >= 0 )
+      {
+         findiff_group_cols_[group_pos[color[ivar]]++] = ivar;
+      }
+   }
+
+   jnlst_->Printf(J_DETAILED, J_INITIALIZATION,
+                  "Finite difference Jacobian: %" IPOPT_INDEX_FORMAT " columns with nonzeros are approximated in %" IPOPT_INDEX_FORMAT " groups.\n",
+                  findiff_group_ia_[ncolors], ncolors);
+
+   findiff_pool_ = NULL;
+   if( findiff_num_threads_ != 1 )
+   {
+      findiff_pool_ = new ThreadPool(findiff_num_threads_);
+      if( findiff_pool_->NumThreads() == 1 )
+      {
+         findiff_pool_ = NULL;
+      }
+   }
 }
 
 bool TNLPAdapter::CheckDerivatives(
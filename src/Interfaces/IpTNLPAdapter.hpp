@@ -20,6 +20,7 @@ namespace Ipopt
 class ExpansionMatrixSpace;
 class IteratesVector;
 class TDependencyDetector;
+class ThreadPool;
 
 /** This class adapts the TNLP interface so it looks like an NLP interface.
  *
@@ -487,10 +488,22 @@ private:
    HessianApproximationType hessian_approximation_;
    /** Number of linear variables. */
    Index num_linear_variables_;
+   /** Number of threads for operations on vectors. */
+   Index vector_num_threads_;
+   /** Minimal dimension of vectors for which operations are done in parallel. */
+   Index vector_parallel_min_dim_;
+   /** Number of threads for products with the Jacobians and the Hessian. */
+   Index matrix_num_threads_;
+   /** Minimal number of nonzeros of matrices for which products are done in parallel. */
+   Index matrix_parallel_min_nonzeros_;
    /** Flag indicating how Jacobian is computed. */
    JacobianApproxEnum jacobian_approximation_;
    /** Size of the perturbation for the derivative approximation */
    Number findiff_perturbation_;
+   /** Flag indicating whether structurally orthogonal columns are perturbed together in the finite difference approximation */
+   bool findiff_coloring_;
+   /** Number of threads that evaluate the constraints at perturbed points */
+   Index findiff_num_threads_;
    /** Maximal perturbation of the initial point */
    Number point_perturbation_radius_;
    /** Flag indicating if rhs should be considered during dependency detection */
@@ -580,6 +593,20 @@ private:
    ///@{
    /** Initialize sparsity structure for finite difference Jacobian */
    void initialize_findiff_jac(const Index* iRow, const Index* jCol);
+
+   /** Compute the columns of one group of the finite difference Jacobian.
+    *
+    *  x_pert must hold full_x_ on entry and holds it again on exit.
+    *  g_pert is workspace for the perturbed constraint values.
+    */
+   bool eval_findiff_group(
+      Index   group,
+      Number* x_pert,
+      Number* g_pert
+   );
+
+   /** Task of a thread pool that computes one group of columns of the finite difference Jacobian */
+   class FindiffGroupTask;
    ///@}
 
    /**@name Internal Permutation Spaces and matrices
@@ -631,6 +658,12 @@ private:
    Number* findiff_x_l_;
    /** Copy of the upper bounds */
    Number* findiff_x_u_;
+   /** Start position of each group of columns that are perturbed together in findiff_group_cols_ (one more than groups) */
+   std::vector<Index> findiff_group_ia_;
+   /** Columns of the Jacobian, ordered by groups */
+   std::vector<Index> findiff_group_cols_;
+   /** Thread pool for evaluating the groups in parallel, NULL if only one thread is used */
+   SmartPtr<ThreadPool> findiff_pool_;
    ///@}
 };
 
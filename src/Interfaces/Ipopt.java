@@ -7,6 +7,10 @@
 package org.coinor;
 
 import java.io.File;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.DoubleBuffer;
+import java.nio.IntBuffer;
 
 /** A Java Native Interface for the Ipopt optimization solver.
  *
@@ -33,6 +37,13 @@ import java.io.File;
  * {@link #create(int, int, int, int, int)}
  * and {@link #OptimizeNLP()} can be called multiple times.
  *
+ * By default, Ipopt copies the arguments of the evaluation callbacks between
+ * its own arrays and Java arrays on every call.  For large problems, these copies
+ * can become as expensive as the evaluations themselves.  After calling
+ * {@link #useDirectBuffers(boolean)}, the evaluation callbacks that take
+ * java.nio buffers are called instead, see {@link #eval_f(int, DoubleBuffer, boolean, DoubleBuffer)}.
+ * These buffers alias the arrays of Ipopt, so no data is copied.
+ *
  * Programmers must call {@link #dispose()} when finished using a
  * Ipopt object, otherwise the nativelly allocated memory will be disposed of only
  * when the JVM call {@link #finalize()} on it.
@@ -89,7 +100,8 @@ public abstract class Ipopt
       double mult_x_U[],
       double callback_grad_f[],
       double callback_jac_g[],
-      double callback_hess[]
+      double callback_hess[],
+      boolean direct_buffers
    );
 
    /* Native function should not be used directly */
@@ -184,6 +196,52 @@ public abstract class Ipopt
    /** Status returned by the solver */
    private int status = INVALID_PROBLEM_DEFINITION;
 
+   /** Whether the evaluation callbacks that take buffers are used */
+   private boolean direct_buffers = false;
+
+   /** Views on the direct buffers that are passed by the native code, reused as long as the buffer does not change */
+   private final BufferView x_view = new BufferView();
+   private final BufferView obj_value_view = new BufferView();
+   private final BufferView grad_f_view = new BufferView();
+   private final BufferView g_view = new BufferView();
+   private final BufferView jac_g_view = new BufferView();
+   private final BufferView hess_view = new BufferView();
+   private final BufferView lambda_view = new BufferView();
+
+   /** View on a direct ByteBuffer that aliases an array of Ipopt, in native byte order */
+   private static final class BufferView
+   {
+      private ByteBuffer   bytes;
+      private DoubleBuffer view;
+
+      DoubleBuffer get(
+         ByteBuffer b,
+         boolean    readonly)
+      {
+         if( b == null )
+         {
+            return null;
+         }
+         if( b != bytes )
+         {
+            bytes = b;
+            view = b.order(ByteOrder.nativeOrder()).asDoubleBuffer();
+            if( readonly )
+            {
+               view = view.asReadOnlyBuffer();
+            }
+         }
+         view.clear();
+         return view;
+      }
+
+      static IntBuffer getInt(
+         ByteBuffer b)
+      {
+         return b == null ? null : b.order(ByteOrder.nativeOrder()).asIntBuffer();
+      }
+   }
+
    /** Creates a new NLP Solver using a default as the DLL name.
     *
     * This expects the the Ipopt DLL can somehow be found
@@ -470,6 +528,283 @@ public abstract class Ipopt
       double[] values
    );
 
+   /** Method to request the value of the objective function, with direct buffers.
+    *
+    * This method is called instead of {@link #eval_f(int, double[], boolean, double[])}
+    * if direct buffers are enabled, see {@link #useDirectBuffers(boolean)}.
+    * All buffers alias arrays of Ipopt and are only valid during the call,
+    * so they must not be kept.
+    * Buffers for input are read-only.
+    *
+    * The default implementation copies the buffers from and to arrays and calls
+    * {@link #eval_f(int, double[], boolean, double[])}, so only the callbacks whose
+    * copies are expensive need to be overloaded.
+    *
+    *  @param n     (in) the number of variables in the problem
+    *  @param x     (in) the values for the primal variables at which the objective function is to be evaluated
+    *  @param new_x (in) false if any evaluation method was previously called with the same values in x, true otherwise
+    *  @param obj_value (out) buffer of length 1 to store the value of the objective function
+    *
+    * @return true on success, otherwise false
+    * @since 3.14.5
+    */
+   protected boolean eval_f(
+      int          n,
+      DoubleBuffer x,
+      boolean      new_x,
+      DoubleBuffer obj_value)
+   {
+      x.get(this.x);
+      if( !eval_f(n, this.x, new_x, obj_val) )
+      {
+         return false;
+      }
+      obj_value.put(0, obj_val[0]);
+      return true;
+   }
+
+   /** Method to request the gradient of the objective function, with direct buffers.
+    *
+    * This method is called instead of {@link #eval_grad_f(int, double[], boolean, double[])}
+    * if direct buffers are enabled; see {@link #eval_f(int, DoubleBuffer, boolean, DoubleBuffer)}
+    * for the validity of the buffers and the default implementation.
+    *
+    *  @param n     (in) the number of variables in the problem
+    *  @param x     (in) the values for the primal variables at which the gradient is to be evaluated
+    *  @param new_x (in) false if any evaluation method was previously called with the same values in x, true otherwise
+    *  @param grad_f (out) buffer of length n to store the values of the gradient of the objective function
+    *
+    * @return true on success, otherwise false
+    * @since 3.14.5
+    */
+   protected boolean eval_grad_f(
+      int          n,
+      DoubleBuffer x,
+      boolean      new_x,
+      DoubleBuffer grad_f)
+   {
+      x.get(this.x);
+      if( !eval_grad_f(n, this.x, new_x, callback_grad_f) )
+      {
+         return false;
+      }
+      grad_f.put(callback_grad_f);
+      return true;
+   }
+
+   /** Method to request the constraint values, with direct buffers.
+    *
+    * This method is called instead of {@link #eval_g(int, double[], boolean, int, double[])}
+    * if direct buffers are enabled; see {@link #eval_f(int, DoubleBuffer, boolean, DoubleBuffer)}
+    * for the validity of the buffers and the default implementation.
+    *
+    *  @param n     (in) the number of variables in the problem
+    *  @param x     (in) the values for the primal variables at which the constraint functions are to be evaluated
+    *  @param new_x (in) false if any evaluation method was previously called with the same values in x, true otherwise
+    *  @param m     (in) the number of constraints in the problem
+    *  @param g     (out) buffer of length m to store the constraint function values
+    *
+    * @return true on success, otherwise false
+    * @since 3.14.5
+    */
+   protected boolean eval_g(
+      int          n,
+      DoubleBuffer x,
+      boolean      new_x,
+      int          m,
+      DoubleBuffer g)
+   {
+      x.get(this.x);
+      if( !eval_g(n, this.x, new_x, m, this.g) )
+      {
+         return false;
+      }
+      g.put(this.g);
+      return true;
+   }
+
+   /** Method to request either the sparsity structure or the values of the Jacobian of the constraints, with direct buffers.
+    *
+    * This method is called instead of {@link #eval_jac_g(int, double[], boolean, int, int, int[], int[], double[])}
+    * if direct buffers are enabled; see {@link #eval_f(int, DoubleBuffer, boolean, DoubleBuffer)}
+    * for the validity of the buffers and the default implementation.
+    * As for the method with arrays, iRow and jCol are given on the first call only,
+    * while x and values are null on this call.
+    *
+    *  @param n     (in) the number of variables in the problem
+    *  @param x     (in) first call: null; later calls: the values for the primal variables at which the Jacobian is to be evaluated
+    *  @param new_x (in) false if any evaluation method was previously called with the same values in x, true otherwise
+    *  @param m     (in) the number of constraints in the problem
+    *  @param nele_jac (in) the number of nonzero elements in the Jacobian
+    *  @param iRow  (out) first call: buffer of length nele_jac to store the row indices; later calls: null
+    *  @param jCol  (out) first call: buffer of length nele_jac to store the column indices; later calls: null
+    *  @param values (out) first call: null; later calls: buffer of length nele_jac to store the values of the entries
+    *
+    * @return true on success, otherwise false
+    * @since 3.14.5
+    */
+   protected boolean eval_jac_g(
+      int          n,
+      DoubleBuffer x,
+      boolean      new_x,
+      int          m,
+      int          nele_jac,
+      IntBuffer    iRow,
+      IntBuffer    jCol,
+      DoubleBuffer values)
+   {
+      if( x != null )
+      {
+         x.get(this.x);
+      }
+      if( values == null )
+      {
+         int[] iRowArr = new int[nele_jac];
+         int[] jColArr = new int[nele_jac];
+         if( !eval_jac_g(n, this.x, new_x, m, nele_jac, iRowArr, jColArr, null) )
+         {
+            return false;
+         }
+         iRow.put(iRowArr);
+         jCol.put(jColArr);
+         return true;
+      }
+      if( !eval_jac_g(n, this.x, new_x, m, nele_jac, null, null, callback_jac_g) )
+      {
+         return false;
+      }
+      values.put(callback_jac_g);
+      return true;
+   }
+
+   /** Method to request either the sparsity structure or the values of the Hessian of the Lagrangian, with direct buffers.
+    *
+    * This method is called instead of {@link #eval_h(int, double[], boolean, double, int, double[], boolean, int, int[], int[], double[])}
+    * if direct buffers are enabled; see {@link #eval_f(int, DoubleBuffer, boolean, DoubleBuffer)}
+    * for the validity of the buffers and the default implementation.
+    * As for the method with arrays, iRow and jCol are given on the first call only,
+    * while x, lambda, and values are null on this call.
+    *
+    *  @param n     (in) the number of variables in the problem
+    *  @param x     (in) first call: null; later calls: the values for the primal variables at which the Hessian is to be evaluated
+    *  @param new_x (in) false if any evaluation method was previously called with the same values in x, true otherwise
+    *  @param obj_factor (in) factor in front of the objective term in the Hessian
+    *  @param m     (in) the number of constraints in the problem
+    *  @param lambda (in) the values for the constraint multipliers at which the Hessian is to be evaluated
+    *  @param new_lambda (in) false if any evaluation method was previously called with the same values in lambda, true otherwise
+    *  @param nele_hess (in) the number of nonzero elements in the Hessian
+    *  @param iRow  (out) first call: buffer of length nele_hess to store the row indices; later calls: null
+    *  @param jCol  (out) first call: buffer of length nele_hess to store the column indices; later calls: null
+    *  @param values (out) first call: null; later calls: buffer of length nele_hess to store the values of the entries
+    *
+    * @return true on success, otherwise false
+    * @since 3.14.5
+    */
+   protected boolean eval_h(
+      int          n,
+      DoubleBuffer x,
+      boolean      new_x,
+      double       obj_factor,
+      int          m,
+      DoubleBuffer lambda,
+      boolean      new_lambda,
+      int          nele_hess,
+      IntBuffer    iRow,
+      IntBuffer    jCol,
+      DoubleBuffer values)
+   {
+      if( x != null )
+      {
+         x.get(this.x);
+      }
+      if( lambda != null )
+      {
+         lambda.get(mult_g);
+      }
+      if( values == null )
+      {
+         int[] iRowArr = new int[nele_hess];
+         int[] jColArr = new int[nele_hess];
+         if( !eval_h(n, this.x, new_x, obj_factor, m, mult_g, new_lambda, nele_hess, iRowArr, jColArr, null) )
+         {
+            return false;
+         }
+         iRow.put(iRowArr);
+         jCol.put(jColArr);
+         return true;
+      }
+      if( !eval_h(n, this.x, new_x, obj_factor, m, mult_g, new_lambda, nele_hess, null, null, callback_hess) )
+      {
+         return false;
+      }
+      values.put(callback_hess);
+      return true;
+   }
+
+   /* Called by the native code if direct buffers are used, should not be used directly */
+   private boolean eval_f_direct(
+      int        n,
+      ByteBuffer x,
+      boolean    new_x,
+      ByteBuffer obj_value)
+   {
+      return eval_f(n, x_view.get(x, true), new_x, obj_value_view.get(obj_value, false));
+   }
+
+   /* Called by the native code if direct buffers are used, should not be used directly */
+   private boolean eval_grad_f_direct(
+      int        n,
+      ByteBuffer x,
+      boolean    new_x,
+      ByteBuffer grad_f)
+   {
+      return eval_grad_f(n, x_view.get(x, true), new_x, grad_f_view.get(grad_f, false));
+   }
+
+   /* Called by the native code if direct buffers are used, should not be used directly */
+   private boolean eval_g_direct(
+      int        n,
+      ByteBuffer x,
+      boolean    new_x,
+      int        m,
+      ByteBuffer g)
+   {
+      return eval_g(n, x_view.get(x, true), new_x, m, g_view.get(g, false));
+   }
+
+   /* Called by the native code if direct buffers are used, should not be used directly */
+   private boolean eval_jac_g_direct(
+      int        n,
+      ByteBuffer x,
+      boolean    new_x,
+      int        m,
+      int        nele_jac,
+      ByteBuffer iRow,
+      ByteBuffer jCol,
+      ByteBuffer values)
+   {
+      return eval_jac_g(n, x_view.get(x, true), new_x, m, nele_jac, BufferView.getInt(iRow), BufferView.getInt(jCol),
+                        jac_g_view.get(values, false));
+   }
+
+   /* Called by the native code if direct buffers are used, should not be used directly */
+   private boolean eval_h_direct(
+      int        n,
+      ByteBuffer x,
+      boolean    new_x,
+      double     obj_factor,
+      int        m,
+      ByteBuffer lambda,
+      boolean    new_lambda,
+      int        nele_hess,
+      ByteBuffer iRow,
+      ByteBuffer jCol,
+      ByteBuffer values)
+   {
+      return eval_h(n, x_view.get(x, true), new_x, obj_factor, m, lambda_view.get(lambda, true), new_lambda, nele_hess,
+                    BufferView.getInt(iRow), BufferView.getInt(jCol), hess_view.get(values, false));
+   }
+
    /** Dispose of the natively allocated memory.
     *
     * Programmers must call the dispose method when finished
@@ -598,6 +933,24 @@ public abstract class Ipopt
       return AddIpoptStrOption(ipopt, keyword, val.toLowerCase());
    }
 
+   /** Enables or disables the evaluation callbacks with direct buffers.
+    *
+    * If enabled, the methods eval_f, eval_grad_f, eval_g, eval_jac_g, and eval_h
+    * that take java.nio buffers are called instead of those that take arrays.
+    * The buffers alias the arrays of Ipopt, so that the cost of a callback does
+    * not depend on the size of the problem.
+    * If the JVM does not support direct buffers, the methods with arrays are
+    * called nevertheless.
+    *
+    * @param enable whether to use direct buffers in the next calls of {@link #OptimizeNLP()}
+    * @since 3.14.5
+    */
+   public void useDirectBuffers(
+      boolean enable)
+   {
+      direct_buffers = enable;
+   }
+
    /** This function actually solve the problem.
     *
     * The solve status returned is one of the constant fields of this class,
@@ -612,7 +965,7 @@ public abstract class Ipopt
    {
       this.status = this.OptimizeTNLP(ipopt,
                                       x, g, obj_val, mult_g, mult_x_L, mult_x_U,
-                                      callback_grad_f, callback_jac_g, callback_hess);
+                                      callback_grad_f, callback_jac_g, callback_hess, direct_buffers);
 
       return this.status;
    }
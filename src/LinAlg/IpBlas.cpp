@@ -138,6 +138,27 @@ extern "C"
       int             transb_len
    );
 
+#ifndef IPOPT_SINGLE
+   /** BLAS Fortran subroutine SGEMM */
+   void IPOPT_BLAS_FUNC(sgemm, SGEMM)(
+      char*        transa,
+      char*        transb,
+      ipindex*     m,
+      ipindex*     n,
+      ipindex*     k,
+      const float* alpha,
+      const float* a,
+      ipindex*     lda,
+      const float* b,
+      ipindex*     ldb,
+      const float* beta,
+      float*       c,
+      ipindex*     ldc,
+      int          transa_len,
+      int          transb_len
+   );
+#endif
+
    /** BLAS Fortran subroutine XSYRK */
    void IPOPT_BLAS_FUNCP(syrk, SYRK)(
       char*           uplo,
@@ -393,6 +414,31 @@ void IpBlasGemm(
    IPOPT_BLAS_FUNCP(gemm, GEMM)(&TRANSA, &TRANSB, &M, &N, &K, &alpha, A, &LDA, B, &LDB, &beta, C, &LDC, 1, 1);
 }
 
+#ifndef IPOPT_SINGLE
+void IpBlasGemm(
+   bool         transa,
+   bool         transb,
+   Index        m,
+   Index        n,
+   Index        k,
+   float        alpha,
+   const float* A,
+   Index        ldA,
+   const float* B,
+   Index        ldB,
+   float        beta,
+   float*       C,
+   Index        ldC
+)
+{
+   ipindex M = m, N = n, K = k, LDA = ldA, LDB = ldB, LDC = ldC;
+
+   char TRANSA = transa ? 'T' : 'N';
+   char TRANSB = transb ? 'T' : 'N';
+   IPOPT_BLAS_FUNC(sgemm, SGEMM)(&TRANSA, &TRANSB, &M, &N, &K, &alpha, A, &LDA, B, &LDB, &beta, C, &LDC, 1, 1);
+}
+#endif
+
 void IpBlasSyrk(
    bool          trans,
    Index         ndim,
@@ -319,6 +319,30 @@ IPOPTLIB_EXPORT void IpBlasGemm(
    Index         ldC
 );
 
+#ifndef IPOPT_SINGLE
+/** Wrapper for BLAS subroutine SGEMM.
+ *
+ * Multiplying two matrices in single precision,
+ * e.g., for factors of a mixed-precision factorization.
+ * @since 3.14.5
+ */
+IPOPTLIB_EXPORT void IpBlasGemm(
+   bool         transa,
+   bool         transb,
+   Index        m,
+   Index        n,
+   Index        k,
+   float        alpha,
+   const float* A,
+   Index        ldA,
+   const float* B,
+   Index        ldB,
+   float        beta,
+   float*       C,
+   Index        ldC
+);
+#endif
+
 /** Wrapper for BLAS subroutine DGEMM.
  *
  * Multiplying two matrices.
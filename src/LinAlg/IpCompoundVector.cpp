@@ -436,6 +436,77 @@ void CompoundVector::AddVectorQuotientImpl(
    }
 }
 
+void CompoundVector::AddThreeVectorsImpl(
+   Number        a,
+   const Vector& v1,
+   Number        b,
+   const Vector& v2,
+   Number        c,
+   const Vector& v3,
+   Number        d
+)
+{
+   DBG_ASSERT(vectors_valid_);
+   const CompoundVector* comp_v1 = static_cast<const CompoundVector*>(&v1);
+   DBG_ASSERT(dynamic_cast<const CompoundVector*>(&v1));
+   DBG_ASSERT(NComps() == comp_v1->NComps());
+   const CompoundVector* comp_v2 = static_cast<const CompoundVector*>(&v2);
+   DBG_ASSERT(dynamic_cast<const CompoundVector*>(&v2));
+   DBG_ASSERT(NComps() == comp_v2->NComps());
+   const CompoundVector* comp_v3 = static_cast<const CompoundVector*>(&v3);
+   DBG_ASSERT(dynamic_cast<const CompoundVector*>(&v3));
+   DBG_ASSERT(NComps() == comp_v3->NComps());
+
+   for( Index i = 0; i < NComps(); i++ )
+   {
+      Comp(i)->AddThreeVectors(a, *comp_v1->GetComp(i), b, *comp_v2->GetComp(i), c, *comp_v3->GetComp(i), d);
+   }
+}
+
+void CompoundVector::AddVectorAndProductImpl(
+   Number        a,
+   const Vector& v1,
+   Number        b,
+   const Vector& v2,
+   const Vector& w,
+   Number        c,
+   Number        d
+)
+{
+   DBG_ASSERT(vectors_valid_);
+   const CompoundVector* comp_v1 = static_cast<const CompoundVector*>(&v1);
+   DBG_ASSERT(dynamic_cast<const CompoundVector*>(&v1));
+   DBG_ASSERT(NComps() == comp_v1->NComps());
+   const CompoundVector* comp_v2 = static_cast<const CompoundVector*>(&v2);
+   DBG_ASSERT(dynamic_cast<const CompoundVector*>(&v2));
+   DBG_ASSERT(NComps() == comp_v2->NComps());
+   const CompoundVector* comp_w = static_cast<const CompoundVector*>(&w);
+   DBG_ASSERT(dynamic_cast<const CompoundVector*>(&w));
+   DBG_ASSERT(NComps() == comp_w->NComps());
+
+   for( Index i = 0; i < NComps(); i++ )
+   {
+      Comp(i)->AddVectorAndProduct(a, *comp_v1->GetComp(i), b, *comp_v2->GetComp(i), *comp_w->GetComp(i), c, d);
+   }
+}
+
+Number CompoundVector::WeightedAsumImpl(
+   const Vector& w
+) const
+{
+   DBG_ASSERT(vectors_valid_);
+   const CompoundVector* comp_w = static_cast<const CompoundVector*>(&w);
+   DBG_ASSERT(dynamic_cast<const CompoundVector*>(&w));
+   DBG_ASSERT(NComps() == comp_w->NComps());
+
+   Number asum = 0.;
+   for( Index i = 0; i < NComps(); i++ )
+   {
+      asum += ConstComp(i)->WeightedAsum(*comp_w->GetComp(i));
+   }
+   return asum;
+}
+
 bool CompoundVector::HasValidNumbersImpl() const
 {
    DBG_ASSERT(vectors_valid_);
@@ -208,6 +208,30 @@ protected:
       const Vector& s,
       Number        c
    );
+
+   void AddThreeVectorsImpl(
+      Number        a,
+      const Vector& v1,
+      Number        b,
+      const Vector& v2,
+      Number        c,
+      const Vector& v3,
+      Number        d
+   );
+
+   void AddVectorAndProductImpl(
+      Number        a,
+      const Vector& v1,
+      Number        b,
+      const Vector& v2,
+      const Vector& w,
+      Number        c,
+      Number        d
+   );
+
+   Number WeightedAsumImpl(
+      const Vector& w
+   ) const;
    ///@}
 
    /** Method for determining if all stored numbers are valid (i.e., no Inf or Nan). */
@@ -7,6 +7,7 @@
 #include "IpDenseGenMatrix.hpp"
 #include "IpBlas.hpp"
 #include "IpLapack.hpp"
+#include "IpThreadPool.hpp"
 
 #include <cmath>
 
@@ -17,6 +18,78 @@ namespace Ipopt
 static const Index dbg_verbosity = 0;
 #endif
 
+/** Number of entries of a block of the packed columns for the Level 3 BLAS products */
+static const Index panel_entries = 32768;
+
+/** Task that computes G = V1^T V2 for a range of rows of the dense columns of V1 and V2.
+ *
+ *  The rows are copied into contiguous panels, so that the product
+ *  of two panels is one call of IpBlasGemm.
+ */
+class TransMultPanelTask: public ThreadPoolTask
+{
+public:
+   const Number* const* cols1;
+   const Number* const* cols2;
+   Index k1;
+   Index k2;
+   Index nb;
+   Index begin;
+   Index end;
+   std::vector<Number> G;
+
+   void Run(
+      ThreadPool& /*pool*/,
+      Index       /*worker*/
+   )
+   {
+      Compute();
+   }
+
+   void Compute()
+   {
+      G.assign(k1 * k2, 0.);
+      std::vector<Number> panel1(nb * k1);
+      std::vector<Number> panel2;
+      if( cols2 != cols1 )
+      {
+         panel2.resize(nb * k2);
+      }
+      for( Index r0 = begin; r0 < end; r0 += nb )
+      {
+         const Index nr = Min(nb, end - r0);
+         Pack(cols1, k1, r0, nr, &panel1[0]);
+         const Number* p2 = &panel1[0];
+         if( cols2 != cols1 )
+         {
+            Pack(cols2, k2, r0, nr, &panel2[0]);
+            p2 = &panel2[0];
+         }
+         IpBlasGemm(true, false, k1, k2, nr, 1., &panel1[0], nr, p2, nr, 1., &G[0], k1);
+      }
+   }
+
+private:
+   static void Pack(
+      const Number* const* cols,
+      Index                k,
+      Index                r0,
+      Index                nr,
+      Number*              panel
+   )
+   {
+      for( Index j = 0; j < k; j++ )
+      {
+         const Number* c = cols[j] + r0;
+         Number* p = panel + j * nr;
+         for( Index i = 0; i < nr; i++ )
+         {
+            p[i] = c[i];
+         }
+      }
+   }
+};
+
 DenseGenMatrix::DenseGenMatrix(
    const DenseGenMatrixSpace* owner_space
 )
@@ -118,13 +191,68 @@ void DenseGenMatrix::HighRankUpdateTranspose(
    Number                   alpha,
    const MultiVectorMatrix& V1,
    const MultiVectorMatrix& V2,
-   Number                   beta
+   Number                   beta,
+   ThreadPool*              pool
 )
 {
    DBG_ASSERT(NRows() == V1.NCols());
    DBG_ASSERT(NCols() == V2.NCols());
    DBG_ASSERT(beta == 0. || initialized_);
 
+   // If all columns are dense, we use Level 3 Blas on panels of rows
+   std::vector<const Number*> cols1;
+   std::vector<const Number*> cols2;
+   if( NRows() > 0 && NCols() > 0 && V1.GetDenseColumnValues(cols1) && V2.GetDenseColumnValues(cols2) )
+   {
+      const Index n = V1.NRows();
+      const bool same = (&V1 == &V2);
+      const Index nb = Max(Index(64), panel_entries / (same ? NRows() : NRows() + NCols()));
+      const Index npanels = (n + nb - 1) / nb;
+      Index ntasks = 1;
+      if( pool != NULL )
+      {
+         ntasks = Max(Index(1), Min(pool->NumThreads(), npanels));
+      }
+      std::vector<TransMultPanelTask> tasks(ntasks);
+      for( Index t = 0; t < ntasks; t++ )
+      {
+         TransMultPanelTask& task = tasks[t];
+         task.cols1 = &cols1[0];
+         task.cols2 = same ? &cols1[0] : &cols2[0];
+         task.k1 = NRows();
+         task.k2 = NCols();
+         task.nb = nb;
+         task.begin = Min(n, (npanels * t / ntasks) * nb);
+         task.end = Min(n, (npanels * (t + 1) / ntasks) * nb);
+      }
+      if( ntasks > 1 )
+      {
+         for( Index t = 0; t < ntasks; t++ )
+         {
+            pool->Submit(&tasks[t]);
+         }
+         pool->Wait();
+      }
+      else
+      {
+         tasks[0].Compute();
+      }
+
+      const Index size = NRows() * NCols();
+      for( Index i = 0; i < size; i++ )
+      {
+         Number sum = tasks[0].G[i];
+         for( Index t = 1; t < ntasks; t++ )
+         {
+            sum += tasks[t].G[i];
+         }
+         values_[i] = (beta != 0.) ? alpha * sum + beta * values_[i] : alpha * sum;
+      }
+      initialized_ = true;
+      ObjectChanged();
+      return;
+   }
+
    if( beta == 0. )
    {
       for( Index j = 0; j < NCols(); j++ )
@@ -99,12 +99,18 @@ public:
     *
     *  It computes M = alpha*V1^T V2 + beta*M, where V1 and V2 are
     *  MultiVectorMatrices.
+    *
+    *  If all columns of V1 and V2 are DenseVectors, the product is
+    *  computed with one Level 3 BLAS call per block of rows.  If a
+    *  ThreadPool is given (since 3.14.5), the blocks are distributed
+    *  over its threads.
     */
    void HighRankUpdateTranspose(
       Number                   alpha,
       const MultiVectorMatrix& V1,
       const MultiVectorMatrix& V2,
-      Number                   beta
+      Number                   beta,
+      ThreadPool*              pool = NULL
    );
 
    /** Method for computing the Cholesky factorization of a positive
@@ -125,7 +125,8 @@ void DenseSymMatrix::HighRankUpdateTranspose(
    Number                   alpha,
    const MultiVectorMatrix& V1,
    const MultiVectorMatrix& V2,
-   Number                   beta
+   Number                   beta,
+   ThreadPool*              pool
 )
 {
    DBG_ASSERT(Dim() == V1.NCols());
@@ -133,6 +134,28 @@ void DenseSymMatrix::HighRankUpdateTranspose(
    DBG_ASSERT(beta == 0. || initialized_);
 
    const Index dim = Dim();
+
+   // If all columns are dense, the full product with Level 3 Blas is
+   // cheaper than the dot products for the lower triangle
+   std::vector<const Number*> cols;
+   if( dim > 0 && V1.GetDenseColumnValues(cols) && V2.GetDenseColumnValues(cols) )
+   {
+      SmartPtr<DenseGenMatrixSpace> P_space = new DenseGenMatrixSpace(dim, dim);
+      SmartPtr<DenseGenMatrix> P = P_space->MakeNewDenseGenMatrix();
+      P->HighRankUpdateTranspose(alpha, V1, V2, 0., pool);
+      const Number* Pvalues = P->Values();
+      for( Index j = 0; j < dim; j++ )
+      {
+         for( Index i = j; i < dim; i++ )
+         {
+            values_[i + j * dim] = (beta != 0.) ? Pvalues[i + j * dim] + beta * values_[i + j * dim] : Pvalues[i + j * dim];
+         }
+      }
+      initialized_ = true;
+      ObjectChanged();
+      return;
+   }
+
    if( beta == 0. )
    {
       for( Index j = 0; j < dim; j++ )
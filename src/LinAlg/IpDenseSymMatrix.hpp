@@ -96,12 +96,16 @@ public:
     *
     *  It computes M = alpha*V1^T V2 + beta*M, where V1 and V2 are
     *  MultiVectorMatrices, so that V1^T V2 is symmetric.
+    *
+    *  If all columns of V1 and V2 are DenseVectors, the product is
+    *  computed as in DenseGenMatrix::HighRankUpdateTranspose.
     */
    void HighRankUpdateTranspose(
       Number                   alpha,
       const MultiVectorMatrix& V1,
       const MultiVectorMatrix& V2,
-      Number                   beta
+      Number                   beta,
+      ThreadPool*              pool = NULL
    );
 
    /** Method for doing a specialized Add operation, required in the
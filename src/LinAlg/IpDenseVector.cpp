@@ -8,9 +8,13 @@
 #include "IpBlas.hpp"
 #include "IpUtils.hpp"
 #include "IpDebug.hpp"
+#include "IpThreadPool.hpp"
+#include "IpStoragePool.hpp"
+#include "IpProfiler.hpp"
 
 #include <cmath>
 #include <limits>
+#include <vector>
 
 namespace Ipopt
 {
@@ -19,854 +23,827 @@ namespace Ipopt
 static const Index dbg_verbosity = 0;
 #endif
 
-DenseVector::DenseVector(
-   const DenseVectorSpace* owner_space
+/** Arguments of a kernel that operates on a range of dense vectors.
+ *
+ *  y is the vector that is modified, x1, x2, and x3 are arguments.
+ *  If inc1 (inc2, inc3) is 0, then x1 (x2, x3) points to a single
+ *  value that is used for all entries.  If y_homogeneous is true,
+ *  then the values of y on input are not used by the kernel.
+ */
+struct DenseVectorKernelArgs
+{
+   Number*       y;
+   const Number* x1;
+   const Number* x2;
+   const Number* x3;
+   Index         inc1;
+   Index         inc2;
+   Index         inc3;
+   Number        a;
+   Number        b;
+   Number        c;
+   Number        d;
+   bool          y_homogeneous;
+
+   DenseVectorKernelArgs()
+      : y(NULL),
+        x1(NULL),
+        x2(NULL),
+        x3(NULL),
+        inc1(1),
+        inc2(1),
+        inc3(1),
+        a(0.),
+        b(0.),
+        c(0.),
+        d(0.),
+        y_homogeneous(false)
+   { }
+};
+
+/** A kernel computes the entries begin,...,end-1 and returns a partial result of a reduction */
+typedef Number (*DenseVectorKernel)(
+   Index                        begin,
+   Index                        end,
+   const DenseVectorKernelArgs& args
+);
+
+/** How the partial results of a kernel are combined */
+enum DenseVectorReduction
+{
+   REDUCE_SUM,
+   REDUCE_MIN,
+   REDUCE_MAX
+};
+
+/** Task that executes a kernel on one chunk of a range */
+class DenseVectorKernelTask: public ThreadPoolTask
+{
+public:
+   DenseVectorKernel kernel;
+   const DenseVectorKernelArgs* args;
+   Index begin;
+   Index end;
+   Number result;
+
+   void Run(
+      ThreadPool& /*pool*/,
+      Index       /*worker*/
+   )
+   {
+      result = kernel(begin, end, *args);
+   }
+};
+
+/** Execute a kernel on the entries 0,...,n-1.
+ *
+ *  If pool is not NULL, the range is split into one chunk per thread.
+ *  The partial results are combined in the order of the chunks, so
+ *  that the result does not depend on the scheduling of the threads.
+ */
+static Number RunKernel(
+   ThreadPool*                  pool,
+   Index                        n,
+   DenseVectorKernel            kernel,
+   const DenseVectorKernelArgs& args,
+   DenseVectorReduction         reduction = REDUCE_SUM
 )
-   : Vector(owner_space),
-     owner_space_(owner_space),
-     values_(NULL),
-     expanded_values_(NULL),
-     initialized_(false),
-     homogeneous_(false)
 {
-   DBG_START_METH("DenseVector::DenseVector(Index dim)", dbg_verbosity);
-   if( Dim() == 0 )
+   Profiler* profiler = Profiler::Active();
+   if( profiler != NULL )
    {
-      initialized_ = true;
-      homogeneous_ = true;
-      scalar_ = 0.;
+      // count every vector that is streamed through, not the ones that are replaced by a scalar
+      const Index nvectors = (args.y != NULL ? 1 : 0) + (args.x1 != NULL && args.inc1 != 0 ? 1 : 0)
+                             + (args.x2 != NULL && args.inc2 != 0 ? 1 : 0) + (args.x3 != NULL && args.inc3 != 0 ? 1 : 0);
+      profiler->Count(PROFILE_VECTOR_OPS, 1.);
+      profiler->Count(PROFILE_VECTOR_BYTES, (Number) n * nvectors * sizeof(Number));
    }
-}
 
-DenseVector::~DenseVector()
-{
-   DBG_START_METH("DenseVector::~DenseVector()", dbg_verbosity);
-   if( values_ )
+   Index nchunks = pool == NULL ? 1 : Ipopt::Min(pool->NumThreads(), n);
+   if( nchunks <= 1 )
    {
-      owner_space_->FreeInternalStorage(values_);
+      return kernel(0, n, args);
    }
-   if( expanded_values_ )
+
+   std::vector<DenseVectorKernelTask> tasks(nchunks);
+   for( Index t = 0; t < nchunks; t++ )
    {
-      owner_space_->FreeInternalStorage(expanded_values_);
+      tasks[t].kernel = kernel;
+      tasks[t].args = &args;
+      tasks[t].begin = (Index) ((size_t) n * t / nchunks);
+      tasks[t].end = (Index) ((size_t) n * (t + 1) / nchunks);
+      pool->Submit(&tasks[t]);
+   }
+   pool->Wait();
+
+   Number result = tasks[0].result;
+   for( Index t = 1; t < nchunks; t++ )
+   {
+      switch( reduction )
+      {
+         case REDUCE_SUM:
+            result += tasks[t].result;
+            break;
+         case REDUCE_MIN:
+            result = Ipopt::Min(result, tasks[t].result);
+            break;
+         case REDUCE_MAX:
+            result = Ipopt::Max(result, tasks[t].result);
+            break;
+      }
    }
+   return result;
 }
 
-void DenseVector::SetValues(
-   const Number* x
+/** Position of entry i in an argument with increment inc */
+static inline Index ArgPos(
+   Index i,
+   Index inc
 )
 {
-   initialized_ = true;
-   IpBlasCopy(Dim(), x, 1, values_allocated(), 1);
-   homogeneous_ = false;
-   // This is not an overloaded method from
-   // Vector. Here, we must call ObjectChanged()
-   // manually.
-   ObjectChanged();
+   return inc == 0 ? 0 : i;
 }
 
-const Number* DenseVector::ExpandedValues() const
+static Number CopyKernel(
+   Index                        begin,
+   Index                        end,
+   const DenseVectorKernelArgs& k
+)
 {
-   if( IsHomogeneous() )
-   {
-      if( !expanded_values_ )
-      {
-         expanded_values_ = owner_space_->AllocateInternalStorage();
-      }
-      IpBlasCopy(Dim(), &scalar_, 0, expanded_values_, 1);
-      return expanded_values_;
-   }
-   else
-   {
-      return values_;
-   }
+   IpBlasCopy(end - begin, k.x1 + ArgPos(begin, k.inc1), k.inc1, k.y + begin, 1);
+   return 0.;
 }
 
-void DenseVector::set_values_from_scalar()
+static Number ScalKernel(
+   Index                        begin,
+   Index                        end,
+   const DenseVectorKernelArgs& k
+)
 {
-   DBG_ASSERT(homogeneous_);
-   initialized_ = true;
-   homogeneous_ = false;
-   Number* vals = values_allocated();
-   IpBlasCopy(Dim(), &scalar_, 0, vals, 1);
+   IpBlasScal(end - begin, k.a, k.y + begin, 1);
+   return 0.;
 }
 
-void DenseVector::CopyImpl(
-   const Vector& x
+static Number AxpyKernel(
+   Index                        begin,
+   Index                        end,
+   const DenseVectorKernelArgs& k
 )
 {
-   DBG_START_METH("DenseVector::CopyImpl(const Vector& x)", dbg_verbosity);
-   const DenseVector* dense_x = static_cast<const DenseVector*>(&x);
-   DBG_ASSERT(dynamic_cast<const DenseVector*>(&x));
-
-   DBG_ASSERT(dense_x->initialized_);
-   DBG_ASSERT(Dim() == dense_x->Dim());
-   homogeneous_ = dense_x->homogeneous_;
-   if( homogeneous_ )
-   {
-      scalar_ = dense_x->scalar_;
-   }
-   else
-   {
-      IpBlasCopy(Dim(), dense_x->values_, 1, values_allocated(), 1);
-   }
-   initialized_ = true;
+   IpBlasAxpy(end - begin, k.a, k.x1 + ArgPos(begin, k.inc1), k.inc1, k.y + begin, 1);
+   return 0.;
 }
 
-void DenseVector::ScalImpl(
-   Number alpha
+/* y = b + a*x1 */
+static Number ScalarAxpyKernel(
+   Index                        begin,
+   Index                        end,
+   const DenseVectorKernelArgs& k
 )
 {
-   DBG_ASSERT(initialized_);
-   if( homogeneous_ )
-   {
-      scalar_ *= alpha;
-   }
-   else
+   for( Index i = begin; i < end; i++ )
    {
-      IpBlasScal(Dim(), alpha, values_, 1);
+      k.y[i] = k.b + k.a * k.x1[i];
    }
+   return 0.;
 }
 
-void DenseVector::AxpyImpl(
-   Number        alpha,
-   const Vector& x
+static Number DotKernel(
+   Index                        begin,
+   Index                        end,
+   const DenseVectorKernelArgs& k
 )
 {
-   DBG_ASSERT(initialized_);
-   const DenseVector* dense_x = static_cast<const DenseVector*>(&x);
-   DBG_ASSERT(dynamic_cast<const DenseVector*>(&x));
-
-   DBG_ASSERT(dense_x->initialized_);
-   DBG_ASSERT(Dim() == dense_x->Dim());
-
-   if( Dim() == 0 )
-   {
-      return;
-   }
+   return IpBlasDot(end - begin, k.x1 + ArgPos(begin, k.inc1), k.inc1, k.x2 + ArgPos(begin, k.inc2), k.inc2);
+}
 
-   if( homogeneous_ )
+static Number DivideKernel(
+   Index                        begin,
+   Index                        end,
+   const DenseVectorKernelArgs& k
+)
+{
+   if( k.inc1 == 0 )
    {
-      if( dense_x->homogeneous_ )
-      {
-         scalar_ += alpha * dense_x->scalar_;
-      }
-      else
+      for( Index i = begin; i < end; i++ )
       {
-         homogeneous_ = false;
-         Number* vals = values_allocated();
-         for( Index i = 0; i < Dim(); i++ )
-         {
-            vals[i] = scalar_ + alpha * dense_x->values_[i];
-         }
+         k.y[i] /= k.x1[0];
       }
    }
    else
    {
-      if( dense_x->homogeneous_ )
-      {
-         if( dense_x->scalar_ != 0. )
-         {
-            IpBlasAxpy(Dim(), alpha, &dense_x->scalar_, 0, values_, 1);
-         }
-      }
-      else
+      for( Index i = begin; i < end; i++ )
       {
-         IpBlasAxpy(Dim(), alpha, dense_x->values_, 1, values_, 1);
+         k.y[i] /= k.x1[i];
       }
    }
+   return 0.;
 }
 
-Number DenseVector::DotImpl(
-   const Vector& x
-) const
+static Number MultiplyKernel(
+   Index                        begin,
+   Index                        end,
+   const DenseVectorKernelArgs& k
+)
 {
-   DBG_ASSERT(initialized_);
-   Number retValue;
-   const DenseVector* dense_x = static_cast<const DenseVector*>(&x);
-   DBG_ASSERT(dynamic_cast<const DenseVector*>(&x));
-
-   DBG_ASSERT(dense_x->initialized_);
-   DBG_ASSERT(Dim() == dense_x->Dim());
-
-   if( Dim() == 0 )
-   {
-      return 0.0;
-   }
-
-   if( homogeneous_ )
+   if( k.inc1 == 0 )
    {
-      if( dense_x->homogeneous_ )
-      {
-         retValue = Dim() * scalar_ * dense_x->scalar_;
-      }
-      else
+      for( Index i = begin; i < end; i++ )
       {
-         retValue = IpBlasDot(Dim(), dense_x->values_, 1, &scalar_, 0);
+         k.y[i] *= k.x1[0];
       }
    }
    else
    {
-      if( dense_x->homogeneous_ )
-      {
-         retValue = IpBlasDot(Dim(), &dense_x->scalar_, 0, values_, 1);
-      }
-      else
+      for( Index i = begin; i < end; i++ )
       {
-         retValue = IpBlasDot(Dim(), dense_x->values_, 1, values_, 1);
+         k.y[i] *= k.x1[i];
       }
    }
-   return retValue;
+   return 0.;
 }
 
-Number DenseVector::Nrm2Impl() const
+static Number SelectKernel(
+   Index                        begin,
+   Index                        end,
+   const DenseVectorKernelArgs& k
+)
 {
-   DBG_ASSERT(initialized_);
-   if( homogeneous_ )
-   {
-      return std::sqrt((Number) Dim()) * std::abs(scalar_);
-   }
-   else
+   for( Index i = begin; i < end; i++ )
    {
-      return IpBlasNrm2(Dim(), values_, 1);
+      if( k.y[i] > 0.0 )
+      {
+         k.y[i] = k.x1[ArgPos(i, k.inc1)];
+      }
+      else if( k.y[i] < 0.0 )
+      {
+         k.y[i] = -k.x1[ArgPos(i, k.inc1)];
+      }
+      // else y[i] remains at 0.0
    }
+   return 0.;
 }
 
-Number DenseVector::AsumImpl() const
+static Number MaxKernel(
+   Index                        begin,
+   Index                        end,
+   const DenseVectorKernelArgs& k
+)
 {
-   DBG_ASSERT(initialized_);
-   if( homogeneous_ )
-   {
-      return Dim() * std::abs(scalar_);
-   }
-   else
+   for( Index i = begin; i < end; i++ )
    {
-      return IpBlasAsum(Dim(), values_, 1);
+      k.y[i] = Ipopt::Max(k.y[i], k.x1[ArgPos(i, k.inc1)]);
    }
+   return 0.;
 }
 
-Number DenseVector::AmaxImpl() const
+static Number MinKernel(
+   Index                        begin,
+   Index                        end,
+   const DenseVectorKernelArgs& k
+)
 {
-   DBG_ASSERT(initialized_);
-   if( Dim() == 0 )
+   for( Index i = begin; i < end; i++ )
    {
-      return 0.;
+      k.y[i] = Ipopt::Min(k.y[i], k.x1[ArgPos(i, k.inc1)]);
    }
+   return 0.;
+}
 
-   if( homogeneous_ )
+static Number ReciprocalKernel(
+   Index                        begin,
+   Index                        end,
+   const DenseVectorKernelArgs& k
+)
+{
+   for( Index i = begin; i < end; i++ )
    {
-      return std::abs(scalar_);
+      k.y[i] = 1.0 / k.y[i];
    }
-
-   return std::abs(values_[IpBlasIamax(Dim(), values_, 1) - 1]);
+   return 0.;
 }
 
-void DenseVector::SetImpl(
-   Number value
+static Number AbsKernel(
+   Index                        begin,
+   Index                        end,
+   const DenseVectorKernelArgs& k
 )
 {
-   initialized_ = true;
-   homogeneous_ = true;
-   scalar_ = value;
-   // ToDo decide if we want this here:
-   if( values_ )
+   for( Index i = begin; i < end; i++ )
    {
-      owner_space_->FreeInternalStorage(values_);
-      values_ = NULL;
+      k.y[i] = std::abs(k.y[i]);
    }
+   return 0.;
 }
 
-void DenseVector::ElementWiseDivideImpl(
-   const Vector& x
+static Number SqrtKernel(
+   Index                        begin,
+   Index                        end,
+   const DenseVectorKernelArgs& k
 )
 {
-   DBG_ASSERT(initialized_);
-   const DenseVector* dense_x = static_cast<const DenseVector*>(&x);
-   DBG_ASSERT(dynamic_cast<const DenseVector*>(&x));
-
-   DBG_ASSERT(dense_x->initialized_);
-   const Number* values_x = dense_x->values_;
-   DBG_ASSERT(Dim() == dense_x->Dim());
-
-   if( Dim() == 0 )
+   for( Index i = begin; i < end; i++ )
    {
-      return;
+      k.y[i] = std::sqrt(k.y[i]);
    }
+   return 0.;
+}
 
-   if( homogeneous_ )
+static Number SgnKernel(
+   Index                        begin,
+   Index                        end,
+   const DenseVectorKernelArgs& k
+)
+{
+   for( Index i = begin; i < end; i++ )
    {
-      if( dense_x->homogeneous_ )
-      {
-         scalar_ /= dense_x->scalar_;
-      }
-      else
+      if( k.y[i] > 0. )
       {
-         homogeneous_ = false;
-         Number* vals = values_allocated();
-         for( Index i = 0; i < Dim(); i++ )
-         {
-            vals[i] = scalar_ / values_x[i];
-         }
+         k.y[i] = 1.;
       }
-   }
-   else
-   {
-      if( dense_x->homogeneous_ )
+      else if( k.y[i] < 0. )
       {
-         for( Index i = 0; i < Dim(); i++ )
-         {
-            values_[i] /= dense_x->scalar_;
-         }
+         k.y[i] = -1.;
       }
       else
       {
-         for( Index i = 0; i < Dim(); i++ )
-         {
-            values_[i] /= values_x[i];
-         }
+         k.y[i] = 0;
       }
    }
+   return 0.;
 }
 
-void DenseVector::ElementWiseMultiplyImpl(
-   const Vector& x
+static Number MaxReductionKernel(
+   Index                        begin,
+   Index                        end,
+   const DenseVectorKernelArgs& k
 )
 {
-   DBG_ASSERT(initialized_);
-   const DenseVector* dense_x = static_cast<const DenseVector*>(&x);
-   DBG_ASSERT(dynamic_cast<const DenseVector*>(&x));
+   Number max = k.x1[begin];
+   for( Index i = begin + 1; i < end; i++ )
+   {
+      max = Ipopt::Max(k.x1[i], max);
+   }
+   return max;
+}
 
-   DBG_ASSERT(dense_x->initialized_);
-   const Number* values_x = dense_x->values_;
-   DBG_ASSERT(Dim() == dense_x->Dim());
+static Number MinReductionKernel(
+   Index                        begin,
+   Index                        end,
+   const DenseVectorKernelArgs& k
+)
+{
+   Number min = k.x1[begin];
+   for( Index i = begin + 1; i < end; i++ )
+   {
+      min = Ipopt::Min(k.x1[i], min);
+   }
+   return min;
+}
 
-   if( Dim() == 0 )
+static Number SumKernel(
+   Index                        begin,
+   Index                        end,
+   const DenseVectorKernelArgs& k
+)
+{
+   Number sum = 0.;
+   for( Index i = begin; i < end; i++ )
    {
-      return;
+      sum += k.x1[i];
    }
+   return sum;
+}
 
-   if( homogeneous_ )
+static Number SumLogsKernel(
+   Index                        begin,
+   Index                        end,
+   const DenseVectorKernelArgs& k
+)
+{
+   Number sum = 0.0;
+   for( Index i = begin; i < end; i++ )
    {
-      if( dense_x->homogeneous_ )
-      {
-         scalar_ *= dense_x->scalar_;
-      }
-      else
-      {
-         homogeneous_ = false;
-         Number* vals = values_allocated();
-         for( Index i = 0; i < Dim(); i++ )
-         {
-            vals[i] = scalar_ * values_x[i];
-         }
-      }
+      sum += std::log(k.x1[i]);
    }
-   else
+   return sum;
+}
+
+/* largest alpha <= 1 with x1 + alpha*x2 >= (1-tau)*x1, where tau = a */
+static Number FracToBoundKernel(
+   Index                        begin,
+   Index                        end,
+   const DenseVectorKernelArgs& k
+)
+{
+   Number alpha = 1.;
+   const Number tau = k.a;
+   for( Index i = begin; i < end; i++ )
    {
-      if( dense_x->homogeneous_ )
-      {
-         if( dense_x->scalar_ != 1.0 )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] *= dense_x->scalar_;
-            }
-         }
-      }
-      else
+      const Number delta = k.x2[ArgPos(i, k.inc2)];
+      if( delta < 0. )
       {
-         for( Index i = 0; i < Dim(); i++ )
-         {
-            values_[i] *= values_x[i];
-         }
+         alpha = Ipopt::Min(alpha, -tau / delta * k.x1[ArgPos(i, k.inc1)]);
       }
    }
+   return alpha;
 }
 
-void DenseVector::ElementWiseSelectImpl(
-   const Vector& x
+/* y = a*x1 + b*x2 + c*y */
+static Number AddTwoVectorsKernel(
+   Index                        begin,
+   Index                        end,
+   const DenseVectorKernelArgs& k
 )
 {
-   DBG_ASSERT(initialized_);
-   const DenseVector* dense_x = static_cast<const DenseVector*>(&x);
-   DBG_ASSERT(dynamic_cast<const DenseVector*>(&x));
-
-   DBG_ASSERT(dense_x->initialized_);
-   const Number* values_x = dense_x->values_;
-   DBG_ASSERT(Dim() == dense_x->Dim());
-
-   if( Dim() == 0 )
-   {
-      return;
-   }
+   Number* y = k.y;
+   const Number* v1 = k.x1;
+   const Number* v2 = k.x2;
+   const Number a = k.a;
+   const Number b = k.b;
+   const Number c = k.c;
 
-   if( homogeneous_ )
+   // I guess I'm going over board here, but it might be best to
+   // capture all cases for a, b, and c separately...
+   if( c == 0. )
    {
-      if( scalar_ == 0.0 )
-      {
-         return;
-      }
-      if( dense_x->homogeneous_ )
-      {
-         scalar_ *= dense_x->scalar_;
-      }
-      else
+      if( a == 1. )
       {
-         homogeneous_ = false;
-         Number* vals = values_allocated();
-         for( Index i = 0; i < Dim(); i++ )
+         if( b == 0. )
          {
-            vals[i] = scalar_ * values_x[i];
+            IpBlasCopy(end - begin, v1 + begin, 1, y + begin, 1);
          }
-      }
-   }
-   else
-   {
-      if( dense_x->homogeneous_ )
-      {
-         if( dense_x->scalar_ != 1.0 )
+         else if( b == 1. )
          {
-            for( Index i = 0; i < Dim(); i++ )
+            for( Index i = begin; i < end; i++ )
             {
-               if( values_[i] > 0.0 )
-               {
-                  values_[i] = dense_x->scalar_;
-               }
-               else if( values_[i] < 0.0 )
-               {
-                  values_[i] = -dense_x->scalar_;
-               }
-               // else values_[i] remains at 0.0
+               y[i] = v1[i] + v2[i];
             }
          }
-      }
-      else
-      {
-         for( Index i = 0; i < Dim(); i++ )
+         else if( b == -1. )
          {
-            if( values_[i] > 0.0 )
+            for( Index i = begin; i < end; i++ )
             {
-               values_[i] = values_x[i];
+               y[i] = v1[i] - v2[i];
             }
-            else if( values_[i] < 0.0 )
+         }
+         else
+         {
+            for( Index i = begin; i < end; i++ )
             {
-               values_[i] = -values_x[i];
+               y[i] = v1[i] + b * v2[i];
             }
-            // else values_[i] remains at 0.0
          }
       }
-   }
-}
-
-void DenseVector::ElementWiseMaxImpl(
-   const Vector& x
-)
-{
-   DBG_ASSERT(initialized_);
-   const DenseVector* dense_x = static_cast<const DenseVector*>(&x);
-   DBG_ASSERT(dynamic_cast<const DenseVector*>(&x));
-
-   DBG_ASSERT(dense_x->initialized_);
-   const Number* values_x = dense_x->values_;
-   DBG_ASSERT(Dim() == dense_x->Dim());
-
-   if( Dim() == 0 )
-   {
-      return;
-   }
-
-   if( homogeneous_ )
-   {
-      if( dense_x->homogeneous_ )
-      {
-         scalar_ = Ipopt::Max(scalar_, dense_x->scalar_);
-      }
-      else
+      else if( a == -1. )
       {
-         homogeneous_ = false;
-         Number* vals = values_allocated();
-         for( Index i = 0; i < Dim(); i++ )
+         if( b == 0. )
          {
-            vals[i] = Ipopt::Max(scalar_, values_x[i]);
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] = -v1[i];
+            }
+         }
+         else if( b == 1. )
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] = -v1[i] + v2[i];
+            }
+         }
+         else if( b == -1. )
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] = -v1[i] - v2[i];
+            }
+         }
+         else
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] = -v1[i] + b * v2[i];
+            }
          }
       }
-   }
-   else
-   {
-      if( dense_x->homogeneous_ )
+      else if( a == 0. )
       {
-         for( Index i = 0; i < Dim(); i++ )
+         if( b == 0. )
+         {
+            Number zero = 0.;
+            IpBlasCopy(end - begin, &zero, 0, y + begin, 1);
+         }
+         else if( b == 1. )
+         {
+            IpBlasCopy(end - begin, v2 + begin, 1, y + begin, 1);
+         }
+         else if( b == -1. )
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] = -v2[i];
+            }
+         }
+         else
          {
-            values_[i] = Ipopt::Max(values_[i], dense_x->scalar_);
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] = b * v2[i];
+            }
          }
       }
       else
       {
-         for( Index i = 0; i < Dim(); i++ )
+         if( b == 0. )
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] = a * v1[i];
+            }
+         }
+         else if( b == 1. )
          {
-            values_[i] = Ipopt::Max(values_[i], values_x[i]);
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] = a * v1[i] + v2[i];
+            }
+         }
+         else if( b == -1. )
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] = a * v1[i] - v2[i];
+            }
+         }
+         else
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] = a * v1[i] + b * v2[i];
+            }
          }
       }
    }
-}
-
-void DenseVector::ElementWiseMinImpl(
-   const Vector& x
-)
-{
-   DBG_ASSERT(initialized_);
-   const DenseVector* dense_x = static_cast<const DenseVector*>(&x);
-   DBG_ASSERT(dynamic_cast<const DenseVector*>(&x));
-
-   DBG_ASSERT(dense_x->initialized_);
-   const Number* values_x = dense_x->values_;
-   DBG_ASSERT(Dim() == dense_x->Dim());
-
-   if( Dim() == 0 )
-   {
-      return;
-   }
-
-   if( homogeneous_ )
+   else if( c == 1. )
    {
-      if( dense_x->homogeneous_ )
+      if( a == 1. )
       {
-         scalar_ = Ipopt::Min(scalar_, dense_x->scalar_);
+         if( b == 0. )
+         {
+            IpBlasAxpy(end - begin, 1., v1 + begin, 1, y + begin, 1);
+         }
+         else if( b == 1. )
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] += v1[i] + v2[i];
+            }
+         }
+         else if( b == -1. )
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] += v1[i] - v2[i];
+            }
+         }
+         else
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] += v1[i] + b * v2[i];
+            }
+         }
       }
-      else
+      else if( a == -1. )
       {
-         homogeneous_ = false;
-         Number* vals = values_allocated();
-         for( Index i = 0; i < Dim(); i++ )
+         if( b == 0. )
          {
-            vals[i] = Ipopt::Min(scalar_, values_x[i]);
+            IpBlasAxpy(end - begin, -1., v1 + begin, 1, y + begin, 1);
+         }
+         else if( b == 1. )
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] += -v1[i] + v2[i];
+            }
+         }
+         else if( b == -1. )
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] += -v1[i] - v2[i];
+            }
+         }
+         else
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] += -v1[i] + b * v2[i];
+            }
          }
       }
-   }
-   else
-   {
-      if( dense_x->homogeneous_ )
+      else if( a == 0. )
       {
-         for( Index i = 0; i < Dim(); i++ )
+         if( b == 0. )
+         {
+            /* Nothing */
+         }
+         else if( b == 1. )
+         {
+            IpBlasAxpy(end - begin, 1., v2 + begin, 1, y + begin, 1);
+         }
+         else if( b == -1. )
+         {
+            IpBlasAxpy(end - begin, -1., v2 + begin, 1, y + begin, 1);
+         }
+         else
          {
-            values_[i] = Ipopt::Min(values_[i], dense_x->scalar_);
+            IpBlasAxpy(end - begin, b, v2 + begin, 1, y + begin, 1);
          }
       }
       else
       {
-         for( Index i = 0; i < Dim(); i++ )
+         if( b == 0. )
          {
-            values_[i] = Ipopt::Min(values_[i], values_x[i]);
+            IpBlasAxpy(end - begin, a, v1 + begin, 1, y + begin, 1);
+         }
+         else if( b == 1. )
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] += a * v1[i] + v2[i];
+            }
+         }
+         else if( b == -1. )
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] += a * v1[i] - v2[i];
+            }
+         }
+         else
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] += a * v1[i] + b * v2[i];
+            }
          }
       }
    }
-}
-
-void DenseVector::ElementWiseReciprocalImpl()
-{
-   DBG_ASSERT(initialized_);
-
-   if( Dim() == 0 )
-   {
-      return;
-   }
-
-   if( homogeneous_ )
-   {
-      scalar_ = 1.0 / scalar_;
-   }
-   else
-   {
-      for( Index i = 0; i < Dim(); i++ )
-      {
-         values_[i] = 1.0 / values_[i];
-      }
-   }
-}
-
-void DenseVector::ElementWiseAbsImpl()
-{
-   DBG_ASSERT(initialized_);
-   if( homogeneous_ )
-   {
-      scalar_ = std::abs(scalar_);
-   }
-   else
-   {
-      for( Index i = 0; i < Dim(); i++ )
-      {
-         values_[i] = std::abs(values_[i]);
-      }
-   }
-}
-
-void DenseVector::ElementWiseSqrtImpl()
-{
-   DBG_ASSERT(initialized_);
-   if( homogeneous_ )
-   {
-      scalar_ = std::sqrt(scalar_);
-   }
-   else
-   {
-      for( Index i = 0; i < Dim(); i++ )
-      {
-         values_[i] = std::sqrt(values_[i]);
-      }
-   }
-}
-
-void DenseVector::AddScalarImpl(
-   Number scalar
-)
-{
-   DBG_ASSERT(initialized_);
-   if( homogeneous_ )
-   {
-      scalar_ += scalar;
-   }
-   else
-   {
-      IpBlasAxpy(Dim(), 1., &scalar, 0, values_, 1);
-   }
-}
-
-Number DenseVector::MaxImpl() const
-{
-   DBG_ASSERT(initialized_);
-   if( Dim() == 0 )
-   {
-      return -std::numeric_limits<Number>::max();
-   }
-
-   Number max;
-   if( homogeneous_ )
-   {
-      max = scalar_;
-   }
-   else
-   {
-      max = values_[0];
-      for( Index i = 1; i < Dim(); i++ )
-      {
-         max = Ipopt::Max(values_[i], max);
-      }
-   }
-   return max;
-}
-
-Number DenseVector::MinImpl() const
-{
-   DBG_ASSERT(initialized_);
-   if( Dim() == 0 )
-   {
-      return std::numeric_limits<Number>::max();
-   }
-
-   Number min;
-   if( homogeneous_ )
-   {
-      min = scalar_;
-   }
-   else
-   {
-      min = values_[0];
-      for( Index i = 1; i < Dim(); i++ )
-      {
-         min = Ipopt::Min(values_[i], min);
-      }
-   }
-   return min;
-}
-
-Number DenseVector::SumImpl() const
-{
-   DBG_ASSERT(initialized_);
-   Number sum;
-   if( homogeneous_ )
-   {
-      sum = Dim() * scalar_;
-   }
-   else
-   {
-      sum = 0.;
-      for( Index i = 0; i < Dim(); i++ )
-      {
-         sum += values_[i];
-      }
-   }
-   return sum;
-}
-
-Number DenseVector::SumLogsImpl() const
-{
-   DBG_ASSERT(initialized_);
-   Number sum;
-   if( Dim() == 0 )
-   {
-      sum = 0.0;
-   }
-   else if( homogeneous_ )
-   {
-      sum = Dim() * std::log(scalar_);
-   }
-   else
+   else if( c == -1. )
    {
-      sum = 0.0;
-      for( Index i = 0; i < Dim(); i++ )
+      if( a == 1. )
       {
-         sum += std::log(values_[i]);
+         if( b == 0. )
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] = v1[i] - y[i];
+            }
+         }
+         else if( b == 1. )
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] = v1[i] + v2[i] - y[i];
+            }
+         }
+         else if( b == -1. )
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] = v1[i] - v2[i] - y[i];
+            }
+         }
+         else
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] = v1[i] + b * v2[i] - y[i];
+            }
+         }
       }
-   }
-   return sum;
-}
-
-void DenseVector::ElementWiseSgnImpl()
-{
-   DBG_ASSERT(initialized_);
-   if( homogeneous_ )
-   {
-      if( scalar_ > 0. )
+      else if( a == -1. )
       {
-         scalar_ = 1.;
+         if( b == 0. )
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] = -v1[i] - y[i];
+            }
+         }
+         else if( b == 1. )
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] = -v1[i] + v2[i] - y[i];
+            }
+         }
+         else if( b == -1. )
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] = -v1[i] - v2[i] - y[i];
+            }
+         }
+         else
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] = -v1[i] + b * v2[i] - y[i];
+            }
+         }
       }
-      else if( scalar_ < 0. )
+      else if( a == 0. )
       {
-         scalar_ = -1.;
+         if( b == 0. )
+         {
+            IpBlasScal(end - begin, -1., y + begin, 1);
+         }
+         else if( b == 1. )
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] = v2[i] - y[i];
+            }
+         }
+         else if( b == -1. )
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] = -v2[i] - y[i];
+            }
+         }
+         else
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] = b * v2[i] - y[i];
+            }
+         }
       }
       else
       {
-         scalar_ = 0.;
+         if( b == 0. )
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] = a * v1[i] - y[i];
+            }
+         }
+         else if( b == 1. )
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] = a * v1[i] + v2[i] - y[i];
+            }
+         }
+         else if( b == -1. )
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] = a * v1[i] - v2[i] - y[i];
+            }
+         }
+         else
+         {
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] = a * v1[i] + b * v2[i] - y[i];
+            }
+         }
       }
    }
    else
    {
-      for( Index i = 0; i < Dim(); i++ )
+      if( a == 1. )
       {
-         if( values_[i] > 0. )
+         if( b == 0. )
          {
-            values_[i] = 1.;
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] = v1[i] + c * y[i];
+            }
          }
-         else if( values_[i] < 0. )
+         else if( b == 1. )
          {
-            values_[i] = -1.;
+            for( Index i = begin; i < end; i++ )
+            {
+               y[i] = v1[i] + v2[i] + c * y[i];
+            }
          }
-         else
+         else if( b == -1. )
          {
-            values_[i] = 0;
-         }
-      }
-   }
-}
-
-// Specialized Functions
-void DenseVector::AddTwoVectorsImpl(
-   Number        a,
-   const Vector& v1,
-   Number        b,
-   const Vector& v2,
-   Number        c
-)
-{
-   if( Dim() == 0 )
-   {
-      DBG_ASSERT(initialized_);
-      return;
-   }
-
-   const Number* values_v1 = NULL;
-   bool homogeneous_v1 = false;
-   Number scalar_v1 = 0;
-   if( a != 0. )
-   {
-      const DenseVector* dense_v1 = static_cast<const DenseVector*>(&v1);
-      DBG_ASSERT(dynamic_cast<const DenseVector*>(&v1));
-
-      DBG_ASSERT(dense_v1->initialized_);
-      DBG_ASSERT(Dim() == dense_v1->Dim());
-      values_v1 = dense_v1->values_;
-      homogeneous_v1 = dense_v1->homogeneous_;
-      if( homogeneous_v1 )
-      {
-         scalar_v1 = dense_v1->scalar_;
-      }
-   }
-   const Number* values_v2 = NULL;
-   bool homogeneous_v2 = false;
-   Number scalar_v2 = 0;
-   if( b != 0. )
-   {
-      const DenseVector* dense_v2 = static_cast<const DenseVector*>(&v2);
-      DBG_ASSERT(dynamic_cast<const DenseVector*>(&v2));
-
-      DBG_ASSERT(dense_v2->initialized_);
-      DBG_ASSERT(Dim() == dense_v2->Dim());
-      values_v2 = dense_v2->values_;
-      homogeneous_v2 = dense_v2->homogeneous_;
-      if( homogeneous_v2 )
-      {
-         scalar_v2 = dense_v2->scalar_;
-      }
-   }
-   DBG_ASSERT(c == 0. || initialized_);
-   if( (c == 0. || homogeneous_) && homogeneous_v1 && homogeneous_v2 )
-   {
-      homogeneous_ = true;
-      Number val = 0;
-      if( c != 0. )
-      {
-         val = c * scalar_;
-      }
-      scalar_ = val + a * scalar_v1 + b * scalar_v2;
-      initialized_ = true;
-      return;
-   }
-   if( c == 0. )
-   {
-      // make sure we have memory allocated for this vector
-      values_allocated();
-      homogeneous_ = false;
-   }
-
-   // If any of the vectors is homogeneous, call the default implementation
-   if( homogeneous_ || homogeneous_v1 || homogeneous_v2 )
-   {
-      // ToDo:Should we implement specialized methods here too?
-      Vector::AddTwoVectorsImpl(a, v1, b, v2, c);
-      return;
-   }
-   DBG_ASSERT(values_v1 != NULL || a == 0.);
-   DBG_ASSERT(values_v2 != NULL || b == 0.);
-   DBG_ASSERT(values_ != NULL);
-
-   // I guess I'm going over board here, but it might be best to
-   // capture all cases for a, b, and c separately...
-   if( c == 0. )
-   {
-      if( a == 1. )
-      {
-         if( b == 0. )
-         {
-            IpBlasCopy(Dim(), values_v1, 1, values_, 1);
-         }
-         else if( b == 1. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
+            for( Index i = begin; i < end; i++ )
             {
-               values_[i] = values_v1[i] + values_v2[i];
-            }
-         }
-         else if( b == -1. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = values_v1[i] - values_v2[i];
+               y[i] = v1[i] - v2[i] + c * y[i];
             }
          }
          else
          {
-            for( Index i = 0; i < Dim(); i++ )
+            for( Index i = begin; i < end; i++ )
             {
-               values_[i] = values_v1[i] + b * values_v2[i];
+               y[i] = v1[i] + b * v2[i] + c * y[i];
             }
          }
       }
@@ -874,30 +851,30 @@ void DenseVector::AddTwoVectorsImpl(
       {
          if( b == 0. )
          {
-            for( Index i = 0; i < Dim(); i++ )
+            for( Index i = begin; i < end; i++ )
             {
-               values_[i] = -values_v1[i];
+               y[i] = -v1[i] + c * y[i];
             }
          }
          else if( b == 1. )
          {
-            for( Index i = 0; i < Dim(); i++ )
+            for( Index i = begin; i < end; i++ )
             {
-               values_[i] = -values_v1[i] + values_v2[i];
+               y[i] = -v1[i] + v2[i] + c * y[i];
             }
          }
          else if( b == -1. )
          {
-            for( Index i = 0; i < Dim(); i++ )
+            for( Index i = begin; i < end; i++ )
             {
-               values_[i] = -values_v1[i] - values_v2[i];
+               y[i] = -v1[i] - v2[i] + c * y[i];
             }
          }
          else
          {
-            for( Index i = 0; i < Dim(); i++ )
+            for( Index i = begin; i < end; i++ )
             {
-               values_[i] = -values_v1[i] + b * values_v2[i];
+               y[i] = -v1[i] + b * v2[i] + c * y[i];
             }
          }
       }
@@ -905,28 +882,27 @@ void DenseVector::AddTwoVectorsImpl(
       {
          if( b == 0. )
          {
-            Number zero = 0.;
-            IpBlasCopy(Dim(), &zero, 0, values_, 1);
+            IpBlasScal(end - begin, c, y + begin, 1);
          }
          else if( b == 1. )
          {
-            for( Index i = 0; i < Dim(); i++ )
+            for( Index i = begin; i < end; i++ )
             {
-               IpBlasCopy(Dim(), values_v2, 1, values_, 1);
+               y[i] = v2[i] + c * y[i];
             }
          }
          else if( b == -1. )
          {
-            for( Index i = 0; i < Dim(); i++ )
+            for( Index i = begin; i < end; i++ )
             {
-               values_[i] = -values_v2[i];
+               y[i] = -v2[i] + c * y[i];
             }
          }
          else
          {
-            for( Index i = 0; i < Dim(); i++ )
+            for( Index i = begin; i < end; i++ )
             {
-               values_[i] = b * values_v2[i];
+               y[i] = b * v2[i] + c * y[i];
             }
          }
       }
@@ -934,391 +910,1107 @@ void DenseVector::AddTwoVectorsImpl(
       {
          if( b == 0. )
          {
-            for( Index i = 0; i < Dim(); i++ )
+            for( Index i = begin; i < end; i++ )
             {
-               values_[i] = a * values_v1[i];
+               y[i] = a * v1[i] + c * y[i];
             }
          }
          else if( b == 1. )
          {
-            for( Index i = 0; i < Dim(); i++ )
+            for( Index i = begin; i < end; i++ )
             {
-               values_[i] = a * values_v1[i] + values_v2[i];
+               y[i] = a * v1[i] + v2[i] + c * y[i];
             }
          }
          else if( b == -1. )
          {
-            for( Index i = 0; i < Dim(); i++ )
+            for( Index i = begin; i < end; i++ )
             {
-               values_[i] = a * values_v1[i] - values_v2[i];
+               y[i] = a * v1[i] - v2[i] + c * y[i];
             }
          }
          else
          {
-            for( Index i = 0; i < Dim(); i++ )
+            for( Index i = begin; i < end; i++ )
             {
-               values_[i] = a * values_v1[i] + b * values_v2[i];
+               y[i] = a * v1[i] + b * v2[i] + c * y[i];
             }
          }
       }
    }
-   else if( c == 1. )
+   return 0.;
+}
+
+/* y = a*x1./x2 + c*y; if y_homogeneous, then b = c*y */
+static Number AddVectorQuotientKernel(
+   Index                        begin,
+   Index                        end,
+   const DenseVectorKernelArgs& k
+)
+{
+   Number* y = k.y;
+   const Number* values_z = k.x1;
+   const Number* values_s = k.x2;
+   const bool homogeneous_z = (k.inc1 == 0);
+   const bool homogeneous_s = (k.inc2 == 0);
+   const Number scalar_z = k.x1[0];
+   const Number scalar_s = k.x2[0];
+   const Number a = k.a;
+   const Number val = k.b;
+   const Number c = k.c;
+
+   if( c == 0. )
    {
-      if( a == 1. )
+      if( homogeneous_z )
       {
-         if( b == 0. )
-         {
-            IpBlasAxpy(Dim(), 1., values_v1, 1, values_, 1);
-         }
-         else if( b == 1. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] += values_v1[i] + values_v2[i];
-            }
-         }
-         else if( b == -1. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] += values_v1[i] - values_v2[i];
-            }
-         }
-         else
+         // then s is not homogeneous
+         for( Index i = begin; i < end; i++ )
          {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] += values_v1[i] + b * values_v2[i];
-            }
+            y[i] = a * scalar_z / values_s[i];
          }
       }
-      else if( a == -1. )
+      else if( homogeneous_s )
       {
-         if( b == 0. )
-         {
-            IpBlasAxpy(Dim(), -1., values_v1, 1, values_, 1);
-         }
-         else if( b == 1. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] += -values_v1[i] + values_v2[i];
-            }
-         }
-         else if( b == -1. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] += -values_v1[i] - values_v2[i];
-            }
-         }
-         else
+         // then z is not homogeneous
+         for( Index i = begin; i < end; i++ )
          {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] += -values_v1[i] + b * values_v2[i];
-            }
+            y[i] = values_z[i] * a / scalar_s;
          }
       }
-      else if( a == 0. )
+      else
       {
-         if( b == 0. )
-         {
-            /* Nothing */
-         }
-         else if( b == 1. )
+         for( Index i = begin; i < end; i++ )
          {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               IpBlasAxpy(Dim(), 1., values_v2, 1, values_, 1);
-            }
+            y[i] = a * values_z[i] / values_s[i];
          }
-         else if( b == -1. )
+      }
+   }
+   else if( k.y_homogeneous )
+   {
+      if( homogeneous_z )
+      {
+         // then s is not homogeneous
+         for( Index i = begin; i < end; i++ )
          {
-            IpBlasAxpy(Dim(), -1., values_v2, 1, values_, 1);
+            y[i] = val + a * scalar_z / values_s[i];
          }
-         else
+      }
+      else if( homogeneous_s )
+      {
+         // then z is not homogeneous
+         for( Index i = begin; i < end; i++ )
          {
-            IpBlasAxpy(Dim(), b, values_v2, 1, values_, 1);
+            y[i] = val + values_z[i] * a / scalar_s;
          }
       }
       else
       {
-         if( b == 0. )
-         {
-            IpBlasAxpy(Dim(), a, values_v1, 1, values_, 1);
-         }
-         else if( b == 1. )
+         for( Index i = begin; i < end; i++ )
          {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] += a * values_v1[i] + values_v2[i];
-            }
-         }
-         else if( b == -1. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] += a * values_v1[i] - values_v2[i];
-            }
-         }
-         else
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] += a * values_v1[i] + b * values_v2[i];
-            }
+            y[i] = val + a * values_z[i] / values_s[i];
          }
       }
    }
-   else if( c == -1. )
+   else
    {
-      if( a == 1. )
+      // ToDo could distinguish c = 1
+      if( homogeneous_z )
       {
-         if( b == 0. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = values_v1[i] - values_[i];
-            }
-         }
-         else if( b == 1. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = values_v1[i] + values_v2[i] - values_[i];
-            }
-         }
-         else if( b == -1. )
+         if( homogeneous_s )
          {
-            for( Index i = 0; i < Dim(); i++ )
+            for( Index i = begin; i < end; i++ )
             {
-               values_[i] = values_v1[i] - values_v2[i] - values_[i];
+               y[i] = c * y[i] + a * scalar_z / scalar_s;
             }
          }
          else
          {
-            for( Index i = 0; i < Dim(); i++ )
+            for( Index i = begin; i < end; i++ )
             {
-               values_[i] = values_v1[i] + b * values_v2[i] - values_[i];
+               y[i] = c * y[i] + a * scalar_z / values_s[i];
             }
          }
       }
-      else if( a == -1. )
+      else
       {
-         if( b == 0. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = -values_v1[i] - values_[i];
-            }
-         }
-         else if( b == 1. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = -values_v1[i] + values_v2[i] - values_[i];
-            }
-         }
-         else if( b == -1. )
+         if( homogeneous_s )
          {
-            for( Index i = 0; i < Dim(); i++ )
+            for( Index i = begin; i < end; i++ )
             {
-               values_[i] = -values_v1[i] - values_v2[i] - values_[i];
+               y[i] = c * y[i] + values_z[i] * a / scalar_s;
             }
          }
          else
          {
-            for( Index i = 0; i < Dim(); i++ )
+            for( Index i = begin; i < end; i++ )
             {
-               values_[i] = -values_v1[i] + b * values_v2[i] - values_[i];
+               y[i] = c * y[i] + a * values_z[i] / values_s[i];
             }
          }
       }
-      else if( a == 0. )
+   }
+
+   return 0.;
+}
+
+/* y = a*x1 + b*x2 + c*x3 + d*y; if d is zero, then y is not read */
+static Number AddThreeVectorsKernel(
+   Index                        begin,
+   Index                        end,
+   const DenseVectorKernelArgs& k
+)
+{
+   Number* y = k.y;
+   const Number* v1 = k.x1;
+   const Number* v2 = k.x2;
+   const Number* v3 = k.x3;
+   const Index inc1 = k.inc1;
+   const Index inc2 = k.inc2;
+   const Index inc3 = k.inc3;
+   const Number a = k.a;
+   const Number b = k.b;
+   const Number c = k.c;
+   const Number d = k.d;
+
+   if( a == 1. && b == 1. && c == 1. && d == 0. && inc1 == 1 && inc2 == 1 && inc3 == 1 )
+   {
+      for( Index i = begin; i < end; i++ )
       {
-         if( b == 0. )
-         {
-            IpBlasScal(Dim(), -1., values_, 1);
-         }
-         else if( b == 1. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = values_v2[i] - values_[i];
-            }
-         }
-         else if( b == -1. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = -values_v2[i] - values_[i];
-            }
-         }
-         else
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = b * values_v2[i] - values_[i];
-            }
-         }
+         y[i] = v1[i] + v2[i] + v3[i];
       }
-      else
+   }
+   else if( d == 0. )
+   {
+      for( Index i = begin; i < end; i++ )
       {
-         if( b == 0. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = a * values_v1[i] - values_[i];
-            }
-         }
-         else if( b == 1. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = a * values_v1[i] + values_v2[i] - values_[i];
-            }
-         }
-         else if( b == -1. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = a * values_v1[i] - values_v2[i] - values_[i];
-            }
-         }
-         else
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = a * values_v1[i] + b * values_v2[i] - values_[i];
-            }
-         }
+         y[i] = a * v1[i * inc1] + b * v2[i * inc2] + c * v3[i * inc3];
       }
    }
    else
    {
-      if( a == 1. )
+      for( Index i = begin; i < end; i++ )
       {
-         if( b == 0. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = values_v1[i] + c * values_[i];
-            }
-         }
-         else if( b == 1. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = values_v1[i] + values_v2[i] + c * values_[i];
-            }
-         }
-         else if( b == -1. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = values_v1[i] - values_v2[i] + c * values_[i];
-            }
-         }
-         else
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = values_v1[i] + b * values_v2[i] + c * values_[i];
-            }
-         }
+         y[i] = a * v1[i * inc1] + b * v2[i * inc2] + c * v3[i * inc3] + d * y[i];
       }
-      else if( a == -1. )
+   }
+   return 0.;
+}
+
+/* y = a*x1 + b*x2.*x3 + c*y + d; if c is zero, then y is not read */
+static Number AddVectorAndProductKernel(
+   Index                        begin,
+   Index                        end,
+   const DenseVectorKernelArgs& k
+)
+{
+   Number* y = k.y;
+   const Number* v1 = k.x1;
+   const Number* v2 = k.x2;
+   const Number* w = k.x3;
+   const Index inc1 = k.inc1;
+   const Index inc2 = k.inc2;
+   const Index inc3 = k.inc3;
+   const Number a = k.a;
+   const Number b = k.b;
+   const Number c = k.c;
+   const Number d = k.d;
+
+   if( a == 0. && b == 1. && c == 0. && inc2 == 1 && inc3 == 1 )
+   {
+      // complementarity and its relaxation by a scalar
+      for( Index i = begin; i < end; i++ )
       {
-         if( b == 0. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = -values_v1[i] + c * values_[i];
-            }
-         }
-         else if( b == 1. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = -values_v1[i] + values_v2[i] + c * values_[i];
-            }
-         }
-         else if( b == -1. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = -values_v1[i] - values_v2[i] + c * values_[i];
-            }
-         }
-         else
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = -values_v1[i] + b * values_v2[i] + c * values_[i];
-            }
-         }
+         y[i] = v2[i] * w[i] + d;
       }
-      else if( a == 0. )
+   }
+   else if( c == 0. )
+   {
+      for( Index i = begin; i < end; i++ )
       {
-         if( b == 0. )
-         {
-            IpBlasScal(Dim(), c, values_, 1);
-         }
-         else if( b == 1. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = values_v2[i] + c * values_[i];
-            }
-         }
-         else if( b == -1. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = -values_v2[i] + c * values_[i];
-            }
-         }
-         else
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = b * values_v2[i] + c * values_[i];
-            }
-         }
+         y[i] = a * v1[i * inc1] + b * v2[i * inc2] * w[i * inc3] + d;
+      }
+   }
+   else
+   {
+      for( Index i = begin; i < end; i++ )
+      {
+         y[i] = a * v1[i * inc1] + b * v2[i * inc2] * w[i * inc3] + c * y[i] + d;
+      }
+   }
+   return 0.;
+}
+
+static Number WeightedAsumKernel(
+   Index                        begin,
+   Index                        end,
+   const DenseVectorKernelArgs& k
+)
+{
+   const Number* x = k.x1;
+   const Number* w = k.x2;
+   const Index inc1 = k.inc1;
+   const Index inc2 = k.inc2;
+
+   Number asum = 0.;
+   for( Index i = begin; i < end; i++ )
+   {
+      asum += std::abs(x[i * inc1] * w[i * inc2]);
+   }
+   return asum;
+}
+
+DenseVectorSpace::DenseVectorSpace(
+   Index dim
+)
+   : VectorSpace(dim),
+     storage_pool_(new StoragePool(dim)),
+     min_dim_parallel_(0)
+{ }
+
+DenseVectorSpace::~DenseVectorSpace()
+{ }
+
+Number* DenseVectorSpace::AllocateInternalStorage() const
+{
+   return storage_pool_->Allocate();
+}
+
+void DenseVectorSpace::FreeInternalStorage(
+   Number* values
+) const
+{
+   storage_pool_->Free(values);
+}
+
+Index DenseVectorSpace::StoragePoolHits() const
+{
+   return storage_pool_->NumHits();
+}
+
+Index DenseVectorSpace::StoragePoolMisses() const
+{
+   return storage_pool_->NumMisses();
+}
+
+void DenseVectorSpace::SetThreadPool(
+   ThreadPool* pool,
+   Index       min_dim_parallel
+)
+{
+   pool_ = pool;
+   min_dim_parallel_ = min_dim_parallel;
+}
+
+DenseVector::DenseVector(
+   const DenseVectorSpace* owner_space
+)
+   : Vector(owner_space),
+     owner_space_(owner_space),
+     values_(NULL),
+     expanded_values_(NULL),
+     initialized_(false),
+     homogeneous_(false)
+{
+   DBG_START_METH("DenseVector::DenseVector(Index dim)", dbg_verbosity);
+   if( Dim() == 0 )
+   {
+      initialized_ = true;
+      homogeneous_ = true;
+      scalar_ = 0.;
+   }
+}
+
+DenseVector::~DenseVector()
+{
+   DBG_START_METH("DenseVector::~DenseVector()", dbg_verbosity);
+   if( values_ )
+   {
+      owner_space_->FreeInternalStorage(values_);
+   }
+   if( expanded_values_ )
+   {
+      owner_space_->FreeInternalStorage(expanded_values_);
+   }
+}
+
+void DenseVector::SetValues(
+   const Number* x
+)
+{
+   initialized_ = true;
+   IpBlasCopy(Dim(), x, 1, values_allocated(), 1);
+   homogeneous_ = false;
+   // This is not an overloaded method from
+   // Vector. Here, we must call ObjectChanged()
+   // manually.
+   ObjectChanged();
+}
+
+const Number* DenseVector::ExpandedValues() const
+{
+   if( IsHomogeneous() )
+   {
+      if( !expanded_values_ )
+      {
+         expanded_values_ = owner_space_->AllocateInternalStorage();
+      }
+      IpBlasCopy(Dim(), &scalar_, 0, expanded_values_, 1);
+      return expanded_values_;
+   }
+   else
+   {
+      return values_;
+   }
+}
+
+void DenseVector::set_values_from_scalar()
+{
+   DBG_ASSERT(homogeneous_);
+   initialized_ = true;
+   homogeneous_ = false;
+   Number* vals = values_allocated();
+   IpBlasCopy(Dim(), &scalar_, 0, vals, 1);
+}
+
+void DenseVector::CopyImpl(
+   const Vector& x
+)
+{
+   DBG_START_METH("DenseVector::CopyImpl(const Vector& x)", dbg_verbosity);
+   const DenseVector* dense_x = static_cast<const DenseVector*>(&x);
+   DBG_ASSERT(dynamic_cast<const DenseVector*>(&x));
+
+   DBG_ASSERT(dense_x->initialized_);
+   DBG_ASSERT(Dim() == dense_x->Dim());
+   homogeneous_ = dense_x->homogeneous_;
+   if( homogeneous_ )
+   {
+      scalar_ = dense_x->scalar_;
+   }
+   else
+   {
+      DenseVectorKernelArgs k;
+      k.y = values_allocated();
+      k.x1 = dense_x->values_;
+      k.inc1 = 1;
+      RunKernel(owner_space_->GetThreadPool(), Dim(), CopyKernel, k);
+   }
+   initialized_ = true;
+}
+
+void DenseVector::ScalImpl(
+   Number alpha
+)
+{
+   DBG_ASSERT(initialized_);
+   if( homogeneous_ )
+   {
+      scalar_ *= alpha;
+   }
+   else
+   {
+      DenseVectorKernelArgs k;
+      k.y = values_;
+      k.a = alpha;
+      RunKernel(owner_space_->GetThreadPool(), Dim(), ScalKernel, k);
+   }
+}
+
+void DenseVector::AxpyImpl(
+   Number        alpha,
+   const Vector& x
+)
+{
+   DBG_ASSERT(initialized_);
+   const DenseVector* dense_x = static_cast<const DenseVector*>(&x);
+   DBG_ASSERT(dynamic_cast<const DenseVector*>(&x));
+
+   DBG_ASSERT(dense_x->initialized_);
+   DBG_ASSERT(Dim() == dense_x->Dim());
+
+   if( Dim() == 0 )
+   {
+      return;
+   }
+
+   if( homogeneous_ )
+   {
+      if( dense_x->homogeneous_ )
+      {
+         scalar_ += alpha * dense_x->scalar_;
+      }
+      else
+      {
+         homogeneous_ = false;
+         DenseVectorKernelArgs k;
+         k.y = values_allocated();
+         k.x1 = dense_x->values_;
+         k.a = alpha;
+         k.b = scalar_;
+         RunKernel(owner_space_->GetThreadPool(), Dim(), ScalarAxpyKernel, k);
+      }
+   }
+   else
+   {
+      DenseVectorKernelArgs k;
+      k.y = values_;
+      k.a = alpha;
+      if( dense_x->homogeneous_ )
+      {
+         if( dense_x->scalar_ != 0. )
+         {
+            k.x1 = &dense_x->scalar_;
+            k.inc1 = 0;
+            RunKernel(owner_space_->GetThreadPool(), Dim(), AxpyKernel, k);
+         }
+      }
+      else
+      {
+         k.x1 = dense_x->values_;
+         k.inc1 = 1;
+         RunKernel(owner_space_->GetThreadPool(), Dim(), AxpyKernel, k);
+      }
+   }
+}
+
+Number DenseVector::DotImpl(
+   const Vector& x
+) const
+{
+   DBG_ASSERT(initialized_);
+   Number retValue;
+   const DenseVector* dense_x = static_cast<const DenseVector*>(&x);
+   DBG_ASSERT(dynamic_cast<const DenseVector*>(&x));
+
+   DBG_ASSERT(dense_x->initialized_);
+   DBG_ASSERT(Dim() == dense_x->Dim());
+
+   if( Dim() == 0 )
+   {
+      return 0.0;
+   }
+
+   if( homogeneous_ && dense_x->homogeneous_ )
+   {
+      retValue = Dim() * scalar_ * dense_x->scalar_;
+   }
+   else
+   {
+      DenseVectorKernelArgs k;
+      if( dense_x->homogeneous_ )
+      {
+         k.x1 = &dense_x->scalar_;
+         k.inc1 = 0;
+      }
+      else
+      {
+         k.x1 = dense_x->values_;
+         k.inc1 = 1;
+      }
+      if( homogeneous_ )
+      {
+         k.x2 = &scalar_;
+         k.inc2 = 0;
+      }
+      else
+      {
+         k.x2 = values_;
+         k.inc2 = 1;
+      }
+      retValue = RunKernel(owner_space_->GetThreadPool(), Dim(), DotKernel, k);
+   }
+   return retValue;
+}
+
+Number DenseVector::Nrm2Impl() const
+{
+   DBG_ASSERT(initialized_);
+   if( homogeneous_ )
+   {
+      return std::sqrt((Number) Dim()) * std::abs(scalar_);
+   }
+   else
+   {
+      ProfileCount(PROFILE_VECTOR_OPS, 1.);
+      ProfileCount(PROFILE_VECTOR_BYTES, (Number) Dim() * sizeof(Number));
+      return IpBlasNrm2(Dim(), values_, 1);
+   }
+}
+
+Number DenseVector::AsumImpl() const
+{
+   DBG_ASSERT(initialized_);
+   if( homogeneous_ )
+   {
+      return Dim() * std::abs(scalar_);
+   }
+   else
+   {
+      ProfileCount(PROFILE_VECTOR_OPS, 1.);
+      ProfileCount(PROFILE_VECTOR_BYTES, (Number) Dim() * sizeof(Number));
+      return IpBlasAsum(Dim(), values_, 1);
+   }
+}
+
+Number DenseVector::AmaxImpl() const
+{
+   DBG_ASSERT(initialized_);
+   if( Dim() == 0 )
+   {
+      return 0.;
+   }
+
+   if( homogeneous_ )
+   {
+      return std::abs(scalar_);
+   }
+
+   ProfileCount(PROFILE_VECTOR_OPS, 1.);
+   ProfileCount(PROFILE_VECTOR_BYTES, (Number) Dim() * sizeof(Number));
+   return std::abs(values_[IpBlasIamax(Dim(), values_, 1) - 1]);
+}
+
+void DenseVector::SetImpl(
+   Number value
+)
+{
+   initialized_ = true;
+   homogeneous_ = true;
+   scalar_ = value;
+   // ToDo decide if we want this here:
+   if( values_ )
+   {
+      owner_space_->FreeInternalStorage(values_);
+      values_ = NULL;
+   }
+}
+
+void DenseVector::ElementWiseDivideImpl(
+   const Vector& x
+)
+{
+   DBG_ASSERT(initialized_);
+   const DenseVector* dense_x = static_cast<const DenseVector*>(&x);
+   DBG_ASSERT(dynamic_cast<const DenseVector*>(&x));
+
+   DBG_ASSERT(dense_x->initialized_);
+   const Number* values_x = dense_x->values_;
+   DBG_ASSERT(Dim() == dense_x->Dim());
+
+   if( Dim() == 0 )
+   {
+      return;
+   }
+
+   if( homogeneous_ )
+   {
+      if( dense_x->homogeneous_ )
+      {
+         scalar_ /= dense_x->scalar_;
+      }
+      else
+      {
+         homogeneous_ = false;
+         Number* vals = values_allocated();
+         for( Index i = 0; i < Dim(); i++ )
+         {
+            vals[i] = scalar_ / values_x[i];
+         }
+      }
+   }
+   else
+   {
+      DenseVectorKernelArgs k;
+      k.y = values_;
+      if( dense_x->homogeneous_ )
+      {
+         k.x1 = &dense_x->scalar_;
+         k.inc1 = 0;
+      }
+      else
+      {
+         k.x1 = values_x;
+         k.inc1 = 1;
+      }
+      RunKernel(owner_space_->GetThreadPool(), Dim(), DivideKernel, k);
+   }
+}
+
+void DenseVector::ElementWiseMultiplyImpl(
+   const Vector& x
+)
+{
+   DBG_ASSERT(initialized_);
+   const DenseVector* dense_x = static_cast<const DenseVector*>(&x);
+   DBG_ASSERT(dynamic_cast<const DenseVector*>(&x));
+
+   DBG_ASSERT(dense_x->initialized_);
+   const Number* values_x = dense_x->values_;
+   DBG_ASSERT(Dim() == dense_x->Dim());
+
+   if( Dim() == 0 )
+   {
+      return;
+   }
+
+   if( homogeneous_ )
+   {
+      if( dense_x->homogeneous_ )
+      {
+         scalar_ *= dense_x->scalar_;
+      }
+      else
+      {
+         homogeneous_ = false;
+         Number* vals = values_allocated();
+         for( Index i = 0; i < Dim(); i++ )
+         {
+            vals[i] = scalar_ * values_x[i];
+         }
+      }
+   }
+   else if( !dense_x->homogeneous_ || dense_x->scalar_ != 1.0 )
+   {
+      DenseVectorKernelArgs k;
+      k.y = values_;
+      if( dense_x->homogeneous_ )
+      {
+         k.x1 = &dense_x->scalar_;
+         k.inc1 = 0;
+      }
+      else
+      {
+         k.x1 = values_x;
+         k.inc1 = 1;
+      }
+      RunKernel(owner_space_->GetThreadPool(), Dim(), MultiplyKernel, k);
+   }
+}
+
+void DenseVector::ElementWiseSelectImpl(
+   const Vector& x
+)
+{
+   DBG_ASSERT(initialized_);
+   const DenseVector* dense_x = static_cast<const DenseVector*>(&x);
+   DBG_ASSERT(dynamic_cast<const DenseVector*>(&x));
+
+   DBG_ASSERT(dense_x->initialized_);
+   const Number* values_x = dense_x->values_;
+   DBG_ASSERT(Dim() == dense_x->Dim());
+
+   if( Dim() == 0 )
+   {
+      return;
+   }
+
+   if( homogeneous_ )
+   {
+      if( scalar_ == 0.0 )
+      {
+         return;
+      }
+      if( dense_x->homogeneous_ )
+      {
+         scalar_ *= dense_x->scalar_;
+      }
+      else
+      {
+         homogeneous_ = false;
+         Number* vals = values_allocated();
+         for( Index i = 0; i < Dim(); i++ )
+         {
+            vals[i] = scalar_ * values_x[i];
+         }
+      }
+   }
+   else if( !dense_x->homogeneous_ || dense_x->scalar_ != 1.0 )
+   {
+      DenseVectorKernelArgs k;
+      k.y = values_;
+      if( dense_x->homogeneous_ )
+      {
+         k.x1 = &dense_x->scalar_;
+         k.inc1 = 0;
+      }
+      else
+      {
+         k.x1 = values_x;
+         k.inc1 = 1;
+      }
+      RunKernel(owner_space_->GetThreadPool(), Dim(), SelectKernel, k);
+   }
+}
+
+void DenseVector::ElementWiseMaxImpl(
+   const Vector& x
+)
+{
+   DBG_ASSERT(initialized_);
+   const DenseVector* dense_x = static_cast<const DenseVector*>(&x);
+   DBG_ASSERT(dynamic_cast<const DenseVector*>(&x));
+
+   DBG_ASSERT(dense_x->initialized_);
+   const Number* values_x = dense_x->values_;
+   DBG_ASSERT(Dim() == dense_x->Dim());
+
+   if( Dim() == 0 )
+   {
+      return;
+   }
+
+   if( homogeneous_ )
+   {
+      if( dense_x->homogeneous_ )
+      {
+         scalar_ = Ipopt::Max(scalar_, dense_x->scalar_);
+      }
+      else
+      {
+         homogeneous_ = false;
+         Number* vals = values_allocated();
+         for( Index i = 0; i < Dim(); i++ )
+         {
+            vals[i] = Ipopt::Max(scalar_, values_x[i]);
+         }
+      }
+   }
+   else
+   {
+      DenseVectorKernelArgs k;
+      k.y = values_;
+      if( dense_x->homogeneous_ )
+      {
+         k.x1 = &dense_x->scalar_;
+         k.inc1 = 0;
+      }
+      else
+      {
+         k.x1 = values_x;
+         k.inc1 = 1;
+      }
+      RunKernel(owner_space_->GetThreadPool(), Dim(), MaxKernel, k);
+   }
+}
+
+void DenseVector::ElementWiseMinImpl(
+   const Vector& x
+)
+{
+   DBG_ASSERT(initialized_);
+   const DenseVector* dense_x = static_cast<const DenseVector*>(&x);
+   DBG_ASSERT(dynamic_cast<const DenseVector*>(&x));
+
+   DBG_ASSERT(dense_x->initialized_);
+   const Number* values_x = dense_x->values_;
+   DBG_ASSERT(Dim() == dense_x->Dim());
+
+   if( Dim() == 0 )
+   {
+      return;
+   }
+
+   if( homogeneous_ )
+   {
+      if( dense_x->homogeneous_ )
+      {
+         scalar_ = Ipopt::Min(scalar_, dense_x->scalar_);
+      }
+      else
+      {
+         homogeneous_ = false;
+         Number* vals = values_allocated();
+         for( Index i = 0; i < Dim(); i++ )
+         {
+            vals[i] = Ipopt::Min(scalar_, values_x[i]);
+         }
+      }
+   }
+   else
+   {
+      DenseVectorKernelArgs k;
+      k.y = values_;
+      if( dense_x->homogeneous_ )
+      {
+         k.x1 = &dense_x->scalar_;
+         k.inc1 = 0;
+      }
+      else
+      {
+         k.x1 = values_x;
+         k.inc1 = 1;
+      }
+      RunKernel(owner_space_->GetThreadPool(), Dim(), MinKernel, k);
+   }
+}
+
+void DenseVector::ElementWiseReciprocalImpl()
+{
+   DBG_ASSERT(initialized_);
+
+   if( Dim() == 0 )
+   {
+      return;
+   }
+
+   if( homogeneous_ )
+   {
+      scalar_ = 1.0 / scalar_;
+   }
+   else
+   {
+      DenseVectorKernelArgs k;
+      k.y = values_;
+      RunKernel(owner_space_->GetThreadPool(), Dim(), ReciprocalKernel, k);
+   }
+}
+
+void DenseVector::ElementWiseAbsImpl()
+{
+   DBG_ASSERT(initialized_);
+   if( homogeneous_ )
+   {
+      scalar_ = std::abs(scalar_);
+   }
+   else
+   {
+      DenseVectorKernelArgs k;
+      k.y = values_;
+      RunKernel(owner_space_->GetThreadPool(), Dim(), AbsKernel, k);
+   }
+}
+
+void DenseVector::ElementWiseSqrtImpl()
+{
+   DBG_ASSERT(initialized_);
+   if( homogeneous_ )
+   {
+      scalar_ = std::sqrt(scalar_);
+   }
+   else
+   {
+      DenseVectorKernelArgs k;
+      k.y = values_;
+      RunKernel(owner_space_->GetThreadPool(), Dim(), SqrtKernel, k);
+   }
+}
+
+void DenseVector::AddScalarImpl(
+   Number scalar
+)
+{
+   DBG_ASSERT(initialized_);
+   if( homogeneous_ )
+   {
+      scalar_ += scalar;
+   }
+   else
+   {
+      DenseVectorKernelArgs k;
+      k.y = values_;
+      k.x1 = &scalar;
+      k.inc1 = 0;
+      k.a = 1.;
+      RunKernel(owner_space_->GetThreadPool(), Dim(), AxpyKernel, k);
+   }
+}
+
+Number DenseVector::MaxImpl() const
+{
+   DBG_ASSERT(initialized_);
+   if( Dim() == 0 )
+   {
+      return -std::numeric_limits<Number>::max();
+   }
+
+   Number max;
+   if( homogeneous_ )
+   {
+      max = scalar_;
+   }
+   else
+   {
+      DenseVectorKernelArgs k;
+      k.x1 = values_;
+      max = RunKernel(owner_space_->GetThreadPool(), Dim(), MaxReductionKernel, k, REDUCE_MAX);
+   }
+   return max;
+}
+
+Number DenseVector::MinImpl() const
+{
+   DBG_ASSERT(initialized_);
+   if( Dim() == 0 )
+   {
+      return std::numeric_limits<Number>::max();
+   }
+
+   Number min;
+   if( homogeneous_ )
+   {
+      min = scalar_;
+   }
+   else
+   {
+      DenseVectorKernelArgs k;
+      k.x1 = values_;
+      min = RunKernel(owner_space_->GetThreadPool(), Dim(), MinReductionKernel, k, REDUCE_MIN);
+   }
+   return min;
+}
+
+Number DenseVector::SumImpl() const
+{
+   DBG_ASSERT(initialized_);
+   Number sum;
+   if( homogeneous_ )
+   {
+      sum = Dim() * scalar_;
+   }
+   else
+   {
+      DenseVectorKernelArgs k;
+      k.x1 = values_;
+      sum = RunKernel(owner_space_->GetThreadPool(), Dim(), SumKernel, k);
+   }
+   return sum;
+}
+
+Number DenseVector::SumLogsImpl() const
+{
+   DBG_ASSERT(initialized_);
+   Number sum;
+   if( Dim() == 0 )
+   {
+      sum = 0.0;
+   }
+   else if( homogeneous_ )
+   {
+      sum = Dim() * std::log(scalar_);
+   }
+   else
+   {
+      DenseVectorKernelArgs k;
+      k.x1 = values_;
+      sum = RunKernel(owner_space_->GetThreadPool(), Dim(), SumLogsKernel, k);
+   }
+   return sum;
+}
+
+void DenseVector::ElementWiseSgnImpl()
+{
+   DBG_ASSERT(initialized_);
+   if( homogeneous_ )
+   {
+      if( scalar_ > 0. )
+      {
+         scalar_ = 1.;
+      }
+      else if( scalar_ < 0. )
+      {
+         scalar_ = -1.;
+      }
+      else
+      {
+         scalar_ = 0.;
+      }
+   }
+   else
+   {
+      DenseVectorKernelArgs k;
+      k.y = values_;
+      RunKernel(owner_space_->GetThreadPool(), Dim(), SgnKernel, k);
+   }
+}
+
+// Specialized Functions
+void DenseVector::AddTwoVectorsImpl(
+   Number        a,
+   const Vector& v1,
+   Number        b,
+   const Vector& v2,
+   Number        c
+)
+{
+   if( Dim() == 0 )
+   {
+      DBG_ASSERT(initialized_);
+      return;
+   }
+
+   const Number* values_v1 = NULL;
+   bool homogeneous_v1 = false;
+   Number scalar_v1 = 0;
+   if( a != 0. )
+   {
+      const DenseVector* dense_v1 = static_cast<const DenseVector*>(&v1);
+      DBG_ASSERT(dynamic_cast<const DenseVector*>(&v1));
+
+      DBG_ASSERT(dense_v1->initialized_);
+      DBG_ASSERT(Dim() == dense_v1->Dim());
+      values_v1 = dense_v1->values_;
+      homogeneous_v1 = dense_v1->homogeneous_;
+      if( homogeneous_v1 )
+      {
+         scalar_v1 = dense_v1->scalar_;
+      }
+   }
+   const Number* values_v2 = NULL;
+   bool homogeneous_v2 = false;
+   Number scalar_v2 = 0;
+   if( b != 0. )
+   {
+      const DenseVector* dense_v2 = static_cast<const DenseVector*>(&v2);
+      DBG_ASSERT(dynamic_cast<const DenseVector*>(&v2));
+
+      DBG_ASSERT(dense_v2->initialized_);
+      DBG_ASSERT(Dim() == dense_v2->Dim());
+      values_v2 = dense_v2->values_;
+      homogeneous_v2 = dense_v2->homogeneous_;
+      if( homogeneous_v2 )
+      {
+         scalar_v2 = dense_v2->scalar_;
       }
-      else
+   }
+   DBG_ASSERT(c == 0. || initialized_);
+   if( (c == 0. || homogeneous_) && homogeneous_v1 && homogeneous_v2 )
+   {
+      homogeneous_ = true;
+      Number val = 0;
+      if( c != 0. )
       {
-         if( b == 0. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = a * values_v1[i] + c * values_[i];
-            }
-         }
-         else if( b == 1. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = a * values_v1[i] + values_v2[i] + c * values_[i];
-            }
-         }
-         else if( b == -1. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = a * values_v1[i] - values_v2[i] + c * values_[i];
-            }
-         }
-         else
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = a * values_v1[i] + b * values_v2[i] + c * values_[i];
-            }
-         }
+         val = c * scalar_;
       }
+      scalar_ = val + a * scalar_v1 + b * scalar_v2;
+      initialized_ = true;
+      return;
+   }
+   if( c == 0. )
+   {
+      // make sure we have memory allocated for this vector
+      values_allocated();
+      homogeneous_ = false;
+   }
+
+   // If any of the vectors is homogeneous, call the default implementation
+   if( homogeneous_ || homogeneous_v1 || homogeneous_v2 )
+   {
+      // ToDo:Should we implement specialized methods here too?
+      Vector::AddTwoVectorsImpl(a, v1, b, v2, c);
+      return;
    }
+   DBG_ASSERT(values_v1 != NULL || a == 0.);
+   DBG_ASSERT(values_v2 != NULL || b == 0.);
+   DBG_ASSERT(values_ != NULL);
+
+   DenseVectorKernelArgs k;
+   k.y = values_;
+   k.x1 = values_v1;
+   k.x2 = values_v2;
+   k.a = a;
+   k.b = b;
+   k.c = c;
+   RunKernel(owner_space_->GetThreadPool(), Dim(), AddTwoVectorsKernel, k);
    initialized_ = true;
 }
 
@@ -1338,50 +2030,38 @@ Number DenseVector::FracToBoundImpl(
    }
 
    Number alpha = 1.;
-   Number* values_x = values_;
-   Number* values_delta = dense_delta->values_;
-   if( homogeneous_ )
+   if( homogeneous_ && dense_delta->homogeneous_ )
    {
-      if( dense_delta->homogeneous_ )
+      if( dense_delta->scalar_ < 0. )
       {
-         if( dense_delta->scalar_ < 0. )
-         {
-            alpha = Ipopt::Min(alpha, -tau / dense_delta->scalar_ * scalar_);
-         }
+         alpha = Ipopt::Min(alpha, -tau / dense_delta->scalar_ * scalar_);
+      }
+   }
+   else if( !dense_delta->homogeneous_ || dense_delta->scalar_ < 0. )
+   {
+      DenseVectorKernelArgs k;
+      if( homogeneous_ )
+      {
+         k.x1 = &scalar_;
+         k.inc1 = 0;
       }
       else
       {
-         for( Index i = 0; i < Dim(); i++ )
-         {
-            if( values_delta[i] < 0. )
-            {
-               alpha = Ipopt::Min(alpha, -tau / values_delta[i] * scalar_);
-            }
-         }
+         k.x1 = values_;
+         k.inc1 = 1;
       }
-   }
-   else
-   {
       if( dense_delta->homogeneous_ )
       {
-         if( dense_delta->scalar_ < 0. )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               alpha = Ipopt::Min(alpha, -tau / dense_delta->scalar_ * values_x[i]);
-            }
-         }
+         k.x2 = &dense_delta->scalar_;
+         k.inc2 = 0;
       }
       else
       {
-         for( Index i = 0; i < Dim(); i++ )
-         {
-            if( values_delta[i] < 0. )
-            {
-               alpha = Ipopt::Min(alpha, -tau / values_delta[i] * values_x[i]);
-            }
-         }
+         k.x2 = dense_delta->values_;
+         k.inc2 = 1;
       }
+      k.a = tau;
+      alpha = RunKernel(owner_space_->GetThreadPool(), Dim(), FracToBoundKernel, k, REDUCE_MIN);
    }
 
    DBG_ASSERT(alpha >= 0.);
@@ -1438,103 +2118,211 @@ void DenseVector::AddVectorQuotientImpl(
    // Make sure we have memory to store a non-homogeneous vector
    values_allocated();
 
-   Number* values_z = dense_z->values_;
-   Number* values_s = dense_s->values_;
+   DenseVectorKernelArgs k;
+   k.y = values_;
+   k.x1 = homogeneous_z ? &dense_z->scalar_ : dense_z->values_;
+   k.inc1 = homogeneous_z ? 0 : 1;
+   k.x2 = homogeneous_s ? &dense_s->scalar_ : dense_s->values_;
+   k.inc2 = homogeneous_s ? 0 : 1;
+   k.a = a;
+   k.c = c;
+   k.y_homogeneous = homogeneous_;
+   if( c != 0. && homogeneous_ )
+   {
+      k.b = c * scalar_;
+   }
+   RunKernel(owner_space_->GetThreadPool(), Dim(), AddVectorQuotientKernel, k);
 
-   if( c == 0. )
+   initialized_ = true;
+   homogeneous_ = false;
+}
+
+/** Get the values of a dense vector as kernel argument.
+ *
+ *  If the vector is homogeneous, then values points to scalar.
+ *  If the coefficient of the vector is zero, then the vector is not
+ *  accessed and a single zero is used instead.
+ */
+static void KernelArgValues(
+   Number         coef,
+   const Vector&  v,
+   Index          dim,
+   const Number*& values,
+   Index&         inc,
+   bool&          homogeneous,
+   Number&        scalar
+)
+{
+   static const Number zero = 0.;
+   if( coef == 0. )
    {
-      if( homogeneous_z )
-      {
-         // then s is not homogeneous
-         for( Index i = 0; i < Dim(); i++ )
-         {
-            values_[i] = a * dense_z->scalar_ / values_s[i];
-         }
-      }
-      else if( homogeneous_s )
-      {
-         // then z is not homogeneous
-         for( Index i = 0; i < Dim(); i++ )
-         {
-            values_[i] = values_z[i] * a / dense_s->scalar_;
-         }
-      }
-      else
-      {
-         for( Index i = 0; i < Dim(); i++ )
-         {
-            values_[i] = a * values_z[i] / values_s[i];
-         }
-      }
+      values = &zero;
+      inc = 0;
+      homogeneous = true;
+      scalar = 0.;
+      return;
    }
-   else if( homogeneous_ )
+
+   const DenseVector* dense_v = static_cast<const DenseVector*>(&v);
+   DBG_ASSERT(dynamic_cast<const DenseVector*>(&v));
+   DBG_ASSERT(dense_v->Dim() == dim);
+   (void) dim;
+
+   homogeneous = dense_v->IsHomogeneous();
+   if( homogeneous )
    {
-      Number val = c * scalar_;
-      if( homogeneous_z )
-      {
-         // then s is not homogeneous
-         for( Index i = 0; i < Dim(); i++ )
-         {
-            values_[i] = val + a * dense_z->scalar_ / values_s[i];
-         }
-      }
-      else if( homogeneous_s )
-      {
-         // then z is not homogeneous
-         for( Index i = 0; i < Dim(); i++ )
-         {
-            values_[i] = val + values_z[i] * a / dense_s->scalar_;
-         }
-      }
-      else
-      {
-         for( Index i = 0; i < Dim(); i++ )
-         {
-            values_[i] = val + a * values_z[i] / values_s[i];
-         }
-      }
+      scalar = dense_v->Scalar();
+      values = &scalar;
+      inc = 0;
    }
    else
    {
-      // ToDo could distinguish c = 1
-      if( homogeneous_z )
+      scalar = 0.;
+      values = dense_v->Values();
+      inc = 1;
+   }
+}
+
+void DenseVector::AddThreeVectorsImpl(
+   Number        a,
+   const Vector& v1,
+   Number        b,
+   const Vector& v2,
+   Number        c,
+   const Vector& v3,
+   Number        d
+)
+{
+   DBG_ASSERT(d == 0. || initialized_);
+   if( Dim() == 0 )
+   {
+      initialized_ = true;
+      return;
+   }
+
+   DenseVectorKernelArgs k;
+   bool homogeneous1, homogeneous2, homogeneous3;
+   Number scalar1, scalar2, scalar3;
+   KernelArgValues(a, v1, Dim(), k.x1, k.inc1, homogeneous1, scalar1);
+   KernelArgValues(b, v2, Dim(), k.x2, k.inc2, homogeneous2, scalar2);
+   KernelArgValues(c, v3, Dim(), k.x3, k.inc3, homogeneous3, scalar3);
+
+   if( (d == 0. || homogeneous_) && homogeneous1 && homogeneous2 && homogeneous3 )
+   {
+      Number val = 0.;
+      if( d != 0. )
       {
-         if( homogeneous_s )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = c * values_[i] + a * dense_z->scalar_ / dense_s->scalar_;
-            }
-         }
-         else
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = c * values_[i] + a * dense_z->scalar_ / values_s[i];
-            }
-         }
+         val = d * scalar_;
       }
-      else
+      scalar_ = a * scalar1 + b * scalar2 + c * scalar3 + val;
+      homogeneous_ = true;
+      initialized_ = true;
+      return;
+   }
+
+   if( d == 0. )
+   {
+      values_allocated();
+      homogeneous_ = false;
+   }
+   else if( homogeneous_ )
+   {
+      set_values_from_scalar();
+   }
+   k.y = values_;
+   k.a = a;
+   k.b = b;
+   k.c = c;
+   k.d = d;
+   RunKernel(owner_space_->GetThreadPool(), Dim(), AddThreeVectorsKernel, k);
+   initialized_ = true;
+}
+
+void DenseVector::AddVectorAndProductImpl(
+   Number        a,
+   const Vector& v1,
+   Number        b,
+   const Vector& v2,
+   const Vector& w,
+   Number        c,
+   Number        d
+)
+{
+   DBG_ASSERT(c == 0. || initialized_);
+   if( Dim() == 0 )
+   {
+      initialized_ = true;
+      return;
+   }
+
+   DenseVectorKernelArgs k;
+   bool homogeneous1, homogeneous2, homogeneous_w;
+   Number scalar1, scalar2, scalar_w;
+   KernelArgValues(a, v1, Dim(), k.x1, k.inc1, homogeneous1, scalar1);
+   KernelArgValues(b, v2, Dim(), k.x2, k.inc2, homogeneous2, scalar2);
+   KernelArgValues(b, w, Dim(), k.x3, k.inc3, homogeneous_w, scalar_w);
+
+   if( (c == 0. || homogeneous_) && homogeneous1 && homogeneous2 && homogeneous_w )
+   {
+      Number val = 0.;
+      if( c != 0. )
       {
-         if( homogeneous_s )
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = c * values_[i] + values_z[i] * a / dense_s->scalar_;
-            }
-         }
-         else
-         {
-            for( Index i = 0; i < Dim(); i++ )
-            {
-               values_[i] = c * values_[i] + a * values_z[i] / values_s[i];
-            }
-         }
+         val = c * scalar_;
       }
+      scalar_ = a * scalar1 + b * scalar2 * scalar_w + val + d;
+      homogeneous_ = true;
+      initialized_ = true;
+      return;
+   }
+
+   if( c == 0. )
+   {
+      values_allocated();
+      homogeneous_ = false;
+   }
+   else if( homogeneous_ )
+   {
+      set_values_from_scalar();
    }
 
+   k.y = values_;
+   k.a = a;
+   k.b = b;
+   k.c = c;
+   k.d = d;
+   RunKernel(owner_space_->GetThreadPool(), Dim(), AddVectorAndProductKernel, k);
    initialized_ = true;
-   homogeneous_ = false;
+}
+
+Number DenseVector::WeightedAsumImpl(
+   const Vector& w
+) const
+{
+   DBG_ASSERT(initialized_);
+   if( Dim() == 0 )
+   {
+      return 0.;
+   }
+
+   DenseVectorKernelArgs k;
+   bool homogeneous_w;
+   Number scalar_w;
+   KernelArgValues(1., w, Dim(), k.x2, k.inc2, homogeneous_w, scalar_w);
+   if( homogeneous_ && homogeneous_w )
+   {
+      return Dim() * std::abs(scalar_ * scalar_w);
+   }
+   if( homogeneous_ )
+   {
+      k.x1 = &scalar_;
+      k.inc1 = 0;
+   }
+   else
+   {
+      k.x1 = values_;
+      k.inc1 = 1;
+   }
+   return RunKernel(owner_space_->GetThreadPool(), Dim(), WeightedAsumKernel, k);
 }
 
 void DenseVector::CopyToPos(
@@ -16,6 +16,8 @@ namespace Ipopt
 
 /* forward declarations */
 class DenseVectorSpace;
+class ThreadPool;
+class StoragePool;
 
 /** @name Exceptions */
 ///@{
@@ -234,6 +236,33 @@ protected:
       const Vector& s,
       Number        c
    );
+
+   /** Add three vectors, y = a * v1 + b * v2 + c * v3 + d * y. */
+   void AddThreeVectorsImpl(
+      Number        a,
+      const Vector& v1,
+      Number        b,
+      const Vector& v2,
+      Number        c,
+      const Vector& v3,
+      Number        d
+   );
+
+   /** Add a vector and an element-wise product, y = a * v1 + b * v2 .* w + c * y + d. */
+   void AddVectorAndProductImpl(
+      Number        a,
+      const Vector& v1,
+      Number        b,
+      const Vector& v2,
+      const Vector& w,
+      Number        c,
+      Number        d
+   );
+
+   /** 1-norm of the element-wise product with w. */
+   Number WeightedAsumImpl(
+      const Vector& w
+   ) const;
    ///@}
 
    /** @name Output methods */
@@ -338,13 +367,10 @@ public:
    /** Constructor, requires dimension of all vector for this VectorSpace */
    DenseVectorSpace(
       Index dim
-   )
-      : VectorSpace(dim)
-   { }
+   );
 
    /** Destructor */
-   ~DenseVectorSpace()
-   { }
+   ~DenseVectorSpace();
    ///@}
 
    /** Method for creating a new vector of this specific type. */
@@ -360,17 +386,29 @@ public:
 
    /**@name Methods called by DenseVector for memory management.
     *
-    * This could allow to have sophisticated memory management in the
-    * VectorSpace.
+    * The storage is taken from a pool that keeps the arrays of
+    * deleted vectors for reuse, so that creating vectors in later
+    * iterations does not allocate memory on the heap.
     */
    ///@{
    /** Allocate internal storage for the DenseVector */
-   inline Number* AllocateInternalStorage() const;
+   Number* AllocateInternalStorage() const;
 
    /** Deallocate internal storage for the DenseVector */
-   inline void FreeInternalStorage(
+   void FreeInternalStorage(
       Number* values
    ) const;
+
+   /** Number of allocations of internal storage that reused the
+    *  storage of a deleted vector.
+    *  @since 3.14.5
+    */
+   Index StoragePoolHits() const;
+
+   /** Number of allocations of internal storage that required new memory.
+    *  @since 3.14.5
+    */
+   Index StoragePoolMisses() const;
    ///@}
 
    /**@name Methods for dealing with meta data on the vector
@@ -437,7 +475,40 @@ public:
    inline const NumericMetaDataMapType& GetNumericMetaData() const;
    ///@}
 
+   /**@name Methods for parallel operations on the vectors of this space */
+   ///@{
+   /** Set the thread pool that is used by operations on vectors of this space.
+    *
+    *  Operations are distributed over the threads of the pool if the
+    *  dimension of the space is at least min_dim_parallel.
+    *  If pool is NULL, all operations are executed sequentially.
+    *  @since 3.14.5
+    */
+   void SetThreadPool(
+      ThreadPool* pool,
+      Index       min_dim_parallel
+   );
+
+   /** Thread pool for operations on vectors of this space, or NULL
+    *  if they should be executed sequentially.
+    *  @since 3.14.5
+    */
+   ThreadPool* GetThreadPool() const
+   {
+      return Dim() >= min_dim_parallel_ ? GetRawPtr(pool_) : NULL;
+   }
+   ///@}
+
 private:
+   /** Pool for the internal storage of vectors of this space */
+   SmartPtr<StoragePool> storage_pool_;
+
+   /** Thread pool for operations on vectors of this space (may be NULL) */
+   SmartPtr<ThreadPool> pool_;
+
+   /** Minimal dimension for which operations are executed in parallel */
+   Index min_dim_parallel_;
+
    // variables to store vector meta data
    StringMetaDataMapType string_meta_data_;
    IntegerMetaDataMapType integer_meta_data_;
@@ -480,26 +551,6 @@ inline Number* DenseVector::values_allocated()
    return values_;
 }
 
-inline Number* DenseVectorSpace::AllocateInternalStorage() const
-{
-   if( Dim() > 0 )
-   {
-      return new Number[Dim()];
-   }
-   else
-   {
-      return NULL;
-   }
-}
-
-inline
-void DenseVectorSpace::FreeInternalStorage(
-   Number* values
-) const
-{
-   delete[] values;
-}
-
 inline SmartPtr<DenseVector> DenseVector::MakeNewDenseVector() const
 {
    return owner_space_->MakeNewDenseVector();
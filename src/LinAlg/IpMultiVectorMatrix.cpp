@@ -7,6 +7,8 @@
 #include "IpMultiVectorMatrix.hpp"
 #include "IpDenseVector.hpp"
 #include "IpDenseGenMatrix.hpp"
+#include "IpBlas.hpp"
+#include "IpThreadPool.hpp"
 
 #include <cstdio>
 
@@ -17,6 +19,79 @@ namespace Ipopt
 static const Index dbg_verbosity = 0;
 #endif
 
+/** Number of rows of the blocks in which the products with dense columns are computed */
+static const Index block_rows = 2048;
+
+/** Number of entries of a block of the packed columns for the Level 3 BLAS products */
+static const Index panel_entries = 32768;
+
+/** Task that computes V = a * U * C + b * V for a range of rows, if all columns are dense.
+ *
+ *  The rows of U are copied into a contiguous panel, so that the
+ *  product of a panel with C is one call of IpBlasGemm.
+ */
+class RightMultPanelTask: public ThreadPoolTask
+{
+public:
+   const Number* const* ucols;
+   Number* const* vcols;
+   const Number* Cvalues;
+   Index k;
+   Index m;
+   Index nb;
+   Number a;
+   Number b;
+   Index begin;
+   Index end;
+
+   void Run(
+      ThreadPool& /*pool*/,
+      Index       /*worker*/
+   )
+   {
+      Compute();
+   }
+
+   void Compute()
+   {
+      std::vector<Number> panel(nb * k);
+      std::vector<Number> prod(nb * m);
+      for( Index r0 = begin; r0 < end; r0 += nb )
+      {
+         const Index nr = Min(nb, end - r0);
+         for( Index j = 0; j < k; j++ )
+         {
+            const Number* u = ucols[j] + r0;
+            Number* p = &panel[j * nr];
+            for( Index i = 0; i < nr; i++ )
+            {
+               p[i] = u[i];
+            }
+         }
+         IpBlasGemm(false, false, nr, m, k, a, &panel[0], nr, Cvalues, k, 0., &prod[0], nr);
+         for( Index j = 0; j < m; j++ )
+         {
+            Number* v = vcols[j] + r0;
+            const Number* p = &prod[j * nr];
+            if( b == 0. )
+            {
+               for( Index i = 0; i < nr; i++ )
+               {
+                  v[i] = p[i];
+               }
+            }
+            else
+            {
+               for( Index i = 0; i < nr; i++ )
+               {
+                  v[i] = b * v[i] + p[i];
+               }
+            }
+         }
+      }
+   }
+};
+
 MultiVectorMatrix::MultiVectorMatrix(
    const MultiVectorMatrixSpace* owner_space
 )
@@ -59,6 +134,41 @@ void MultiVectorMatrix::MultVectorImpl(
    DBG_ASSERT(NCols() == x.Dim());
    DBG_ASSERT(NRows() == y.Dim());
 
+   // See if we can understand the data
+   const DenseVector* dense_x = static_cast<const DenseVector*>(&x);
+   DBG_ASSERT(dynamic_cast<const DenseVector*>(&x));
+
+   // If all vectors are dense, we add the columns block by block, so
+   // that the block of y stays in the cache
+   std::vector<const Number*> cols;
+   DenseVector* dense_y = dynamic_cast<DenseVector*>(&y);
+   if( dense_y != NULL && !dense_x->IsHomogeneous() && GetDenseColumnValues(cols) )
+   {
+      const Number* xvals = dense_x->Values();
+      Number* yvals = dense_y->Values();
+      const Index n = NRows();
+      for( Index r0 = 0; r0 < n; r0 += block_rows )
+      {
+         const Index nr = Min(block_rows, n - r0);
+         if( beta == 0. )
+         {
+            for( Index i = r0; i < r0 + nr; i++ )
+            {
+               yvals[i] = 0.;
+            }
+         }
+         else if( beta != 1. )
+         {
+            IpBlasScal(nr, beta, yvals + r0, 1);
+         }
+         for( Index j = 0; j < NCols(); j++ )
+         {
+            IpBlasAxpy(nr, alpha * xvals[j], cols[j] + r0, 1, yvals + r0, 1);
+         }
+      }
+      return;
+   }
+
    // Take care of the y part of the addition
    if( beta != 0.0 )
    {
@@ -69,10 +179,6 @@ void MultiVectorMatrix::MultVectorImpl(
       y.Set(0.0);  // In case y hasn't been initialized yet
    }
 
-   // See if we can understand the data
-   const DenseVector* dense_x = static_cast<const DenseVector*>(&x);
-   DBG_ASSERT(dynamic_cast<const DenseVector*>(&x));
-
    // We simply add all the Vectors one after the other
    if( dense_x->IsHomogeneous() )
    {
@@ -107,6 +213,31 @@ void MultiVectorMatrix::TransMultVectorImpl(
    DenseVector* dense_y = static_cast<DenseVector*>(&y);
    DBG_ASSERT(dynamic_cast<DenseVector*>(&y));
 
+   // If all vectors are dense, we compute the dot products block by
+   // block, so that the block of x stays in the cache
+   std::vector<const Number*> cols;
+   const DenseVector* dense_x = dynamic_cast<const DenseVector*>(&x);
+   if( dense_x != NULL && !dense_x->IsHomogeneous() && GetDenseColumnValues(cols) )
+   {
+      const Number* xvals = dense_x->Values();
+      std::vector<Number> dots(NCols(), 0.);
+      const Index n = NRows();
+      for( Index r0 = 0; r0 < n; r0 += block_rows )
+      {
+         const Index nr = Min(block_rows, n - r0);
+         for( Index j = 0; j < NCols(); j++ )
+         {
+            dots[j] += IpBlasDot(nr, cols[j] + r0, 1, xvals + r0, 1);
+         }
+      }
+      Number* yvals = dense_y->Values();
+      for( Index j = 0; j < NCols(); j++ )
+      {
+         yvals[j] = (beta != 0.0) ? alpha * dots[j] + beta * yvals[j] : alpha * dots[j];
+      }
+      return;
+   }
+
    // Use the individual dot products to get the matrix (transpose)
    // vector product
    Number* yvals = dense_y->Values();
@@ -142,6 +273,20 @@ void MultiVectorMatrix::LRMultVector(
    DBG_PRINT((1, "alpha = %e beta = %e\n", alpha, beta));
    DBG_PRINT_VECTOR(2, "x", x);
 
+   // If all vectors are dense, first compute V^T x and then add V
+   // times the result, with one blocked pass over the columns each
+   std::vector<const Number*> cols;
+   const DenseVector* dense_x = dynamic_cast<const DenseVector*>(&x);
+   if( NCols() > 0 && dense_x != NULL && !dense_x->IsHomogeneous() && dynamic_cast<DenseVector*>(&y) != NULL
+       && GetDenseColumnValues(cols) )
+   {
+      SmartPtr<DenseVectorSpace> tmp_space = new DenseVectorSpace(NCols());
+      SmartPtr<DenseVector> tmp = tmp_space->MakeNewDenseVector();
+      TransMultVectorImpl(1., x, 0., *tmp);
+      MultVectorImpl(alpha, *tmp, beta, y);
+      return;
+   }
+
    if( beta != 0.0 )
    {
       y.Scal(beta);
@@ -240,7 +385,8 @@ void MultiVectorMatrix::AddRightMultMatrix(
    Number                   a,
    const MultiVectorMatrix& U,
    const Matrix&            C,
-   Number                   b
+   Number                   b,
+   ThreadPool*              pool
 )
 {
    DBG_ASSERT(NRows() == U.NRows());
@@ -252,14 +398,66 @@ void MultiVectorMatrix::AddRightMultMatrix(
       FillWithNewVectors();
    }
 
-   // ToDo: For now, we simply use MatrixVector multiplications, but
-   // we might be more efficient (at least in the non-parallel case)
-   // if we used Level 3 Blas
+   const DenseGenMatrix* dgm_C = static_cast<const DenseGenMatrix*>(&C);
+   DBG_ASSERT(dynamic_cast<const DenseGenMatrix*>(&C));
+
+   // If all columns are dense, we use Level 3 Blas on panels of rows
+   std::vector<const Number*> ucols;
+   std::vector<Number*> vcols(NCols());
+   bool dense = U.NCols() > 0 && U.GetDenseColumnValues(ucols);
+   for( Index i = 0; dense && i < NCols(); i++ )
+   {
+      DenseVector* dv = dynamic_cast<DenseVector*>(Vec(i));
+      dense = (dv != NULL);
+      if( dense )
+      {
+         vcols[i] = dv->Values();
+      }
+   }
+   if( dense && NCols() > 0 )
+   {
+      const Index n = NRows();
+      const Index nb = Max(Index(64), panel_entries / (U.NCols() + NCols()));
+      const Index npanels = (n + nb - 1) / nb;
+      Index ntasks = 1;
+      if( pool != NULL )
+      {
+         ntasks = Max(Index(1), Min(pool->NumThreads(), npanels));
+      }
+      std::vector<RightMultPanelTask> tasks(ntasks);
+      for( Index t = 0; t < ntasks; t++ )
+      {
+         RightMultPanelTask& task = tasks[t];
+         task.ucols = &ucols[0];
+         task.vcols = &vcols[0];
+         task.Cvalues = dgm_C->Values();
+         task.k = U.NCols();
+         task.m = NCols();
+         task.nb = nb;
+         task.a = a;
+         task.b = b;
+         task.begin = Min(n, (npanels * t / ntasks) * nb);
+         task.end = Min(n, (npanels * (t + 1) / ntasks) * nb);
+      }
+      if( ntasks > 1 )
+      {
+         for( Index t = 0; t < ntasks; t++ )
+         {
+            pool->Submit(&tasks[t]);
+         }
+         pool->Wait();
+      }
+      else
+      {
+         tasks[0].Compute();
+      }
+      ObjectChanged();
+      return;
+   }
+
    SmartPtr<const DenseVectorSpace> mydspace = new DenseVectorSpace(C.NRows());
    SmartPtr<DenseVector> mydvec = mydspace->MakeNewDenseVector();
 
-   const DenseGenMatrix* dgm_C = static_cast<const DenseGenMatrix*>(&C);
-   DBG_ASSERT(dynamic_cast<const DenseGenMatrix*>(&C));
    for( Index i = 0; i < NCols(); i++ )
    {
       const Number* CValues = dgm_C->Values();
@@ -273,6 +471,23 @@ void MultiVectorMatrix::AddRightMultMatrix(
    ObjectChanged();
 }
 
+bool MultiVectorMatrix::GetDenseColumnValues(
+   std::vector<const Number*>& values
+) const
+{
+   values.resize(NCols());
+   for( Index i = 0; i < NCols(); i++ )
+   {
+      const DenseVector* dv = dynamic_cast<const DenseVector*>(ConstVec(i));
+      if( dv == NULL || dv->IsHomogeneous() )
+      {
+         return false;
+      }
+      values[i] = dv->Values();
+   }
+   return true;
+}
+
 bool MultiVectorMatrix::HasValidNumbersImpl() const
 {
    for( Index i = 0; i < NCols(); i++ )
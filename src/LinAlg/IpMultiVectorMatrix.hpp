@@ -15,6 +15,7 @@ namespace Ipopt
 
 /** forward declarations */
 class MultiVectorMatrixSpace;
+class ThreadPool;
 
 /** Class for Matrices with few columns that consists of Vectors.
  *
@@ -106,12 +107,18 @@ public:
    /** Multiplying a Matrix C (for now assumed to be a DenseGenMatrix)
     *  from the right to a MultiVectorMatrix U and adding the result
     *  to this MultiVectorMatrix V. V = a * U * C + b * V.
+    *
+    *  If all columns of U and V are DenseVectors, the product is
+    *  computed with one Level 3 BLAS call per block of rows.  If a
+    *  ThreadPool is given (since 3.14.5), the blocks are distributed
+    *  over its threads.
     */
    void AddRightMultMatrix(
       Number                   a,
       const MultiVectorMatrix& U,
       const Matrix&            C,
-      Number                   b
+      Number                   b,
+      ThreadPool*              pool = NULL
    );
 
    /** Method for initializing all Vectors with new (uninitialized) Vectors. */
@@ -130,6 +137,16 @@ public:
       Vector&       y
    ) const;
 
+   /** Get the values of all columns, if all of them are DenseVectors
+    *  that are not homogeneous.
+    *
+    *  @return false, if this is not the case
+    *  @since 3.14.5
+    */
+   bool GetDenseColumnValues(
+      std::vector<const Number*>& values
+   ) const;
+
    /** Vector space for the columns */
    SmartPtr<const VectorSpace> ColVectorSpace() const;
 
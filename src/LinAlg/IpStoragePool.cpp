@@ -0,0 +1,67 @@
+// Copyright (C) 2021 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpStoragePool.hpp"
+#include "IpProfiler.hpp"
+
+#include <cstddef>
+
+namespace Ipopt
+{
+
+StoragePool::StoragePool(
+   Index size
+)
+   : size_(size),
+     num_hits_(0),
+     num_misses_(0)
+{ }
+
+StoragePool::~StoragePool()
+{
+   Clear();
+}
+
+Number* StoragePool::Allocate()
+{
+   if( size_ == 0 )
+   {
+      return NULL;
+   }
+
+   if( !pooled_.empty() )
+   {
+      Number* values = pooled_.back();
+      pooled_.pop_back();
+      ++num_hits_;
+      return values;
+   }
+
+   ++num_misses_;
+   ProfileCount(PROFILE_ALLOCATIONS, 1.);
+   ProfileCount(PROFILE_ALLOCATED_BYTES, (Number) size_ * sizeof(Number));
+   return new Number[size_];
+}
+
+void StoragePool::Free(
+   Number* values
+)
+{
+   if( values == NULL )
+   {
+      return;
+   }
+   pooled_.push_back(values);
+}
+
+void StoragePool::Clear()
+{
+   for( std::vector<Number*>::iterator it = pooled_.begin(); it != pooled_.end(); ++it )
+   {
+      delete[] *it;
+   }
+   pooled_.clear();
+}
+
+} // namespace Ipopt
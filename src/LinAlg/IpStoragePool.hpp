@@ -0,0 +1,112 @@
+// Copyright (C) 2021 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPSTORAGEPOOL_HPP__
+#define __IPSTORAGEPOOL_HPP__
+
+#include "IpTypes.hpp"
+#include "IpReferenced.hpp"
+
+#include <vector>
+
+namespace Ipopt
+{
+
+/** Pool of Number arrays of a fixed length.
+ *
+ *  Vector and matrix spaces hand out the storage for the values of
+ *  their vectors and matrices from such a pool.  Arrays that are
+ *  released are kept and handed out again by the next allocation,
+ *  so that, after the first iterations, creating vectors and
+ *  matrices does not allocate memory on the heap anymore.  The pool
+ *  keeps as many arrays as have been in use at the same time.
+ *
+ *  The pool counts how many allocations could be served from
+ *  released arrays (hits) and how many needed a new array (misses).
+ *
+ *  A pool is not thread-safe: the objects of one space must not be
+ *  created or destroyed concurrently.
+ *  @since 3.14.5
+ */
+class StoragePool: public ReferencedObject
+{
+public:
+   /** Constructor
+    *
+    *  @param size  length of the arrays of this pool
+    */
+   StoragePool(
+      Index size
+   );
+
+   /** Destructor, frees all released arrays */
+   ~StoragePool();
+
+   /** Get an array of length size */
+   Number* Allocate();
+
+   /** Give an array back to the pool */
+   void Free(
+      Number* values
+   );
+
+   /** Release the memory of all arrays that are currently not in use */
+   void Clear();
+
+   /** Number of allocations that were served from released arrays */
+   Index NumHits() const
+   {
+      return num_hits_;
+   }
+
+   /** Number of allocations that required a new array */
+   Index NumMisses() const
+   {
+      return num_misses_;
+   }
+
+   /** Number of released arrays that are kept by the pool */
+   Index NumPooled() const
+   {
+      return (Index) pooled_.size();
+   }
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called. */
+   ///@{
+   /** Default Constructor */
+   StoragePool();
+
+   /** Copy Constructor */
+   StoragePool(
+      const StoragePool&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const StoragePool&
+   );
+   ///@}
+
+   /** Length of the arrays */
+   Index size_;
+
+   /** Released arrays */
+   std::vector<Number*> pooled_;
+
+   /** Number of allocations that were served from released arrays */
+   Index num_hits_;
+
+   /** Number of allocations that required a new array */
+   Index num_misses_;
+};
+
+} // namespace Ipopt
+#endif
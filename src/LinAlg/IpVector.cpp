@@ -233,6 +233,77 @@ void Vector::AddVectorQuotientImpl(
    }
 }
 
+void Vector::AddThreeVectorsImpl(
+   Number        a,
+   const Vector& v1,
+   Number        b,
+   const Vector& v2,
+   Number        c,
+   const Vector& v3,
+   Number        d
+)
+{
+   DBG_ASSERT(Dim() == v3.Dim());
+
+   AddTwoVectors(a, v1, b, v2, d);
+   if( c != 0. )
+   {
+      Axpy(c, v3);
+   }
+}
+
+void Vector::AddVectorAndProductImpl(
+   Number        a,
+   const Vector& v1,
+   Number        b,
+   const Vector& v2,
+   const Vector& w,
+   Number        c,
+   Number        d
+)
+{
+   DBG_ASSERT(Dim() == v1.Dim());
+   DBG_ASSERT(Dim() == v2.Dim());
+   DBG_ASSERT(Dim() == w.Dim());
+
+   if( b == 0. )
+   {
+      AddOneVector(a, v1, c);
+   }
+   else if( a == 0. && c == 0. )
+   {
+      Copy(v2);
+      ElementWiseMultiply(w);
+      if( b != 1. )
+      {
+         Scal(b);
+      }
+   }
+   else
+   {
+      SmartPtr<Vector> tmp = MakeNew();
+      tmp->Copy(v2);
+      tmp->ElementWiseMultiply(w);
+      AddTwoVectors(a, v1, b, *tmp, c);
+   }
+   if( d != 0. )
+   {
+      AddScalar(d);
+   }
+}
+
+Number Vector::WeightedAsumImpl(
+   const Vector& w
+) const
+{
+   DBG_ASSERT(Dim() == w.Dim());
+
+   SmartPtr<Vector> tmp = MakeNew();
+   tmp->Copy(*this);
+   tmp->ElementWiseMultiply(w);
+   return tmp->Asum();
+}
+
 bool Vector::HasValidNumbersImpl() const
 {
    Number sum = Asum();
@@ -220,6 +220,47 @@ public:
       const Vector& s,
       Number        c
    );
+
+   /** Add three vectors, y = a * v1 + b * v2 + c * v3 + d * y.
+    *
+    *  Vectors with a zero coefficient are not accessed.
+    *  @since 3.14.5
+    */
+   inline void AddThreeVectors(
+      Number        a,
+      const Vector& v1,
+      Number        b,
+      const Vector& v2,
+      Number        c,
+      const Vector& v3,
+      Number        d
+   );
+
+   /** Add a vector and an element-wise product of two vectors,
+    *  y = a * v1 + b * v2 .* w + c * y + d.
+    *
+    *  The scalar d is added to every element.
+    *  v1 is not accessed if a is zero, and v2 and w are not accessed
+    *  if b is zero.
+    *  @since 3.14.5
+    */
+   inline void AddVectorAndProduct(
+      Number        a,
+      const Vector& v1,
+      Number        b,
+      const Vector& v2,
+      const Vector& w,
+      Number        c,
+      Number        d
+   );
+
+   /** Returns the 1-norm of the element-wise product with w, sum_i |x_i * w_i|.
+    *
+    *  @since 3.14.5
+    */
+   inline Number WeightedAsum(
+      const Vector& w
+   ) const;
    ///@}
 
    /** Method for determining if all stored numbers are valid (i.e., no Inf or Nan). */
@@ -380,6 +421,33 @@ protected:
       Number        c
    );
 
+   /** Add three vectors */
+   virtual void AddThreeVectorsImpl(
+      Number        a,
+      const Vector& v1,
+      Number        b,
+      const Vector& v2,
+      Number        c,
+      const Vector& v3,
+      Number        d
+   );
+
+   /** Add a vector and an element-wise product of two vectors */
+   virtual void AddVectorAndProductImpl(
+      Number        a,
+      const Vector& v1,
+      Number        b,
+      const Vector& v2,
+      const Vector& w,
+      Number        c,
+      Number        d
+   );
+
+   /** 1-norm of the element-wise product with another vector */
+   virtual Number WeightedAsumImpl(
+      const Vector& w
+   ) const;
+
    /** Method for determining if all stored numbers are valid (i.e., no Inf or Nan).
     *
     *  A default implementation using Asum is provided. */
@@ -845,6 +913,41 @@ inline void Vector::AddVectorQuotient(
    ObjectChanged();
 }
 
+inline void Vector::AddThreeVectors(
+   Number        a,
+   const Vector& v1,
+   Number        b,
+   const Vector& v2,
+   Number        c,
+   const Vector& v3,
+   Number        d
+)
+{
+   AddThreeVectorsImpl(a, v1, b, v2, c, v3, d);
+   ObjectChanged();
+}
+
+inline void Vector::AddVectorAndProduct(
+   Number        a,
+   const Vector& v1,
+   Number        b,
+   const Vector& v2,
+   const Vector& w,
+   Number        c,
+   Number        d
+)
+{
+   AddVectorAndProductImpl(a, v1, b, v2, w, c, d);
+   ObjectChanged();
+}
+
+inline Number Vector::WeightedAsum(
+   const Vector& w
+) const
+{
+   return WeightedAsumImpl(w);
+}
+
 inline bool Vector::HasValidNumbers() const
 {
    if( valid_cache_tag_ != GetTag() )
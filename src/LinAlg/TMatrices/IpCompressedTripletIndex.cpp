@@ -0,0 +1,170 @@
+// Copyright (C) 2021 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpCompressedTripletIndex.hpp"
+#include "IpThreadPool.hpp"
+#include "IpUtils.hpp"
+
+#include <algorithm>
+
+namespace Ipopt
+{
+
+CompressedTripletIndex::CompressedTripletIndex(
+   Index        ndim,
+   Index        nonzeros,
+   const Index* keys,
+   const Index* others,
+   bool         symmetric
+)
+   : ndim_(ndim),
+     ptr_(ndim + 1, 0)
+{
+   // count the entries of every row (counting sort, stable in the triplet order)
+   for( Index k = 0; k < nonzeros; k++ )
+   {
+      ptr_[keys[k]]++;
+      if( symmetric && keys[k] != others[k] )
+      {
+         ptr_[others[k]]++;
+      }
+   }
+   for( Index i = 0; i < ndim; i++ )
+   {
+      ptr_[i + 1] += ptr_[i];
+   }
+
+   pos_.resize(ptr_[ndim]);
+   other_.resize(ptr_[ndim]);
+   std::vector<Index> next(ptr_.begin(), ptr_.end() - 1);
+   for( Index k = 0; k < nonzeros; k++ )
+   {
+      const Index key = keys[k] - 1;
+      const Index other = others[k] - 1;
+      Index p = next[key]++;
+      pos_[p] = k;
+      other_[p] = other;
+      if( symmetric && key != other )
+      {
+         p = next[other]++;
+         pos_[p] = k;
+         other_[p] = key;
+      }
+   }
+}
+
+CompressedTripletIndex::~CompressedTripletIndex()
+{ }
+
+/** Task that computes the product for a range of rows */
+class CompressedTripletMultTask: public ThreadPoolTask
+{
+public:
+   const Index* ptr;
+   const Index* pos;
+   const Index* other;
+   Number alpha;
+   const Number* values;
+   const Number* x;
+   Number xscalar;
+   Number* y;
+   Index begin;
+   Index end;
+
+   void Run(
+      ThreadPool& /*pool*/,
+      Index       /*worker*/
+   )
+   {
+      Compute();
+   }
+
+   void Compute()
+   {
+      if( x == NULL )
+      {
+         const Number as = alpha * xscalar;
+         for( Index i = begin; i < end; i++ )
+         {
+            Number yi = y[i];
+            for( Index p = ptr[i]; p < ptr[i + 1]; p++ )
+            {
+               yi += as * values[pos[p]];
+            }
+            y[i] = yi;
+         }
+      }
+      else
+      {
+         for( Index i = begin; i < end; i++ )
+         {
+            Number yi = y[i];
+            for( Index p = ptr[i]; p < ptr[i + 1]; p++ )
+            {
+               yi += alpha * values[pos[p]] * x[other[p]];
+            }
+            y[i] = yi;
+         }
+      }
+   }
+};
+
+void CompressedTripletIndex::MultVector(
+   Number        alpha,
+   const Number* values,
+   const Number* x,
+   Number        xscalar,
+   Number*       y,
+   ThreadPool*   pool
+) const
+{
+   Index nchunks = pool == NULL ? 1 : Min(pool->NumThreads(), ndim_);
+   if( nchunks < 1 )
+   {
+      return;
+   }
+
+   std::vector<CompressedTripletMultTask> tasks(nchunks);
+   const Index nentries = ptr_[ndim_];
+   Index begin = 0;
+   for( Index t = 0; t < nchunks; t++ )
+   {
+      CompressedTripletMultTask& task = tasks[t];
+      task.ptr = &ptr_[0];
+      task.pos = pos_.empty() ? NULL : &pos_[0];
+      task.other = other_.empty() ? NULL : &other_[0];
+      task.alpha = alpha;
+      task.values = values;
+      task.x = x;
+      task.xscalar = xscalar;
+      task.y = y;
+      task.begin = begin;
+      // the chunk ends with the first row whose entries start after
+      // the share of entries of this chunk
+      if( t == nchunks - 1 )
+      {
+         task.end = ndim_;
+      }
+      else
+      {
+         const Index target = (Index) ((size_t) nentries * (t + 1) / nchunks);
+         task.end = (Index) (std::lower_bound(ptr_.begin() + begin, ptr_.end() - 1, target) - ptr_.begin());
+      }
+      begin = task.end;
+   }
+
+   if( nchunks == 1 )
+   {
+      tasks[0].Compute();
+      return;
+   }
+
+   for( Index t = 0; t < nchunks; t++ )
+   {
+      pool->Submit(&tasks[t]);
+   }
+   pool->Wait();
+}
+
+} // namespace Ipopt
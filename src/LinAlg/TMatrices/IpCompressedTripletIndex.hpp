@@ -0,0 +1,116 @@
+// Copyright (C) 2021 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPCOMPRESSEDTRIPLETINDEX_HPP__
+#define __IPCOMPRESSEDTRIPLETINDEX_HPP__
+
+#include "IpTypes.hpp"
+#include "IpReferenced.hpp"
+
+#include <vector>
+
+namespace Ipopt
+{
+
+class ThreadPool;
+
+/** Compressed (CSR or CSC) index of the nonzeros of a matrix in
+ *  triplet format.
+ *
+ *  The index groups the nonzeros of a triplet matrix by their row
+ *  (giving a CSR shadow of the matrix) or by their column (giving a
+ *  CSC shadow).  The values are not copied: for every entry, the
+ *  index stores the position of the value in the triplet arrays.
+ *  Within a row (column), the entries keep the order of the
+ *  triplets, so that a product computed with this index sums up the
+ *  contributions to every element of the result in the same order
+ *  as the loop over the triplets, and gives the same result.
+ *
+ *  Since every element of the result is computed by exactly one
+ *  thread, products can be distributed over a ThreadPool without
+ *  atomic operations: a CSR shadow gives a row-partitioned product
+ *  A*x, a CSC shadow a column-partitioned product A^T*x.
+ *
+ *  For a symmetric matrix of which only one triangle is stored,
+ *  every off-diagonal entry is listed for both its row and its
+ *  column.
+ *  @since 3.14.5
+ */
+class CompressedTripletIndex: public ReferencedObject
+{
+public:
+   /** Constructor.
+    *
+    *  @param ndim      number of rows (columns) to group by
+    *  @param nonzeros  number of triplet entries
+    *  @param keys      row (column) index of every entry, counting from 1
+    *  @param others    column (row) index of every entry, counting from 1
+    *  @param symmetric whether off-diagonal entries should also be listed for their other index
+    */
+   CompressedTripletIndex(
+      Index        ndim,
+      Index        nonzeros,
+      const Index* keys,
+      const Index* others,
+      bool         symmetric
+   );
+
+   /** Destructor */
+   ~CompressedTripletIndex();
+
+   /** Compute y[i] += alpha * sum_k values[pos_k] * x[other_k] for all i,
+    *  where the sum is over the entries of i.
+    *
+    *  If x is NULL, all entries of x are taken to be xscalar.
+    *  If pool is not NULL, the rows are split into chunks with about
+    *  the same number of entries, one per thread.
+    */
+   void MultVector(
+      Number        alpha,
+      const Number* values,
+      const Number* x,
+      Number        xscalar,
+      Number*       y,
+      ThreadPool*   pool
+   ) const;
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called. */
+   ///@{
+   /** Default Constructor */
+   CompressedTripletIndex();
+
+   /** Copy Constructor */
+   CompressedTripletIndex(
+      const CompressedTripletIndex&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const CompressedTripletIndex&
+   );
+   ///@}
+
+   /** Number of rows (columns) */
+   Index ndim_;
+
+   /** Start of the entries of every row (column), length ndim_+1 */
+   std::vector<Index> ptr_;
+
+   /** Position of the value of every entry in the triplet arrays */
+   std::vector<Index> pos_;
+
+   /** Column (row) of every entry, counting from 0 */
+   std::vector<Index> other_;
+};
+
+} // namespace Ipopt
+
+#endif
@@ -7,6 +7,10 @@
 #include "IpGenTMatrix.hpp"
 #include "IpDenseVector.hpp"
 #include "IpBlas.hpp"
+#include "IpStoragePool.hpp"
+#include "IpThreadPool.hpp"
+#include "IpCompressedTripletIndex.hpp"
+#include "IpProfiler.hpp"
 
 #include <cmath>
 
@@ -53,6 +57,7 @@ void GenTMatrix::MultVectorImpl(
    //  A few sanity checks
    DBG_ASSERT(NCols() == x.Dim());
    DBG_ASSERT(NRows() == y.Dim());
+   ProfileCount(PROFILE_MATVEC_PRODUCTS, 1.);
 
    // Take care of the y part of the addition
    DBG_ASSERT(initialized_);
@@ -76,6 +81,15 @@ void GenTMatrix::MultVectorImpl(
    DenseVector* dense_y = static_cast<DenseVector*>(&y);
    DBG_ASSERT(dynamic_cast<DenseVector*>(&y));
 
+   ThreadPool* pool = owner_space_->GetThreadPool();
+   if( pool != NULL )
+   {
+      const Number* xvals = dense_x->IsHomogeneous() ? NULL : dense_x->Values();
+      const Number xscalar = dense_x->IsHomogeneous() ? dense_x->Scalar() : 0.;
+      owner_space_->RowIndex().MultVector(alpha, values_, xvals, xscalar, dense_y->Values(), pool);
+      return;
+   }
+
    if( dense_x && dense_y )
    {
       const Index* irows = Irows();
@@ -120,6 +134,7 @@ void GenTMatrix::TransMultVectorImpl(
    //  A few sanity checks
    DBG_ASSERT(NCols() == y.Dim());
    DBG_ASSERT(NRows() == x.Dim());
+   ProfileCount(PROFILE_MATVEC_PRODUCTS, 1.);
 
    // Take care of the y part of the addition
    DBG_ASSERT(initialized_);
@@ -143,6 +158,15 @@ void GenTMatrix::TransMultVectorImpl(
    DenseVector* dense_y = static_cast<DenseVector*>(&y);
    DBG_ASSERT(dynamic_cast<DenseVector*>(&y));
 
+   ThreadPool* pool = owner_space_->GetThreadPool();
+   if( pool != NULL )
+   {
+      const Number* xvals = dense_x->IsHomogeneous() ? NULL : dense_x->Values();
+      const Number xscalar = dense_x->IsHomogeneous() ? dense_x->Scalar() : 0.;
+      owner_space_->ColumnIndex().MultVector(alpha, values_, xvals, xscalar, dense_y->Values(), pool);
+      return;
+   }
+
    if( dense_x && dense_y )
    {
       const Index* irows = Irows();
@@ -278,7 +302,9 @@ GenTMatrixSpace::GenTMatrixSpace(
    : MatrixSpace(nRows, nCols),
      nonZeros_(nonZeros),
      jCols_(NULL),
-     iRows_(NULL)
+     iRows_(NULL),
+     storage_pool_(new StoragePool(nonZeros)),
+     min_nonzeros_parallel_(0)
 {
    iRows_ = new Index[nonZeros];
    jCols_ = new Index[nonZeros];
@@ -289,16 +315,68 @@ GenTMatrixSpace::GenTMatrixSpace(
    }
 }
 
+GenTMatrixSpace::~GenTMatrixSpace()
+{
+   delete[] iRows_;
+   delete[] jCols_;
+}
+
 Number* GenTMatrixSpace::AllocateInternalStorage() const
 {
-   return new Number[Nonzeros()];
+   return storage_pool_->Allocate();
 }
 
 void GenTMatrixSpace::FreeInternalStorage(
    Number* values
 ) const
 {
-   delete[] values;
+   storage_pool_->Free(values);
+}
+
+Index GenTMatrixSpace::StoragePoolHits() const
+{
+   return storage_pool_->NumHits();
+}
+
+Index GenTMatrixSpace::StoragePoolMisses() const
+{
+   return storage_pool_->NumMisses();
+}
+
+void GenTMatrixSpace::SetThreadPool(
+   ThreadPool* pool,
+   Index       min_nonzeros_parallel
+)
+{
+   thread_pool_ = pool;
+   min_nonzeros_parallel_ = min_nonzeros_parallel;
+}
+
+ThreadPool* GenTMatrixSpace::GetThreadPool() const
+{
+   if( IsNull(thread_pool_) || thread_pool_->NumThreads() <= 1 || nonZeros_ < min_nonzeros_parallel_ )
+   {
+      return NULL;
+   }
+   return GetRawPtr(thread_pool_);
+}
+
+const CompressedTripletIndex& GenTMatrixSpace::RowIndex() const
+{
+   if( IsNull(row_index_) )
+   {
+      row_index_ = new CompressedTripletIndex(NRows(), nonZeros_, iRows_, jCols_, false);
+   }
+   return *row_index_;
+}
+
+const CompressedTripletIndex& GenTMatrixSpace::ColumnIndex() const
+{
+   if( IsNull(col_index_) )
+   {
+      col_index_ = new CompressedTripletIndex(NCols(), nonZeros_, jCols_, iRows_, false);
+   }
+   return *col_index_;
 }
 
 } // namespace Ipopt
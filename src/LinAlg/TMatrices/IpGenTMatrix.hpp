@@ -15,6 +15,9 @@ namespace Ipopt
 
 /* forward declarations */
 class GenTMatrixSpace;
+class StoragePool;
+class ThreadPool;
+class CompressedTripletIndex;
 
 /** Class for general matrices stored in triplet format.
  *
@@ -208,11 +211,7 @@ public:
    );
 
    /** Destructor */
-   ~GenTMatrixSpace()
-   {
-      delete[] iRows_;
-      delete[] jCols_;
-   }
+   ~GenTMatrixSpace();
    ///@}
 
    /** Method for creating a new matrix of this specific type. */
@@ -247,6 +246,38 @@ public:
    }
    ///@}
 
+   /**@name Statistics of the pool for the values of the matrices */
+   ///@{
+   /** Number of allocations of values that reused the values of a deleted matrix.
+    *  @since 3.14.5
+    */
+   Index StoragePoolHits() const;
+
+   /** Number of allocations of values that required new memory.
+    *  @since 3.14.5
+    */
+   Index StoragePoolMisses() const;
+   ///@}
+
+   /**@name Methods for parallel products with the matrices of this space */
+   ///@{
+   /** Set the thread pool that is used by products with matrices of this space.
+    *
+    *  If the matrices have at least min_nonzeros_parallel nonzeros,
+    *  products with them and their transpose are distributed over the
+    *  threads of the pool by rows and columns, respectively.  For
+    *  this purpose, a compressed row and a compressed column index of
+    *  the sparsity structure are built when they are first needed.
+    *  The result is the same as for the sequential product.
+    *  If pool is NULL, all products are computed sequentially.
+    *  @since 3.14.5
+    */
+   void SetThreadPool(
+      ThreadPool* pool,
+      Index       min_nonzeros_parallel
+   );
+   ///@}
+
 private:
    /** @name Sparsity structure of matrices generated by this matrix space. */
    ///@{
@@ -255,6 +286,35 @@ private:
    Index* iRows_;
    ///@}
 
+   /** Pool for the values of the matrices of this space */
+   SmartPtr<StoragePool> storage_pool_;
+
+   /**@name Data for parallel products */
+   ///@{
+   /** Thread pool for products (may be NULL) */
+   SmartPtr<ThreadPool> thread_pool_;
+
+   /** Minimal number of nonzeros for which products are computed in parallel */
+   Index min_nonzeros_parallel_;
+
+   /** Compressed row index of the structure (built on first use) */
+   mutable SmartPtr<CompressedTripletIndex> row_index_;
+
+   /** Compressed column index of the structure (built on first use) */
+   mutable SmartPtr<CompressedTripletIndex> col_index_;
+   ///@}
+
+   /** Thread pool for products with matrices of this space, or NULL
+    *  if they should be computed sequentially.
+    */
+   ThreadPool* GetThreadPool() const;
+
+   /** Compressed row index of the structure */
+   const CompressedTripletIndex& RowIndex() const;
+
+   /** Compressed column index of the structure */
+   const CompressedTripletIndex& ColumnIndex() const;
+
    /** This method is only for the GenTMatrix to call in order
     *  to allocate internal storage
     */
@@ -7,6 +7,10 @@
 #include "IpSymTMatrix.hpp"
 #include "IpDenseVector.hpp"
 #include "IpBlas.hpp"
+#include "IpStoragePool.hpp"
+#include "IpThreadPool.hpp"
+#include "IpCompressedTripletIndex.hpp"
+#include "IpProfiler.hpp"
 
 #include <cmath>
 
@@ -53,6 +57,7 @@ void SymTMatrix::MultVectorImpl(
    //  A few sanity checks
    DBG_ASSERT(Dim() == x.Dim());
    DBG_ASSERT(Dim() == y.Dim());
+   ProfileCount(PROFILE_MATVEC_PRODUCTS, 1.);
 
    // Take care of the y part of the addition
    DBG_ASSERT(initialized_);
@@ -71,6 +76,15 @@ void SymTMatrix::MultVectorImpl(
    DenseVector* dense_y = static_cast<DenseVector*>(&y);
    DBG_ASSERT(dynamic_cast<DenseVector*>(&y));
 
+   ThreadPool* pool = owner_space_->GetThreadPool();
+   if( pool != NULL )
+   {
+      const Number* xvals = dense_x->IsHomogeneous() ? NULL : dense_x->Values();
+      const Number xscalar = dense_x->IsHomogeneous() ? dense_x->Scalar() : 0.;
+      owner_space_->RowIndex().MultVector(alpha, values_, xvals, xscalar, dense_y->Values(), pool);
+      return;
+   }
+
    if( dense_x && dense_y )
    {
       const Index* irn = Irows();
@@ -234,7 +248,9 @@ SymTMatrixSpace::SymTMatrixSpace(
    : SymMatrixSpace(dim),
      nonZeros_(nonZeros),
      iRows_(NULL),
-     jCols_(NULL)
+     jCols_(NULL),
+     storage_pool_(new StoragePool(nonZeros)),
+     min_nonzeros_parallel_(0)
 {
    iRows_ = new Index[nonZeros];
    jCols_ = new Index[nonZeros];
@@ -253,13 +269,50 @@ SymTMatrixSpace::~SymTMatrixSpace()
 
 Number* SymTMatrixSpace::AllocateInternalStorage() const
 {
-   return new Number[Nonzeros()];
+   return storage_pool_->Allocate();
 }
 
 void SymTMatrixSpace::FreeInternalStorage(
    Number* values) const
 {
-   delete[] values;
+   storage_pool_->Free(values);
+}
+
+Index SymTMatrixSpace::StoragePoolHits() const
+{
+   return storage_pool_->NumHits();
+}
+
+Index SymTMatrixSpace::StoragePoolMisses() const
+{
+   return storage_pool_->NumMisses();
+}
+
+void SymTMatrixSpace::SetThreadPool(
+   ThreadPool* pool,
+   Index       min_nonzeros_parallel
+)
+{
+   thread_pool_ = pool;
+   min_nonzeros_parallel_ = min_nonzeros_parallel;
+}
+
+ThreadPool* SymTMatrixSpace::GetThreadPool() const
+{
+   if( IsNull(thread_pool_) || thread_pool_->NumThreads() <= 1 || nonZeros_ < min_nonzeros_parallel_ )
+   {
+      return NULL;
+   }
+   return GetRawPtr(thread_pool_);
+}
+
+const CompressedTripletIndex& SymTMatrixSpace::RowIndex() const
+{
+   if( IsNull(row_index_) )
+   {
+      row_index_ = new CompressedTripletIndex(Dim(), nonZeros_, iRows_, jCols_, true);
+   }
+   return *row_index_;
 }
 
 } // namespace Ipopt
@@ -15,6 +15,9 @@ namespace Ipopt
 
 /* forward declarations */
 class SymTMatrixSpace;
+class StoragePool;
+class ThreadPool;
+class CompressedTripletIndex;
 
 /** Class for symmetric matrices stored in triplet format.
  *
@@ -236,6 +239,38 @@ public:
    }
    ///@}
 
+   /**@name Statistics of the pool for the values of the matrices */
+   ///@{
+   /** Number of allocations of values that reused the values of a deleted matrix.
+    *  @since 3.14.5
+    */
+   Index StoragePoolHits() const;
+
+   /** Number of allocations of values that required new memory.
+    *  @since 3.14.5
+    */
+   Index StoragePoolMisses() const;
+   ///@}
+
+   /**@name Methods for parallel products with the matrices of this space */
+   ///@{
+   /** Set the thread pool that is used by products with matrices of this space.
+    *
+    *  If the matrices have at least min_nonzeros_parallel nonzeros,
+    *  products with them are distributed over the threads of the pool
+    *  by rows.  For this purpose, a compressed row index of the
+    *  sparsity structure, which lists every off-diagonal element for
+    *  its row and its column, is built when it is first needed.
+    *  The result is the same as for the sequential product.
+    *  If pool is NULL, all products are computed sequentially.
+    *  @since 3.14.5
+    */
+   void SetThreadPool(
+      ThreadPool* pool,
+      Index       min_nonzeros_parallel
+   );
+   ///@}
+
 private:
    /**@name Methods called by SymTMatrix for memory management */
    ///@{
@@ -252,6 +287,29 @@ private:
    Index* iRows_;
    Index* jCols_;
 
+   /** Pool for the values of the matrices of this space */
+   SmartPtr<StoragePool> storage_pool_;
+
+   /**@name Data for parallel products */
+   ///@{
+   /** Thread pool for products (may be NULL) */
+   SmartPtr<ThreadPool> thread_pool_;
+
+   /** Minimal number of nonzeros for which products are computed in parallel */
+   Index min_nonzeros_parallel_;
+
+   /** Compressed row index of the symmetric structure (built on first use) */
+   mutable SmartPtr<CompressedTripletIndex> row_index_;
+   ///@}
+
+   /** Thread pool for products with matrices of this space, or NULL
+    *  if they should be computed sequentially.
+    */
+   ThreadPool* GetThreadPool() const;
+
+   /** Compressed row index of the symmetric structure */
+   const CompressedTripletIndex& RowIndex() const;
+
    friend class SymTMatrix;
 };
 
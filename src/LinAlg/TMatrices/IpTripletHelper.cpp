@@ -1143,6 +1143,348 @@ void TripletHelper::FillValues_(
    }
 }
 
+void TripletHelper::AddValuesAtPositions(
+   Index         n_entries,
+   const Matrix& matrix,
+   Number        factor,
+   const Index*  positions,
+   Number*       values
+)
+{
+   const Matrix* mptr = &matrix;
+   const GenTMatrix* gent = dynamic_cast<const GenTMatrix*>(mptr);
+   if( gent )
+   {
+      AddValuesAtPositions_(n_entries, *gent, factor, positions, values);
+      return;
+   }
+
+   const SymTMatrix* symt = dynamic_cast<const SymTMatrix*>(mptr);
+   if( symt )
+   {
+      AddValuesAtPositions_(n_entries, *symt, factor, positions, values);
+      return;
+   }
+
+   const DiagMatrix* diag = dynamic_cast<const DiagMatrix*>(mptr);
+   if( diag )
+   {
+      AddValuesAtPositions_(n_entries, *diag, factor, positions, values);
+      return;
+   }
+
+   const IdentityMatrix* ident = dynamic_cast<const IdentityMatrix*>(mptr);
+   if( ident )
+   {
+      AddValuesAtPositions_(n_entries, *ident, factor, positions, values);
+      return;
+   }
+
+   const ExpansionMatrix* exp = dynamic_cast<const ExpansionMatrix*>(mptr);
+   if( exp )
+   {
+      AddValuesAtPositions_(n_entries, *exp, factor, positions, values);
+      return;
+   }
+
+   const SumMatrix* sum = dynamic_cast<const SumMatrix*>(mptr);
+   if( sum )
+   {
+      AddValuesAtPositions_(n_entries, *sum, factor, positions, values);
+      return;
+   }
+
+   const SumSymMatrix* sum_sym = dynamic_cast<const SumSymMatrix*>(mptr);
+   if( sum_sym )
+   {
+      AddValuesAtPositions_(n_entries, *sum_sym, factor, positions, values);
+      return;
+   }
+
+   const CompoundMatrix* cmpd = dynamic_cast<const CompoundMatrix*>(mptr);
+   if( cmpd )
+   {
+      AddValuesAtPositions_(n_entries, *cmpd, factor, positions, values);
+      return;
+   }
+
+   const CompoundSymMatrix* cmpd_sym = dynamic_cast<const CompoundSymMatrix*>(mptr);
+   if( cmpd_sym )
+   {
+      AddValuesAtPositions_(n_entries, *cmpd_sym, factor, positions, values);
+      return;
+   }
+
+   const TransposeMatrix* trans = dynamic_cast<const TransposeMatrix*>(mptr);
+   if( trans )
+   {
+      AddValuesAtPositions_(n_entries, *trans, factor, positions, values);
+      return;
+   }
+
+   // For all other matrix types, go through the triplet values
+   if( n_entries > 0 )
+   {
+      Number* tvalues = new Number[n_entries];
+      FillValues(n_entries, matrix, tvalues);
+      for( Index i = 0; i < n_entries; i++ )
+      {
+         values[positions[i]] += factor * tvalues[i];
+      }
+      delete[] tvalues;
+   }
+}
+
+void TripletHelper::AddValuesAtPositions_(
+   Index             n_entries,
+   const GenTMatrix& matrix,
+   Number            factor,
+   const Index*      positions,
+   Number*           values
+)
+{
+   DBG_ASSERT(n_entries == matrix.Nonzeros());
+   const Number* vals = matrix.Values();
+   if( factor == 1. )
+   {
+      for( Index i = 0; i < n_entries; i++ )
+      {
+         values[positions[i]] += vals[i];
+      }
+   }
+   else
+   {
+      for( Index i = 0; i < n_entries; i++ )
+      {
+         values[positions[i]] += factor * vals[i];
+      }
+   }
+}
+
+void TripletHelper::AddValuesAtPositions_(
+   Index             n_entries,
+   const SymTMatrix& matrix,
+   Number            factor,
+   const Index*      positions,
+   Number*           values
+)
+{
+   DBG_ASSERT(n_entries == matrix.Nonzeros());
+   const Number* vals = matrix.Values();
+   if( factor == 1. )
+   {
+      for( Index i = 0; i < n_entries; i++ )
+      {
+         values[positions[i]] += vals[i];
+      }
+   }
+   else
+   {
+      for( Index i = 0; i < n_entries; i++ )
+      {
+         values[positions[i]] += factor * vals[i];
+      }
+   }
+}
+
+void TripletHelper::AddValuesAtPositions_(
+   Index             n_entries,
+   const DiagMatrix& matrix,
+   Number            factor,
+   const Index*      positions,
+   Number*           values
+)
+{
+   DBG_ASSERT(n_entries == matrix.Dim());
+   SmartPtr<const Vector> v = matrix.GetDiag();
+   const DenseVector* dv = dynamic_cast<const DenseVector*>(GetRawPtr(v));
+   if( dv && dv->IsHomogeneous() )
+   {
+      Number scalar = factor * dv->Scalar();
+      for( Index i = 0; i < n_entries; i++ )
+      {
+         values[positions[i]] += scalar;
+      }
+   }
+   else if( dv )
+   {
+      const Number* vals = dv->Values();
+      for( Index i = 0; i < n_entries; i++ )
+      {
+         values[positions[i]] += factor * vals[i];
+      }
+   }
+   else
+   {
+      Number* vals = new Number[n_entries];
+      FillValuesFromVector(n_entries, *v, vals);
+      for( Index i = 0; i < n_entries; i++ )
+      {
+         values[positions[i]] += factor * vals[i];
+      }
+      delete[] vals;
+   }
+}
+
+void TripletHelper::AddValuesAtPositions_(
+   Index                 n_entries,
+   const IdentityMatrix& matrix,
+   Number                factor,
+   const Index*          positions,
+   Number*               values
+)
+{
+   DBG_ASSERT(n_entries == matrix.Dim());
+   Number scalar = factor * matrix.GetFactor();
+   for( Index i = 0; i < n_entries; i++ )
+   {
+      values[positions[i]] += scalar;
+   }
+}
+
+void TripletHelper::AddValuesAtPositions_(
+   Index                  n_entries,
+   const ExpansionMatrix& matrix,
+   Number                 factor,
+   const Index*           positions,
+   Number*                values
+)
+{
+   DBG_ASSERT(n_entries == matrix.NCols());
+   (void) matrix;
+   for( Index i = 0; i < n_entries; i++ )
+   {
+      values[positions[i]] += factor;
+   }
+}
+
+void TripletHelper::AddValuesAtPositions_(
+   Index            n_entries,
+   const SumMatrix& matrix,
+   Number           factor,
+   const Index*     positions,
+   Number*          values
+)
+{
+   DBG_DO(Index total_n_entries = 0);
+   for( Index i = 0; i < matrix.NTerms(); i++ )
+   {
+      Number retFactor = 0.0;
+      SmartPtr<const Matrix> retTerm;
+      matrix.GetTerm(i, retFactor, retTerm);
+      Index term_n_entries = GetNumberEntries(*retTerm);
+      DBG_DO(total_n_entries += term_n_entries);
+      if( retFactor != 0.0 )
+      {
+         AddValuesAtPositions(term_n_entries, *retTerm, factor * retFactor, positions, values);
+      }
+
+      // now shift the positions pointer for the next term
+      positions += term_n_entries;
+   }
+   DBG_ASSERT(total_n_entries == n_entries);
+   (void) n_entries;
+}
+
+void TripletHelper::AddValuesAtPositions_(
+   Index               n_entries,
+   const SumSymMatrix& matrix,
+   Number              factor,
+   const Index*        positions,
+   Number*             values
+)
+{
+   DBG_DO(Index total_n_entries = 0);
+   for( Index i = 0; i < matrix.NTerms(); i++ )
+   {
+      Number retFactor = 0.0;
+      SmartPtr<const SymMatrix> retTerm;
+      matrix.GetTerm(i, retFactor, retTerm);
+      Index term_n_entries = GetNumberEntries(*retTerm);
+      DBG_DO(total_n_entries += term_n_entries);
+      if( retFactor != 0.0 )
+      {
+         AddValuesAtPositions(term_n_entries, *retTerm, factor * retFactor, positions, values);
+      }
+
+      // now shift the positions pointer for the next term
+      positions += term_n_entries;
+   }
+   DBG_ASSERT(total_n_entries == n_entries);
+   (void) n_entries;
+}
+
+void TripletHelper::AddValuesAtPositions_(
+   Index                 n_entries,
+   const CompoundMatrix& matrix,
+   Number                factor,
+   const Index*          positions,
+   Number*               values
+)
+{
+   DBG_DO(Index total_n_entries = 0);
+
+   for( Index i = 0; i < matrix.NComps_Rows(); i++ )
+   {
+      for( Index j = 0; j < matrix.NComps_Cols(); j++ )
+      {
+         SmartPtr<const Matrix> blk_mat = matrix.GetComp(i, j);
+         if( IsValid(blk_mat) )
+         {
+            Index blk_n_entries = GetNumberEntries(*blk_mat);
+            DBG_DO(total_n_entries += blk_n_entries);
+            AddValuesAtPositions(blk_n_entries, *blk_mat, factor, positions, values);
+
+            // now shift the positions pointer for the next block
+            positions += blk_n_entries;
+         }
+      }
+   }
+   DBG_ASSERT(total_n_entries == n_entries);
+   (void) n_entries;
+}
+
+void TripletHelper::AddValuesAtPositions_(
+   Index                    n_entries,
+   const CompoundSymMatrix& matrix,
+   Number                   factor,
+   const Index*             positions,
+   Number*                  values
+)
+{
+   DBG_DO(Index total_n_entries = 0);
+
+   for( Index i = 0; i < matrix.NComps_Dim(); i++ )
+   {
+      for( Index j = 0; j <= i; j++ )
+      {
+         SmartPtr<const Matrix> blk_mat = matrix.GetComp(i, j);
+         if( IsValid(blk_mat) )
+         {
+            Index blk_n_entries = GetNumberEntries(*blk_mat);
+            DBG_DO(total_n_entries += blk_n_entries);
+            AddValuesAtPositions(blk_n_entries, *blk_mat, factor, positions, values);
+
+            // now shift the positions pointer for the next block
+            positions += blk_n_entries;
+         }
+      }
+   }
+   DBG_ASSERT(total_n_entries == n_entries);
+   (void) n_entries;
+}
+
+void TripletHelper::AddValuesAtPositions_(
+   Index                  n_entries,
+   const TransposeMatrix& matrix,
+   Number                 factor,
+   const Index*           positions,
+   Number*                values
+)
+{
+   AddValuesAtPositions(n_entries, *matrix.OrigMatrix(), factor, positions, values);
+}
+
 void TripletHelper::PutValuesInVector(
    Index         dim,
    const Number* values,
@@ -62,6 +62,21 @@ public:
       Number*       values
    );
 
+   /** add the values for the triplet format from the matrix, multiplied
+    *  by factor, to the given positions of a values array
+    *
+    *  The value of the i-th triplet entry is added to values[positions[i]].
+    *  This allows to assemble the matrix directly into a compressed
+    *  format, where repeated entries are mapped to the same position.
+    */
+   static void AddValuesAtPositions(
+      Index         n_entries,
+      const Matrix& matrix,
+      Number        factor,
+      const Index*  positions,
+      Number*       values
+   );
+
    /** fill the values from the vector into a dense double* structure */
    static void FillValuesFromVector(
       Index         dim,
@@ -302,6 +317,86 @@ private:
       const ExpandedMultiVectorMatrix& matrix,
       Number*                          values
    );
+
+   static void AddValuesAtPositions_(
+      Index             n_entries,
+      const GenTMatrix& matrix,
+      Number            factor,
+      const Index*      positions,
+      Number*           values
+   );
+
+   static void AddValuesAtPositions_(
+      Index             n_entries,
+      const SymTMatrix& matrix,
+      Number            factor,
+      const Index*      positions,
+      Number*           values
+   );
+
+   static void AddValuesAtPositions_(
+      Index             n_entries,
+      const DiagMatrix& matrix,
+      Number            factor,
+      const Index*      positions,
+      Number*           values
+   );
+
+   static void AddValuesAtPositions_(
+      Index                 n_entries,
+      const IdentityMatrix& matrix,
+      Number                factor,
+      const Index*          positions,
+      Number*               values
+   );
+
+   static void AddValuesAtPositions_(
+      Index                  n_entries,
+      const ExpansionMatrix& matrix,
+      Number                 factor,
+      const Index*           positions,
+      Number*                values
+   );
+
+   static void AddValuesAtPositions_(
+      Index            n_entries,
+      const SumMatrix& matrix,
+      Number           factor,
+      const Index*     positions,
+      Number*          values
+   );
+
+   static void AddValuesAtPositions_(
+      Index               n_entries,
+      const SumSymMatrix& matrix,
+      Number              factor,
+      const Index*        positions,
+      Number*             values
+   );
+
+   static void AddValuesAtPositions_(
+      Index                 n_entries,
+      const CompoundMatrix& matrix,
+      Number                factor,
+      const Index*          positions,
+      Number*               values
+   );
+
+   static void AddValuesAtPositions_(
+      Index                    n_entries,
+      const CompoundSymMatrix& matrix,
+      Number                   factor,
+      const Index*             positions,
+      Number*                  values
+   );
+
+   static void AddValuesAtPositions_(
+      Index                  n_entries,
+      const TransposeMatrix& matrix,
+      Number                 factor,
+      const Index*           positions,
+      Number*                values
+   );
 };
 
 } // namespace Ipopt
@@ -0,0 +1,386 @@
+// Copyright (C) 2021 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+// get active asserts also if NDEBUG is defined
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include "IpIpoptApplication.hpp"
+#include "IpSolveStatistics.hpp"
+#include "IpTNLP.hpp"
+
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+using namespace Ipopt;
+
+#ifdef IPOPT_SINGLE
+#define TESTTOL 5e-4
+#else
+#define TESTTOL 1e-9
+#endif
+#define ASSERTEQ(val1, val2) \
+   do if( std::abs((val1)-(val2)) > TESTTOL*std::max(1.0,std::max((double)std::abs(val1),(double)std::abs(val2))) ) \
+   { \
+      fprintf(stderr, "Line %d: Wrong %s = %.12g, expected %s = %.12g\n", __LINE__, #val1, val1, #val2, val2); \
+      abort(); \
+   } while (false)
+
+/** NLP to test the built-in LDL^T solver with several threads
+ *
+ * Discretized boundary control problem on (0,1) with N interior grid points:
+ * min  h/2 sum_i ((y_i - 1)^2 + alpha u_i^2)
+ * s.t. y_{i-1} - 2 y_i + y_{i+1} - h^2 (y_i^3 - u_i) = 0,  i = 1..N
+ *      y_0 = y_{N+1} = 0
+ *      u_i <= umax
+ *
+ * The KKT matrix has zero diagonal entries for the constraints and an
+ * assembly tree with many independent fronts.
+ */
+class LdlTestNLP: public TNLP
+{
+private:
+   Index N_;
+   Number h_;
+   Number alpha_;
+   Number umax_;
+
+public:
+   /// solution
+   std::vector<Number> x_sol;
+   /// objective value at solution
+   Number obj_sol;
+
+   /** constructor */
+   LdlTestNLP(
+      Index N
+   )
+      : N_(N),
+        h_(1. / (N + 1)),
+        alpha_(1e-2),
+        umax_(5.),
+        obj_sol(0.)
+   { }
+
+   /** Method to return some info about the nlp */
+   bool get_nlp_info(
+      Index&          n,
+      Index&          m,
+      Index&          nnz_jac_g,
+      Index&          nnz_h_lag,
+      IndexStyleEnum& index_style
+   )
+   {
+      n = 2 * N_;
+      m = N_;
+      nnz_jac_g = 4 * N_ - 2;
+      nnz_h_lag = 2 * N_;
+      index_style = C_STYLE;
+
+      return true;
+   }
+
+   /** Method to return the bounds for my problem */
+   bool get_bounds_info(
+      Index   n,
+      Number* x_l,
+      Number* x_u,
+      Index   m,
+      Number* g_l,
+      Number* g_u
+   )
+   {
+      assert(n == 2 * N_);
+      assert(m == N_);
+
+      for( Index i = 0; i < N_; i++ )
+      {
+         x_l[i] = -1e300;
+         x_u[i] = 1e300;
+         x_l[N_ + i] = -1e300;
+         x_u[N_ + i] = umax_;
+         g_l[i] = 0.;
+         g_u[i] = 0.;
+      }
+
+      return true;
+   }
+
+   /** Method to return the starting point for the algorithm */
+   bool get_starting_point(
+      Index   n,
+      bool    init_x,
+      Number* x,
+      bool    init_z,
+      Number*,
+      Number*,
+      Index,
+      bool    init_lambda,
+      Number*
+   )
+   {
+      assert(n == 2 * N_);
+      assert(init_x);
+      assert(!init_z);
+      assert(!init_lambda);
+
+      for( Index i = 0; i < n; i++ )
+      {
+         x[i] = 0.;
+      }
+
+      return true;
+   }
+
+   /** Method to return the objective value */
+   bool eval_f(
+      Index         n,
+      const Number* x,
+      bool,
+      Number&       obj_value
+   )
+   {
+      assert(n == 2 * N_);
+
+      obj_value = 0.;
+      for( Index i = 0; i < N_; i++ )
+      {
+         obj_value += (x[i] - 1.) * (x[i] - 1.) + alpha_ * x[N_ + i] * x[N_ + i];
+      }
+      obj_value *= h_ / 2.;
+
+      return true;
+   }
+
+   /** Method to return the gradient of the objective */
+   bool eval_grad_f(
+      Index         n,
+      const Number* x,
+      bool,
+      Number*       grad_f
+   )
+   {
+      assert(n == 2 * N_);
+
+      for( Index i = 0; i < N_; i++ )
+      {
+         grad_f[i] = h_ * (x[i] - 1.);
+         grad_f[N_ + i] = h_ * alpha_ * x[N_ + i];
+      }
+
+      return true;
+   }
+
+   /** Method to return the constraint residuals */
+   bool eval_g(
+      Index         n,
+      const Number* x,
+      bool,
+      Index         m,
+      Number*       g
+   )
+   {
+      assert(n == 2 * N_);
+      assert(m == N_);
+
+      for( Index i = 0; i < N_; i++ )
+      {
+         const Number yl = i > 0 ? x[i - 1] : 0.;
+         const Number yr = i < N_ - 1 ? x[i + 1] : 0.;
+         g[i] = yl - 2. * x[i] + yr - h_ * h_ * (x[i] * x[i] * x[i] - x[N_ + i]);
+      }
+
+      return true;
+   }
+
+   /** Method to return:
+    *   1) The structure of the jacobian (if "values" is NULL)
+    *   2) The values of the jacobian (if "values" is not NULL)
+    */
+   bool eval_jac_g(
+      Index         n,
+      const Number* x,
+      bool,
+      Index         m,
+      Index         nele_jac,
+      Index*        iRow,
+      Index*        jCol,
+      Number*       values
+   )
+   {
+      assert(n == 2 * N_);
+      assert(m == N_);
+
+      Index k = 0;
+      for( Index i = 0; i < N_; i++ )
+      {
+         if( i > 0 )
+         {
+            if( values == NULL )
+            {
+               iRow[k] = i;
+               jCol[k] = i - 1;
+            }
+            else
+            {
+               values[k] = 1.;
+            }
+            k++;
+         }
+         if( values == NULL )
+         {
+            iRow[k] = i;
+            jCol[k] = i;
+            iRow[k + 1] = i;
+            jCol[k + 1] = N_ + i;
+         }
+         else
+         {
+            values[k] = -2. - 3. * h_ * h_ * x[i] * x[i];
+            values[k + 1] = h_ * h_;
+         }
+         k += 2;
+         if( i < N_ - 1 )
+         {
+            if( values == NULL )
+            {
+               iRow[k] = i;
+               jCol[k] = i + 1;
+            }
+            else
+            {
+               values[k] = 1.;
+            }
+            k++;
+         }
+      }
+      assert(k == nele_jac);
+
+      return true;
+   }
+
+   /** Method to return:
+    *   1) The structure of the hessian of the lagrangian (if "values" is NULL)
+    *   2) The values of the hessian of the lagrangian (if "values" is not NULL)
+    */
+   bool eval_h(
+      Index         n,
+      const Number* x,
+      bool,
+      Number        obj_factor,
+      Index         m,
+      const Number* lambda,
+      bool,
+      Index         nele_hess,
+      Index*        iRow,
+      Index*        jCol,
+      Number*       values
+   )
+   {
+      assert(n == 2 * N_);
+      assert(m == N_);
+      assert(nele_hess == 2 * N_);
+
+      for( Index i = 0; i < n; i++ )
+      {
+         if( values == NULL )
+         {
+            iRow[i] = i;
+            jCol[i] = i;
+         }
+         else if( i < N_ )
+         {
+            values[i] = obj_factor * h_ - 6. * lambda[i] * h_ * h_ * x[i];
+         }
+         else
+         {
+            values[i] = obj_factor * h_ * alpha_;
+         }
+      }
+
+      return true;
+   }
+
+   /** This method is called when the algorithm is complete so the TNLP can store/write the solution */
+   void finalize_solution(
+      SolverReturn,
+      Index         n,
+      const Number* x,
+      const Number*,
+      const Number*,
+      Index,
+      const Number*,
+      const Number*,
+      Number        obj_value,
+      const IpoptData*,
+      IpoptCalculatedQuantities*
+   )
+   {
+      x_sol.assign(x, x + n);
+      obj_sol = obj_value;
+   }
+};
+
+static bool run(
+   Index       num_threads,
+   LdlTestNLP& nlp
+)
+{
+   // Create an instance of the IpoptApplication
+   SmartPtr<IpoptApplication> app = new IpoptApplication();
+
+   // Initialize the IpoptApplication and process the options
+   ApplicationReturnStatus status;
+   status = app->Initialize();
+   if( status != Solve_Succeeded )
+   {
+      std::cout << std::endl << std::endl << "*** Error during initialization!" << std::endl;
+      return false;
+   }
+
+   app->Options()->SetIntegerValue("print_level", 0, true, true);
+   app->Options()->SetStringValue("linear_solver", "ldl", true, true);
+   app->Options()->SetIntegerValue("ldl_num_threads", num_threads, true, true);
+
+   status = app->OptimizeTNLP(&nlp);
+   if( status != Solve_Succeeded )
+   {
+      std::cout << std::endl << std::endl << "*** The problem FAILED with " << num_threads << " threads!" << std::endl;
+      return false;
+   }
+
+   return true;
+}
+
+int main(
+   int,
+   char**
+)
+{
+   SmartPtr<LdlTestNLP> nlp1 = new LdlTestNLP(2000);
+   if( !run(1, *nlp1) )
+   {
+      return EXIT_FAILURE;
+   }
+
+   // the parallel factorization gives the same result as the sequential one
+   SmartPtr<LdlTestNLP> nlp4 = new LdlTestNLP(2000);
+   if( !run(4, *nlp4) )
+   {
+      return EXIT_FAILURE;
+   }
+
+   ASSERTEQ(nlp4->obj_sol, nlp1->obj_sol);
+   for( size_t i = 0; i < nlp1->x_sol.size(); i++ )
+   {
+      ASSERTEQ(nlp4->x_sol[i], nlp1->x_sol[i]);
+   }
+
+   std::cout << std::endl << "*** All tests passed" << std::endl;
+
+   return EXIT_SUCCESS;
+}